@@ -0,0 +1,174 @@
+#include "Client.h"
+
+#include <zuazo/StringConversions.h>
+
+#include <stdexcept>
+
+namespace Cenital::Bench {
+
+using namespace Zuazo;
+
+/*
+ * Client
+ */
+
+std::string Client::request(const std::string& command) {
+	const auto id = "#" + toString(m_nextId++) + ' ';
+	send(id + command + '\n');
+
+	//Skip everything until our response arrives
+	std::string response;
+	do {
+		response = receive();
+	} while(response.compare(0, id.size(), id) != 0);
+
+	return response;
+}
+
+
+
+/*
+ * DirectClient
+ */
+
+DirectClient::DirectClient(Control::CLIView& view)
+	: m_view(view)
+	, m_response()
+{
+}
+
+void DirectClient::send(const std::string& message) {
+	m_view.parse(message, m_response);
+}
+
+std::string DirectClient::receive() {
+	return m_response;
+}
+
+
+
+/*
+ * TCPClient
+ */
+
+TCPClient::TCPClient(uint16_t port)
+	: m_ios()
+	, m_socket(m_ios)
+	, m_streambuf()
+{
+	m_socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+	m_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+}
+
+void TCPClient::send(const std::string& message) {
+	boost::asio::write(m_socket, boost::asio::buffer(message));
+}
+
+std::string TCPClient::receive() {
+	const auto byteCnt = boost::asio::read_until(m_socket, m_streambuf, '\n');
+	const auto buffer = m_streambuf.data();
+	std::string result(
+		boost::asio::buffers_begin(buffer),
+		boost::asio::buffers_begin(buffer) + byteCnt
+	);
+	m_streambuf.consume(byteCnt);
+	return result;
+}
+
+
+
+/*
+ * WebSocketClient
+ */
+
+WebSocketClient::WebSocketClient(uint16_t port)
+	: m_endpoint()
+	, m_connection()
+	, m_thread()
+	, m_mutex()
+	, m_condition()
+	, m_incoming()
+	, m_open(false)
+	, m_closed(false)
+{
+	m_endpoint.clear_access_channels(websocketpp::log::alevel::all); 
+	m_endpoint.clear_error_channels(websocketpp::log::elevel::all);
+	m_endpoint.init_asio();
+
+	m_endpoint.set_open_handler(
+		[this] (websocketpp::connection_hdl) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_open = true;
+			m_condition.notify_all();
+		}
+	);
+	m_endpoint.set_fail_handler(
+		[this] (websocketpp::connection_hdl) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_closed = true;
+			m_condition.notify_all();
+		}
+	);
+	m_endpoint.set_close_handler(
+		[this] (websocketpp::connection_hdl) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_closed = true;
+			m_condition.notify_all();
+		}
+	);
+	m_endpoint.set_message_handler(
+		[this] (websocketpp::connection_hdl, Endpoint::message_ptr msg) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_incoming.push_back(msg->get_payload());
+			m_condition.notify_all();
+		}
+	);
+
+	//Connect to the server
+	websocketpp::lib::error_code error;
+	const auto connection = m_endpoint.get_connection("ws://127.0.0.1:" + toString(port), error);
+	if(error) {
+		throw std::runtime_error(error.message());
+	}
+	m_connection = connection->get_handle();
+	m_endpoint.connect(connection);
+
+	//Run the client on its own thread and wait until it is connected
+	m_thread = std::thread(
+		[this] () {
+			m_endpoint.run();
+		}
+	);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this] { return m_open || m_closed; });
+	if(!m_open) {
+		lock.unlock();
+		m_thread.join();
+		throw std::runtime_error("Could not connect to the WebSocket server");
+	}
+}
+
+WebSocketClient::~WebSocketClient() {
+	websocketpp::lib::error_code error;
+	m_endpoint.close(m_connection, websocketpp::close::status::going_away, "", error);
+	m_thread.join();
+}
+
+void WebSocketClient::send(const std::string& message) {
+	m_endpoint.send(m_connection, message, websocketpp::frame::opcode::TEXT);
+}
+
+std::string WebSocketClient::receive() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this] { return !m_incoming.empty() || m_closed; });
+	if(m_incoming.empty()) {
+		throw std::runtime_error("WebSocket connection closed");
+	}
+
+	auto result = std::move(m_incoming.front());
+	m_incoming.pop_front();
+	return result;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Control/CLIView.h>
+
+#include <boost/asio.hpp>
+#include <websocketpp/config/asio_no_tls_client.hpp>
+#include <websocketpp/client.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Cenital::Bench {
+
+//Sends a command and blocks until its response arrives. Every
+//request is tagged with an acknowledgement id, so that the response 
+//can be told apart from the broadcasts of the previous requests
+class Client {
+public:
+	Client() = default;
+	Client(const Client& other) = delete;
+	virtual ~Client() = default;
+
+	Client&								operator=(const Client& other) = delete;
+
+	std::string							request(const std::string& command);
+
+protected:
+	virtual void						send(const std::string& message) = 0;
+	virtual std::string					receive() = 0;
+
+private:
+	size_t								m_nextId = 0;
+
+};
+
+
+
+//Calls the CLI view in-process
+class DirectClient 
+	: public Client
+{
+public:
+	explicit DirectClient(Control::CLIView& view);
+	virtual ~DirectClient() = default;
+
+protected:
+	virtual void						send(const std::string& message) final;
+	virtual std::string					receive() final;
+
+private:
+	Control::CLIView&					m_view;
+	std::string							m_response;
+
+};
+
+
+
+class TCPClient 
+	: public Client
+{
+public:
+	explicit TCPClient(uint16_t port);
+	virtual ~TCPClient() = default;
+
+protected:
+	virtual void						send(const std::string& message) final;
+	virtual std::string					receive() final;
+
+private:
+	boost::asio::io_service				m_ios;
+	boost::asio::ip::tcp::socket		m_socket;
+	boost::asio::streambuf				m_streambuf;
+
+};
+
+
+
+class WebSocketClient 
+	: public Client
+{
+public:
+	explicit WebSocketClient(uint16_t port);
+	virtual ~WebSocketClient();
+
+protected:
+	virtual void						send(const std::string& message) final;
+	virtual std::string					receive() final;
+
+private:
+	using Endpoint = websocketpp::client<websocketpp::config::asio_client>;
+
+	Endpoint							m_endpoint;
+	websocketpp::connection_hdl			m_connection;
+	std::thread							m_thread;
+
+	std::mutex							m_mutex;
+	std::condition_variable				m_condition;
+	std::deque<std::string>				m_incoming;
+	bool								m_open;
+	bool								m_closed;
+
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "Trace.h"
+
+#include <zuazo/StringConversions.h>
+
+#include <cmath>
+
+namespace Cenital::Bench {
+
+using namespace Zuazo;
+
+void generateSetupTrace(Trace& trace, size_t mixEffectCount, size_t inputCount, size_t keyerCount) {
+	for(size_t i = 0; i < mixEffectCount; ++i) {
+		const auto me = getMixEffectName(i);
+
+		trace.emplace_back("add mix-effect " + me);
+		trace.emplace_back("config " + me + " input:count set " + toString(inputCount));
+		trace.emplace_back("config " + me + " us-overlay:count set " + toString(keyerCount));
+
+		for(size_t j = 0; j < keyerCount; ++j) {
+			const auto keyer = "config " + me + " us-overlay config " + toString(j);
+			trace.emplace_back(keyer + " luma-key:ena set true");
+		}
+	}
+}
+
+void generateFaderSweep(Trace& trace, size_t mixEffectCount, size_t stepCount) {
+	//Move the T-bar all the way and back, as a human operator would do
+	for(size_t i = 0; i < mixEffectCount; ++i) {
+		const auto command = "config " + getMixEffectName(i) + " transition:bar set ";
+
+		for(size_t j = 0; j <= stepCount; ++j) {
+			trace.emplace_back(command + toString(static_cast<float>(j) / stepCount));
+		}
+		for(size_t j = stepCount; j > 0; --j) {
+			trace.emplace_back(command + toString(static_cast<float>(j - 1) / stepCount));
+		}
+	}
+}
+
+void generateCutStorm(Trace& trace, size_t mixEffectCount, size_t inputCount, size_t cutCount) {
+	//Select a preview and cut to it as fast as possible
+	for(size_t i = 0; i < cutCount; ++i) {
+		const auto me = "config " + getMixEffectName(i % mixEffectCount);
+
+		trace.emplace_back(me + " pvw set " + toString(i % inputCount));
+		trace.emplace_back(me + " cut");
+	}
+}
+
+void generateKeyerDrag(Trace& trace, size_t mixEffectCount, size_t keyerCount, size_t stepCount) {
+	//Drag the parameters of the keyers as if a slider was being moved
+	for(size_t i = 0; i < mixEffectCount; ++i) {
+		for(size_t j = 0; j < keyerCount; ++j) {
+			const auto keyer = "config " + getMixEffectName(i) + " us-overlay config " + toString(j);
+
+			for(size_t k = 0; k <= stepCount; ++k) {
+				const auto value = static_cast<float>(k) / stepCount;
+				trace.emplace_back(keyer + " luma-key:min set " + toString(value * 0.5f));
+				trace.emplace_back(keyer + " luma-key:max set " + toString(0.5f + value * 0.5f));
+				trace.emplace_back(keyer + " blending:opacity set " + toString(1.0f - value));
+			}
+		}
+	}
+}
+
+
+
+bool loadTrace(std::istream& is, Trace& trace) {
+	//One command per line. Empty lines and lines starting
+	//with '#' are ignored, as acknowledgement ids are assigned 
+	//when replaying the trace
+	std::string line;
+
+	while(std::getline(is, line)) {
+		while(!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+			line.pop_back();
+		}
+
+		if(!line.empty() && line.front() != '#') {
+			trace.push_back(std::move(line));
+		}
+	}
+
+	return !is.bad();
+}
+
+std::string getMixEffectName(size_t index) {
+	return "ME" + toString(index);
+}
+
+}
\ No newline at end of file
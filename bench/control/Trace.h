@@ -0,0 +1,22 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace Cenital::Bench {
+
+//A trace is a sequence of commands as they are sent by 
+//a client, without the acknowledgement id nor line feed
+using Trace = std::vector<std::string>;
+
+void generateSetupTrace(Trace& trace, size_t mixEffectCount, size_t inputCount, size_t keyerCount);
+void generateFaderSweep(Trace& trace, size_t mixEffectCount, size_t stepCount);
+void generateCutStorm(Trace& trace, size_t mixEffectCount, size_t inputCount, size_t cutCount);
+void generateKeyerDrag(Trace& trace, size_t mixEffectCount, size_t keyerCount, size_t stepCount);
+
+bool loadTrace(std::istream& is, Trace& trace);
+
+std::string getMixEffectName(size_t index);
+
+}
\ No newline at end of file
@@ -0,0 +1,420 @@
+#include "Trace.h"
+#include "Client.h"
+
+#include <Mixer.h>
+#include <MixEffect.h>
+#include <Transitions/Mix.h>
+#include <Transitions/DVE.h>
+#include <Transitions/Wipe.h>
+#include <Transitions/Stinger.h>
+#include <Overlays/Keyer.h>
+#include <Control/Controller.h>
+#include <Control/CLIView.h>
+#include <Control/TCPServer.h>
+#include <Control/WebSocketServer.h>
+
+#include <zuazo/Instance.h>
+#include <zuazo/Modules/Compositor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tclap/CmdLine.h>
+
+using namespace Cenital;
+
+using Latency = std::chrono::nanoseconds;
+
+struct Result {
+	size_t							commandCount;
+	size_t							failureCount;
+	std::chrono::nanoseconds		elapsed;
+	std::vector<Latency>			latencies;
+};
+
+
+
+static void registerCommands(Control::Controller& controller) {
+	//Only the elements created by the traces
+	Mixer::registerCommands(controller);
+	MixEffect::registerCommands(controller);
+
+	Transitions::Mix::registerCommands(controller);
+	Transitions::DVE::registerCommands(controller);
+	Transitions::Wipe::registerCommands(controller);
+	Transitions::Stinger::registerCommands(controller);
+
+	Overlays::Keyer::registerCommands(controller);
+}
+
+static std::unique_ptr<Control::TCPServer> createTCPServer(	boost::asio::io_service& ios,
+															uint16_t port,
+															Control::CLIView& cliView )
+{
+	//Same as the application
+	auto result = Zuazo::Utils::makeUnique<Control::TCPServer>(ios, port);
+
+	result->setConnectionOpenCallback(
+		[&cliView, &server = *result] (Control::TCPServer::SessionPtr session) -> void {
+			cliView.addListener(
+				[&server, session] (const std::string& msg) -> void {
+					server.send(session, msg);
+				}
+			);
+		}
+	);
+	result->setMessageCallback(
+		[&cliView, &srv = *result] (Control::TCPServer::SessionPtr session, std::string msg) {
+			std::string response;
+			cliView.parse(msg, response);
+			srv.send(std::move(session), std::move(response));
+		}
+	);
+
+	result->startAccept();
+	return result;
+}
+
+static std::unique_ptr<Control::WebSocketServer> createWebSocketServer(	boost::asio::io_service& ios,
+																		uint16_t port,
+																		Control::CLIView& cliView )
+{
+	//Same as the application
+	auto result = Zuazo::Utils::makeUnique<Control::WebSocketServer>(ios, port);
+
+	result->setConnectionOpenCallback(
+		[&cliView, &server = *result] (Control::WebSocketServer::SessionPtr session) -> void {
+			cliView.addListener(
+				[&server, session] (const std::string& msg) -> void {
+					server.send(session, msg);
+				}
+			);
+		}
+	);
+	result->setMessageCallback(
+		[&cliView, &srv = *result] (Control::WebSocketServer::SessionPtr session, Control::WebSocketServer::Message msg) {
+			std::string response;
+			cliView.parse(msg->get_payload(), response);
+			srv.send(std::move(session), std::move(response));
+		}
+	);
+
+	result->startAccept();
+	return result;
+}
+
+
+
+static bool isSuccess(const std::string& response) {
+	//Responses are formatted as "#<id> OK ..."
+	const auto pos = response.find(' ');
+	return pos != std::string::npos && response.compare(pos + 1, 2, "OK") == 0;
+}
+
+static bool setup(Bench::Client& client, const Bench::Trace& trace) {
+	bool result = true;
+
+	for(const auto& command : trace) {
+		if(!isSuccess(client.request(command))) {
+			std::cerr << "Setup command failed: " << command << std::endl;
+			result = false;
+		}
+	}
+
+	return result;
+}
+
+static Result replay(Bench::Client& client, const Bench::Trace& trace, size_t iterationCount) {
+	Result result;
+	result.commandCount = 0;
+	result.failureCount = 0;
+	result.latencies.reserve(trace.size() * iterationCount);
+
+	const auto t0 = std::chrono::steady_clock::now();
+	for(size_t i = 0; i < iterationCount; ++i) {
+		for(const auto& command : trace) {
+			const auto t1 = std::chrono::steady_clock::now();
+			const auto response = client.request(command);
+			const auto t2 = std::chrono::steady_clock::now();
+
+			result.latencies.push_back(std::chrono::duration_cast<Latency>(t2 - t1));
+			++result.commandCount;
+			if(!isSuccess(response)) {
+				++result.failureCount;
+			}
+		}
+	}
+	const auto t3 = std::chrono::steady_clock::now();
+
+	result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(t3 - t0);
+	return result;
+}
+
+static double getPercentile(const std::vector<Latency>& sorted, double percentile) {
+	double result = 0.0;
+
+	if(!sorted.empty()) {
+		//Nearest rank method
+		const auto rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+		const auto index = std::min(std::max(rank, size_t(1)), sorted.size()) - 1;
+		result = std::chrono::duration<double, std::micro>(sorted[index]).count();
+	}
+
+	return result;
+}
+
+static void writeResult(std::ostream& os, const std::string& mode, Result result) {
+	const auto seconds = std::chrono::duration<double>(result.elapsed).count();
+	const auto rate = seconds > 0 ? result.commandCount / seconds : 0.0;
+
+	std::sort(result.latencies.begin(), result.latencies.end());
+
+	os << "{\n";
+	os << "\t\"mode\": \"" << mode << "\",\n";
+	os << "\t\"commands\": " << result.commandCount << ",\n";
+	os << "\t\"failures\": " << result.failureCount << ",\n";
+	os << "\t\"seconds\": " << seconds << ",\n";
+	os << "\t\"commandsPerSecond\": " << rate << ",\n";
+	os << "\t\"latencyUs\": {\n";
+	os << "\t\t\"p50\": " << getPercentile(result.latencies, 50.0) << ",\n";
+	os << "\t\t\"p99\": " << getPercentile(result.latencies, 99.0) << ",\n";
+	os << "\t\t\"p99.9\": " << getPercentile(result.latencies, 99.9) << ",\n";
+	os << "\t\t\"max\": " << getPercentile(result.latencies, 100.0) << "\n";
+	os << "\t}\n";
+	os << "}" << std::endl;
+}
+
+
+
+
+
+int main(int argc, const char* const* argv) {
+	constexpr const char* appName = "Cenital Control Bench";
+	constexpr Zuazo::Version version(0, 1, 0);
+
+	/*****************************
+	 *      Argument parsing     *
+	 *****************************/
+
+	TCLAP::CmdLine cmd(
+		appName, 							//Message
+		' ', 								//Delimiter
+		Zuazo::toString(version), 			//Version
+		true								//Help
+	);
+
+	TCLAP::SwitchArg verboseArg(
+		"v", "verbose", 					//Arguments
+		"Show debug information in stderr", //Description
+		cmd 								//Command parser
+	);
+	std::vector<std::string> modes = { "direct", "tcp", "websocket" };
+	TCLAP::ValuesConstraint<std::string> modeConstraint(modes);
+	TCLAP::ValueArg<std::string> modeArg(
+		"m", "mode", 						//Arguments
+		"How commands are sent. direct calls the CLI in-process, the rest use loopback sockets. Default: direct",//Description
+		false, 								//Required
+		"direct", 							//Default value
+		&modeConstraint, 					//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<uint16_t> portArg(
+		"p", "port", 						//Arguments
+		"Loopback port used by the socket modes. Default: 9700",//Description
+		false, 								//Required
+		9700, 								//Default value
+		"port", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<std::string> traceArg(
+		"", "trace", 						//Arguments
+		"Recorded trace to replay, one command per line. Default: a synthetic trace",//Description
+		false, 								//Required
+		"", 								//Default value
+		"path", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> iterationsArg(
+		"n", "iterations", 					//Arguments
+		"Number of times the trace is replayed. Default: 10",//Description
+		false, 								//Required
+		10, 								//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> mixEffectsArg(
+		"", "mix-effects", 					//Arguments
+		"Number of mix effects. Default: 2",//Description
+		false, 								//Required
+		2, 									//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> inputsArg(
+		"i", "inputs", 						//Arguments
+		"Number of inputs of each mix effect. Default: 8",//Description
+		false, 								//Required
+		8, 									//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> keyersArg(
+		"k", "keyers", 						//Arguments
+		"Number of upstream keyers of each mix effect. Default: 4",//Description
+		false, 								//Required
+		4, 									//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<std::string> outputArg(
+		"o", "output", 						//Arguments
+		"Path of the JSON report. Default: stdout",//Description
+		false, 								//Required
+		"", 								//Default value
+		"path", 							//Type description
+		cmd									//Command parser
+	);
+
+	cmd.parse(argc, argv);
+
+	const auto mixEffectCount = std::max(mixEffectsArg.getValue(), size_t(1));
+	const auto inputCount = std::max(inputsArg.getValue(), size_t(1));
+	const auto keyerCount = keyersArg.getValue();
+
+
+
+	/*****************************
+	 *     Trace elaboration     *
+	 *****************************/
+
+	Bench::Trace setupTrace;
+	Bench::generateSetupTrace(setupTrace, mixEffectCount, inputCount, keyerCount);
+
+	Bench::Trace trace;
+	if(traceArg.getValue().empty()) {
+		Bench::generateFaderSweep(trace, mixEffectCount, 100);
+		Bench::generateCutStorm(trace, mixEffectCount, inputCount, 100);
+		Bench::generateKeyerDrag(trace, mixEffectCount, keyerCount, 50);
+	} else {
+		std::ifstream file(traceArg.getValue());
+		if(!file.is_open() || !Bench::loadTrace(file, trace)) {
+			std::cerr << "Could not load " << traceArg.getValue() << std::endl;
+			return 1;
+		}
+	}
+
+
+
+	/*****************************
+	 *    Mixer instantiation    *
+	 *****************************/
+
+	//Nothing is rendered, as there are no outputs
+	const auto verbosity = 	verboseArg.getValue() ?
+							Zuazo::Verbosity::geqVerbose :
+							Zuazo::Verbosity::geqError ;
+
+	Zuazo::Instance::ApplicationInfo appInfo(
+		appName,					//Application name
+		version,					//Application version
+		verbosity,					//Verbosity
+		{							//Enabled modules
+			Zuazo::Modules::Compositor::get()
+		}
+	);
+
+	Zuazo::Instance instance(std::move(appInfo));
+	std::unique_lock<Zuazo::Instance> lock(instance);
+
+	Mixer mixer(instance, "Application");
+	mixer.asyncOpen(lock);
+
+	//The controller takes the lock by itself
+	lock.unlock();
+
+	Control::Controller controller(mixer);
+	registerCommands(controller);
+
+	Control::CLIView cliView(controller);
+	controller.addView(cliView);
+
+
+
+	/*****************************
+	 *   Service instantiation   *
+	 *****************************/
+
+	boost::asio::io_service ios;
+	const auto& mode = modeArg.getValue();
+
+	std::unique_ptr<Control::TCPServer> tcpServer;
+	std::unique_ptr<Control::WebSocketServer> webSocketServer;
+	if(mode == "tcp") {
+		tcpServer = createTCPServer(ios, portArg.getValue(), cliView);
+	} else if(mode == "websocket") {
+		webSocketServer = createWebSocketServer(ios, portArg.getValue(), cliView);
+	}
+
+	std::thread serviceThread(
+		[&ios] () {
+			ios.run();
+		}
+	);
+
+
+
+	/*****************************
+	 *   Benchmark and report    *
+	 *****************************/
+
+	int exitCode = 0;
+
+	try {
+		std::unique_ptr<Bench::Client> client;
+		if(mode == "tcp") {
+			client = Zuazo::Utils::makeUnique<Bench::TCPClient>(portArg.getValue());
+		} else if(mode == "websocket") {
+			client = Zuazo::Utils::makeUnique<Bench::WebSocketClient>(portArg.getValue());
+		} else {
+			client = Zuazo::Utils::makeUnique<Bench::DirectClient>(cliView);
+		}
+
+		if(setup(*client, setupTrace)) {
+			auto result = replay(*client, trace, iterationsArg.getValue());
+
+			if(outputArg.getValue().empty()) {
+				writeResult(std::cout, mode, std::move(result));
+			} else {
+				std::ofstream file(outputArg.getValue());
+				writeResult(file, mode, std::move(result));
+			}
+		} else {
+			exitCode = 1;
+		}
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		exitCode = 1;
+	}
+
+
+
+	/*****************************
+	 *  Wait completion and exit *
+	 *****************************/
+
+	ios.stop();
+	serviceThread.join();
+
+	lock.lock();
+	mixer.asyncClose(lock);
+
+	return exitCode;
+}
\ No newline at end of file
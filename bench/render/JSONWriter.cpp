@@ -0,0 +1,162 @@
+#include "JSONWriter.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+
+namespace Cenital::Bench {
+
+JSONWriter::JSONWriter(std::ostream& os)
+	: m_os(os)
+	, m_scopes()
+	, m_hasKey(false)
+{
+}
+
+
+
+void JSONWriter::beginObject() {
+	beginValue();
+	m_os << '{';
+	m_scopes.push_back(Scope{ true, true });
+}
+
+void JSONWriter::endObject() {
+	end(true, '}');
+}
+
+void JSONWriter::beginArray() {
+	beginValue();
+	m_os << '[';
+	m_scopes.push_back(Scope{ false, true });
+}
+
+void JSONWriter::endArray() {
+	end(false, ']');
+}
+
+
+void JSONWriter::key(std::string_view name) {
+	assert(!m_scopes.empty() && m_scopes.back().isObject);
+	assert(!m_hasKey);
+
+	auto& scope = m_scopes.back();
+	if(!scope.isEmpty) {
+		m_os << ',';
+	}
+	scope.isEmpty = false;
+	newLine();
+
+	writeString(name);
+	m_os << ": ";
+	m_hasKey = true;
+}
+
+
+void JSONWriter::value(std::string_view str) {
+	beginValue();
+	writeString(str);
+}
+
+void JSONWriter::value(const char* str) {
+	value(std::string_view(str));
+}
+
+void JSONWriter::value(double number) {
+	beginValue();
+
+	//JSON has no representation for infinities nor NaNs
+	if(std::isfinite(number)) {
+		m_os << number;
+	} else {
+		m_os << "null";
+	}
+}
+
+void JSONWriter::value(uint64_t number) {
+	beginValue();
+	m_os << number;
+}
+
+void JSONWriter::value(bool boolean) {
+	beginValue();
+	m_os << (boolean ? "true" : "false");
+}
+
+
+
+void JSONWriter::beginValue() {
+	if(m_scopes.empty()) {
+		return; //Root value
+	}
+
+	auto& scope = m_scopes.back();
+	if(scope.isObject) {
+		//The key has already placed the separator
+		assert(m_hasKey);
+		m_hasKey = false;
+	} else {
+		if(!scope.isEmpty) {
+			m_os << ',';
+		}
+		scope.isEmpty = false;
+		newLine();
+	}
+}
+
+void JSONWriter::end(bool isObject, char delimiter) {
+	assert(!m_scopes.empty() && m_scopes.back().isObject == isObject);
+	assert(!m_hasKey);
+	(void)isObject;
+
+	const auto isEmpty = m_scopes.back().isEmpty;
+	m_scopes.pop_back();
+
+	//Empty containers are kept on a single line
+	if(!isEmpty) {
+		newLine();
+	}
+	m_os << delimiter;
+
+	//Finish the document with a line feed
+	if(m_scopes.empty()) {
+		m_os << '\n';
+	}
+}
+
+void JSONWriter::newLine() {
+	m_os << '\n';
+	for(size_t i = 0; i < m_scopes.size(); ++i) {
+		m_os << '\t';
+	}
+}
+
+void JSONWriter::writeString(std::string_view str) {
+	m_os << '"';
+
+	for(const auto c : str) {
+		switch(c) {
+		case '"':	m_os << "\\\""; break;
+		case '\\':	m_os << "\\\\"; break;
+		case '\b':	m_os << "\\b"; break;
+		case '\f':	m_os << "\\f"; break;
+		case '\n':	m_os << "\\n"; break;
+		case '\r':	m_os << "\\r"; break;
+		case '\t':	m_os << "\\t"; break;
+		default:
+			if(static_cast<unsigned char>(c) < 0x20) {
+				//Other control characters need to be escaped with their code
+				char code[7];
+				std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(c));
+				m_os << code;
+			} else {
+				m_os << c;
+			}
+			break;
+		}
+	}
+
+	m_os << '"';
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace Cenital::Bench {
+
+//Streaming JSON writer. It takes care of escaping strings and of
+//placing the separators, so that the output is always well formed
+//as long as every begin call is matched with its end call. Nested
+//values are indented with tabs
+class JSONWriter {
+public:
+	explicit JSONWriter(std::ostream& os);
+	JSONWriter(const JSONWriter& other) = delete;
+	~JSONWriter() = default;
+
+	JSONWriter&					operator=(const JSONWriter& other) = delete;
+
+	void						beginObject();
+	void						endObject();
+	void						beginArray();
+	void						endArray();
+
+	//Inside objects, every value must be preceded by its key
+	void						key(std::string_view name);
+
+	void						value(std::string_view str);
+	void						value(const char* str);
+	void						value(double number);
+	void						value(uint64_t number);
+	void						value(bool boolean);
+
+	template<typename T>
+	void						member(std::string_view name, const T& val);
+
+private:
+	struct Scope {
+		bool	isObject;
+		bool	isEmpty;
+	};
+
+	std::ostream&				m_os;
+	std::vector<Scope>			m_scopes;
+	bool						m_hasKey;
+
+	void						beginValue();
+	void						end(bool isObject, char delimiter);
+	void						newLine();
+	void						writeString(std::string_view str);
+
+};
+
+template<typename T>
+inline void JSONWriter::member(std::string_view name, const T& val) {
+	key(name);
+	value(val);
+}
+
+}
\ No newline at end of file
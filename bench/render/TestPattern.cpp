@@ -0,0 +1,185 @@
+#include "TestPattern.h"
+
+#include <zuazo/Signal/DummyPad.h>
+#include <zuazo/Signal/Output.h>
+#include <zuazo/Graphics/Uploader.h>
+
+#include <algorithm>
+#include <array>
+
+namespace Cenital::Bench {
+
+using namespace Zuazo;
+
+/*
+ * TestPatternImpl
+ */
+
+struct TestPatternImpl {
+	using Output = Signal::DummyPad<Video>;
+	using Pixel = std::array<std::byte, 4>;
+
+	static constexpr auto UPDATE_PRIORITY = Instance::inputPriority;
+	static constexpr size_t FRAME_COUNT = 2;
+
+	std::reference_wrapper<TestPattern> owner;
+
+	Output								output;
+	Signal::Output<Video>				patternOut;
+
+	Resolution							resolution;
+	size_t								seed;
+	std::array<Video, FRAME_COUNT>		frames;
+	size_t								currentFrame;
+
+	TestPatternImpl(TestPattern& owner, Resolution resolution, size_t seed)
+		: owner(owner)
+		, output(owner, std::string(Signal::makeOutputName<Video>()))
+		, patternOut(owner, "patternOut")
+		, resolution(resolution)
+		, seed(seed)
+		, frames()
+		, currentFrame(0)
+	{
+		output.getInput() << patternOut;
+	}
+
+	~TestPatternImpl() = default;
+
+
+	void moved(ZuazoBase& base) {
+		owner = static_cast<TestPattern&>(base);
+		output.setLayout(base);
+		patternOut.setLayout(base);
+	}
+
+	void open(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& pattern = static_cast<TestPattern&>(base);
+		assert(&owner.get() == &pattern);
+
+		(void)(lock);
+
+		generateFrames(pattern.getInstance().getVulkan());
+
+		pattern.enableRegularUpdate(UPDATE_PRIORITY);
+	}
+
+	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		open(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+	void close(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& pattern = static_cast<TestPattern&>(base);
+		assert(&owner.get() == &pattern);
+		(void)(lock);
+
+		pattern.disableRegularUpdate();
+		patternOut.reset();
+		frames = {};
+	}
+
+	void asyncClose(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		close(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+	void update() {
+		//Alternate between the variants
+		currentFrame = (currentFrame + 1) % frames.size();
+		patternOut.push(frames[currentFrame]);
+	}
+
+private:
+	void generateFrames(const Graphics::Vulkan& vulkan) {
+		//75% color bars. The order is rotated by the seed, so that 
+		//each of the inputs can be told apart on the output
+		constexpr std::array<Pixel, 8> BARS = {
+			Pixel{ std::byte(191), std::byte(191), std::byte(191), std::byte(255) }, //White
+			Pixel{ std::byte(191), std::byte(191), std::byte(0), std::byte(255) }, //Yellow
+			Pixel{ std::byte(0), std::byte(191), std::byte(191), std::byte(255) }, //Cyan
+			Pixel{ std::byte(0), std::byte(191), std::byte(0), std::byte(255) }, //Green
+			Pixel{ std::byte(191), std::byte(0), std::byte(191), std::byte(255) }, //Magenta
+			Pixel{ std::byte(191), std::byte(0), std::byte(0), std::byte(255) }, //Red
+			Pixel{ std::byte(0), std::byte(0), std::byte(191), std::byte(255) }, //Blue
+			Pixel{ std::byte(0), std::byte(0), std::byte(0), std::byte(255) }, //Black
+		};
+
+		const Graphics::Frame::Descriptor descriptor(
+			resolution,
+			AspectRatio(1, 1),
+			ColorPrimaries::bt709,
+			ColorModel::rgb,
+			ColorTransferFunction::iec61966_2_1,
+			ColorSubsampling::rb444,
+			ColorRange::full,
+			ColorFormat::R8G8B8A8
+		);
+		const Graphics::Uploader uploader(vulkan, descriptor);
+
+		for(size_t i = 0; i < frames.size(); ++i) {
+			auto frame = uploader.acquireFrame();
+			auto* pixels = reinterpret_cast<Pixel*>(frame->getPixelData().front().data());
+
+			//The second variant is shifted half a bar, so that
+			//every pixel changes between both of them
+			const size_t barWidth = std::max(resolution.width / BARS.size(), size_t(1));
+			const size_t offset = seed*barWidth + i*barWidth/2;
+			for(size_t y = 0; y < resolution.height; ++y) {
+				for(size_t x = 0; x < resolution.width; ++x) {
+					const auto bar = ((x + offset) / barWidth) % BARS.size();
+					pixels[y*resolution.width + x] = BARS[bar];
+				}
+			}
+
+			frame->flush();
+			frames[i] = std::move(frame);
+		}
+	}
+
+};
+
+
+
+
+
+/*
+ * TestPattern
+ */
+
+TestPattern::TestPattern(	Zuazo::Instance& instance,
+							std::string name,
+							Zuazo::Resolution resolution,
+							size_t seed )
+	: Zuazo::Utils::Pimpl<TestPatternImpl>({}, *this, resolution, seed)
+	, Zuazo::ZuazoBase(
+		instance,
+		std::move(name),
+		{},
+		std::bind(&TestPatternImpl::moved, std::ref(**this), std::placeholders::_1),
+		std::bind(&TestPatternImpl::open, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&TestPatternImpl::asyncOpen, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&TestPatternImpl::close, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&TestPatternImpl::asyncClose, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&TestPatternImpl::update, std::ref(**this)) )
+	, Zuazo::Signal::SourceLayout<Zuazo::Video>((*this)->output)
+{
+	//Register the output pad
+	registerPad(getOutput());
+}
+
+TestPattern::TestPattern(TestPattern&& other) = default;
+
+TestPattern::~TestPattern() = default;
+
+TestPattern& TestPattern::operator=(TestPattern&& other) = default;
+
+
+
+Zuazo::Resolution TestPattern::getResolution() const noexcept {
+	return (*this)->resolution;
+}
+
+}
\ No newline at end of file
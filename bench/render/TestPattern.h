@@ -0,0 +1,38 @@
+#pragma once
+
+#include <zuazo/ZuazoBase.h>
+#include <zuazo/Video.h>
+#include <zuazo/Resolution.h>
+#include <zuazo/Signal/SourceLayout.h>
+#include <zuazo/Utils/Pimpl.h>
+
+namespace Cenital::Bench {
+
+//Synthetic video source. Color bars are generated and uploaded
+//on open, so that the benchmarks do not depend on decoding any
+//media. Two variants are alternated every update, so that the 
+//downstream elements always receive new frames
+struct TestPatternImpl;
+class TestPattern 
+	: private Zuazo::Utils::Pimpl<TestPatternImpl>
+	, public Zuazo::ZuazoBase
+	, public Zuazo::Signal::SourceLayout<Zuazo::Video>
+{
+	friend TestPatternImpl;
+public:
+	TestPattern(Zuazo::Instance& instance,
+				std::string name,
+				Zuazo::Resolution resolution,
+				size_t seed );
+	TestPattern(const TestPattern& other) = delete;
+	TestPattern(TestPattern&& other);
+	virtual ~TestPattern();
+
+	TestPattern&						operator=(const TestPattern& other) = delete;
+	TestPattern&						operator=(TestPattern&& other);
+
+	Zuazo::Resolution					getResolution() const noexcept;
+
+};
+	
+}
\ No newline at end of file
@@ -0,0 +1,375 @@
+#include "TestPattern.h"
+#include "JSONWriter.h"
+
+#include <MixEffect.h>
+#include <Profiling.h>
+#include <Consumers/Offscreen.h>
+#include <Overlays/Keyer.h>
+#include <Shapes.h>
+
+#include <zuazo/Instance.h>
+#include <zuazo/Modules/FFmpeg.h>
+#include <zuazo/Modules/Compositor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tclap/CmdLine.h>
+
+using namespace Cenital;
+
+struct Scene {
+	size_t							inputCount;
+	size_t							keyerCount;
+	std::string						transition;
+	size_t							transitionFrames;
+	Zuazo::Resolution				resolution;
+	Zuazo::Rate						frameRate;
+};
+
+struct CounterResult {
+	std::string						name;
+	uint64_t						callCount;
+	ProfilingCounter::Duration		totalTime;
+};
+
+struct Result {
+	size_t							frameCount;
+	std::chrono::nanoseconds		elapsed;
+	std::vector<CounterResult>		counters;
+};
+
+
+
+static void configureKeyers(MixEffect& mixEffect, const Scene& scene) {
+	constexpr auto SLOT = MixEffect::OverlaySlot::upstream;
+	mixEffect.setOverlayCount(SLOT, scene.keyerCount);
+
+	for(size_t i = 0; i < scene.keyerCount; ++i) {
+		auto& keyer = static_cast<Overlays::Keyer&>(*mixEffect.getOverlay(SLOT, i));
+
+		//Key each input on top of the next one
+		mixEffect.setOverlaySignal(SLOT, i, "keyIn", i % scene.inputCount);
+		mixEffect.setOverlaySignal(SLOT, i, "fillIn", (i + 1) % scene.inputCount);
+		mixEffect.setOverlayVisible(SLOT, i, true);
+		mixEffect.setOverlayTransition(SLOT, i, true);
+
+		//Crop each keyer with a different box, so that they overlap partially
+		Shape crop;
+		generateRectangle(crop, keyer.getSize() / static_cast<float>(i + 2));
+		keyer.setCrop(Zuazo::Utils::BufferView<const Shape>(&crop, 1));
+		keyer.setLumaKeyEnabled(true);
+	}
+}
+
+static void waitFrames(	std::unique_lock<Zuazo::Instance>& lock,
+						MixEffect& mixEffect,
+						Consumers::Offscreen& output,
+						size_t count )
+{
+	constexpr auto POLL_PERIOD = std::chrono::milliseconds(1);
+
+	while(output.getFrameCount() < count) {
+		//Keep the transition running
+		const auto* transition = mixEffect.getSelectedTransition();
+		if(transition && !transition->isPlaying()) {
+			mixEffect.transition();
+		}
+
+		lock.unlock();
+		std::this_thread::sleep_for(POLL_PERIOD);
+		lock.lock();
+	}
+}
+
+static Result run(	Zuazo::Instance& instance,
+					const Scene& scene,
+					size_t warmupFrames,
+					size_t frameCount )
+{
+	std::unique_lock<Zuazo::Instance> lock(instance);
+
+	//Configure the video mode for the whole chain
+	Zuazo::DefaultVideoModeNegotiator negotiator;
+	negotiator.setResolution(Zuazo::Utils::MustBe<Zuazo::Resolution>(scene.resolution));
+	negotiator.setFrameRate(Zuazo::Utils::MustBe<Zuazo::Rate>(scene.frameRate));
+
+	//Create the inputs
+	std::vector<std::unique_ptr<Bench::TestPattern>> inputs;
+	inputs.reserve(scene.inputCount);
+	for(size_t i = 0; i < scene.inputCount; ++i) {
+		inputs.emplace_back(Zuazo::Utils::makeUnique<Bench::TestPattern>(
+			instance,
+			"Input " + Zuazo::toString(i),
+			scene.resolution,
+			i
+		));
+		inputs.back()->asyncOpen(lock);
+	}
+
+	//Create the mix effect
+	MixEffect mixEffect(instance, "Mix Effect");
+	mixEffect.setVideoModeNegotiationCallback(negotiator);
+	mixEffect.setInputCount(scene.inputCount);
+	for(size_t i = 0; i < scene.inputCount; ++i) {
+		mixEffect.getInput(i) << *inputs[i];
+	}
+	mixEffect.setBackground(MixEffect::OutputBus::program, 0);
+	mixEffect.setBackground(MixEffect::OutputBus::preview, 1 % scene.inputCount);
+	mixEffect.setSelectedTransition(scene.transition);
+	mixEffect.setTransitionRate(scene.transitionFrames);
+	mixEffect.asyncOpen(lock);
+	configureKeyers(mixEffect, scene);
+
+	//Create the output. Reading back the frames ensures that
+	//the GPU work is accounted for
+	Consumers::Offscreen output(instance, "Output");
+	output.setVideoModeNegotiationCallback(negotiator);
+	output.setFrameCallback([] (Consumers::Offscreen&, Zuazo::Utils::BufferView<const std::byte>) {});
+	output.getInput() << mixEffect.getOutput(MixEffect::OutputBus::program);
+	output.asyncOpen(lock);
+
+	//Let everything settle before measuring
+	waitFrames(lock, mixEffect, output, warmupFrames);
+
+	//Measure
+	ProfilingCounter::resetAll();
+	ProfilingCounter::setEnabled(true);
+	output.resetFrameCount();
+	const auto t0 = std::chrono::steady_clock::now();
+	waitFrames(lock, mixEffect, output, frameCount);
+	const auto t1 = std::chrono::steady_clock::now();
+	ProfilingCounter::setEnabled(false);
+
+	Result result;
+	result.frameCount = output.getFrameCount();
+	result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+	ProfilingCounter::forEach(
+		[&result] (const ProfilingCounter& counter) {
+			result.counters.push_back(CounterResult{
+				std::string(counter.getName()),
+				counter.getCallCount(),
+				counter.getTotalTime()
+			});
+		}
+	);
+
+	//Tear down in reverse order
+	output.asyncClose(lock);
+	mixEffect.asyncClose(lock);
+	for(auto& input : inputs) {
+		input->asyncClose(lock);
+	}
+
+	return result;
+}
+
+static void writeResult(std::ostream& os, const Scene& scene, const Result& result) {
+	const auto seconds = std::chrono::duration<double>(result.elapsed).count();
+	const auto fps = seconds > 0 ? result.frameCount / seconds : 0.0;
+	std::ostringstream resolution;
+	resolution << scene.resolution;
+	Bench::JSONWriter writer(os);
+
+	writer.beginObject();
+
+	writer.key("scene");
+	writer.beginObject();
+	writer.member("inputs", uint64_t(scene.inputCount));
+	writer.member("keyers", uint64_t(scene.keyerCount));
+	writer.member("transition", scene.transition);
+	writer.member("transitionFrames", uint64_t(scene.transitionFrames));
+	writer.member("resolution", resolution.str());
+	writer.member("frameRate", static_cast<double>(scene.frameRate));
+	writer.endObject();
+
+	writer.member("frames", uint64_t(result.frameCount));
+	writer.member("seconds", seconds);
+	writer.member("fps", fps);
+
+	writer.key("counters");
+	writer.beginObject();
+	for(const auto& counter : result.counters) {
+		const auto calls = counter.callCount;
+		const auto total = std::chrono::duration<double, std::micro>(counter.totalTime).count();
+
+		writer.key(counter.name);
+		writer.beginObject();
+		writer.member("calls", calls);
+		writer.member("totalUs", total);
+		writer.member("meanUs", calls > 0 ? total / calls : 0.0);
+		writer.member("perFrameUs", result.frameCount > 0 ? total / result.frameCount : 0.0);
+		writer.endObject();
+	}
+	writer.endObject();
+
+	writer.endObject();
+	os.flush();
+}
+
+
+
+
+
+int main(int argc, const char* const* argv) {
+	constexpr const char* appName = "Cenital Bench";
+	constexpr Zuazo::Version version(0, 1, 0);
+
+	/*****************************
+	 *      Argument parsing     *
+	 *****************************/
+
+	TCLAP::CmdLine cmd(
+		appName, 							//Message
+		' ', 								//Delimiter
+		Zuazo::toString(version), 			//Version
+		true								//Help
+	);
+
+	TCLAP::SwitchArg verboseArg(
+		"v", "verbose", 					//Arguments
+		"Show debug information in stderr", //Description
+		cmd 								//Command parser
+	);
+	TCLAP::ValueArg<size_t> framesArg(
+		"f", "frames", 						//Arguments
+		"Number of measured frames. Default: 600",//Description
+		false, 								//Required
+		600, 								//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> warmupArg(
+		"", "warmup", 						//Arguments
+		"Number of frames rendered before measuring. Default: 60",//Description
+		false, 								//Required
+		60, 								//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> inputsArg(
+		"i", "inputs", 						//Arguments
+		"Number of test pattern inputs. Default: 4",//Description
+		false, 								//Required
+		4, 									//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> keyersArg(
+		"k", "keyers", 						//Arguments
+		"Number of cropped upstream keyers. Default: 2",//Description
+		false, 								//Required
+		2, 									//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	std::vector<std::string> transitions = { "Mix", "DVE", "Wipe" };
+	TCLAP::ValuesConstraint<std::string> transitionConstraint(transitions);
+	TCLAP::ValueArg<std::string> transitionArg(
+		"", "transition", 					//Arguments
+		"Transition kept running during the measurement. Default: Mix",//Description
+		false, 								//Required
+		"Mix", 								//Default value
+		&transitionConstraint, 				//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<size_t> transitionFramesArg(
+		"", "transition-frames", 			//Arguments
+		"Duration of the transition in frames. Default: 30",//Description
+		false, 								//Required
+		30, 								//Default value
+		"count", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<uint32_t> widthArg(
+		"", "width", 						//Arguments
+		"Width of the video mode. Default: 1920",//Description
+		false, 								//Required
+		1920, 								//Default value
+		"pixels", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<uint32_t> heightArg(
+		"", "height", 						//Arguments
+		"Height of the video mode. Default: 1080",//Description
+		false, 								//Required
+		1080, 								//Default value
+		"pixels", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<uint32_t> rateArg(
+		"r", "rate", 						//Arguments
+		"Frame rate of the output. It should be higher than achievable to measure the throughput. Default: 1000",//Description
+		false, 								//Required
+		1000, 								//Default value
+		"fps", 								//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<std::string> outputArg(
+		"o", "output", 						//Arguments
+		"Path of the JSON report. Default: stdout",//Description
+		false, 								//Required
+		"", 								//Default value
+		"path", 							//Type description
+		cmd									//Command parser
+	);
+
+	cmd.parse(argc, argv);
+
+	const Scene scene = {
+		std::max(inputsArg.getValue(), size_t(1)),
+		keyersArg.getValue(),
+		transitionArg.getValue(),
+		transitionFramesArg.getValue(),
+		Zuazo::Resolution(widthArg.getValue(), heightArg.getValue()),
+		Zuazo::Rate(rateArg.getValue(), 1)
+	};
+
+
+
+	/*****************************
+	 *    Zuazo instantiation    *
+	 *****************************/
+
+	//No window module, so that it can run without a display
+	const auto verbosity = 	verboseArg.getValue() ?
+							Zuazo::Verbosity::geqVerbose :
+							Zuazo::Verbosity::geqError ;
+
+	Zuazo::Instance::ApplicationInfo appInfo(
+		appName,					//Application name
+		version,					//Application version
+		verbosity,					//Verbosity
+		{							//Enabled modules
+			Zuazo::Modules::FFmpeg::get(),
+			Zuazo::Modules::Compositor::get()
+		}
+	);
+
+	Zuazo::Instance instance(std::move(appInfo));
+
+
+
+	/*****************************
+	 *   Benchmark and report    *
+	 *****************************/
+
+	const auto result = run(instance, scene, warmupArg.getValue(), framesArg.getValue());
+
+	if(outputArg.getValue().empty()) {
+		writeResult(std::cout, scene, result);
+	} else {
+		std::ofstream file(outputArg.getValue());
+		writeResult(file, scene, result);
+	}
+
+	return 0;
+}
\ No newline at end of file
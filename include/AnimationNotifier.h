@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Mixer.h"
+#include "MixEffect.h"
+#include "Overlays/Keyer.h"
+#include "Control/ViewBase.h"
+#include "Control/Controller.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Cenital {
+
+//Publishes the end of the keyer animations, as it happens outside any
+//command. Both the keyers of the mixer and the overlays of the M/Es
+//are observed. Keyers report it from their update, so the broadcast
+//is deferred until refresh() is called by the owner of the views
+class AnimationNotifier
+	: public Control::ViewBase
+{
+public:
+	using InvalidateCallback = std::function<void(AnimationNotifier&)>;
+
+	AnimationNotifier(	Control::Controller& controller,
+						Mixer& mixer );
+	AnimationNotifier(const AnimationNotifier& other) = delete;
+	AnimationNotifier(AnimationNotifier&& other) = delete;
+	virtual ~AnimationNotifier() = default;
+
+	AnimationNotifier&					operator=(const AnimationNotifier& other) = delete;
+	AnimationNotifier&					operator=(AnimationNotifier&& other) = delete;
+
+	void								setInvalidateCallback(InvalidateCallback cbk);
+	const InvalidateCallback&			getInvalidateCallback() const noexcept;
+
+	void								invalidate();
+	void								refresh();
+
+	virtual void						update(const Control::Message& msg) final;
+
+private:
+	//Overlays of a M/E are referred by their slot and index. Keyers
+	//of the mixer have no slot
+	struct FinishedAnimation {
+		std::string							element;
+		MixEffect::OverlaySlot				slot;
+		size_t								index;
+	};
+
+	std::reference_wrapper<Mixer>		m_mixer;
+	std::vector<FinishedAnimation>		m_finished;
+	bool								m_refreshPending;
+
+	InvalidateCallback					m_invalidateCallback;
+
+	void								installCallback(Overlays::Keyer& keyer);
+	void								installCallback(MixEffect& mixEffect);
+	void								installCallback(Zuazo::ZuazoBase& element);
+
+};
+
+}
\ No newline at end of file
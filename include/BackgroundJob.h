@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Cenital {
+
+//Runs a long operation (i.e. decoding a file) on a worker thread, so
+//that the instance does not need to be locked meanwhile. The worker never
+//touches the instance: its result is delivered by poll(), which the owner
+//calls with the instance locked (i.e. from its update). Cancelled jobs
+//are joined by join() and on destruction, so they never outlive the owner
+class BackgroundJob {
+public:
+	using CancelFlag = std::atomic<bool>;
+
+	BackgroundJob() = default;
+	BackgroundJob(const BackgroundJob& other) = delete;
+	BackgroundJob(BackgroundJob&& other) = default;
+	~BackgroundJob();
+
+	BackgroundJob&						operator=(const BackgroundJob& other) = delete;
+	BackgroundJob&						operator=(BackgroundJob&& other);
+
+	//job is invoked as job(const CancelFlag&) on the worker thread and it
+	//must not throw. Its result is passed to done(result) by poll().
+	//Any previous job is cancelled
+	template<typename Job, typename Done>
+	void								start(Job&& job, Done&& done);
+	bool								poll();
+	void								cancel() noexcept;
+	void								join();
+	bool								isPending() const noexcept;
+
+private:
+	struct State {
+		CancelFlag							cancelled{ false };
+		std::atomic<bool>					finished{ false };
+		std::function<void()>				deliver;
+	};
+
+	struct Worker {
+		std::shared_ptr<const State>		state;
+		std::thread							thread;
+	};
+
+	std::shared_ptr<State>				m_state;
+	std::vector<Worker>					m_workers;
+
+	void								reap();
+
+};
+
+}
+
+#include "BackgroundJob.inl"
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "BackgroundJob.h"
+
+#include <utility>
+
+namespace Cenital {
+
+inline BackgroundJob::~BackgroundJob() {
+	join();
+}
+
+inline BackgroundJob& BackgroundJob::operator=(BackgroundJob&& other) {
+	join();
+	m_state = std::move(other.m_state);
+	m_workers = std::move(other.m_workers);
+	return *this;
+}
+
+
+
+template<typename Job, typename Done>
+inline void BackgroundJob::start(Job&& job, Done&& done) {
+	cancel();
+	reap();
+
+	auto state = std::make_shared<State>();
+	m_state = state;
+
+	//The result is left for poll(), as the owner may be waiting
+	//for this thread with the instance locked
+	std::thread thread(
+		[state, job = std::forward<Job>(job), done = std::forward<Done>(done)] () mutable {
+			auto result = job(static_cast<const CancelFlag&>(state->cancelled));
+
+			if(!state->cancelled.load()) {
+				state->deliver = [done = std::move(done), result = std::move(result)] () mutable {
+					done(std::move(result));
+				};
+			}
+
+			state->finished.store(true);
+		}
+	);
+
+	m_workers.push_back(Worker{ std::move(state), std::move(thread) });
+}
+
+inline bool BackgroundJob::poll() {
+	if(m_state && m_state->finished.load()) {
+		const auto state = std::move(m_state);
+		reap();
+
+		if(state->deliver) {
+			state->deliver();
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+inline void BackgroundJob::cancel() noexcept {
+	if(m_state) {
+		m_state->cancelled.store(true);
+		m_state.reset();
+	}
+}
+
+inline void BackgroundJob::join() {
+	cancel();
+
+	for(auto& worker : m_workers) {
+		worker.thread.join();
+	}
+	m_workers.clear();
+}
+
+inline bool BackgroundJob::isPending() const noexcept {
+	return static_cast<bool>(m_state);
+}
+
+
+
+inline void BackgroundJob::reap() {
+	//Join the workers which are done, so that they do not pile up
+	for(auto ite = m_workers.begin(); ite != m_workers.end(); ) {
+		if(ite->state->finished.load()) {
+			ite->thread.join();
+			ite = m_workers.erase(ite);
+		} else {
+			++ite;
+		}
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "TextureUpload.h"
+
+#include <zuazo/Graphics/Vulkan.h>
+#include <zuazo/Math/Vector.h>
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Cenital {
+
+//3D colour look-up table as described by the .cube format. The table is
+//indexed with the red component varying the fastest
+class ColorLUT {
+public:
+	class Texture;
+
+	ColorLUT(	std::string path,
+				std::string title,
+				uint32_t size,
+				Zuazo::Math::Vec3f domainMin,
+				Zuazo::Math::Vec3f domainMax,
+				std::vector<Zuazo::Math::Vec3f> table );
+	ColorLUT(const ColorLUT& other) = delete;
+	~ColorLUT() = default;
+
+	ColorLUT&								operator=(const ColorLUT& other) = delete;
+
+	const std::string&						getPath() const noexcept;
+	const std::string&						getTitle() const noexcept;
+	uint32_t								getSize() const noexcept;
+	const Zuazo::Math::Vec3f&				getDomainMin() const noexcept;
+	const Zuazo::Math::Vec3f&				getDomainMax() const noexcept;
+	const std::vector<Zuazo::Math::Vec3f>&	getTable() const noexcept;
+
+	static std::shared_ptr<const ColorLUT>	parse(std::istream& is, std::string path = "");
+	static std::shared_ptr<const ColorLUT>	load(std::string_view path);
+	static std::shared_ptr<const ColorLUT>	identity();
+
+private:
+	std::string								m_path;
+	std::string								m_title;
+	uint32_t								m_size;
+	Zuazo::Math::Vec3f						m_domainMin;
+	Zuazo::Math::Vec3f						m_domainMax;
+	std::vector<Zuazo::Math::Vec3f>			m_table;
+
+};
+
+
+
+//GPU copy of a ColorLUT. It is uploaded once per device and shared by
+//all the elements which use the same table. The upload is not waited 
+//for, so releaseStaging() should be called periodically afterwards
+class ColorLUT::Texture {
+public:
+	Texture(const Zuazo::Graphics::Vulkan& vulkan, std::shared_ptr<const ColorLUT> lut);
+	Texture(const Texture& other) = delete;
+	~Texture() = default;
+
+	Texture&								operator=(const Texture& other) = delete;
+
+	const ColorLUT&							getColorLUT() const noexcept;
+	vk::DescriptorSet						getDescriptorSet() const noexcept;
+	void									releaseStaging() const;
+
+	static vk::DescriptorSetLayout			getDescriptorSetLayout(const Zuazo::Graphics::Vulkan& vulkan);
+	static std::shared_ptr<const Texture>	get(const Zuazo::Graphics::Vulkan& vulkan,
+												std::shared_ptr<const ColorLUT> lut );
+
+private:
+	std::shared_ptr<const ColorLUT>			m_lut;
+	vk::UniqueImage							m_image;
+	vk::UniqueDeviceMemory					m_memory;
+	vk::UniqueImageView						m_imageView;
+	vk::UniqueSampler						m_sampler;
+	vk::UniqueDescriptorPool				m_descriptorPool;
+	vk::DescriptorSet						m_descriptorSet;
+	mutable std::unique_ptr<TextureUpload>	m_upload;
+
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Control/Controller.h>
+
+#include <zuazo/Utils/Pimpl.h>
+#include <zuazo/Utils/BufferView.h>
+#include <zuazo/ZuazoBase.h>
+#include <zuazo/Video.h>
+#include <zuazo/Signal/Input.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace Cenital::Consumers {
+
+struct OffscreenImpl;
+class Offscreen
+	: private Zuazo::Utils::Pimpl<OffscreenImpl>
+	, public Zuazo::ZuazoBase
+	, public Zuazo::VideoBase
+	, public Zuazo::VideoScalerBase
+{
+	friend OffscreenImpl;
+public:
+	using Input = Zuazo::Signal::PadProxy<Zuazo::Signal::Input<Zuazo::Video>>;
+	using FrameCallback = std::function<void(Offscreen&, Zuazo::Utils::BufferView<const std::byte>)>;
+
+	Offscreen(	Zuazo::Instance& instance,
+				std::string name );
+	Offscreen(const Offscreen& other) = delete;
+	Offscreen(Offscreen&& other);
+	virtual ~Offscreen();
+
+	Offscreen&						operator=(const Offscreen& other) = delete;
+	Offscreen&						operator=(Offscreen&& other);
+
+	Input&							getInput() noexcept;
+	const Input&					getInput() const noexcept;
+
+	void							setFrameCallback(FrameCallback cbk);
+	const FrameCallback&			getFrameCallback() const noexcept;
+
+	void							setDumpPath(std::string path);
+	const std::string&				getDumpPath() const noexcept;
+
+	size_t							getFrameCount() const noexcept;
+	void							resetFrameCount() noexcept;
+
+	static void						registerCommands(Control::Controller& controller);
+};
+
+}
\ No newline at end of file
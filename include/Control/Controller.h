@@ -37,6 +37,7 @@ public:
 
 	void											addView(ViewBase& view);
 	void											removeView(const ViewBase& view);
+	void											broadcast(const Message& msg);
 	
 private:
 	Node											m_root;
@@ -44,8 +45,6 @@ private:
 	std::vector<std::reference_wrapper<ViewBase>>	m_views;
 	std::reference_wrapper<Zuazo::ZuazoBase>		m_baseObject;
 
-	void											broadcast(const Message& msg);
-
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include <boost/asio.hpp>
+
+namespace Cenital::Control {
+
+//Minimal HTTP server which serves the metrics in the 
+//Prometheus text format at GET /metrics
+class PrometheusServer {
+public:
+	class Session;
+	using Acceptor = boost::asio::ip::tcp::acceptor;
+	using Socket = boost::asio::ip::tcp::socket;
+	using BodyCallback = std::function<std::string()>;
+
+	PrometheusServer(	boost::asio::io_service& ios,
+						uint16_t port,
+						BodyCallback bodyCbk = {} );
+	PrometheusServer(const PrometheusServer& other) = delete;
+	PrometheusServer(PrometheusServer&& other) = default;
+	~PrometheusServer() = default;
+
+	void						setBodyCallback(BodyCallback cbk);
+
+	void						startAccept();
+
+private:
+    boost::asio::io_service&	m_ios;
+    Acceptor					m_acceptor;
+	Socket						m_socket;
+
+	BodyCallback				m_bodyCallback;
+
+	void 						asyncAccept();
+	void						onAccept(boost::system::error_code error);
+
+};
+
+}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <Metrics.h>
+
 #include <memory>
 #include <functional>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/asio.hpp>
 
@@ -35,6 +38,8 @@ public:
 	void						startAccept();
 	void						send(SessionPtr session, Message msg);
 
+	void						collectMetrics(Metrics::Writer& writer) const;
+
 private:
     boost::asio::io_service&	m_ios;
     Acceptor					m_acceptor;
@@ -44,6 +49,9 @@ private:
 	ConnectionCloseCallback		m_closeCallback;
 	MessageCallback				m_messageCallback;
 
+	std::shared_ptr<MetricsHistogram> m_commandTime;
+	std::vector<SessionPtr>		m_sessions;
+
 	void 						asyncAccept();
 	void						onAccept(boost::system::error_code error);
 
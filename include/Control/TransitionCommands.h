@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Node.h"
+
+#include <string>
+
+namespace Cenital::Control {
+
+template<typename T>
+void registerTransitionEasingCommands(	Node& node,
+										const std::string& parentPath = "easing" );
+
+}
+
+#include "TransitionCommands.inl"
\ No newline at end of file
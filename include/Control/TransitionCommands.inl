@@ -0,0 +1,116 @@
+#include "TransitionCommands.h"
+
+#include "Generic.h"
+#include "../Transitions/Base.h"
+
+namespace Cenital::Control {
+
+template<typename T>
+inline void setTransitionEasing(Controller& controller,
+								Zuazo::ZuazoBase& base, 
+								const Message& request,
+								size_t level,
+								Message& response )
+{
+	invokeSetter<T, Transitions::Base::Easing>(
+		[] (T& transition, Transitions::Base::Easing easing) {
+			transition.setEasing(easing);
+		},
+		[] (const T&, Transitions::Base::Easing easing) -> bool {
+			//Custom easing is set through the curve
+			return easing > Transitions::Base::Easing::none && easing < Transitions::Base::Easing::custom;
+		},
+		controller, base, request, level, response
+	);
+}
+
+template<typename T>
+inline void getTransitionEasing(Controller& controller,
+								Zuazo::ZuazoBase& base, 
+								const Message& request,
+								size_t level,
+								Message& response )
+{
+	invokeGetter<Transitions::Base::Easing, T>(
+		[] (const T& transition) -> Transitions::Base::Easing {
+			return transition.getEasing();
+		},
+		controller, base, request, level, response
+	);
+}
+
+inline void enumTransitionEasing(	Controller& controller,
+									Zuazo::ZuazoBase& base, 
+									const Message& request,
+									size_t level,
+									Message& response )
+{
+	enumerate<Transitions::Base::Easing>(
+		controller, base, request, level, response
+	);
+}
+
+
+template<typename T>
+inline void setTransitionEasingCurve(	Controller& controller,
+										Zuazo::ZuazoBase& base, 
+										const Message& request,
+										size_t level,
+										Message& response )
+{
+	invokeSetter<T, float, float, float, float>(
+		[] (T& transition, float x1, float y1, float x2, float y2) {
+			transition.setEasingCurve(EasingCurve(x1, y1, x2, y2));
+		},
+		controller, base, request, level, response
+	);
+}
+
+template<typename T>
+inline void getTransitionEasingCurve(	Controller&,
+										Zuazo::ZuazoBase& base, 
+										const Message& request,
+										size_t level,
+										Message& response )
+{
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level) {
+		assert(typeid(base) == typeid(T));
+		const T& transition = static_cast<const T&>(base);
+		const auto& curve = transition.getEasingCurve();
+
+		//Elaborate the response
+		response.setType(Message::Type::response);
+		response.getPayload() = {
+			std::string(Zuazo::toString(curve[0])),
+			std::string(Zuazo::toString(curve[1])),
+			std::string(Zuazo::toString(curve[2])),
+			std::string(Zuazo::toString(curve[3]))
+		};
+	}
+}
+
+
+
+template<typename T>
+inline void registerTransitionEasingCommands(	Node& node,
+												const std::string& parentPath )
+{
+	node.addPath(
+		parentPath,
+		makeAttributeNode(
+			setTransitionEasing<T>,
+			getTransitionEasing<T>,
+			enumTransitionEasing
+		)
+	);
+	node.addPath(
+		parentPath + ":curve",
+		makeAttributeNode(
+			setTransitionEasingCurve<T>,
+			getTransitionEasingCurve<T>
+		)
+	);
+}
+
+}
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <Metrics.h>
+
+#include <memory>
+#include <set>
+
 #include <websocketpp/config/asio_no_tls.hpp>
 #include <websocketpp/server.hpp>
 
@@ -33,8 +38,16 @@ public:
 	void						startAccept();
 	void						send(SessionPtr connection, const std::string& msg);
 
+	void						collectMetrics(Metrics::Writer& writer) const;
+
 private:
+	struct Statistics {
+		MetricsHistogram								commandTime;
+		std::set<SessionPtr, std::owner_less<SessionPtr>>	sessions;
+	};
+
 	Socket						m_socket;
+	std::shared_ptr<Statistics>	m_statistics;
 
 };
 
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace Cenital {
+
+//Directory where the files requested through the control interface
+//are written. Clients only provide a plain file name, so that they
+//can not write anywhere else. When no directory is configured, file
+//dumps are disabled
+class DumpDirectory {
+public:
+	DumpDirectory() = delete;
+
+	static void						setPath(std::string path);
+	static const std::string&		getPath() noexcept;
+
+	static bool						isValidName(std::string_view name) noexcept;
+
+	//Returns the path of the given file in the directory, or an empty
+	//string if it is disabled or the name is not valid
+	static std::string				resolve(std::string_view name);
+
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <zuazo/Math/Vector.h>
+
+namespace Cenital {
+
+//Easing curves are expressed as the control points of a cubic bezier 
+//starting at (0, 0) and ending at (1, 1), in the (x1, y1, x2, y2) form 
+//used by CSS
+using EasingCurve = Zuazo::Math::Vec4f;
+
+constexpr EasingCurve LINEAR_EASING_CURVE = EasingCurve(0.0f, 0.0f, 1.0f, 1.0f);
+constexpr EasingCurve EASE_IN_CURVE = EasingCurve(0.42f, 0.0f, 1.0f, 1.0f);
+constexpr EasingCurve EASE_OUT_CURVE = EasingCurve(0.0f, 0.0f, 0.58f, 1.0f);
+constexpr EasingCurve EASE_IN_OUT_CURVE = EasingCurve(0.42f, 0.0f, 0.58f, 1.0f);
+
+EasingCurve sanitizeEasingCurve(EasingCurve curve) noexcept;
+float evaluateEasingCurve(const EasingCurve& curve, float x) noexcept;
+
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <zuazo/Chrono.h>
+
+namespace Cenital {
+
+//Converts the elapsed time of the render loop into whole output frames.
+//The elapsed time is rounded to the nearest frame count and the error 
+//is carried over, so that the jitter of the loop does not add or drop
+//frames
+class FrameClock {
+public:
+	using Duration = Zuazo::Duration;
+	using FrameCount = Duration::rep;
+
+	FrameClock() noexcept;
+	FrameClock(const FrameClock& other) = default;
+	~FrameClock() = default;
+
+	FrameClock&						operator=(const FrameClock& other) = default;
+
+	void							reset() noexcept;
+	FrameCount						advance(Duration deltaTime, Duration period) noexcept;
+
+	static FrameCount				getFrameCount(Duration duration, Duration period) noexcept;
+
+private:
+	Duration						m_remainder;
+
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "TextureUpload.h"
+
+#include <zuazo/Graphics/Vulkan.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Cenital {
+
+//Greyscale image which multiplies the alpha of a keyer. Pixels are
+//stored row by row, starting from the top-left corner
+class KeyMask {
+public:
+	class Texture;
+
+	KeyMask(	std::string path,
+				uint32_t width,
+				uint32_t height,
+				std::vector<uint8_t> pixels );
+	KeyMask(const KeyMask& other) = delete;
+	~KeyMask() = default;
+
+	KeyMask&								operator=(const KeyMask& other) = delete;
+
+	const std::string&						getPath() const noexcept;
+	uint32_t								getWidth() const noexcept;
+	uint32_t								getHeight() const noexcept;
+	const std::vector<uint8_t>&				getPixels() const noexcept;
+
+	static std::shared_ptr<const KeyMask>	load(std::string_view path);
+	static std::shared_ptr<const KeyMask>	identity();
+
+private:
+	std::string								m_path;
+	uint32_t								m_width;
+	uint32_t								m_height;
+	std::vector<uint8_t>					m_pixels;
+
+};
+
+
+
+//GPU copy of a KeyMask. It is uploaded once per device and shared by
+//all the elements which use the same mask. The upload is not waited 
+//for, so releaseStaging() should be called periodically afterwards
+class KeyMask::Texture {
+public:
+	Texture(const Zuazo::Graphics::Vulkan& vulkan, std::shared_ptr<const KeyMask> mask);
+	Texture(const Texture& other) = delete;
+	~Texture() = default;
+
+	Texture&								operator=(const Texture& other) = delete;
+
+	const KeyMask&							getKeyMask() const noexcept;
+	vk::DescriptorSet						getDescriptorSet() const noexcept;
+	void									releaseStaging() const;
+
+	static vk::DescriptorSetLayout			getDescriptorSetLayout(const Zuazo::Graphics::Vulkan& vulkan);
+	static std::shared_ptr<const Texture>	get(const Zuazo::Graphics::Vulkan& vulkan,
+												std::shared_ptr<const KeyMask> mask );
+
+private:
+	std::shared_ptr<const KeyMask>			m_mask;
+	vk::UniqueImage							m_image;
+	vk::UniqueDeviceMemory					m_memory;
+	vk::UniqueImageView						m_imageView;
+	vk::UniqueSampler						m_sampler;
+	vk::UniqueDescriptorPool				m_descriptorPool;
+	vk::DescriptorSet						m_descriptorSet;
+	mutable std::unique_ptr<TextureUpload>	m_upload;
+
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Cenital::Control {
+class Controller;
+}
+
+namespace Cenital {
+
+//Distribution of durations with fixed buckets, which are suitable for
+//frame and command timings. It can be updated from any thread
+class MetricsHistogram {
+public:
+	using Duration = std::chrono::nanoseconds;
+
+	static constexpr size_t BUCKET_COUNT = 12;
+	static constexpr std::array<double, BUCKET_COUNT> BUCKETS = { //Upper bounds in seconds
+		0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005,
+		0.01, 0.0167, 0.025, 0.05, 0.1, 0.25
+	};
+
+	MetricsHistogram() noexcept;
+	MetricsHistogram(const MetricsHistogram& other) = delete;
+	~MetricsHistogram() = default;
+
+	MetricsHistogram&				operator=(const MetricsHistogram& other) = delete;
+
+	void							observe(Duration value) noexcept;
+
+	uint64_t						getBucketCount(size_t index) const noexcept;
+	uint64_t						getCount() const noexcept;
+	Duration						getSum() const noexcept;
+
+	//Wraps a callback so that the time spent on each of its invocations
+	//is observed. The histogram is shared with the returned callback, so
+	//that it can be copied around freely. Empty callbacks are not timed
+	template<typename... Args>
+	static std::function<void(Args...)> timeCallback(	std::shared_ptr<MetricsHistogram> histogram,
+														std::function<void(Args...)> cbk );
+
+private:
+	std::array<std::atomic<uint64_t>, BUCKET_COUNT + 1> m_buckets; //Last one is +Inf
+	std::atomic<uint64_t>			m_count;
+	std::atomic<int64_t>			m_sum;
+
+};
+
+
+
+//Registry of metric collectors. Collectors are invoked on demand, so
+//that the monitored elements only need to keep their raw counters. The
+//metrics can be exported in the Prometheus text format
+class Metrics {
+public:
+	enum class Type {
+		counter,
+		gauge,
+		histogram
+	};
+
+	using Labels = std::vector<std::pair<std::string, std::string>>;
+
+	struct Sample {
+		std::string					name; //May have a suffix, i.e. _bucket
+		Labels						labels;
+		double						value;
+	};
+
+	struct Family {
+		std::string					name;
+		std::string					help;
+		Type						type;
+		std::vector<Sample>			samples;
+	};
+
+	class Writer {
+	public:
+		Writer() = default;
+		Writer(const Writer& other) = delete;
+		~Writer() = default;
+
+		Writer&						operator=(const Writer& other) = delete;
+
+		void						counter(std::string_view name,
+											std::string_view help,
+											Labels labels,
+											double value );
+		void						gauge(	std::string_view name,
+											std::string_view help,
+											Labels labels,
+											double value );
+		void						histogram(	std::string_view name,
+												std::string_view help,
+												Labels labels,
+												const MetricsHistogram& histogram );
+
+		const std::vector<Family>&	getFamilies() const noexcept;
+
+	private:
+		std::vector<Family>			m_families;
+
+		Family&						getFamily(std::string_view name, std::string_view help, Type type);
+
+	};
+
+	using Collector = std::function<void(Writer&)>;
+	using CollectorId = size_t;
+
+	Metrics() = delete;
+
+	static CollectorId				addCollector(Collector collector);
+	static void						removeCollector(CollectorId id);
+
+	static void						collect(Writer& writer);
+	static void						writePrometheus(std::ostream& os);
+
+	static void						registerCommands(Control::Controller& controller);
+
+};
+
+}
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Metrics::Type type) noexcept;
+
+}
+
+#include "Metrics.inl"
\ No newline at end of file
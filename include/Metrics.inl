@@ -0,0 +1,21 @@
+#include "Metrics.h"
+
+namespace Cenital {
+
+template<typename... Args>
+inline std::function<void(Args...)> MetricsHistogram::timeCallback(	std::shared_ptr<MetricsHistogram> histogram,
+																	std::function<void(Args...)> cbk )
+{
+	return 
+		[histogram = std::move(histogram), cbk = std::move(cbk)] (Args... args) {
+			if(cbk) {
+				const auto start = std::chrono::steady_clock::now();
+				cbk(std::forward<Args>(args)...);
+				histogram->observe(
+					std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - start)
+				);
+			}
+		};
+}
+
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Transitions/Base.h"
 #include "Overlays/Base.h"
 
+#include <zuazo/Macros.h>
 #include <zuazo/ZuazoBase.h>
 #include <zuazo/Video.h>
 #include <zuazo/RendererBase.h>
@@ -11,6 +12,7 @@
 #include <zuazo/Signal/Output.h>
 
 #include <memory>
+#include <functional>
 
 namespace Cenital {
 
@@ -44,6 +46,32 @@ public:
 		count
 	};
 
+	//Effect of the automatic transition of each overlay. Fly effects
+	//enter and leave the frame through the given side
+	enum class OverlayEffect {
+		none = -1,
+
+		mix,
+		flyLeft,
+		flyRight,
+		flyTop,
+		flyBottom,
+
+		count
+	};
+
+	enum class Tally : int {
+		none				= 0,
+
+		program				= Zuazo::Utils::bit(0),
+		preview				= Zuazo::Utils::bit(1),
+
+		all					= 0b11
+	};
+
+	using TallyCallback = std::function<void(MixEffect&)>;
+	using OverlayAnimationCallback = std::function<void(MixEffect&, OverlaySlot, size_t)>;
+
 	static constexpr auto NO_SIGNAL = ~size_t(0);
 
 	MixEffect(	Zuazo::Instance& instance,
@@ -63,6 +91,10 @@ public:
 
 	Output&									getOutput(OutputBus bus);
 	const Output&							getOutput(OutputBus bus) const;
+	Output&									getCleanOutput(OutputBus bus);
+	const Output&							getCleanOutput(OutputBus bus) const;
+	void									setCleanFeedEnabled(OutputBus bus, bool ena);
+	bool									getCleanFeedEnabled(OutputBus bus) const;
 
 	void									setBackground(OutputBus bus, size_t idx);
 	size_t									getBackground(OutputBus bus) const noexcept;
@@ -87,6 +119,8 @@ public:
 	const Transitions::Base*				getSelectedTransition() const noexcept;
 	void									setTransitionDuration(Zuazo::Duration duration);
 	Zuazo::Duration 						getTransitionDuration() const noexcept;
+	void									setTransitionRate(size_t frames);
+	size_t									getTransitionRate() const noexcept;
 
 
 	void									setOverlayCount(OverlaySlot slot, size_t count);
@@ -101,10 +135,58 @@ public:
 	bool									getOverlayTransition(OverlaySlot slot, size_t idx) const;
 	void									setOverlaySignal(OverlaySlot slot, size_t overlay, std::string_view port, size_t idx);
 	size_t									getOverlaySignal(OverlaySlot slot, size_t overlay, std::string_view port) const noexcept;
+	void									autoOverlay(OverlaySlot slot, size_t idx);
+	bool									isOverlayAutoPlaying(OverlaySlot slot, size_t idx) const;
+	void									setOverlayAutoEffect(OverlaySlot slot, size_t idx, OverlayEffect effect);
+	OverlayEffect							getOverlayAutoEffect(OverlaySlot slot, size_t idx) const;
+	void									setOverlayAutoDuration(OverlaySlot slot, size_t idx, Zuazo::Duration duration);
+	Zuazo::Duration							getOverlayAutoDuration(OverlaySlot slot, size_t idx) const;
+
+	std::vector<Tally>						getTally() const;
+	std::vector<Tally>						getCleanTally() const;
+	void									setTallyCallback(TallyCallback cbk);
+	const TallyCallback&					getTallyCallback() const noexcept;
+	void									setOverlayAnimationCallback(OverlayAnimationCallback cbk);
+	const OverlayAnimationCallback&			getOverlayAnimationCallback() const noexcept;
 
 
 	static void 							registerCommands(Control::Controller& controller);
 
 };
 
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(MixEffect::OverlayEffect)
+ZUAZO_ENUM_COMP_OPERATORS(MixEffect::OverlayEffect)
+
+ZUAZO_ENUM_BIT_OPERATORS(MixEffect::Tally)
+
+}
+
+
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::MixEffect::OverlayEffect effect) noexcept;
+size_t fromString(std::string_view str, Cenital::MixEffect::OverlayEffect& effect);
+std::ostream& operator<<(std::ostream& os, Cenital::MixEffect::OverlayEffect effect);
+
+std::string_view toString(Cenital::MixEffect::Tally tally) noexcept;
+std::ostream& operator<<(std::ostream& os, Cenital::MixEffect::Tally tally);
+
+namespace Utils {
+
+template<typename T>
+struct EnumTraits;
+
+template<>
+struct EnumTraits<Cenital::MixEffect::OverlayEffect> {
+	static constexpr Cenital::MixEffect::OverlayEffect first() noexcept {
+		return Cenital::MixEffect::OverlayEffect::none + static_cast<Cenital::MixEffect::OverlayEffect>(1);
+	}
+	static constexpr Cenital::MixEffect::OverlayEffect last() noexcept {
+		return Cenital::MixEffect::OverlayEffect::count - static_cast<Cenital::MixEffect::OverlayEffect>(1);
+	}
+};
+
+}
+
 }
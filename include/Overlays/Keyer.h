@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Base.h"
+#include "KeyerAnimation.h"
 #include "../Shapes.h"
 #include "../Control/Controller.h"
 
@@ -9,6 +10,9 @@
 #include <zuazo/ZuazoBase.h>
 #include <zuazo/LayerBase.h>
 #include <zuazo/Video.h>
+#include <zuazo/Signal/Output.h>
+
+#include <functional>
 
 namespace Cenital::Overlays {
 
@@ -16,10 +20,13 @@ struct KeyerImpl;
 class Keyer
 	: private Zuazo::Utils::Pimpl<KeyerImpl>
 	, public Base
+	, public Zuazo::VideoBase
 	, public Zuazo::VideoScalerBase
 {
 	friend KeyerImpl;
 public:
+	using Output = Zuazo::Signal::PadProxy<Zuazo::Signal::Output<Zuazo::Video>>;
+	using AnimationCallback = std::function<void(Keyer&)>;
 
 	enum class LinearKeyChannel {
 		keyR,
@@ -35,6 +42,18 @@ public:
 
 	};
 
+	enum class ChromaKeyMode {
+		basic,			//Keyed per pixel while drawing
+		refined			//Keyed on a compute pre-pass. Allows matte filtering
+	};
+
+	enum class DebugView {
+		none,
+		matte,			//Alpha as greyscale
+		fill,			//Fill inside the crop, without keying
+		composite		//Keyed fill over black
+	};
+
 	Keyer(	Zuazo::Instance& instance,
 			std::string name,
 			Zuazo::Math::Vec2f size );
@@ -54,6 +73,15 @@ public:
 	void									setCrop(Zuazo::Utils::BufferView<const Shape> shapes);
 	Zuazo::Utils::BufferView<const Shape>	getCrop() const noexcept;
 
+	//When not empty, boxes replace the crop shapes
+	void									setCropBoxes(Zuazo::Utils::BufferView<const Box> boxes);
+	void									setCropBox(size_t index, const Box& box);
+	Zuazo::Utils::BufferView<const Box>		getCropBoxes() const noexcept;
+
+	//Width of the soft crop edge in pixels, in addition to the antialiasing
+	void									setFeather(float width);
+	float									getFeather() const noexcept;
+
 
 	//Luma key
 	void									setLumaKeyEnabled(bool ena);
@@ -93,6 +121,24 @@ public:
 	void									setChromaKeyValueSmoothness(float smoothness);
 	float									getChromaKeyValueSmoothness() const noexcept;
 
+	void									setChromaKeyMode(ChromaKeyMode mode);
+	ChromaKeyMode							getChromaKeyMode() const noexcept;
+
+	void									setChromaKeyDespill(float strength);
+	float									getChromaKeyDespill() const noexcept;
+
+	void									setChromaKeyClip(float clip);
+	float									getChromaKeyClip() const noexcept;
+
+	void									setChromaKeyGain(float gain);
+	float									getChromaKeyGain() const noexcept;
+
+	void									setChromaKeyErode(int32_t erode);
+	int32_t									getChromaKeyErode() const noexcept;
+
+	void									setChromaKeyBlur(int32_t blur);
+	int32_t									getChromaKeyBlur() const noexcept;
+
 
 	//Linear key
 	void									setLinearKeyEnabled(bool ena);
@@ -104,6 +150,37 @@ public:
 	void									setLinearKeyChannel(LinearKeyChannel ch);
 	LinearKeyChannel						getLinearKeyChannel() const noexcept;	
 
+	//Colour grading. The .cube file is loaded in the background. An
+	//empty path disables it
+	void									setColorLUTPath(std::string path);
+	const std::string&						getColorLUTPath() const noexcept;
+
+	//Alpha mask. The image is decoded in the background. An empty 
+	//path disables it
+	void									setMaskPath(std::string path);
+	const std::string&						getMaskPath() const noexcept;
+
+	//Debug output
+	Output&									getDebugOutput() noexcept;
+	const Output&							getDebugOutput() const noexcept;
+
+	void									setDebugView(DebugView view);
+	DebugView								getDebugView() const noexcept;
+
+	//Animation. It is evaluated on each update while playing
+	void									setAnimation(KeyerAnimation animation);
+	const KeyerAnimation&					getAnimation() const noexcept;
+
+	void									play();
+	void									stop();
+	bool									isPlaying() const noexcept;
+	float									getAnimationTime() const noexcept;
+
+	//Invoked from the update when the animation reaches its end while
+	//playing. Therefore, it must not access the control views directly
+	void									setAnimationCallback(AnimationCallback cbk);
+	const AnimationCallback&				getAnimationCallback() const noexcept;
+
 
 
 	static void								registerCommands(Control::Controller& controller);				
@@ -112,6 +189,12 @@ public:
 
 ZUAZO_ENUM_ARITHMETIC_OPERATORS(Keyer::LinearKeyChannel)
 ZUAZO_ENUM_COMP_OPERATORS(Keyer::LinearKeyChannel)
+
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(Keyer::ChromaKeyMode)
+ZUAZO_ENUM_COMP_OPERATORS(Keyer::ChromaKeyMode)
+
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(Keyer::DebugView)
+ZUAZO_ENUM_COMP_OPERATORS(Keyer::DebugView)
 }
 
 
@@ -122,6 +205,14 @@ std::string_view toString(Cenital::Overlays::Keyer::LinearKeyChannel channel) no
 size_t fromString(std::string_view str, Cenital::Overlays::Keyer::LinearKeyChannel& channel);
 std::ostream& operator<<(std::ostream& os, Cenital::Overlays::Keyer::LinearKeyChannel channel);
 
+std::string_view toString(Cenital::Overlays::Keyer::ChromaKeyMode mode) noexcept;
+size_t fromString(std::string_view str, Cenital::Overlays::Keyer::ChromaKeyMode& mode);
+std::ostream& operator<<(std::ostream& os, Cenital::Overlays::Keyer::ChromaKeyMode mode);
+
+std::string_view toString(Cenital::Overlays::Keyer::DebugView view) noexcept;
+size_t fromString(std::string_view str, Cenital::Overlays::Keyer::DebugView& view);
+std::ostream& operator<<(std::ostream& os, Cenital::Overlays::Keyer::DebugView view);
+
 namespace Utils {
 
 template<typename T>
@@ -137,6 +228,26 @@ struct EnumTraits<Cenital::Overlays::Keyer::LinearKeyChannel> {
 	}
 };
 
+template<>
+struct EnumTraits<Cenital::Overlays::Keyer::ChromaKeyMode> {
+	static constexpr Cenital::Overlays::Keyer::ChromaKeyMode first() noexcept { 
+		return Cenital::Overlays::Keyer::ChromaKeyMode::basic; 
+	}
+	static constexpr Cenital::Overlays::Keyer::ChromaKeyMode last() noexcept { 
+		return Cenital::Overlays::Keyer::ChromaKeyMode::refined; 
+	}
+};
+
+template<>
+struct EnumTraits<Cenital::Overlays::Keyer::DebugView> {
+	static constexpr Cenital::Overlays::Keyer::DebugView first() noexcept { 
+		return Cenital::Overlays::Keyer::DebugView::none; 
+	}
+	static constexpr Cenital::Overlays::Keyer::DebugView last() noexcept { 
+		return Cenital::Overlays::Keyer::DebugView::composite; 
+	}
+};
+
 }
 
 }
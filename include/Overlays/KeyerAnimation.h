@@ -0,0 +1,132 @@
+#pragma once
+
+#include "../Easing.h"
+#include "../Shapes.h"
+
+#include <zuazo/Math/Vector.h>
+#include <zuazo/Macros.h>
+
+#include <vector>
+#include <array>
+#include <istream>
+#include <ostream>
+
+namespace Cenital::Overlays {
+
+//Timeline of keyer parameters. Only the tracks with keyframes are
+//animated, so that the rest of the parameters can be freely set
+class KeyerAnimation {
+public:
+	enum class Track : int {
+		none = -1,
+
+		positionX,
+		positionY,
+		positionZ,
+		rotationAxisX,
+		rotationAxisY,
+		rotationAxisZ,
+		rotationAngle,
+		scaleX,
+		scaleY,
+		scaleZ,
+		opacity,
+		feather,
+		lumaKeyMinThreshold,
+		lumaKeyMaxThreshold,
+		chromaKeyHueThreshold,
+		chromaKeySaturationThreshold,
+		chromaKeyValueThreshold,
+
+		count
+	};
+
+	struct Keyframe {
+		//Time at which this keyframe is reached, in seconds
+		float							time;
+
+		//Value of the track at this keyframe
+		float							value;
+
+		//Easing curve that leads to the next keyframe
+		EasingCurve						easing;
+	};
+
+	struct CropKeyframe {
+		//Time at which this keyframe is reached, in seconds
+		float							time;
+
+		//Crop at this keyframe. It is only morphed into the next
+		//one when both have the same amount of contours and segments.
+		//Otherwise it is held until the next keyframe
+		std::vector<Shape>				crop;
+
+		//Easing curve that leads to the next keyframe
+		EasingCurve						easing;
+	};
+
+	static constexpr EasingCurve LINEAR_EASING = LINEAR_EASING_CURVE;
+
+	KeyerAnimation() = default;
+	KeyerAnimation(const KeyerAnimation& other) = default;
+	KeyerAnimation(KeyerAnimation&& other) = default;
+	~KeyerAnimation() = default;
+
+	KeyerAnimation&						operator=(const KeyerAnimation& other) = default;
+	KeyerAnimation&						operator=(KeyerAnimation&& other) = default;
+
+	void								setKeyframes(Track track, std::vector<Keyframe> keyframes);
+	const std::vector<Keyframe>&		getKeyframes(Track track) const noexcept;
+	void								addKeyframe(Track track, const Keyframe& keyframe);
+
+	void								setCropKeyframes(std::vector<CropKeyframe> keyframes);
+	const std::vector<CropKeyframe>&	getCropKeyframes() const noexcept;
+	void								addCropKeyframe(CropKeyframe keyframe);
+
+	void								clear();
+	bool								empty() const noexcept;
+	float								getDuration() const noexcept;
+
+	float								evaluate(Track track, float time) const noexcept;
+	void								evaluateCrop(float time, std::vector<Shape>& result) const;
+
+	bool								load(std::istream& is);
+	void								save(std::ostream& os) const;
+
+private:
+	std::array<std::vector<Keyframe>, static_cast<size_t>(Track::count)> m_tracks;
+	std::vector<CropKeyframe>			m_cropKeyframes;
+
+};
+
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(KeyerAnimation::Track)
+ZUAZO_ENUM_COMP_OPERATORS(KeyerAnimation::Track)
+
+}
+
+
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Overlays::KeyerAnimation::Track track) noexcept;
+size_t fromString(std::string_view str, Cenital::Overlays::KeyerAnimation::Track& track);
+std::ostream& operator<<(std::ostream& os, Cenital::Overlays::KeyerAnimation::Track track);
+
+namespace Utils {
+
+template<typename T>
+struct EnumTraits;
+
+template<>
+struct EnumTraits<Cenital::Overlays::KeyerAnimation::Track> {
+	static constexpr Cenital::Overlays::KeyerAnimation::Track first() noexcept {
+		return Cenital::Overlays::KeyerAnimation::Track::none + static_cast<Cenital::Overlays::KeyerAnimation::Track>(1);
+	}
+	static constexpr Cenital::Overlays::KeyerAnimation::Track last() noexcept {
+		return Cenital::Overlays::KeyerAnimation::Track::count - static_cast<Cenital::Overlays::KeyerAnimation::Track>(1);
+	}
+};
+
+}
+
+}
\ No newline at end of file
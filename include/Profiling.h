@@ -0,0 +1,123 @@
+#pragma once
+
+#include <zuazo/Macros.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string_view>
+
+namespace Cenital::Control {
+class Controller;
+}
+
+namespace Cenital {
+
+enum class ProfilingFlags : uint32_t {
+	none		= 0,
+	counters	= 1 << 0,
+	tracing		= 1 << 1
+};
+
+ZUAZO_ENUM_BIT_OPERATORS(ProfilingFlags)
+
+//Accumulates the CPU time spent on a code region. Counters are meant
+//to be declared as static objects, so that they register themselves
+//and they can be enumerated later (i.e. by the benchmarks)
+class ProfilingCounter {
+public:
+	using Clock = std::chrono::steady_clock;
+	using Duration = std::chrono::nanoseconds;
+	using Callback = std::function<void(const ProfilingCounter&)>;
+
+	explicit ProfilingCounter(std::string_view name) noexcept;
+	ProfilingCounter(const ProfilingCounter& other) = delete;
+	ProfilingCounter(ProfilingCounter&& other) = delete;
+	~ProfilingCounter() = default;
+
+	ProfilingCounter&				operator=(const ProfilingCounter& other) = delete;
+	ProfilingCounter&				operator=(ProfilingCounter&& other) = delete;
+
+	std::string_view				getName() const noexcept;
+	uint64_t						getCallCount() const noexcept;
+	Duration						getTotalTime() const noexcept;
+
+	void							add(Duration time) noexcept;
+	void							reset() noexcept;
+
+	static void						setEnabled(bool ena) noexcept;
+	static bool						isEnabled() noexcept;
+
+	static void						forEach(const Callback& cbk);
+	static void						resetAll() noexcept;
+
+private:
+	std::string_view				m_name;
+	std::atomic<uint64_t>			m_callCount;
+	std::atomic<int64_t>			m_totalTime;
+	ProfilingCounter*				m_next;
+
+};
+
+
+
+//Records the profiled scopes as a timeline. Each thread writes to its
+//own ring buffer without locking, so only the newest events are kept.
+//The timeline can be exported in the Chrome trace-event format, which
+//can be opened by chrome://tracing and Perfetto
+class Tracing {
+public:
+	static constexpr size_t BUFFER_SIZE = 1 << 14; //Events per thread
+
+	Tracing() = delete;
+
+	static void						setEnabled(bool ena) noexcept;
+	static bool						isEnabled() noexcept;
+
+	static void						record(	std::string_view name,
+											ProfilingCounter::Clock::time_point begin,
+											ProfilingCounter::Clock::time_point end ) noexcept;
+	static void						clear();
+	static void						write(std::ostream& os);
+
+	static void						registerCommands(Control::Controller& controller);
+
+};
+
+
+
+//Adds the lifetime of this object to a counter and to the timeline.
+//When both are disabled the only overhead is a relaxed load
+class ProfilingScope {
+public:
+	explicit ProfilingScope(ProfilingCounter& counter) noexcept;
+	ProfilingScope(const ProfilingScope& other) = delete;
+	~ProfilingScope();
+
+	ProfilingScope&					operator=(const ProfilingScope& other) = delete;
+
+	static ProfilingFlags			getFlags() noexcept;
+	static void						setFlags(ProfilingFlags flags, bool ena) noexcept;
+
+private:
+	ProfilingCounter&				m_counter;
+	ProfilingFlags					m_flags;
+	ProfilingCounter::Clock::time_point m_start;
+
+	static std::atomic<uint32_t>	s_flags;
+
+};
+
+}
+
+#define CENITAL_PROFILING_CONCAT_IMPL(x, y) x ## y
+#define CENITAL_PROFILING_CONCAT(x, y) CENITAL_PROFILING_CONCAT_IMPL(x, y)
+
+//Profiles the rest of the enclosing scope under the given name
+#define CENITAL_PROFILE_SCOPE(name)																		\
+	static ::Cenital::ProfilingCounter CENITAL_PROFILING_CONCAT(profilingCounter, __LINE__)(name);		\
+	const ::Cenital::ProfilingScope CENITAL_PROFILING_CONCAT(profilingScope, __LINE__)(CENITAL_PROFILING_CONCAT(profilingCounter, __LINE__))
+
+#include "Profiling.inl"
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "Profiling.h"
+
+namespace Cenital {
+
+inline std::string_view ProfilingCounter::getName() const noexcept {
+	return m_name;
+}
+
+inline uint64_t ProfilingCounter::getCallCount() const noexcept {
+	return m_callCount.load(std::memory_order_relaxed);
+}
+
+inline ProfilingCounter::Duration ProfilingCounter::getTotalTime() const noexcept {
+	return Duration(m_totalTime.load(std::memory_order_relaxed));
+}
+
+inline void ProfilingCounter::add(Duration time) noexcept {
+	m_callCount.fetch_add(1, std::memory_order_relaxed);
+	m_totalTime.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+inline void ProfilingCounter::reset() noexcept {
+	m_callCount.store(0, std::memory_order_relaxed);
+	m_totalTime.store(0, std::memory_order_relaxed);
+}
+
+
+inline void ProfilingCounter::setEnabled(bool ena) noexcept {
+	ProfilingScope::setFlags(ProfilingFlags::counters, ena);
+}
+
+inline bool ProfilingCounter::isEnabled() noexcept {
+	return (ProfilingScope::getFlags() & ProfilingFlags::counters) != ProfilingFlags::none;
+}
+
+
+
+inline void Tracing::setEnabled(bool ena) noexcept {
+	ProfilingScope::setFlags(ProfilingFlags::tracing, ena);
+}
+
+inline bool Tracing::isEnabled() noexcept {
+	return (ProfilingScope::getFlags() & ProfilingFlags::tracing) != ProfilingFlags::none;
+}
+
+
+
+inline ProfilingScope::ProfilingScope(ProfilingCounter& counter) noexcept
+	: m_counter(counter)
+	, m_flags(getFlags())
+	, m_start()
+{
+	if(m_flags != ProfilingFlags::none) {
+		m_start = ProfilingCounter::Clock::now();
+	}
+}
+
+inline ProfilingScope::~ProfilingScope() {
+	if(m_flags != ProfilingFlags::none) {
+		const auto end = ProfilingCounter::Clock::now();
+
+		if((m_flags & ProfilingFlags::counters) != ProfilingFlags::none) {
+			m_counter.add(std::chrono::duration_cast<ProfilingCounter::Duration>(end - m_start));
+		}
+
+		if((m_flags & ProfilingFlags::tracing) != ProfilingFlags::none) {
+			Tracing::record(m_counter.getName(), m_start, end);
+		}
+	}
+}
+
+inline ProfilingFlags ProfilingScope::getFlags() noexcept {
+	return static_cast<ProfilingFlags>(s_flags.load(std::memory_order_relaxed));
+}
+
+inline void ProfilingScope::setFlags(ProfilingFlags flags, bool ena) noexcept {
+	if(ena) {
+		s_flags.fetch_or(static_cast<uint32_t>(flags), std::memory_order_relaxed);
+	} else {
+		s_flags.fetch_and(~static_cast<uint32_t>(flags), std::memory_order_relaxed);
+	}
+}
+
+}
\ No newline at end of file
@@ -3,14 +3,43 @@
 
 #include <zuazo/Math/Vector.h>
 #include <zuazo/Math/BezierLoop.h>
+#include <zuazo/Utils/BufferView.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
 
 namespace Cenital {
 
 using Shape = Zuazo::Math::CubicBezierLoop<Zuazo::Math::Vec2f>;
 
+//Axis aligned rectangle with rounded corners. Radii are given 
+//counter-clockwise, starting from the (+x, +y) corner
+struct Box {
+	Zuazo::Math::Vec2f	center;
+	Zuazo::Math::Vec2f	size;
+	Zuazo::Math::Vec4f	radii;
+};
+
+//Generators write into the provided shape. Its storage is reused 
+//when the amount of segments does not change
 void generateStar(Shape& result, size_t count, float radius0, float radius1, float angle);
 void generateHeart(Shape& result, float size);
 void generateEllipse(Shape& result, Zuazo::Math::Vec2f size);
 void generateRectangle(Shape& result, Zuazo::Math::Vec2f size);
+void generateRoundedRectangle(Shape& result, Zuazo::Math::Vec2f size, Zuazo::Math::Vec4f radii);
+void generatePolygon(Shape& result, Zuazo::Utils::BufferView<const Zuazo::Math::Vec2f> vertices);
+void generateRegularPolygon(Shape& result, size_t count, float radius, float angle);
+
+//Parses the M, L, H, V, C, S, Q, T and Z commands of a SVG path, 
+//both in their absolute and relative forms. Each subpath results 
+//in a contour, which is implicitly closed. Returns false on error,
+//leaving the result in an unspecified state
+bool parseSVGPath(std::string_view path, std::vector<Shape>& result);
+
+//As parseSVGPath(), but the result is shared with the previous 
+//calls with the same path. The most recently used paths are kept 
+//cached even when not in use. Returns nullptr on error
+std::shared_ptr<const std::vector<Shape>> loadSVGPath(std::string_view path);
 
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Mixer.h"
+#include "MixEffect.h"
+#include "Control/ViewBase.h"
+#include "Control/Controller.h"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace Cenital {
+
+class Tally 
+	: public Control::ViewBase
+{
+public:
+	using Flags = MixEffect::Tally;
+	using TallyMap = std::unordered_map<std::string, Flags>;
+	using InvalidateCallback = std::function<void(Tally&)>;
+
+	Tally(	Control::Controller& controller,
+			Mixer& mixer );
+	Tally(const Tally& other) = delete;
+	Tally(Tally&& other) = delete;
+	virtual ~Tally() = default;
+
+	Tally&								operator=(const Tally& other) = delete;
+	Tally&								operator=(Tally&& other) = delete;
+
+	void								setInvalidateCallback(InvalidateCallback cbk);
+	const InvalidateCallback&			getInvalidateCallback() const noexcept;
+
+	void								invalidate();
+	void								refresh();
+	const TallyMap&						getTally();
+
+	virtual void						update(const Control::Message& msg) final;
+
+	void								registerCommands(Control::Controller& controller);
+
+private:
+	std::reference_wrapper<Mixer>		m_mixer;
+	TallyMap							m_tally;
+	bool								m_dirty;
+	bool								m_refreshPending;
+
+	InvalidateCallback					m_invalidateCallback;
+
+	void								compute(TallyMap& result);
+	void								installCallback(MixEffect& mixEffect);
+
+};
+
+}
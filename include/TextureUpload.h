@@ -0,0 +1,40 @@
+#pragma once
+
+#include <zuazo/Graphics/Vulkan.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace Cenital {
+
+//Copies host data into a single level image without waiting for it. The
+//copy is submitted to the graphics queue, so that any later submission
+//on it finds the image in the shader read-only layout. The staging
+//resources must be kept until isComplete() returns true
+class TextureUpload {
+public:
+	using FillCallback = std::function<void(std::byte* data)>;
+
+	TextureUpload(	const Zuazo::Graphics::Vulkan& vulkan,
+					vk::Image image,
+					vk::Extent3D extent,
+					vk::DeviceSize size,
+					const FillCallback& fill );
+	TextureUpload(const TextureUpload& other) = delete;
+	~TextureUpload();
+
+	TextureUpload&							operator=(const TextureUpload& other) = delete;
+
+	bool									isComplete() const;
+
+private:
+	const Zuazo::Graphics::Vulkan&			m_vulkan;
+	vk::UniqueBuffer						m_stagingBuffer;
+	vk::UniqueDeviceMemory					m_stagingMemory;
+	vk::UniqueCommandPool					m_commandPool;
+	vk::UniqueCommandBuffer					m_commandBuffer;
+	vk::UniqueFence							m_fence;
+
+};
+
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../Easing.h"
+
+#include <zuazo/Macros.h>
 #include <zuazo/Video.h>
 #include <zuazo/ZuazoBase.h>
 #include <zuazo/ClipBase.h>
@@ -7,6 +10,7 @@
 #include <zuazo/Signal/Input.h>
 #include <zuazo/Utils/BufferView.h>
 
+#include <array>
 #include <utility>
 #include <functional>
 
@@ -21,6 +25,20 @@ public:
 	using Layers = Zuazo::Utils::BufferView<const Zuazo::RendererBase::LayerRef>;
 	using SizeCallback = std::function<void(Base&, Zuazo::Math::Vec2f)>;
 
+	enum class Easing : int {
+		none = -1,
+
+		linear,
+		easeIn,
+		easeOut,
+		easeInOut,
+		custom,
+
+		count
+	};
+
+	static constexpr size_t EASING_TABLE_SIZE = 64;
+
 	Base(	Zuazo::Instance& instance, 
 			std::string name,
 			Input& prevIn,
@@ -53,6 +71,13 @@ public:
 	void							setSize(Zuazo::Math::Vec2f size);
 	Zuazo::Math::Vec2f				getSize() const noexcept;
 
+	void							setEasing(Easing easing);
+	Easing							getEasing() const noexcept;
+	void							setEasingCurve(const EasingCurve& curve);
+	const EasingCurve&				getEasingCurve() const noexcept;
+
+	double							getEasedProgress() const noexcept;
+
 protected:
 	void							setPrevIn(Input& in) noexcept;
 	void							setPostIn(Input& in) noexcept;
@@ -71,6 +96,42 @@ private:
 
 	SizeCallback					m_sizeCallback;
 
+	Easing							m_easing;
+	EasingCurve						m_easingCurve;
+	std::array<float, EASING_TABLE_SIZE + 1> m_easingTable;
+
+	void							updateEasingTable() noexcept;
+
+};
+
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(Base::Easing)
+ZUAZO_ENUM_COMP_OPERATORS(Base::Easing)
+
+}
+
+
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Transitions::Base::Easing easing) noexcept;
+size_t fromString(std::string_view str, Cenital::Transitions::Base::Easing& easing);
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::Base::Easing easing);
+
+namespace Utils {
+
+template<typename T>
+struct EnumTraits;
+
+template<>
+struct EnumTraits<Cenital::Transitions::Base::Easing> {
+	static constexpr Cenital::Transitions::Base::Easing first() noexcept { 
+		return Cenital::Transitions::Base::Easing::none + static_cast<Cenital::Transitions::Base::Easing>(1); 
+	}
+	static constexpr Cenital::Transitions::Base::Easing last() noexcept { 
+		return Cenital::Transitions::Base::Easing::count - static_cast<Cenital::Transitions::Base::Easing>(1);
+	}
 };
 
+}
+
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "Base.h"
+#include "DVEMove.h"
 #include "../Control/Controller.h"
 
 #include <zuazo/Utils/Pimpl.h>
 #include <zuazo/ZuazoBase.h>
+#include <zuazo/LayerBase.h>
 #include <zuazo/Video.h>
 
 namespace Cenital::Transitions {
@@ -13,6 +15,7 @@ struct DVEImpl;
 class DVE
 	: private Zuazo::Utils::Pimpl<DVEImpl>
 	, public Base
+	, public Zuazo::LayerBase
 {
 	friend DVEImpl;
 public:
@@ -23,6 +26,7 @@ public:
 		cover,
 		slide,
 		rotate3D,
+		custom,
 		
 		//Add here
 
@@ -48,6 +52,9 @@ public:
 	void							setEffect(Effect effect);
 	Effect							getEffect() const noexcept;
 
+	void							setMove(DVEMove move);
+	const DVEMove&					getMove() const noexcept;
+
 
 
 	static void						registerCommands(Control::Controller& controller);	
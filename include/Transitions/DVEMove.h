@@ -0,0 +1,148 @@
+#pragma once
+
+#include "../Easing.h"
+
+#include <zuazo/Math/Vector.h>
+#include <zuazo/Utils/BufferView.h>
+#include <zuazo/Macros.h>
+
+#include <array>
+#include <vector>
+#include <istream>
+#include <ostream>
+
+namespace Cenital::Transitions {
+
+class DVEMove {
+public:
+	enum class Layer : int {
+		none = -1,
+
+		prev,
+		post,
+
+		count
+	};
+
+	enum class Track : int {
+		none = -1,
+
+		positionX,
+		positionY,
+		positionZ,
+		rotationAxisX,
+		rotationAxisY,
+		rotationAxisZ,
+		rotationAngle,
+		scaleX,
+		scaleY,
+		scaleZ,
+		opacity,
+		cropLeft,
+		cropRight,
+		cropTop,
+		cropBottom,
+
+		count
+	};
+
+	struct Keyframe {
+		//Progress at which this keyframe is reached [0, 1]
+		float							time;
+
+		//Value of the track at this keyframe
+		float							value;
+
+		//Easing curve that leads to the next keyframe
+		EasingCurve						easing;
+	};
+
+	using Sample = std::array<float, static_cast<size_t>(Track::count)>;
+
+	static constexpr size_t SAMPLE_COUNT = 256;
+	static constexpr EasingCurve LINEAR_EASING = LINEAR_EASING_CURVE;
+
+	DVEMove();
+	DVEMove(const DVEMove& other) = default;
+	DVEMove(DVEMove&& other) = default;
+	~DVEMove() = default;
+
+	DVEMove&						operator=(const DVEMove& other) = default;
+	DVEMove&						operator=(DVEMove&& other) = default;
+
+	void							setTopLayer(Layer layer) noexcept;
+	Layer							getTopLayer() const noexcept;
+
+	void							setKeyframes(Layer layer, Track track, std::vector<Keyframe> keyframes);
+	const std::vector<Keyframe>&	getKeyframes(Layer layer, Track track) const noexcept;
+	void							addKeyframe(Layer layer, Track track, const Keyframe& keyframe);
+	void							clear();
+
+	Sample							evaluate(Layer layer, float progress) const noexcept;
+	Zuazo::Utils::BufferView<const Sample> getSamples(Layer layer) const noexcept;
+
+	bool							load(std::istream& is);
+	void							save(std::ostream& os) const;
+
+	static float					getDefaultValue(Track track) noexcept;
+
+private:
+	using TrackArray = std::array<std::vector<Keyframe>, static_cast<size_t>(Track::count)>;
+	using SampleTable = std::array<Sample, SAMPLE_COUNT + 1>;
+
+	Layer																m_topLayer;
+	std::array<TrackArray, static_cast<size_t>(Layer::count)>			m_tracks;
+	std::array<SampleTable, static_cast<size_t>(Layer::count)>			m_samples;
+
+	void							updateSamples(Layer layer, Track track) noexcept;
+
+};
+
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(DVEMove::Layer)
+ZUAZO_ENUM_COMP_OPERATORS(DVEMove::Layer)
+
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(DVEMove::Track)
+ZUAZO_ENUM_COMP_OPERATORS(DVEMove::Track)
+
+}
+
+
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Transitions::DVEMove::Layer layer) noexcept;
+size_t fromString(std::string_view str, Cenital::Transitions::DVEMove::Layer& layer);
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::DVEMove::Layer layer);
+
+std::string_view toString(Cenital::Transitions::DVEMove::Track track) noexcept;
+size_t fromString(std::string_view str, Cenital::Transitions::DVEMove::Track& track);
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::DVEMove::Track track);
+
+namespace Utils {
+
+template<typename T>
+struct EnumTraits;
+
+template<>
+struct EnumTraits<Cenital::Transitions::DVEMove::Layer> {
+	static constexpr Cenital::Transitions::DVEMove::Layer first() noexcept {
+		return Cenital::Transitions::DVEMove::Layer::none + static_cast<Cenital::Transitions::DVEMove::Layer>(1);
+	}
+	static constexpr Cenital::Transitions::DVEMove::Layer last() noexcept {
+		return Cenital::Transitions::DVEMove::Layer::count - static_cast<Cenital::Transitions::DVEMove::Layer>(1);
+	}
+};
+
+template<>
+struct EnumTraits<Cenital::Transitions::DVEMove::Track> {
+	static constexpr Cenital::Transitions::DVEMove::Track first() noexcept {
+		return Cenital::Transitions::DVEMove::Track::none + static_cast<Cenital::Transitions::DVEMove::Track>(1);
+	}
+	static constexpr Cenital::Transitions::DVEMove::Track last() noexcept {
+		return Cenital::Transitions::DVEMove::Track::count - static_cast<Cenital::Transitions::DVEMove::Track>(1);
+	}
+};
+
+}
+
+}
\ No newline at end of file
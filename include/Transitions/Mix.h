@@ -5,6 +5,7 @@
 
 #include <zuazo/Utils/Pimpl.h>
 #include <zuazo/ZuazoBase.h>
+#include <zuazo/LayerBase.h>
 #include <zuazo/Video.h>
 
 namespace Cenital::Transitions {
@@ -13,6 +14,7 @@ struct MixImpl;
 class Mix
 	: private Zuazo::Utils::Pimpl<MixImpl>
 	, public Base
+	, public Zuazo::LayerBase
 {
 	friend MixImpl;
 public:
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Base.h"
+#include "../Control/Controller.h"
+
+#include <zuazo/Utils/Pimpl.h>
+#include <zuazo/ZuazoBase.h>
+#include <zuazo/Video.h>
+
+#include <limits>
+
+namespace Cenital::Transitions {
+
+struct StingerImpl;
+class Stinger
+	: private Zuazo::Utils::Pimpl<StingerImpl>
+	, public Base
+{
+	friend StingerImpl;
+public:
+	static constexpr size_t DEFAULT_CUT_FRAME = std::numeric_limits<size_t>::max(); //Half of the clip
+
+	Stinger(Zuazo::Instance& instance,
+			std::string name );
+
+	Stinger(const Stinger& other) = delete;
+	Stinger(Stinger&& other);
+	virtual ~Stinger();
+
+	Stinger&						operator=(const Stinger& other) = delete;
+	Stinger&						operator=(Stinger&& other);
+
+	void							setScalingFilter(Zuazo::ScalingFilter filter); 
+	Zuazo::ScalingFilter			getScalingFilter() const noexcept;
+
+	void							setClipPath(std::string path);
+	const std::string&				getClipPath() const noexcept;
+
+	void							setCutFrame(size_t frame);
+	size_t							getCutFrame() const noexcept;
+
+	size_t							getFrameCount() const noexcept;
+
+
+
+	static void						registerCommands(Control::Controller& controller);	
+
+};
+
+}
\ No newline at end of file
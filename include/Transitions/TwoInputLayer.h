@@ -0,0 +1,143 @@
+#pragma once
+
+#include <zuazo/Video.h>
+#include <zuazo/LayerBase.h>
+#include <zuazo/RendererBase.h>
+#include <zuazo/Graphics/Vulkan.h>
+#include <zuazo/Graphics/CommandBuffer.h>
+#include <zuazo/Math/Vector.h>
+#include <zuazo/Math/Transform.h>
+#include <zuazo/Utils/BufferView.h>
+#include <zuazo/Utils/Area.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Cenital::Transitions {
+
+//Draws the previous and the posterior frames with a single pipeline. It
+//holds the Vulkan objects shared by the transitions that are rendered as
+//a layer, so that each of them only provides its shaders, the bindings of
+//its descriptor set and its specialization constants. The model matrix
+//and the sampling modes of the frames are handled here. Specialization
+//constants are 32bit wide and their ids match their position
+class TwoInputLayer {
+public:
+	enum DescriptorSets {
+		DESCRIPTOR_SET_RENDERER = Zuazo::RendererBase::DESCRIPTOR_SET,
+		DESCRIPTOR_SET_TRANSITION,
+		DESCRIPTOR_SET_PREVFRAME,
+		DESCRIPTOR_SET_POSTFRAME,
+
+		DESCRIPTOR_SET_COUNT
+	};
+
+	//Bindings of the transitions are numbered after these
+	enum DescriptorBindings {
+		DESCRIPTOR_BINDING_MODEL_MATRIX,
+
+		DESCRIPTOR_BINDING_COUNT
+	};
+
+	//Fragment constants of the transitions are numbered after these
+	enum FragmentConstantId {
+		FRAGMENT_CONSTANT_ID_PREV_SAMPLE_MODE,
+		FRAGMENT_CONSTANT_ID_POST_SAMPLE_MODE,
+
+		FRAGMENT_CONSTANT_ID_COUNT
+	};
+
+	//Either a uniform or a storage buffer
+	struct Binding {
+		uint32_t										binding;
+		vk::DescriptorType								type;
+		vk::ShaderStageFlags							stages;
+		size_t											size;
+	};
+
+	//Must outlive the layer. It is also used to identify the pipelines
+	struct Layout {
+		Zuazo::Utils::BufferView<const uint32_t>		vertexShader;
+		Zuazo::Utils::BufferView<const uint32_t>		fragmentShader;
+		Zuazo::Utils::BufferView<const Binding>			bindings;
+		uint32_t										vertexConstantCount;
+		uint32_t										fragmentConstantCount;
+	};
+
+	static constexpr std::array<uint32_t, 1> SINGLE_INSTANCE = { 0 };
+
+	TwoInputLayer(	const Zuazo::Graphics::Vulkan& vulkan,
+					const Layout& layout,
+					Zuazo::Math::Vec2f size );
+	TwoInputLayer(const TwoInputLayer& other) = delete;
+	~TwoInputLayer();
+
+	TwoInputLayer&									operator=(const TwoInputLayer& other) = delete;
+
+	void											recreate();
+
+	//A full-screen quad is drawn for each of the instances, in order
+	void											draw(	Zuazo::Graphics::CommandBuffer& cmd,
+															const Zuazo::Video& prevFrame,
+															const Zuazo::Video& postFrame,
+															Zuazo::ScalingFilter filter,
+															vk::RenderPass renderPass,
+															Zuazo::BlendingMode blendingMode,
+															Zuazo::RenderingLayer renderingLayer,
+															Zuazo::Utils::BufferView<const uint32_t> instances = SINGLE_INSTANCE );
+
+	void											setSize(Zuazo::Math::Vec2f size);
+	void											updateModelMatrixUniform(const Zuazo::Math::Transformf& transform);
+
+protected:
+	template<typename T>
+	void											setVertexConstant(uint32_t id, T value);
+	template<typename T>
+	void											setFragmentConstant(uint32_t id, T value);
+
+	template<typename T>
+	void											writeUniform(uint32_t binding, Zuazo::Utils::Area area, const T& value);
+	void											writeUniform(	uint32_t binding,
+																	const void* data,
+																	size_t size,
+																	size_t offset = 0 );
+
+	//The returned data is flushed on the next draw
+	Zuazo::Utils::BufferView<std::byte>				writeStorage(uint32_t binding);
+
+private:
+	struct Resources;
+
+	const Zuazo::Graphics::Vulkan&					m_vulkan;
+	const Layout&									m_layout;
+
+	std::shared_ptr<Resources>						m_resources;
+	vk::DescriptorSet								m_descriptorSet;
+
+	Zuazo::Math::Vec2f								m_size;
+	bool											m_flushVertexBuffer;
+	std::vector<bool>								m_flushStorageBuffers;
+
+	std::vector<uint32_t>							m_vertexConstants;
+	std::vector<uint32_t>							m_fragmentConstants;
+	vk::DescriptorSetLayout							m_prevFrameDescriptorSetLayout;
+	vk::DescriptorSetLayout							m_postFrameDescriptorSetLayout;
+	vk::PipelineLayout								m_pipelineLayout;
+	vk::Pipeline									m_pipeline;
+
+	void											configureSamplers(	const Zuazo::Graphics::Frame& prevFrame,
+																		const Zuazo::Graphics::Frame& postFrame,
+																		Zuazo::ScalingFilter filter,
+																		vk::RenderPass renderPass,
+																		Zuazo::BlendingMode blendingMode,
+																		Zuazo::RenderingLayer renderingLayer );
+	void											fillVertexBuffer();
+	void											fillStorageBuffers();
+	size_t											findStorageBuffer(uint32_t binding) const noexcept;
+
+};
+
+}
+
+#include "TwoInputLayer.inl"
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "TwoInputLayer.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace Cenital::Transitions {
+
+template<typename T>
+inline void TwoInputLayer::setVertexConstant(uint32_t id, T value) {
+	static_assert(sizeof(T) == sizeof(uint32_t), "Specialization constants must be 32bit wide");
+	assert(id < m_vertexConstants.size());
+	std::memcpy(&m_vertexConstants[id], &value, sizeof(value));
+	recreate();
+}
+
+template<typename T>
+inline void TwoInputLayer::setFragmentConstant(uint32_t id, T value) {
+	static_assert(sizeof(T) == sizeof(uint32_t), "Specialization constants must be 32bit wide");
+	assert(id < m_fragmentConstants.size());
+	std::memcpy(&m_fragmentConstants[id], &value, sizeof(value));
+	recreate();
+}
+
+template<typename T>
+inline void TwoInputLayer::writeUniform(uint32_t binding, Zuazo::Utils::Area area, const T& value) {
+	assert(sizeof(value) == area.size());
+	writeUniform(binding, &value, sizeof(value), area.offset());
+}
+
+}
\ No newline at end of file
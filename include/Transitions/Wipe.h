@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Base.h"
+#include "../Shapes.h"
+#include "../Control/Controller.h"
+
+#include <zuazo/Utils/Pimpl.h>
+#include <zuazo/ZuazoBase.h>
+#include <zuazo/LayerBase.h>
+#include <zuazo/Video.h>
+
+namespace Cenital::Transitions {
+
+struct WipeImpl;
+class Wipe
+	: private Zuazo::Utils::Pimpl<WipeImpl>
+	, public Base
+	, public Zuazo::LayerBase
+{
+	friend WipeImpl;
+public:
+	enum class Pattern : int {
+		none = -1,
+
+		bars,
+		box,
+		circle,
+		diamond,
+		clock,
+		shape,
+		
+		//Add here
+
+		count
+	};
+
+	Wipe(	Zuazo::Instance& instance,
+			std::string name );
+
+	Wipe(const Wipe& other) = delete;
+	Wipe(Wipe&& other);
+	virtual ~Wipe();
+
+	Wipe&							operator=(const Wipe& other) = delete;
+	Wipe&							operator=(Wipe&& other);
+
+	void							setScalingFilter(Zuazo::ScalingFilter filter); 
+	Zuazo::ScalingFilter			getScalingFilter() const noexcept;
+
+	void							setPattern(Pattern pattern);
+	Pattern							getPattern() const noexcept;
+
+	void							setAngle(float angle);
+	float							getAngle() const noexcept;
+
+	void							setBarCount(uint32_t count);
+	uint32_t						getBarCount() const noexcept;
+
+	void							setBorder(float border);
+	float							getBorder() const noexcept;
+
+	void							setShape(const Shape& shape);
+	const Shape&					getShape() const noexcept;
+
+
+
+	static void						registerCommands(Control::Controller& controller);	
+
+};
+
+ZUAZO_ENUM_ARITHMETIC_OPERATORS(Wipe::Pattern)
+ZUAZO_ENUM_COMP_OPERATORS(Wipe::Pattern)	
+
+}
+
+
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Transitions::Wipe::Pattern pattern) noexcept;
+size_t fromString(std::string_view str, Cenital::Transitions::Wipe::Pattern& pattern);
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::Wipe::Pattern pattern);
+
+namespace Utils {
+
+template<typename T>
+struct EnumTraits;
+
+template<>
+struct EnumTraits<Cenital::Transitions::Wipe::Pattern> {
+	static constexpr Cenital::Transitions::Wipe::Pattern first() noexcept { 
+		return Cenital::Transitions::Wipe::Pattern::none + static_cast<Cenital::Transitions::Wipe::Pattern>(1); 
+	}
+	static constexpr Cenital::Transitions::Wipe::Pattern last() noexcept { 
+		return Cenital::Transitions::Wipe::Pattern::count - static_cast<Cenital::Transitions::Wipe::Pattern>(1);
+	}
+};
+
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+extern "C" {
+	#include <libavformat/avformat.h>
+	#include <libavcodec/avcodec.h>
+	#include <libswscale/swscale.h>
+}
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Cenital {
+
+//Decodes the video stream of a file frame by frame. It does not
+//depend on the instance, so it can be used from any thread
+class VideoDecoder {
+public:
+	explicit VideoDecoder(std::string filename);
+	VideoDecoder(const VideoDecoder& other) = delete;
+	~VideoDecoder() = default;
+
+	VideoDecoder&									operator=(const VideoDecoder& other) = delete;
+
+	const std::string&								getFilename() const noexcept;
+
+	//Returns nullptr at the end of the stream. The frame is valid
+	//until the next call
+	const AVFrame*									decode();
+
+	//Writes the frame into a single plane of the given format,
+	//rescaling it if necessary
+	void											convert(const AVFrame& frame,
+															AVPixelFormat format,
+															int width,
+															int height,
+															uint8_t* data,
+															int lineSize );
+
+private:
+	struct FormatContextDeleter {
+		void operator()(AVFormatContext* ctx) const noexcept;
+	};
+
+	struct CodecContextDeleter {
+		void operator()(AVCodecContext* ctx) const noexcept;
+	};
+
+	struct PacketDeleter {
+		void operator()(AVPacket* packet) const noexcept;
+	};
+
+	struct FrameDeleter {
+		void operator()(AVFrame* frame) const noexcept;
+	};
+
+	struct SwsContextDeleter {
+		void operator()(SwsContext* ctx) const noexcept;
+	};
+
+	std::string										m_filename;
+	std::unique_ptr<AVFormatContext, FormatContextDeleter> m_formatContext;
+	std::unique_ptr<AVCodecContext, CodecContextDeleter> m_codecContext;
+	std::unique_ptr<AVPacket, PacketDeleter>		m_packet;
+	std::unique_ptr<AVFrame, FrameDeleter>			m_frame;
+	std::unique_ptr<SwsContext, SwsContextDeleter>	m_swsContext;
+	int												m_streamIndex;
+
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace Cenital {
+
+//Shares immutable objects while they are in use. Entries are weak, so
+//objects are released as soon as nobody uses them. A different version
+//of the key replaces the stored object. Objects are created without
+//holding the lock, so that slow loads do not block the rest of the keys.
+//If the same object is created concurrently, the first one is kept
+template<typename Key, typename T, typename Version = std::monostate>
+class WeakCache {
+public:
+	WeakCache() = default;
+	WeakCache(const WeakCache& other) = delete;
+	~WeakCache() = default;
+
+	WeakCache&							operator=(const WeakCache& other) = delete;
+
+	//create is invoked as create() and it must return a std::shared_ptr<const T>
+	template<typename Create>
+	std::shared_ptr<const T>			get(const Key& key, const Version& version, Create&& create);
+	template<typename Create>
+	std::shared_ptr<const T>			get(const Key& key, Create&& create);
+
+private:
+	struct Entry {
+		Version								version;
+		std::weak_ptr<const T>				value;
+	};
+
+	std::mutex							m_mutex;
+	std::map<Key, Entry>				m_entries;
+
+	std::shared_ptr<const T>			find(const Key& key, const Version& version);
+
+};
+
+//Objects loaded from files. Files are identified by their canonical path,
+//so that the same object is shared. The modification time allows
+//reloading edited files
+template<typename T>
+class FileCache {
+public:
+	//load is invoked as load(canonicalPath) and it must return a std::shared_ptr<const T>
+	template<typename Load>
+	std::shared_ptr<const T>			get(std::string_view path, Load&& load);
+
+private:
+	WeakCache<std::string, T, std::filesystem::file_time_type> m_cache;
+
+};
+
+}
+
+#include "WeakCache.inl"
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "WeakCache.h"
+
+#include <utility>
+
+namespace Cenital {
+
+/*
+ * WeakCache
+ */
+
+template<typename Key, typename T, typename Version>
+template<typename Create>
+inline std::shared_ptr<const T> WeakCache<Key, T, Version>::get(const Key& key, const Version& version, Create&& create) {
+	auto result = find(key, version);
+
+	if(!result) {
+		//Create it unlocked, as it may take a while
+		result = std::forward<Create>(create)();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto& entry = m_entries[key];
+		auto existing = entry.value.lock();
+		if(existing && entry.version == version) {
+			//Somebody was faster
+			result = std::move(existing);
+		} else {
+			entry.version = version;
+			entry.value = result;
+		}
+	}
+
+	return result;
+}
+
+template<typename Key, typename T, typename Version>
+template<typename Create>
+inline std::shared_ptr<const T> WeakCache<Key, T, Version>::get(const Key& key, Create&& create) {
+	return get(key, Version(), std::forward<Create>(create));
+}
+
+template<typename Key, typename T, typename Version>
+inline std::shared_ptr<const T> WeakCache<Key, T, Version>::find(const Key& key, const Version& version) {
+	std::shared_ptr<const T> result;
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	//Forget the objects which are no longer used
+	for(auto ite = m_entries.begin(); ite != m_entries.end(); ) {
+		if(ite->second.value.expired()) {
+			ite = m_entries.erase(ite);
+		} else {
+			++ite;
+		}
+	}
+
+	const auto ite = m_entries.find(key);
+	if(ite != m_entries.end() && ite->second.version == version) {
+		result = ite->second.value.lock();
+	}
+
+	return result;
+}
+
+
+
+/*
+ * FileCache
+ */
+
+template<typename T>
+template<typename Load>
+inline std::shared_ptr<const T> FileCache<T>::get(std::string_view path, Load&& load) {
+	const auto canonicalPath = std::filesystem::canonical(std::filesystem::path(path));
+	const auto lastWriteTime = std::filesystem::last_write_time(canonicalPath);
+
+	return m_cache.get(
+		canonicalPath.string(),
+		lastWriteTime,
+		[&canonicalPath, &load] () -> std::shared_ptr<const T> {
+			return std::forward<Load>(load)(canonicalPath);
+		}
+	);
+}
+
+}
\ No newline at end of file
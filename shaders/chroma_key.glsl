@@ -0,0 +1,61 @@
+//Requires color_utils.glsl to be included beforehand
+
+struct ChromaKeyParameters {
+	float hue;
+	float deltaHueThreshold;
+	float deltaHueSmoothness;
+	float saturationThreshold;
+	float saturationSmoothness;
+	float valueThreshold;
+	float valueSmoothness;
+};
+
+//Chroma keying is based on:
+//Software Chroma Keying in an Imersive Virtual Environment, F. van den Bergh & V. Lalioti
+//https://github.com/CasparCG/server/blob/master/src/accelerator/ogl/image/shader.frag
+
+float chromaKeyAlpha(in ChromaKeyParameters parameters, in vec3 keyColor) {
+	//Convert the color into hsv
+	const vec3 hsvColor = rgb2hsv(keyColor);
+	const float halfHue = 0.5;
+
+	//Calculate the scores. High values involve low alphas
+	//The hue is the complemented angle difference, this is,
+	//if both angles are equal, a score of 180deg is given. If
+	//they are 180deg appart, which is the maximum possible, the
+	//score will be 0.
+	const vec3 scores = vec3(
+		abs(abs(hsvColor.x - parameters.hue) - halfHue),
+		hsvColor.y, 
+		hsvColor.z
+	);
+
+	//Obtain the lower and upper thresholds
+	//As hue is inverted, sum the smoothness in
+	//the upper thresholds instead of subtracting them in the
+	//lower threshold.
+	const vec3 threshold = vec3(
+		halfHue - parameters.deltaHueThreshold, //Complementary
+		parameters.saturationThreshold,
+		parameters.valueThreshold
+	);
+	const vec3 smoothness = vec3(
+		parameters.deltaHueSmoothness,
+		parameters.saturationSmoothness,
+		parameters.valueSmoothness
+	);
+
+	const vec3 threshlold0 = threshold - smoothness;
+	const vec3 threshlold1 = threshold;
+
+	//Calculate the alphas related to each of the parameters
+	//Only use smoothstep if its behaviour is defined (edge0 < edge1)
+	const vec3 alphas = mix(
+		step(threshold, scores),
+		smoothstep(threshlold0, threshlold1, scores),
+		lessThan(threshlold0, threshlold1)
+	);
+
+	//The result will be the least limiting one
+	return 1.0f - min(alphas.x, min(alphas.y, alphas.z));
+}
@@ -0,0 +1,27 @@
+//Tables are authored for display referred values, whilst the frames
+//are sampled as linear values. Therefore the lookup is performed over 
+//sRGB encoded values
+
+vec3 color_lut_encode(in vec3 color) {
+	const vec3 linear = clamp(color, 0.0f, 1.0f);
+	return mix(
+		12.92f * linear,
+		1.055f * pow(linear, vec3(1.0f / 2.4f)) - 0.055f,
+		greaterThan(linear, vec3(0.0031308f))
+	);
+}
+
+vec3 color_lut_decode(in vec3 color) {
+	return mix(
+		color / 12.92f,
+		pow((color + 0.055f) / 1.055f, vec3(2.4f)),
+		greaterThan(color, vec3(0.04045f))
+	);
+}
+
+vec3 color_lut_apply(in sampler3D lut, in vec3 scale, in vec3 offset, in vec3 color) {
+	//Scale and offset map the domain to the centers of the edge texels.
+	//A single trilinear lookup replaces the whole grading chain
+	const vec3 texCoord = color_lut_encode(color)*scale + offset;
+	return color_lut_decode(texture(lut, texCoord).rgb);
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#include "frame.glsl"
+
+//Specialization constants and normal constants
+const int LAYER_PREV 			= 0;
+const int LAYER_POST 			= 1;
+
+layout(constant_id = 0) const int prevSampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+layout(constant_id = 1) const int postSampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+
+//Vertex I/O
+layout(location = 0) in vec2 in_texCoord;
+layout(location = 1) in flat int in_layer;
+layout(location = 2) in flat float in_opacity;
+layout(location = 3) in flat vec4 in_crop; //xy: top-left, zw: bottom-right
+
+layout(location = 0) out vec4 out_color;
+
+//Frame descriptor sets
+frame_descriptor_set(2)
+frame_descriptor_set(3)
+
+
+
+void main() {
+	//The layer is uniform for each draw call
+	if(in_layer == LAYER_PREV) {
+		out_color = frame_texture(prevSampleMode, frame_sampler(2), in_texCoord);
+	} else {
+		out_color = frame_texture(postSampleMode, frame_sampler(3), in_texCoord);
+	}
+
+	//Cropped areas are transparent. Texture coordinates start at the top-left corner
+	const bool cropped = any(lessThan(in_texCoord, in_crop.xy)) || any(greaterThan(in_texCoord, in_crop.zw));
+	out_color.a *= cropped ? 0.0f : in_opacity;
+	out_color = frame_premultiply_alpha(out_color);
+}
@@ -0,0 +1,129 @@
+#version 450
+
+//Specialization constants and normal constants
+const int TRACK_POSITION_X		= 0;
+const int TRACK_POSITION_Y		= 1;
+const int TRACK_POSITION_Z		= 2;
+const int TRACK_ROTATION_AXIS_X	= 3;
+const int TRACK_ROTATION_AXIS_Y	= 4;
+const int TRACK_ROTATION_AXIS_Z	= 5;
+const int TRACK_ROTATION_ANGLE	= 6;
+const int TRACK_SCALE_X			= 7;
+const int TRACK_SCALE_Y			= 8;
+const int TRACK_SCALE_Z			= 9;
+const int TRACK_OPACITY			= 10;
+const int TRACK_CROP_LEFT		= 11;
+const int TRACK_CROP_RIGHT		= 12;
+const int TRACK_CROP_TOP		= 13;
+const int TRACK_CROP_BOTTOM		= 14;
+const int TRACK_COUNT			= 15;
+
+const float PI 					= 3.14159265359f;
+
+layout(constant_id = 0) const int sampleCount = 256;
+
+//Vertex I/O
+layout(location = 0) in vec4 in_position;
+layout(location = 1) in vec2 in_texCoord;
+
+layout(location = 0) out vec2 out_texCoord;
+layout(location = 1) out flat int out_layer;
+layout(location = 2) out flat float out_opacity;
+layout(location = 3) out flat vec4 out_crop; //xy: top-left, zw: bottom-right
+
+//Uniform buffers
+layout(set = 0, binding = 0) uniform ProjectionBlock {
+	mat4 projectionMtx;
+};
+
+layout(set = 1, binding = 0) uniform ModelBlock {
+	mat4 modelMtx;
+};
+
+layout(set = 1, binding = 1) uniform DVEDataBlock {
+	vec2 	viewportSize;
+	float 	progress;
+	float 	opacity;
+};
+
+//Sample table of the move. Each layer has sampleCount+1 
+//samples, each one with all the tracks
+layout(set = 1, binding = 2) readonly buffer SampleBlock {
+	float 	samples[];
+};
+
+
+
+float evaluateTrack(in int layer, in int track) {
+	//Same as DVEMove::evaluate()
+	const float position = clamp(progress, 0.0f, 1.0f) * sampleCount;
+	const int index = min(int(position), sampleCount - 1);
+	const float fraction = position - index;
+
+	const int base = (layer*(sampleCount + 1) + index)*TRACK_COUNT + track;
+	return mix(samples[base], samples[base + TRACK_COUNT], fraction);
+}
+
+mat4 calculateMoveMatrix(in int layer) {
+	//Positions are expressed relative to the viewport size
+	const vec3 position = vec3(
+		evaluateTrack(layer, TRACK_POSITION_X) * viewportSize.x,
+		evaluateTrack(layer, TRACK_POSITION_Y) * viewportSize.y,
+		evaluateTrack(layer, TRACK_POSITION_Z)
+	);
+
+	//Obtain the rotation with Rodrigues' formula. 
+	//Fallback to the identity if the axis is null
+	const vec3 axis = vec3(
+		evaluateTrack(layer, TRACK_ROTATION_AXIS_X),
+		evaluateTrack(layer, TRACK_ROTATION_AXIS_Y),
+		evaluateTrack(layer, TRACK_ROTATION_AXIS_Z)
+	);
+	const float axisLength = length(axis);
+	mat3 rotation = mat3(1.0f);
+	if(axisLength > 0.0f) {
+		const vec3 k = axis / axisLength;
+		const float theta = radians(evaluateTrack(layer, TRACK_ROTATION_ANGLE));
+		const mat3 kx = mat3(
+			0.0f, k.z, -k.y, 
+			-k.z, 0.0f, k.x, 
+			k.y, -k.x, 0.0f
+		);
+		rotation += sin(theta)*kx + (1.0f - cos(theta))*(kx*kx);
+	}
+
+	const vec3 scale = vec3(
+		evaluateTrack(layer, TRACK_SCALE_X),
+		evaluateTrack(layer, TRACK_SCALE_Y),
+		evaluateTrack(layer, TRACK_SCALE_Z)
+	);
+
+	//Translate * Rotate * Scale
+	const mat3 rs = mat3(rotation[0]*scale.x, rotation[1]*scale.y, rotation[2]*scale.z);
+	return mat4(
+		vec4(rs[0], 0.0f),
+		vec4(rs[1], 0.0f),
+		vec4(rs[2], 0.0f),
+		vec4(position, 1.0f)
+	);
+}
+
+
+
+void main() {
+	//Each layer of the move is drawn as a instance
+	const int layer = gl_InstanceIndex;
+
+	gl_Position = projectionMtx * modelMtx * calculateMoveMatrix(layer) * in_position;
+	out_texCoord = in_texCoord;
+	out_layer = layer;
+	out_opacity = evaluateTrack(layer, TRACK_OPACITY) * opacity;
+
+	//Crop is expressed as the fraction of the frame removed from each side
+	out_crop = vec4(
+		evaluateTrack(layer, TRACK_CROP_LEFT),
+		evaluateTrack(layer, TRACK_CROP_TOP),
+		1.0f - evaluateTrack(layer, TRACK_CROP_RIGHT),
+		1.0f - evaluateTrack(layer, TRACK_CROP_BOTTOM)
+	);
+}
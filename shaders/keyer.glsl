@@ -0,0 +1,225 @@
+//Shared by keyer.frag and its variants. When KEYER_MATTE is defined,
+//the chroma key alpha is read from the matte computed by keyer_matte.comp
+//When KEYER_BOX is defined, the crop is given by the instanced boxes of
+//keyer_box.vert instead of Bézier outlines. The mask is a greyscale
+//image aligned with the key frame, which multiplies the alpha
+
+#include "color_utils.glsl"
+#include "frame.glsl"
+#include "bezier.glsl"
+#include "chroma_key.glsl"
+#include "color_lut.glsl"
+
+struct LumaKeyParameters {
+	float minThreshHold;
+	float maxThreshHold;
+};
+
+//Specialization constants and normal constants
+const int LINEAR_KEY_DISABLED 	= 0x00;
+const int LINEAR_KEY_KEY_R 		= 0x01;
+const int LINEAR_KEY_KEY_G 		= 0x02;
+const int LINEAR_KEY_KEY_B 		= 0x03;
+const int LINEAR_KEY_KEY_A 		= 0x04;
+const int LINEAR_KEY_KEY_Y 		= 0x05;
+const int LINEAR_KEY_FILL_R 	= 0x06;
+const int LINEAR_KEY_FILL_G 	= 0x07;
+const int LINEAR_KEY_FILL_B 	= 0x08;
+const int LINEAR_KEY_FILL_A 	= 0x09;
+const int LINEAR_KEY_FILL_Y 	= 0x0A;
+
+const int DEBUG_VIEW_NONE 		= 0x00;
+const int DEBUG_VIEW_MATTE 		= 0x01;
+const int DEBUG_VIEW_FILL 		= 0x02;
+
+layout(constant_id = 0) const int sampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+layout(constant_id = 1) const bool sameKeyFill = false;
+layout(constant_id = 2) const bool lumaKeyEnabled = false;
+layout(constant_id = 3) const bool chromaKeyEnabled = false;
+layout(constant_id = 4) const int linearKeyType = 0;
+layout(constant_id = 5) const bool colorLUTEnabled = false;
+layout(constant_id = 6) const int debugView = DEBUG_VIEW_NONE;
+layout(constant_id = 7) const bool maskEnabled = false;
+
+//Vertex I/O
+layout(location = 0) in vec2 in_texCoord;
+#ifdef KEYER_BOX
+layout(location = 1) in vec2 in_boxPosition;
+layout(location = 2) flat in vec2 in_boxHalfSize;
+layout(location = 3) flat in vec4 in_boxRadii;
+#else
+layout(location = 1) in vec3 in_klm;
+#endif
+
+layout(location = 0) out vec4 out_color;
+
+//Uniform buffers
+layout(set = 1, binding = 1) uniform LayerDataBlock {
+	LumaKeyParameters 		lumaKeyparameters;
+	ChromaKeyParameters 	chromaKeyparameters;
+	float 					opacity;
+	vec3					despillColor;
+	float					despillStrength;
+	vec3					colorLUTScale;
+	vec3					colorLUTOffset;
+	float					feather;
+};
+
+//Frame descriptor sets
+frame_descriptor_set(2)
+frame_descriptor_set(3)
+
+//Colour LUT. When disabled, an identity table is bound
+layout(set = 4, binding = 0) uniform sampler3D colorLUT;
+
+//Alpha mask. When disabled, a single opaque pixel is bound
+layout(set = 5, binding = 0) uniform sampler2D mask;
+
+#ifdef KEYER_MATTE
+layout(set = 6, binding = 0) uniform sampler2D matte;
+#endif
+
+
+
+float lumaKeyAlpha(in LumaKeyParameters parameters, in vec3 keyColor) {
+	//Calculate the luminance according to the YUV color system
+	const float luminance = getLuminance(keyColor);
+
+	//Determine if the values are inverted
+	const bool inverted = parameters.minThreshHold < 0.0f;
+
+	const float minThreshHold = abs(parameters.minThreshHold);
+	const float maxThreshHold = abs(parameters.maxThreshHold);
+
+	//Only use smoothstep if its behaviour is defined
+	const float alpha = parameters.minThreshHold < parameters.maxThreshHold ?
+		smoothstep(minThreshHold, maxThreshHold, luminance) :
+		step(minThreshHold, luminance) ;
+
+	//Invert the result if necessary
+	return inverted ? 1.0 - alpha : alpha;
+}
+
+vec3 despill(in vec3 keyColor, in float strength, in vec3 fillColor) {
+	//Limit the key component to the average of the rest of
+	//components. For green, this is g = min(g, (r+b)/2). The
+	//removed amount is added back as gray to keep the luminance
+	const vec3 others = vec3(1.0f) - keyColor;
+	const float keyLevel = dot(fillColor, keyColor) / dot(keyColor, keyColor);
+	const float othersLevel = dot(fillColor, others) / max(dot(others, others), 1e-6f);
+	const float spill = strength * max(keyLevel - othersLevel, 0.0f);
+
+	return fillColor - spill*keyColor + spill*getLuminance(keyColor);
+}
+
+float linearKeyAlpha(in int type, in vec4 keyColor, in vec4 fillColor) {
+	float result;
+
+	switch(abs(type)) {
+	case LINEAR_KEY_KEY_R:	result = keyColor.r;					break;
+	case LINEAR_KEY_KEY_G:	result = keyColor.g;					break;
+	case LINEAR_KEY_KEY_B:	result = keyColor.b;					break;
+	case LINEAR_KEY_KEY_A:	result = keyColor.a;					break;
+	case LINEAR_KEY_KEY_Y:	result = getLuminance(keyColor.rgb);	break;
+
+	case LINEAR_KEY_FILL_R:	result = fillColor.r;					break;
+	case LINEAR_KEY_FILL_G:	result = fillColor.g;					break;
+	case LINEAR_KEY_FILL_B:	result = fillColor.b;					break;
+	case LINEAR_KEY_FILL_A:	result = fillColor.a;					break;
+	case LINEAR_KEY_FILL_Y:	result = getLuminance(fillColor.rgb);	break;
+
+	default:				result = 1.0f;							break;
+	}
+
+	return (type < 0) ? (1.0f - result) : result;
+}
+
+
+
+#ifdef KEYER_BOX
+float boxSignedDistance(in vec2 position, in vec2 halfSize, in vec4 radii) {
+	//Select the radius of this quadrant
+	const vec2 sideRadii = position.x > 0.0f ? radii.xw : radii.yz;
+	const float radius = position.y > 0.0f ? sideRadii.x : sideRadii.y;
+
+	//Evaluate the SDF
+	const vec2 q = abs(position) - halfSize + radius;
+	const float dist = min(max(q.x, q.y), 0.0f) + length(max(q, 0.0f)) - radius;
+
+	//Express it in pixels, as the Bézier distance
+	const float gradient = length(vec2(dFdx(dist), dFdy(dist)));
+	return dist / max(gradient, 1e-6f);
+}
+#endif
+
+void main() {
+	//Obtain th signed distance to the curve
+#ifdef KEYER_BOX
+	const float sDist = boxSignedDistance(in_boxPosition, in_boxHalfSize, in_boxRadii);
+#else
+	const float sDist = bezier3_signed_distance(in_klm);
+#endif
+
+	//Analytic coverage of the edge. It spans one pixel plus the feather
+	const float sDistOpacity = clamp(0.5f - sDist / (1.0f + feather), 0.0f, 1.0f);
+	if(sDistOpacity <= 0.0f) {
+		//Discard everything which is outside
+		discard;
+	}
+
+	//Sample the key frame
+	const vec4 keyColor = frame_texture(sampleMode, frame_sampler(2), in_texCoord);
+
+	//Sample the fill frame
+	vec4 fillColor; 
+	if(sameKeyFill) {
+		fillColor = keyColor;
+	} else {
+		fillColor = frame_texture(sampleMode, frame_sampler(3), in_texCoord);
+	}
+
+	//Apply all alpha-s
+	float alpha = opacity * sDistOpacity;
+	if(lumaKeyEnabled) {
+		alpha *= lumaKeyAlpha(lumaKeyparameters, keyColor.rgb);
+	}
+	if(chromaKeyEnabled) {
+#ifdef KEYER_MATTE
+		alpha *= texture(matte, in_texCoord).r;
+#else
+		alpha *= chromaKeyAlpha(chromaKeyparameters, keyColor.rgb);
+#endif
+		fillColor.rgb = despill(despillColor, despillStrength, fillColor.rgb);
+	}
+	if(linearKeyType != LINEAR_KEY_DISABLED) {
+		alpha *= linearKeyAlpha(linearKeyType, keyColor, fillColor);
+	} 
+	if(maskEnabled) {
+		alpha *= texture(mask, in_texCoord).r;
+	}
+
+	//Grade the fill
+	if(colorLUTEnabled) {
+		fillColor.rgb = color_lut_apply(colorLUT, colorLUTScale, colorLUTOffset, fillColor.rgb);
+	}
+
+	//Compute the final color
+	switch(debugView) {
+	case DEBUG_VIEW_MATTE:
+		//Opaque greyscale representation of the key signal
+		out_color = vec4(vec3(alpha), 1.0f);
+		break;
+
+	case DEBUG_VIEW_FILL:
+		//Fill without keying, only cropped
+		out_color = vec4(fillColor.rgb, sDistOpacity);
+		out_color = frame_premultiply_alpha(out_color);
+		break;
+
+	default:
+		out_color = vec4(fillColor.rgb, alpha); 
+		out_color = frame_premultiply_alpha(out_color);
+		break;
+	}
+}
+ 
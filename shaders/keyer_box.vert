@@ -0,0 +1,39 @@
+#version 450
+
+//Instanced variant of keyer.vert. Each instance is a box, which is 
+//expanded into a quad. Edges are evaluated in the fragment shader
+
+//Instance I/O
+layout(location = 0) in vec4 in_rect; //xy: center, zw: size
+layout(location = 1) in vec4 in_radii;
+
+layout(location = 0) out vec2 out_texCoord;
+layout(location = 1) out vec2 out_boxPosition;
+layout(location = 2) flat out vec2 out_boxHalfSize;
+layout(location = 3) flat out vec4 out_boxRadii;
+
+//Uniform buffers
+layout(set = 0, binding = 0) uniform ProjectionBlock {
+	mat4 projectionMtx;
+};
+
+layout(set = 1, binding = 0) uniform ModelBlock {
+	mat4 modelMtx;
+	vec4 texCoordTransform; //xy: scale, zw: offset
+	float boxMargin; //Antialiasing and feather margin
+};
+
+
+void main() {
+	//Obtain the corner of the triangle strip
+	const vec2 corner = 2.0f*vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1) - 1.0f;
+	const vec2 halfSize = 0.5f * in_rect.zw;
+	const vec2 boxPosition = corner * (halfSize + boxMargin);
+	const vec2 position = in_rect.xy + boxPosition;
+
+	gl_Position = projectionMtx * modelMtx * vec4(position, 0.0f, 1.0f);
+	out_texCoord = position*texCoordTransform.xy + texCoordTransform.zw;
+	out_boxPosition = boxPosition;
+	out_boxHalfSize = halfSize;
+	out_boxRadii = min(in_radii, min(halfSize.x, halfSize.y));
+}
@@ -0,0 +1,7 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#define KEYER_BOX
+#define KEYER_MATTE
+#include "keyer.glsl"
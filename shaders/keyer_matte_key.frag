@@ -0,0 +1,23 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#include "frame.glsl"
+
+//Converts the key frame into an image owned by the keyer, so that the
+//matte pre-pass can read it. Frame descriptor sets are only visible to
+//the fragment stage, so they can not be used by the compute shader
+layout(constant_id = 0) const int sampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+
+//Vertex I/O
+layout(location = 0) in vec2 in_texCoord;
+
+layout(location = 0) out vec4 out_color;
+
+//Frame descriptor sets
+frame_descriptor_set(0)
+
+
+void main() {
+	out_color = frame_texture(sampleMode, frame_sampler(0), in_texCoord);
+}
@@ -0,0 +1,13 @@
+#version 450
+
+//Draws a triangle which covers the whole framebuffer,
+//so that no vertex buffer is needed
+
+//Vertex I/O
+layout(location = 0) out vec2 out_texCoord;
+
+
+void main() {
+	out_texCoord = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+	gl_Position = vec4(out_texCoord * 2.0f - 1.0f, 0.0f, 1.0f);
+}
@@ -0,0 +1,70 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#include "frame.glsl"
+
+//Specialization constants and normal constants
+const int EFFECT_MIX 			= 0x00;
+const int EFFECT_ADD 			= 0x01;
+const int EFFECT_FADE 			= 0x02;
+
+layout(constant_id = 0) const int prevSampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+layout(constant_id = 1) const int postSampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+layout(constant_id = 2) const int effect = EFFECT_MIX;
+
+//Vertex I/O
+layout(location = 0) in vec2 in_texCoord;
+
+layout(location = 0) out vec4 out_color;
+
+//Uniform buffers
+layout(set = 1, binding = 1) uniform MixDataBlock {
+	float 	progress;
+	float 	opacity;
+};
+
+//Frame descriptor sets
+frame_descriptor_set(2)
+frame_descriptor_set(3)
+
+
+
+vec2 effectWeights(in float x) {
+	vec2 result;
+
+	switch(effect) {
+	case EFFECT_MIX:
+		//Complementary gains
+		result = vec2(1.0f - x, x);
+		break;
+	case EFFECT_ADD:
+		//Both are fully added at the middle
+		result = min(2.0f*vec2(1.0f - x, x), vec2(1.0f));
+		break;
+	case EFFECT_FADE:
+		//Through black
+		result = max(vec2(1.0f - 2.0f*x, 2.0f*x - 1.0f), vec2(0.0f));
+		break;
+	default:
+		result = vec2(1.0f, 0.0f);
+		break;
+	}
+
+	return result;
+}
+
+
+
+void main() {
+	//Obtain the gain of each frame
+	const vec2 weights = effectWeights(progress);
+
+	//Sample both frames
+	const vec4 prevColor = frame_premultiply_alpha(frame_texture(prevSampleMode, frame_sampler(2), in_texCoord));
+	const vec4 postColor = frame_premultiply_alpha(frame_texture(postSampleMode, frame_sampler(3), in_texCoord));
+
+	//Add them with their respective gains. As the colors are
+	//premultiplied, the opacity scales all the components
+	out_color = (weights.x*prevColor + weights.y*postColor) * opacity;
+}
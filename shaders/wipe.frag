@@ -0,0 +1,151 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#include "frame.glsl"
+
+//Specialization constants and normal constants
+const int PATTERN_BARS 			= 0x00;
+const int PATTERN_BOX 			= 0x01;
+const int PATTERN_CIRCLE 		= 0x02;
+const int PATTERN_DIAMOND 		= 0x03;
+const int PATTERN_CLOCK 		= 0x04;
+const int PATTERN_SHAPE 		= 0x05;
+
+const int MAX_SHAPE_VERTICES	= 128;
+const float PI 					= 3.14159265359f;
+
+layout(constant_id = 0) const int prevSampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+layout(constant_id = 1) const int postSampleMode = frame_SAMPLE_MODE_PASSTHOUGH;
+layout(constant_id = 2) const int pattern = PATTERN_BARS;
+
+//Vertex I/O
+layout(location = 0) in vec2 in_texCoord;
+
+layout(location = 0) out vec4 out_color;
+
+//Uniform buffers
+layout(set = 1, binding = 1) uniform WipeDataBlock {
+	vec2 	aspect;
+	vec2 	direction;
+	float 	progress;
+	float 	border;
+	float 	barCount;
+	float 	shapeScale;
+	int 	shapeVertexCount;
+	float 	opacity;
+};
+
+layout(set = 1, binding = 2) uniform ShapeDataBlock {
+	vec4 	shapeVertices[MAX_SHAPE_VERTICES];
+};
+
+//Frame descriptor sets
+frame_descriptor_set(2)
+frame_descriptor_set(3)
+
+
+
+//All the patterns are expressed as a scalar field which is 0 where 
+//the wipe starts and 1 at the last point to be revealed
+
+float barsField(in vec2 pos) {
+	//Project the position over the wipe direction
+	const float halfExtent = 0.5f * dot(abs(direction), aspect);
+	const float linear = clamp(dot(pos, direction) / (2.0f*halfExtent) + 0.5f, 0.0f, 1.0f);
+
+	//Repeat it for each bar. Avoid wrapping the last one
+	const float x = linear * barCount;
+	return x - min(floor(x), barCount - 1.0f);
+}
+
+float boxField(in vec2 pos) {
+	const vec2 dist = abs(pos) / (0.5f*aspect);
+	return max(dist.x, dist.y);
+}
+
+float circleField(in vec2 pos) {
+	return length(pos) / length(0.5f*aspect);
+}
+
+float diamondField(in vec2 pos) {
+	const vec2 dist = abs(pos);
+	return (dist.x + dist.y) / (0.5f*(aspect.x + aspect.y));
+}
+
+float clockField(in vec2 pos) {
+	//Angle measured clockwise from 12 o'clock. Y axis points down
+	const float angle = atan(pos.x, -pos.y);
+	return fract(angle / (2.0f*PI) + 1.0f);
+}
+
+float shapeField(in vec2 pos) {
+	const float dist = length(pos);
+	if(dist <= 0.0f) {
+		return 0.0f;
+	}
+
+	//Find the distance to the contour along the ray
+	//from the center towards this position
+	const vec2 dir = pos / dist;
+	float radius = 0.0f;
+	for(int i = 0; i < shapeVertexCount; ++i) {
+		const vec2 a = shapeVertices[i].xy;
+		const vec2 b = shapeVertices[(i + 1) % shapeVertexCount].xy;
+		const vec2 edge = b - a;
+
+		const float den = dir.x*edge.y - dir.y*edge.x;
+		if(den != 0.0f) {
+			const float t = (a.x*edge.y - a.y*edge.x) / den; //Along the ray
+			const float s = (a.x*dir.y - a.y*dir.x) / den; //Along the edge
+			if(t > 0.0f && s >= 0.0f && s <= 1.0f) {
+				radius = max(radius, t);
+			}
+		}
+	}
+
+	//If not found, the center is outside of the shape. 
+	//Consider this position as the last one
+	return (radius > 0.0f) ? (dist / radius * shapeScale) : 1.0f;
+}
+
+float patternField(in vec2 pos) {
+	float result;
+
+	switch(pattern) {
+	case PATTERN_BARS:		result = barsField(pos);	break;
+	case PATTERN_BOX:		result = boxField(pos);		break;
+	case PATTERN_CIRCLE:	result = circleField(pos);	break;
+	case PATTERN_DIAMOND:	result = diamondField(pos);	break;
+	case PATTERN_CLOCK:		result = clockField(pos);	break;
+	case PATTERN_SHAPE:		result = shapeField(pos);	break;
+	default:				result = 0.0f;				break;
+	}
+
+	return result;
+}
+
+
+
+void main() {
+	//Evaluate the pattern at this position
+	const vec2 pos = (in_texCoord - vec2(0.5f)) * aspect;
+	const float field = patternField(pos);
+
+	//Calculate the weight of the post frame. Extend the threshold 
+	//so that the soft border is out of sight at the both ends. 
+	//Only use smoothstep if its behaviour is defined
+	const float threshold = progress * (1.0f + border);
+	const float weight = border > 0.0f ?
+		1.0f - smoothstep(threshold - border, threshold, field) :
+		1.0f - step(threshold, field) ;
+
+	//Sample both frames
+	const vec4 prevColor = frame_texture(prevSampleMode, frame_sampler(2), in_texCoord);
+	const vec4 postColor = frame_texture(postSampleMode, frame_sampler(3), in_texCoord);
+
+	//Compute the final color
+	out_color = mix(prevColor, postColor, weight);
+	out_color.a *= opacity;
+	out_color = frame_premultiply_alpha(out_color);
+}
@@ -0,0 +1,132 @@
+#include <AnimationNotifier.h>
+
+#include <Control/Message.h>
+
+#include <zuazo/StringConversions.h>
+
+namespace Cenital {
+
+using namespace Zuazo;
+
+AnimationNotifier::AnimationNotifier(	Control::Controller& controller,
+										Mixer& mixer )
+	: ViewBase(controller)
+	, m_mixer(mixer)
+	, m_finished()
+	, m_refreshPending(false)
+	, m_invalidateCallback()
+{
+	//Get notified when the animations of the existing keyers end
+	for(ZuazoBase& element : mixer.listElements(typeid(Overlays::Keyer))) {
+		installCallback(element);
+	}
+	for(ZuazoBase& element : mixer.listElements(typeid(MixEffect))) {
+		installCallback(element);
+	}
+}
+
+
+
+void AnimationNotifier::setInvalidateCallback(InvalidateCallback cbk) {
+	m_invalidateCallback = std::move(cbk);
+}
+
+const AnimationNotifier::InvalidateCallback& AnimationNotifier::getInvalidateCallback() const noexcept {
+	return m_invalidateCallback;
+}
+
+
+
+void AnimationNotifier::invalidate() {
+	//Only request a refresh once, as several animations may end
+	//on the same frame
+	if(!m_refreshPending && m_invalidateCallback) {
+		m_refreshPending = true;
+		m_invalidateCallback(*this);
+	}
+}
+
+void AnimationNotifier::refresh() {
+	m_refreshPending = false;
+
+	//The end of the animation is broadcasted as if it was stopped
+	//by a command, so that only the start and end are notified.
+	//Keyers are looked up again, as they may have been removed
+	for(auto& finished : m_finished) {
+		auto* element = m_mixer.get().getElement(finished.element);
+
+		if(!element) {
+			continue;
+		} else if(finished.slot == MixEffect::OverlaySlot::none) {
+			if(typeid(*element) == typeid(Overlays::Keyer)) {
+				getController().broadcast(Control::Message(
+					Control::Message::Type::broadcast,
+					{ "config", std::move(finished.element), "animation:stop" }
+				));
+			}
+		} else if(typeid(*element) == typeid(MixEffect)) {
+			const auto& mixEffect = static_cast<const MixEffect&>(*element);
+			const bool exists = 
+				finished.index < mixEffect.getOverlayCount(finished.slot) &&
+				dynamic_cast<const Overlays::Keyer*>(mixEffect.getOverlay(finished.slot, finished.index)) ;
+
+			if(exists) {
+				getController().broadcast(Control::Message(
+					Control::Message::Type::broadcast,
+					{ 
+						"config", std::move(finished.element), 
+						(finished.slot == MixEffect::OverlaySlot::upstream) ? "us-overlay" : "ds-overlay",
+						"config", std::string(toString(finished.index)), 
+						"animation:stop" 
+					}
+				));
+			}
+		}
+	}
+
+	m_finished.clear();
+}
+
+
+
+void AnimationNotifier::update(const Control::Message& msg) {
+	const auto& tokens = msg.getPayload();
+
+	//New keyers and M/Es need to notify us when their animations end
+	if(tokens.size() > 2 && tokens.front() == "add") {
+		auto* element = m_mixer.get().getElement(tokens[2]);
+		if(element) {
+			installCallback(*element);
+		}
+	}
+}
+
+
+
+void AnimationNotifier::installCallback(Overlays::Keyer& keyer) {
+	keyer.setAnimationCallback(
+		[this] (Overlays::Keyer& keyer) {
+			m_finished.push_back(FinishedAnimation{ keyer.getName(), MixEffect::OverlaySlot::none, 0 });
+			invalidate();
+		}
+	);
+}
+
+void AnimationNotifier::installCallback(MixEffect& mixEffect) {
+	mixEffect.setOverlayAnimationCallback(
+		[this] (MixEffect& mixEffect, MixEffect::OverlaySlot slot, size_t index) {
+			m_finished.push_back(FinishedAnimation{ mixEffect.getName(), slot, index });
+			invalidate();
+		}
+	);
+}
+
+void AnimationNotifier::installCallback(Zuazo::ZuazoBase& element) {
+	if(typeid(element) == typeid(Overlays::Keyer)) {
+		installCallback(static_cast<Overlays::Keyer&>(element));
+	} else if(typeid(element) == typeid(MixEffect)) {
+		installCallback(static_cast<MixEffect&>(element));
+	}
+}
+
+}
\ No newline at end of file
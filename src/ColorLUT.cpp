@@ -0,0 +1,448 @@
+#include <ColorLUT.h>
+
+#include <WeakCache.h>
+
+#include <zuazo/Utils/StaticId.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Cenital {
+
+using namespace Zuazo;
+
+/*
+ * ColorLUT
+ */
+
+static constexpr uint32_t MAX_LUT_SIZE = 256; //As stated by the .cube specification
+
+ColorLUT::ColorLUT(	std::string path,
+					std::string title,
+					uint32_t size,
+					Math::Vec3f domainMin,
+					Math::Vec3f domainMax,
+					std::vector<Math::Vec3f> table )
+	: m_path(std::move(path))
+	, m_title(std::move(title))
+	, m_size(size)
+	, m_domainMin(domainMin)
+	, m_domainMax(domainMax)
+	, m_table(std::move(table))
+{
+	assert(m_table.size() == static_cast<size_t>(m_size)*m_size*m_size);
+}
+
+
+
+const std::string& ColorLUT::getPath() const noexcept {
+	return m_path;
+}
+
+const std::string& ColorLUT::getTitle() const noexcept {
+	return m_title;
+}
+
+uint32_t ColorLUT::getSize() const noexcept {
+	return m_size;
+}
+
+const Math::Vec3f& ColorLUT::getDomainMin() const noexcept {
+	return m_domainMin;
+}
+
+const Math::Vec3f& ColorLUT::getDomainMax() const noexcept {
+	return m_domainMax;
+}
+
+const std::vector<Math::Vec3f>& ColorLUT::getTable() const noexcept {
+	return m_table;
+}
+
+
+
+static Math::Vec3f readVec3(std::istream& is, std::string_view keyword) {
+	Math::Vec3f result;
+	if(!(is >> result.x >> result.y >> result.z)) {
+		throw std::runtime_error("Invalid " + std::string(keyword) + " in .cube file");
+	}
+	return result;
+}
+
+std::shared_ptr<const ColorLUT> ColorLUT::parse(std::istream& is, std::string path) {
+	std::string title;
+	uint32_t size = 0;
+	Math::Vec3f domainMin(0.0f, 0.0f, 0.0f);
+	Math::Vec3f domainMax(1.0f, 1.0f, 1.0f);
+	std::vector<Math::Vec3f> table;
+
+	std::string line;
+	while(std::getline(is, line)) {
+		//Ignore the comments
+		const auto comment = line.find('#');
+		if(comment != std::string::npos) {
+			line.erase(comment);
+		}
+
+		std::istringstream iss(line);
+		std::string keyword;
+		if(!(iss >> keyword)) {
+			continue; //Empty line
+		}
+
+		if(keyword == "TITLE") {
+			const auto begin = line.find('"');
+			const auto end = line.rfind('"');
+			if(begin < end && end != std::string::npos) {
+				title = line.substr(begin + 1, end - begin - 1);
+			}
+		} else if(keyword == "LUT_3D_SIZE") {
+			if(!(iss >> size) || size < 2 || size > MAX_LUT_SIZE) {
+				throw std::runtime_error("Invalid LUT_3D_SIZE in .cube file");
+			}
+			table.reserve(static_cast<size_t>(size)*size*size);
+		} else if(keyword == "LUT_1D_SIZE") {
+			throw std::runtime_error("1D LUTs are not supported");
+		} else if(keyword == "DOMAIN_MIN") {
+			domainMin = readVec3(iss, keyword);
+		} else if(keyword == "DOMAIN_MAX") {
+			domainMax = readVec3(iss, keyword);
+		} else if(keyword == "LUT_3D_INPUT_RANGE") {
+			float min, max;
+			if(!(iss >> min >> max)) {
+				throw std::runtime_error("Invalid LUT_3D_INPUT_RANGE in .cube file");
+			}
+			domainMin = Math::Vec3f(min, min, min);
+			domainMax = Math::Vec3f(max, max, max);
+		} else {
+			//Not a keyword, so it must be a table row
+			iss.clear();
+			iss.str(line);
+			table.push_back(readVec3(iss, "table entry"));
+		}
+	}
+
+	//Validate the result
+	if(size == 0) {
+		throw std::runtime_error("Missing LUT_3D_SIZE in .cube file");
+	}
+	if(table.size() != static_cast<size_t>(size)*size*size) {
+		throw std::runtime_error("Wrong entry count in .cube file");
+	}
+	if(	domainMax.x <= domainMin.x ||
+		domainMax.y <= domainMin.y ||
+		domainMax.z <= domainMin.z )
+	{
+		throw std::runtime_error("Invalid domain in .cube file");
+	}
+
+	return std::make_shared<const ColorLUT>(
+		std::move(path),
+		std::move(title),
+		size,
+		domainMin,
+		domainMax,
+		std::move(table)
+	);
+}
+
+std::shared_ptr<const ColorLUT> ColorLUT::load(std::string_view path) {
+	//The same table is shared while it is in use
+	static FileCache<ColorLUT> cache;
+
+	return cache.get(
+		path,
+		[path] (const std::filesystem::path& canonicalPath) -> std::shared_ptr<const ColorLUT> {
+			std::ifstream file(canonicalPath);
+			if(!file) {
+				throw std::runtime_error("Could not open " + canonicalPath.string());
+			}
+
+			return parse(file, std::string(path));
+		}
+	);
+}
+
+std::shared_ptr<const ColorLUT> ColorLUT::identity() {
+	static const std::shared_ptr<const ColorLUT> result = [] () {
+		//With 2 entries per axis the trilinear interpolation is exact
+		constexpr uint32_t SIZE = 2;
+		std::vector<Math::Vec3f> table;
+		table.reserve(SIZE*SIZE*SIZE);
+
+		for(uint32_t b = 0; b < SIZE; ++b) {
+			for(uint32_t g = 0; g < SIZE; ++g) {
+				for(uint32_t r = 0; r < SIZE; ++r) {
+					table.emplace_back(
+						static_cast<float>(r) / (SIZE - 1),
+						static_cast<float>(g) / (SIZE - 1),
+						static_cast<float>(b) / (SIZE - 1)
+					);
+				}
+			}
+		}
+
+		return std::make_shared<const ColorLUT>(
+			"",
+			"Identity",
+			SIZE,
+			Math::Vec3f(0.0f, 0.0f, 0.0f),
+			Math::Vec3f(1.0f, 1.0f, 1.0f),
+			std::move(table)
+		);
+	}();
+
+	return result;
+}
+
+
+
+/*
+ * ColorLUT::Texture
+ */
+
+//Sampled images and linear filtering are mandatory for this format. A
+//floating point format is used, so that HDR tables with values outside
+//[0, 1] are not clamped
+static constexpr vk::Format LUT_FORMAT = vk::Format::eR16G16B16A16Sfloat;
+using PackedColor = std::array<uint16_t, 4>;
+
+static uint16_t toHalf(float value) noexcept {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000U);
+	const auto exponent = static_cast<int32_t>((bits >> 23) & 0xFFU) - 127 + 15;
+	auto mantissa = bits & 0x7FFFFFU;
+
+	if(exponent >= 0x1F) {
+		//NaNs are kept, too large values saturate to the largest value
+		const bool isNaN = ((bits >> 23) & 0xFFU) == 0xFFU && mantissa;
+		return sign | (isNaN ? 0x7E00U : 0x7BFFU);
+	} else if(exponent <= 0) {
+		//Subnormal or zero
+		if(exponent < -10) {
+			return sign;
+		}
+
+		mantissa |= 0x800000U;
+		const auto shift = 14 - exponent;
+		return sign | static_cast<uint16_t>((mantissa + (1U << (shift - 1))) >> shift);
+	} else {
+		//Rounding may carry into the exponent, which is correct
+		return sign | static_cast<uint16_t>((exponent << 10) + ((mantissa + 0x1000U) >> 13));
+	}
+}
+
+static PackedColor packColor(const Math::Vec3f& color) noexcept {
+	return PackedColor{ 
+		toHalf(color.x), 
+		toHalf(color.y), 
+		toHalf(color.z), 
+		toHalf(1.0f) 
+	};
+}
+
+static vk::UniqueImage createImage(const Graphics::Vulkan& vulkan, uint32_t size) {
+	const vk::ImageCreateInfo createInfo(
+		{},													//Flags
+		vk::ImageType::e3D,									//Image type
+		LUT_FORMAT,											//Format
+		vk::Extent3D(size, size, size),						//Extent
+		1, 1,												//Mip levels and array layers
+		vk::SampleCountFlagBits::e1,						//Sample count
+		vk::ImageTiling::eOptimal,							//Tiling
+		vk::ImageUsageFlagBits::eTransferDst |
+		vk::ImageUsageFlagBits::eSampled,					//Usage
+		vk::SharingMode::eExclusive,						//Sharing mode
+		0, nullptr,											//Queue family indices
+		vk::ImageLayout::eUndefined							//Initial layout
+	);
+
+	return vulkan.getDevice().createImageUnique(createInfo, nullptr, vulkan.getDispatcher());
+}
+
+static vk::UniqueDeviceMemory allocateImageMemory(const Graphics::Vulkan& vulkan, vk::Image image) {
+	const auto& dispatcher = vulkan.getDispatcher();
+	const auto device = vulkan.getDevice();
+
+	const auto requirements = device.getImageMemoryRequirements(image, dispatcher);
+	auto result = vulkan.allocateMemory(requirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+	device.bindImageMemory(image, *result, 0, dispatcher);
+
+	return result;
+}
+
+static vk::UniqueImageView createImageView(const Graphics::Vulkan& vulkan, vk::Image image) {
+	const vk::ImageViewCreateInfo createInfo(
+		{},													//Flags
+		image,												//Image
+		vk::ImageViewType::e3D,								//View type
+		LUT_FORMAT,											//Format
+		vk::ComponentMapping(),								//Swizzle
+		vk::ImageSubresourceRange(
+			vk::ImageAspectFlagBits::eColor,				//Aspect
+			0, 1, 0, 1										//Mip levels and array layers
+		)
+	);
+
+	return vulkan.getDevice().createImageViewUnique(createInfo, nullptr, vulkan.getDispatcher());
+}
+
+static vk::UniqueSampler createSampler(const Graphics::Vulkan& vulkan) {
+	//Clamping to the edge also clamps the colors out of the domain
+	const vk::SamplerCreateInfo createInfo(
+		{},													//Flags
+		vk::Filter::eLinear,								//Mag filter
+		vk::Filter::eLinear,								//Min filter
+		vk::SamplerMipmapMode::eNearest,					//Mipmap mode
+		vk::SamplerAddressMode::eClampToEdge,				//U address mode
+		vk::SamplerAddressMode::eClampToEdge,				//V address mode
+		vk::SamplerAddressMode::eClampToEdge,				//W address mode
+		0.0f,												//Mip LOD bias
+		false, 1.0f,										//Anisotropy
+		false, vk::CompareOp::eNever,						//Comparison
+		0.0f, 0.0f,											//Min and max LOD
+		vk::BorderColor::eFloatOpaqueBlack,					//Border color
+		false 												//Unnormalized coordinates
+	);
+
+	return vulkan.getDevice().createSamplerUnique(createInfo, nullptr, vulkan.getDispatcher());
+}
+
+static vk::UniqueDescriptorPool createDescriptorPool(const Graphics::Vulkan& vulkan) {
+	const std::array poolSizes = {
+		vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, 1)
+	};
+
+	const vk::DescriptorPoolCreateInfo createInfo(
+		{},													//Flags
+		1,													//Descriptor set count
+		poolSizes.size(), poolSizes.data()					//Pool sizes
+	);
+
+	return vulkan.createDescriptorPool(createInfo);
+}
+
+static std::unique_ptr<TextureUpload> createUpload(	const Graphics::Vulkan& vulkan, 
+													vk::Image image,
+													const ColorLUT& lut )
+{
+	const auto& table = lut.getTable();
+	const auto size = lut.getSize();
+
+	return Utils::makeUnique<TextureUpload>(
+		vulkan,
+		image,
+		vk::Extent3D(size, size, size),
+		table.size() * sizeof(PackedColor),
+		[&table] (std::byte* data) {
+			std::transform(table.cbegin(), table.cend(), reinterpret_cast<PackedColor*>(data), packColor);
+		}
+	);
+}
+
+
+
+ColorLUT::Texture::Texture(const Graphics::Vulkan& vulkan, std::shared_ptr<const ColorLUT> lut)
+	: m_lut(std::move(lut))
+	, m_image(createImage(vulkan, m_lut->getSize()))
+	, m_memory(allocateImageMemory(vulkan, *m_image))
+	, m_imageView(createImageView(vulkan, *m_image))
+	, m_sampler(createSampler(vulkan))
+	, m_descriptorPool(createDescriptorPool(vulkan))
+	, m_descriptorSet(vulkan.allocateDescriptorSet(*m_descriptorPool, getDescriptorSetLayout(vulkan)).release())
+	, m_upload(createUpload(vulkan, *m_image, *m_lut))
+{
+
+	const vk::DescriptorImageInfo imageInfo(
+		*m_sampler,											//Sampler
+		*m_imageView,										//Image view
+		vk::ImageLayout::eShaderReadOnlyOptimal				//Layout
+	);
+
+	const vk::WriteDescriptorSet write(
+		m_descriptorSet,									//Descriptor set
+		0,													//Binding
+		0, 													//Index
+		1,													//Descriptor count
+		vk::DescriptorType::eCombinedImageSampler,			//Descriptor type
+		&imageInfo,											//Images
+		nullptr,											//Buffers
+		nullptr												//Texel buffers
+	);
+
+	vulkan.getDevice().updateDescriptorSets(write, {}, vulkan.getDispatcher());
+}
+
+
+
+const ColorLUT& ColorLUT::Texture::getColorLUT() const noexcept {
+	assert(m_lut);
+	return *m_lut;
+}
+
+vk::DescriptorSet ColorLUT::Texture::getDescriptorSet() const noexcept {
+	return m_descriptorSet;
+}
+
+void ColorLUT::Texture::releaseStaging() const {
+	if(m_upload && m_upload->isComplete()) {
+		m_upload.reset();
+	}
+}
+
+
+
+vk::DescriptorSetLayout ColorLUT::Texture::getDescriptorSetLayout(const Graphics::Vulkan& vulkan) {
+	static const Utils::StaticId id;
+	auto result = vulkan.createDescriptorSetLayout(id);
+
+	if(!result) {
+		//Create the bindings
+		const std::array bindings = {
+			vk::DescriptorSetLayoutBinding(	//Sampler binding
+				0,												//Binding
+				vk::DescriptorType::eCombinedImageSampler,		//Type
+				1,												//Count
+				vk::ShaderStageFlagBits::eFragment,				//Shader stage
+				nullptr											//Immutable samplers
+			),
+		};
+
+		const vk::DescriptorSetLayoutCreateInfo createInfo(
+			{},
+			bindings.size(), bindings.data()
+		);
+
+		result = vulkan.createDescriptorSetLayout(id, createInfo);
+	}
+
+	return result;
+}
+
+std::shared_ptr<const ColorLUT::Texture> ColorLUT::Texture::get(const Graphics::Vulkan& vulkan,
+																std::shared_ptr<const ColorLUT> lut )
+{
+	using Key = std::pair<const Graphics::Vulkan*, const ColorLUT*>;
+	static WeakCache<Key, Texture> cache;
+
+	//As the textures keep their table alive, the table 
+	//address is not reused while it is listed
+	assert(lut);
+	const Key key(&vulkan, lut.get());
+	return cache.get(
+		key,
+		[&vulkan, &lut] () -> std::shared_ptr<const Texture> {
+			return std::make_shared<const Texture>(vulkan, std::move(lut));
+		}
+	);
+}
+
+}
\ No newline at end of file
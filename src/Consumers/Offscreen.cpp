@@ -0,0 +1,635 @@
+#include <Consumers/Offscreen.h>
+
+#include <Profiling.h>
+#include <Metrics.h>
+
+#include <zuazo/Signal/DummyPad.h>
+#include <zuazo/Renderers/Compositor.h>
+#include <zuazo/Layers/VideoSurface.h>
+#include <zuazo/Graphics/Vulkan.h>
+#include <zuazo/Graphics/Frame.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <cstring>
+#include <limits>
+
+namespace Cenital::Consumers {
+
+using namespace Zuazo;
+
+static void openHelper(ZuazoBase& base, std::unique_lock<Instance>* lock) {
+	if(lock) {
+		base.asyncOpen(*lock);
+	} else {
+		base.open();
+	}
+}
+
+static void closeHelper(ZuazoBase& base, std::unique_lock<Instance>* lock) {
+	if(lock) {
+		base.asyncClose(*lock);
+	} else {
+		base.close();
+	}
+}
+
+
+
+struct OffscreenImpl {
+	class Readback {
+	public:
+		explicit Readback(const Graphics::Vulkan& vulkan)
+			: m_vulkan(vulkan)
+			, m_commandPool(createCommandPool(vulkan))
+			, m_commandBuffer(createCommandBuffer(vulkan, *m_commandPool))
+			, m_fence(vulkan.createFence())
+			, m_buffer()
+			, m_memory()
+			, m_capacity(0)
+			, m_data()
+		{
+		}
+
+		Readback(const Readback& other) = delete;
+		Readback(Readback&& other) = default;
+		~Readback() = default;
+
+		Readback& operator=(const Readback& other) = delete;
+
+		//Only single plane colour images in a known packed format can
+		//be downloaded. Compositors produce these, but planar or
+		//multi-planar (YCbCr) formats would need a copy per aspect
+		static bool isSupported(const Graphics::Frame& frame) noexcept {
+			const auto planes = frame.getImage().getPlanes();
+			return planes.size() == 1 && getTexelSize(planes.front().getFormat()) > 0;
+		}
+
+		Utils::BufferView<const std::byte> download(const Graphics::Frame& frame) {
+			assert(isSupported(frame));
+			const auto& plane = frame.getImage().getPlanes().front();
+			const auto& dispatcher = m_vulkan.getDispatcher();
+			const auto device = m_vulkan.getDevice();
+
+			const auto extent = plane.getExtent();
+			const vk::DeviceSize size = 
+				static_cast<vk::DeviceSize>(extent.width) * extent.height * extent.depth * 
+				getTexelSize(plane.getFormat());
+			reserve(size);
+
+			const vk::BufferImageCopy region(
+				0,													//Buffer offset
+				0, 0,												//Buffer row length and height (tight)
+				vk::ImageSubresourceLayers(
+					vk::ImageAspectFlagBits::eColor,				//Aspect
+					0, 0, 1											//Mip level, first layer and layer count
+				),
+				vk::Offset3D(0, 0, 0),								//Image offset
+				extent												//Image extent
+			);
+
+			//Record the transfer. The compositor leaves its frames on the 
+			//shader read layout, so transition them back and forth around 
+			//the copy
+			const auto cmd = *m_commandBuffer;
+			cmd.begin(
+				vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit),
+				dispatcher
+			);
+
+			const auto image = plane.getImage();
+			const vk::ImageSubresourceRange range(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
+
+			const vk::ImageMemoryBarrier toTransfer(
+				vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eShaderRead,
+				vk::AccessFlagBits::eTransferRead,
+				vk::ImageLayout::eShaderReadOnlyOptimal,
+				vk::ImageLayout::eTransferSrcOptimal,
+				VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+				image,
+				range
+			);
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eFragmentShader,
+				vk::PipelineStageFlagBits::eTransfer,
+				{}, {}, {}, toTransfer,
+				dispatcher
+			);
+
+			cmd.copyImageToBuffer(
+				image, vk::ImageLayout::eTransferSrcOptimal,
+				*m_buffer,
+				region,
+				dispatcher
+			);
+
+			const vk::ImageMemoryBarrier toShader(
+				vk::AccessFlagBits::eTransferRead,
+				vk::AccessFlagBits::eShaderRead,
+				vk::ImageLayout::eTransferSrcOptimal,
+				vk::ImageLayout::eShaderReadOnlyOptimal,
+				VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+				image,
+				range
+			);
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eFragmentShader,
+				{}, {}, {}, toShader,
+				dispatcher
+			);
+
+			cmd.end(dispatcher);
+
+			//Submit and wait for completion. This is a blocking
+			//operation, but it keeps frames in order
+			const vk::SubmitInfo submitInfo({}, {}, cmd, {});
+			m_vulkan.getGraphicsQueue().submit(submitInfo, *m_fence, dispatcher);
+			{
+				//Time the CPU is blocked until the copy completes. It includes
+				//whatever rendering was still queued ahead of it, so it is not
+				//the GPU time of the frame nor of any particular compositor
+				CENITAL_PROFILE_SCOPE("Offscreen::readbackWait");
+				device.waitForFences(*m_fence, true, std::numeric_limits<uint64_t>::max(), dispatcher);
+			}
+			device.resetFences(*m_fence, dispatcher);
+
+			//Copy the result to host memory
+			m_data.resize(size);
+			const auto* mapped = device.mapMemory(*m_memory, 0, size, {}, dispatcher);
+			std::memcpy(m_data.data(), mapped, size);
+			device.unmapMemory(*m_memory, dispatcher);
+
+			return m_data;
+		}
+
+	private:
+		const Graphics::Vulkan&			m_vulkan;
+		vk::UniqueCommandPool			m_commandPool;
+		vk::UniqueCommandBuffer			m_commandBuffer;
+		vk::UniqueFence					m_fence;
+		vk::UniqueBuffer				m_buffer;
+		vk::UniqueDeviceMemory			m_memory;
+		vk::DeviceSize					m_capacity;
+		std::vector<std::byte>			m_data;
+
+		void reserve(vk::DeviceSize size) {
+			//Only grow the staging buffer, as frame size rarely changes
+			if(size > m_capacity) {
+				const auto& dispatcher = m_vulkan.getDispatcher();
+				const auto device = m_vulkan.getDevice();
+
+				m_memory.reset();
+				m_buffer = m_vulkan.createBuffer(
+					vk::BufferCreateInfo(
+						{},												//Flags
+						size,											//Size
+						vk::BufferUsageFlagBits::eTransferDst,			//Usage
+						vk::SharingMode::eExclusive,					//Sharing mode
+						0, nullptr										//Queue family indices
+					)
+				);
+
+				const auto requirements = device.getBufferMemoryRequirements(*m_buffer, dispatcher);
+				m_memory = m_vulkan.allocateMemory(
+					requirements,
+					vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+				);
+				device.bindBufferMemory(*m_buffer, *m_memory, 0, dispatcher);
+
+				m_capacity = size;
+			}
+		}
+
+		static vk::UniqueCommandPool createCommandPool(const Graphics::Vulkan& vulkan) {
+			const vk::CommandPoolCreateInfo createInfo(
+				vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+				vulkan.getGraphicsQueueIndex()
+			);
+
+			return vulkan.createCommandPool(createInfo);
+		}
+
+		static vk::UniqueCommandBuffer createCommandBuffer(	const Graphics::Vulkan& vulkan,
+															vk::CommandPool pool )
+		{
+			const vk::CommandBufferAllocateInfo allocInfo(
+				pool,
+				vk::CommandBufferLevel::ePrimary,
+				1
+			);
+
+			return vulkan.allocateCommandBuffer(allocInfo);
+		}
+
+		static size_t getTexelSize(vk::Format format) noexcept {
+			switch(format) {
+			case vk::Format::eR8Unorm:
+			case vk::Format::eR8Srgb:
+				return 1;
+
+			case vk::Format::eR8G8Unorm:
+			case vk::Format::eR8G8Srgb:
+			case vk::Format::eR16Unorm:
+			case vk::Format::eR16Sfloat:
+				return 2;
+
+			case vk::Format::eR8G8B8A8Unorm:
+			case vk::Format::eR8G8B8A8Srgb:
+			case vk::Format::eB8G8R8A8Unorm:
+			case vk::Format::eB8G8R8A8Srgb:
+			case vk::Format::eA8B8G8R8UnormPack32:
+			case vk::Format::eA8B8G8R8SrgbPack32:
+			case vk::Format::eA2R10G10B10UnormPack32:
+			case vk::Format::eA2B10G10R10UnormPack32:
+			case vk::Format::eR16G16Unorm:
+			case vk::Format::eR16G16Sfloat:
+			case vk::Format::eR32Sfloat:
+				return 4;
+
+			case vk::Format::eR16G16B16A16Unorm:
+			case vk::Format::eR16G16B16A16Sfloat:
+			case vk::Format::eR32G32Sfloat:
+				return 8;
+
+			case vk::Format::eR32G32B32A32Sfloat:
+				return 16;
+
+			default:
+				return 0; //Unsupported
+			}
+		}
+
+	};
+
+	using Input = Signal::DummyPad<Zuazo::Video>;
+	using Compositor = Renderers::Compositor;
+	using VideoSurface = Layers::VideoSurface;
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr auto UPDATE_PRIORITY = Instance::outputPriority;
+
+	std::reference_wrapper<Offscreen>		owner;
+
+	Input									videoIn;
+	VideoSurface							surface;
+	Compositor								compositor;
+	Signal::Input<Video>					compositorIn;
+	std::array<RendererBase::LayerRef, 1>	layers;
+
+	Offscreen::FrameCallback				frameCallback;
+	std::string								dumpPath;
+	std::ofstream							dumpFile;
+
+	std::unique_ptr<Readback>				readback;
+	Video									lastFrame;
+	size_t									frameCount;
+	bool									readbackFailed;
+
+	MetricsHistogram						renderTime;
+	std::atomic<uint64_t>					renderedFrames;
+	std::atomic<uint64_t>					repeatedFrames;
+	std::atomic<uint64_t>					droppedFrames;
+	Clock::time_point						lastUpdate;
+	Metrics::CollectorId					metricsCollector;
+
+
+	OffscreenImpl(Offscreen& owner, Instance& instance, const std::string& name)
+		: owner(owner)
+		, videoIn(owner, "videoIn")
+		, surface(instance, name + " - Surface", Math::Vec2f())
+		, compositor(instance, name + " - Compositor")
+		, compositorIn(owner, "compositorIn")
+		, layers{ surface }
+		, frameCallback()
+		, dumpPath()
+		, dumpFile()
+		, readback()
+		, lastFrame()
+		, frameCount(0)
+		, readbackFailed(false)
+		, renderTime()
+		, renderedFrames(0)
+		, repeatedFrames(0)
+		, droppedFrames(0)
+		, lastUpdate()
+		, metricsCollector(Metrics::addCollector(std::bind(&OffscreenImpl::collectMetrics, this, std::placeholders::_1)))
+	{
+		//Route the signals
+		surface << videoIn;
+		compositorIn << compositor;
+
+		//Configure the surface
+		surface.setBlendingMode(BlendingMode::write);
+		surface.setRenderingLayer(RenderingLayer::background);
+		compositor.setLayers(layers);
+
+		//Configure the callbacks
+		compositor.setViewportSizeCallback(
+			std::bind(&OffscreenImpl::viewportSizeCallback, this, std::placeholders::_2)
+		);
+		viewportSizeCallback(compositor.getViewportSize());
+	}
+
+	~OffscreenImpl() {
+		Metrics::removeCollector(metricsCollector);
+	}
+
+
+	void moved(ZuazoBase& base) {
+		owner = static_cast<Offscreen&>(base);
+		videoIn.setLayout(base);
+		compositorIn.setLayout(base);
+	}
+
+	void open(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& offscreen = static_cast<Offscreen&>(base);
+		assert(&owner.get() == &offscreen);
+
+		openHelper(surface, lock);
+		openHelper(compositor, lock);
+
+		readback = Utils::makeUnique<Readback>(offscreen.getInstance().getVulkan());
+		readbackFailed = false;
+		lastUpdate = Clock::time_point();
+		enableUpdate(offscreen, offscreen.getVideoMode());
+	}
+
+	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		open(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+	void close(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& offscreen = static_cast<Offscreen&>(base);
+		assert(&owner.get() == &offscreen);
+
+		offscreen.disablePeriodicUpdate();
+		lastFrame.reset();
+		readback.reset();
+
+		closeHelper(surface, lock);
+		closeHelper(compositor, lock);
+	}
+
+	void asyncClose(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		close(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+	void update() {
+		CENITAL_PROFILE_SCOPE("Offscreen::update");
+		const auto now = Clock::now();
+		countDroppedFrames(now);
+
+		//Pulling the frame records and submits the whole rendering chain
+		const auto& frame = [this] () -> const Video& {
+			CENITAL_PROFILE_SCOPE("Offscreen::render");
+			return compositorIn.pull();
+		}();
+		renderTime.observe(std::chrono::duration_cast<MetricsHistogram::Duration>(Clock::now() - now));
+
+		//Only consider new frames
+		if(frame && frame != lastFrame) {
+			lastFrame = frame;
+			++frameCount;
+			renderedFrames.fetch_add(1, std::memory_order_relaxed);
+
+			//Only bring the frame to host memory if someone is interested
+			if(readback && (frameCallback || dumpFile.is_open())) {
+				if(!Readback::isSupported(*frame)) {
+					//Report it only once, as it will repeat on every frame
+					if(!readbackFailed) {
+						ZUAZO_BASE_LOG(owner.get(), Severity::error, "Planar or unknown formats can not be downloaded");
+						readbackFailed = true;
+					}
+					return;
+				}
+
+				const auto data = readback->download(*frame);
+
+				if(dumpFile.is_open()) {
+					dumpFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+				}
+
+				Utils::invokeIf(frameCallback, owner.get(), data);
+			}
+		} else {
+			//The chain did not produce a new frame on time
+			repeatedFrames.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+
+	void setVideoMode(VideoBase& base, const VideoMode& videoMode) {
+		auto& offscreen = static_cast<Offscreen&>(base);
+		assert(&owner.get() == &offscreen);
+		compositor.setVideoMode(videoMode);
+
+		//Follow the new frame rate
+		if(offscreen.isOpen()) {
+			enableUpdate(offscreen, videoMode);
+		}
+	}
+
+	const std::vector<VideoMode>& getVideoModeCompatibility() const noexcept {
+		return compositor.getVideoModeCompatibility();
+	}
+
+	VideoMode videoModeNegotiationCallback(const std::vector<VideoMode>& compatibility) {
+		auto& offscreen = owner.get();
+		offscreen.setVideoModeCompatibility(compatibility); //Will call the underlaying callback
+		return offscreen.getVideoMode();
+	}
+
+	void setScalingMode(ScalingMode scalingMode) {
+		surface.setScalingMode(scalingMode);
+	}
+
+	void setScalingFilter(ScalingFilter scalingFilter) {
+		surface.setScalingFilter(scalingFilter);
+	}
+
+
+	void setDumpPath(std::string path) {
+		dumpPath = std::move(path);
+
+		//Frames are appended as raw video to the file
+		dumpFile.close();
+		if(!dumpPath.empty()) {
+			dumpFile.open(dumpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if(!dumpFile.is_open()) {
+				ZUAZO_BASE_LOG(owner.get(), Severity::error, "Could not open " + dumpPath);
+			}
+		}
+	}
+
+	const std::string& getDumpPath() const noexcept {
+		return dumpPath;
+	}
+
+
+	void viewportSizeCallback(Math::Vec2f size) {
+		surface.setSize(size);
+	}
+
+	void collectMetrics(Metrics::Writer& writer) const {
+		const Metrics::Labels labels = {
+			{ "output", owner.get().getName() }
+		};
+
+		//Zuazo records and submits the compositors (the ones inside the 
+		//M/Es and the ones of the window outputs) on its own, without a 
+		//hook around it. Thus, frame time can only be measured here, as 
+		//the CPU time of pulling a frame through the whole chain. It does
+		//not include the GPU execution, nor it is split by compositor
+		writer.histogram(
+			"cenital_offscreen_render_seconds",
+			"CPU time spent pulling each frame of an offscreen output through the rendering chain",
+			labels,
+			renderTime
+		);
+		writer.counter(
+			"cenital_offscreen_frames_total",
+			"New frames produced by an offscreen output",
+			labels,
+			renderedFrames.load(std::memory_order_relaxed)
+		);
+		writer.counter(
+			"cenital_offscreen_repeated_frames_total",
+			"Updates of an offscreen output without a new frame",
+			labels,
+			repeatedFrames.load(std::memory_order_relaxed)
+		);
+		writer.counter(
+			"cenital_offscreen_dropped_frames_total",
+			"Frame periods skipped by an offscreen output",
+			labels,
+			droppedFrames.load(std::memory_order_relaxed)
+		);
+	}
+
+private:
+	void countDroppedFrames(Clock::time_point now) {
+		//Updates that come later than one and a half periods
+		//mean that the periods in between have been skipped
+		const auto frameRate = owner.get().getVideoMode().getFrameRateValue();
+		if(lastUpdate != Clock::time_point() && frameRate > Rate(0)) {
+			const auto period = std::chrono::duration<double>(getPeriod(frameRate)).count();
+			const auto elapsed = std::chrono::duration<double>(now - lastUpdate).count();
+
+			if(elapsed > 1.5 * period) {
+				droppedFrames.fetch_add(
+					static_cast<uint64_t>(std::round(elapsed / period)) - 1, 
+					std::memory_order_relaxed
+				);
+			}
+		}
+
+		lastUpdate = now;
+	}
+
+	static void enableUpdate(Offscreen& offscreen, const VideoMode& videoMode) {
+		//There is no display to synchronize with, so the output
+		//is clocked by the frame rate of its video mode
+		const auto frameRate = videoMode.getFrameRateValue();
+		if(frameRate > Rate(0)) {
+			offscreen.enablePeriodicUpdate(UPDATE_PRIORITY, getPeriod(frameRate));
+		} else {
+			offscreen.disablePeriodicUpdate();
+		}
+	}
+
+};
+
+
+
+/*
+ * Offscreen
+ */
+
+Offscreen::Offscreen(	Instance& instance,
+						std::string name )
+	: Utils::Pimpl<OffscreenImpl>({}, *this, instance, name)
+	, ZuazoBase(
+		instance,
+		std::move(name),
+		{},
+		std::bind(&OffscreenImpl::moved, std::ref(**this), std::placeholders::_1),
+		std::bind(&OffscreenImpl::open, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&OffscreenImpl::asyncOpen, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&OffscreenImpl::close, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&OffscreenImpl::asyncClose, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&OffscreenImpl::update, std::ref(**this)) )
+	, VideoBase(
+		std::bind(&OffscreenImpl::setVideoMode, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
+	, VideoScalerBase(
+		std::bind(&OffscreenImpl::setScalingMode, std::ref(**this), std::placeholders::_2),
+		std::bind(&OffscreenImpl::setScalingFilter, std::ref(**this), std::placeholders::_2)
+	)
+{
+	//Register the input pad
+	registerPad(getInput());
+
+	//Set compatibility to a known state
+	setVideoModeCompatibility((*this)->getVideoModeCompatibility());
+
+	//Configure the callbacks. Note this callbacks need to be set here
+	//as they make use of this class, so setting them on the PIMPL
+	//instantiation will cause a segfault
+	(*this)->compositor.setVideoModeNegotiationCallback(
+		std::bind(&OffscreenImpl::videoModeNegotiationCallback, this->get(), std::placeholders::_2)
+	);
+}
+
+Offscreen::Offscreen(Offscreen&& other) = default;
+
+Offscreen::~Offscreen() = default;
+
+Offscreen& Offscreen::operator=(Offscreen&& other) = default;
+
+
+
+Offscreen::Input& Offscreen::getInput() noexcept {
+	return (*this)->videoIn.getInput();
+}
+
+const Offscreen::Input& Offscreen::getInput() const noexcept {
+	return (*this)->videoIn.getInput();
+}
+
+
+void Offscreen::setFrameCallback(FrameCallback cbk) {
+	(*this)->frameCallback = std::move(cbk);
+}
+
+const Offscreen::FrameCallback& Offscreen::getFrameCallback() const noexcept {
+	return (*this)->frameCallback;
+}
+
+
+void Offscreen::setDumpPath(std::string path) {
+	(*this)->setDumpPath(std::move(path));
+}
+
+const std::string& Offscreen::getDumpPath() const noexcept {
+	return (*this)->getDumpPath();
+}
+
+
+size_t Offscreen::getFrameCount() const noexcept {
+	return (*this)->frameCount;
+}
+
+void Offscreen::resetFrameCount() noexcept {
+	(*this)->frameCount = 0;
+}
+
+}
\ No newline at end of file
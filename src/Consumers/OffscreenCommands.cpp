@@ -0,0 +1,141 @@
+#include <Consumers/Offscreen.h>
+
+#include <DumpDirectory.h>
+
+#include <Control/Generic.h>
+#include <Control/VideoModeCommands.h>
+#include <Control/VideoScalingCommands.h>
+
+
+namespace Cenital::Consumers {
+
+using namespace Zuazo;
+using namespace Control;
+
+static void setDumpPath(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response )
+{
+	//Only names inside the dump directory are accepted, as
+	//otherwise clients could overwrite any file
+	invokeSetter<Offscreen, std::string>(
+		[] (Offscreen& offscreen, const std::string& name) {
+			offscreen.setDumpPath(DumpDirectory::resolve(name));
+		},
+		[] (const Offscreen&, const std::string& name) -> bool {
+			return !DumpDirectory::resolve(name).empty();
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void getDumpPath(Controller& controller,
+						ZuazoBase& base,  
+						const Message& request,
+						size_t level,
+						Message& response )
+{
+	//Report the name, as it was set
+	invokeGetter<std::string, Offscreen>(
+		[] (const Offscreen& offscreen) -> std::string {
+			const auto& path = offscreen.getDumpPath();
+			return path.substr(path.rfind('/') + 1);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void unsetDumpPath(	Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response )
+{
+	invokeSetter<Offscreen>(
+		[] (Offscreen& offscreen) {
+			offscreen.setDumpPath("");
+		},
+		controller, base, request, level, response
+	);
+}
+
+
+static void getFrameCount(	Controller& controller,
+							ZuazoBase& base,  
+							const Message& request,
+							size_t level,
+							Message& response )
+{
+	invokeGetter<size_t, Offscreen>(
+		&Offscreen::getFrameCount,
+		controller, base, request, level, response
+	);
+}
+
+static void unsetFrameCount(Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response )
+{
+	invokeSetter<Offscreen>(
+		[] (Offscreen& offscreen) {
+			offscreen.resetFrameCount();
+		},
+		controller, base, request, level, response
+	);
+}
+
+
+
+void Offscreen::registerCommands(Controller& controller) {
+	Node configNode({
+		{ "dump",				makeAttributeNode(	Consumers::setDumpPath,
+													Consumers::getDumpPath,
+													{},
+													Consumers::unsetDumpPath ) },
+		{ "frames",				makeAttributeNode(	{},
+													Consumers::getFrameCount,
+													{},
+													Consumers::unsetFrameCount ) },
+
+	});
+
+	constexpr auto videoModeWr = 
+		VideoModeAttributes::frameRate |
+		VideoModeAttributes::resolution |
+		VideoModeAttributes::pixelAspectRatio |
+		VideoModeAttributes::colorPrimaries |
+		VideoModeAttributes::colorModel |
+		VideoModeAttributes::colorTransferFunction |
+		VideoModeAttributes::colorSubsampling |
+		VideoModeAttributes::colorRange |
+		VideoModeAttributes::colorFormat ;
+	constexpr auto videoModeRd = 
+		VideoModeAttributes::all ;
+	registerVideoModeCommands<Offscreen>(configNode, videoModeWr, videoModeRd);
+
+	constexpr auto videoScalingWr = 
+		VideoScalingAttributes::mode |
+		VideoScalingAttributes::filter ;
+	constexpr auto videoScalingRd = 
+		VideoScalingAttributes::mode |
+		VideoScalingAttributes::filter ;
+	registerVideoScalingCommands<Offscreen>(configNode, videoScalingWr, videoScalingRd);
+
+	//Register it
+	auto& classIndex = controller.getClassIndex();
+	classIndex.registerClass(
+		typeid(Offscreen),
+		ClassIndex::Entry(
+			"output-offscreen",
+			std::move(configNode),
+			invokeBaseConstructor<Offscreen>,
+			typeid(ZuazoBase)
+		)	
+	);
+}
+
+}
\ No newline at end of file
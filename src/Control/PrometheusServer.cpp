@@ -0,0 +1,162 @@
+#include <Control/PrometheusServer.h>
+
+#include <zuazo/Utils/Functions.h>
+
+#include <memory>
+#include <string_view>
+
+namespace Cenital::Control {
+
+class PrometheusServer::Session 
+	: public std::enable_shared_from_this<PrometheusServer::Session>
+{
+public:
+	//Requests are tiny, so do not let clients grow the buffer indefinitely
+	static constexpr size_t MAX_REQUEST_SIZE = 8 * 1024;
+
+	Session(boost::asio::ip::tcp::socket socket,
+			BodyCallback bodyCbk )
+		: m_socket(std::move(socket))
+		, m_streambuf(MAX_REQUEST_SIZE)
+		, m_response()
+		, m_bodyCallback(std::move(bodyCbk))
+	{
+	}
+
+	void start() {
+		asyncRead();
+	}
+
+private:
+	void asyncRead() {
+		//Only the request line is relevant, so read until the end of the header
+		boost::asio::async_read_until(
+			m_socket, m_streambuf, "\r\n\r\n",
+			std::bind(&Session::onRead, shared_from_this(), std::placeholders::_1, std::placeholders::_2)
+		);
+	}
+
+	void onRead(boost::system::error_code error, size_t byteCnt) {
+		if(!error) {
+			const auto buffer = m_streambuf.data();
+			const std::string request(
+				boost::asio::buffers_begin(buffer),
+				boost::asio::buffers_begin(buffer) + byteCnt
+			);
+
+			if(isMetricsRequest(request) && m_bodyCallback) {
+				const auto body = m_bodyCallback();
+				m_response = 	"HTTP/1.1 200 OK\r\n"
+								"Content-Type: text/plain; version=0.0.4\r\n"
+								"Content-Length: " + std::to_string(body.size()) + "\r\n"
+								"Connection: close\r\n"
+								"\r\n" + body;
+			} else {
+				m_response = 	"HTTP/1.1 404 Not Found\r\n"
+								"Content-Length: 0\r\n"
+								"Connection: close\r\n"
+								"\r\n";
+			}
+
+			asyncWrite();
+		} else if(error == boost::asio::error::not_found) {
+			//The header did not fit in the buffer
+			m_response = 	"HTTP/1.1 400 Bad Request\r\n"
+							"Content-Length: 0\r\n"
+							"Connection: close\r\n"
+							"\r\n";
+
+			asyncWrite();
+		} else {
+			m_socket.close(error);
+		}
+	}
+
+	void asyncWrite() {
+		boost::asio::async_write(
+			m_socket, 
+			boost::asio::buffer(m_response), 
+			std::bind(&Session::onWrite, shared_from_this(), std::placeholders::_1, std::placeholders::_2)
+		);
+	}
+
+	void onWrite(boost::system::error_code error, size_t) {
+		//Byte count not used. One request per connection
+		if(!error) {
+			m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+		}
+
+		m_socket.close(error);
+	}
+
+	static bool isMetricsRequest(std::string_view request) noexcept {
+		constexpr std::string_view method = "GET ";
+		constexpr std::string_view path = "/metrics";
+
+		if(request.compare(0, method.size(), method) != 0) {
+			return false;
+		}
+		request.remove_prefix(method.size());
+
+		if(request.compare(0, path.size(), path) != 0) {
+			return false;
+		}
+		request.remove_prefix(path.size());
+
+		//Path must end here, although a query is allowed
+		return !request.empty() && (request.front() == ' ' || request.front() == '?');
+	}
+
+	boost::asio::ip::tcp::socket 		m_socket;
+	boost::asio::streambuf 				m_streambuf;
+	std::string							m_response;
+
+	BodyCallback						m_bodyCallback;
+};
+
+
+PrometheusServer::PrometheusServer(	boost::asio::io_service& ios,
+									uint16_t port,
+									BodyCallback bodyCbk )
+	: m_ios(ios)
+	, m_acceptor(m_ios, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port))
+	, m_socket(m_ios)
+	, m_bodyCallback(std::move(bodyCbk))
+{
+}
+
+
+
+void PrometheusServer::setBodyCallback(BodyCallback cbk) {
+	m_bodyCallback = std::move(cbk);
+}
+
+
+void PrometheusServer::startAccept() {
+	asyncAccept();
+}
+
+
+
+void PrometheusServer::asyncAccept() {
+	m_acceptor.async_accept(
+		m_socket, 
+		std::bind(&PrometheusServer::onAccept, std::ref(*this), std::placeholders::_1)
+	);
+}
+
+void PrometheusServer::onAccept(boost::system::error_code error) {
+	if(!error) {
+		auto client = Zuazo::Utils::makeShared<Session>(
+			std::move(m_socket),
+			m_bodyCallback
+		);
+		client->start();
+	}
+
+	//Accept the next client
+	m_socket = Socket(m_ios); //Remember that the socket was moved to the client
+	asyncAccept();
+}
+
+}
\ No newline at end of file
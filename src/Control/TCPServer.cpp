@@ -2,6 +2,7 @@
 
 #include <zuazo/Utils/Functions.h>
 
+#include <algorithm>
 #include <memory>
 #include <queue>
 
@@ -24,6 +25,16 @@ public:
 		asyncRead();
 	}
 
+	size_t getQueueDepth() const noexcept {
+		return m_outgoing.size();
+	}
+
+	std::string getRemoteAddress() const {
+		boost::system::error_code error;
+		const auto endpoint = m_socket.remote_endpoint(error);
+		return error ? std::string() : endpoint.address().to_string() + ":" + std::to_string(endpoint.port());
+	}
+
 	void send(std::string message) {
 		const bool idle = m_outgoing.empty();
 		m_outgoing.push(std::move(message));
@@ -117,8 +128,11 @@ TCPServer::TCPServer(	boost::asio::io_service& ios,
 	, m_socket(m_ios)
 	, m_openCallback(std::move(openCbk))
 	, m_closeCallback(std::move(closeCbk))
-	, m_messageCallback(std::move(msgCbk))
+	, m_messageCallback()
+	, m_commandTime(Zuazo::Utils::makeShared<MetricsHistogram>())
+	, m_sessions()
 {
+	setMessageCallback(std::move(msgCbk));
 }
 
 
@@ -132,7 +146,9 @@ void TCPServer::setConnectionCloseCallback(ConnectionCloseCallback cbk) {
 }
 
 void TCPServer::setMessageCallback(MessageCallback cbk) {
-	m_messageCallback = std::move(cbk);
+	//Time the handling of each message. Sessions hold a copy of the
+	//callback, so the histogram is shared with them
+	m_messageCallback = MetricsHistogram::timeCallback(m_commandTime, std::move(cbk));
 }
 
 
@@ -150,6 +166,42 @@ void TCPServer::send(SessionPtr session, Message msg) {
 }
 
 
+void TCPServer::collectMetrics(Metrics::Writer& writer) const {
+	const Metrics::Labels labels = {
+		{ "view", "tcp" }
+	};
+
+	writer.histogram(
+		"cenital_command_seconds",
+		"Time spent handling each control command",
+		labels,
+		*m_commandTime
+	);
+
+	size_t sessionCount = 0;
+	for(const auto& session : m_sessions) {
+		const auto s = session.lock();
+		if(s) {
+			writer.gauge(
+				"cenital_session_queue_depth",
+				"Outgoing messages waiting to be sent to a session",
+				{ { "view", "tcp" }, { "session", s->getRemoteAddress() } },
+				s->getQueueDepth()
+			);
+
+			++sessionCount;
+		}
+	}
+
+	writer.gauge(
+		"cenital_sessions",
+		"Open control sessions",
+		labels,
+		sessionCount
+	);
+}
+
+
 
 void TCPServer::asyncAccept() {
 	m_acceptor.async_accept(
@@ -167,6 +219,18 @@ void TCPServer::onAccept(boost::system::error_code) {
 		m_messageCallback
 	);
 
+	//Keep track of the client for the metrics, forgetting the closed ones
+	m_sessions.erase(
+		std::remove_if(
+			m_sessions.begin(), m_sessions.end(),
+			[] (const SessionPtr& session) -> bool {
+				return session.expired();
+			}
+		),
+		m_sessions.end()
+	);
+	m_sessions.emplace_back(client);
+
 	//Call the corresponding callback
 	if(m_openCallback) {
 		m_openCallback(client);
@@ -8,6 +8,7 @@ WebSocketServer::WebSocketServer(	boost::asio::io_service& ios,
 									ConnectionCloseCallback closeCbk,
 									MessageCallback msgCbk )
 	: m_socket()
+	, m_statistics(std::make_shared<Statistics>())
 {	
 	//Set verbosity to silent
 	m_socket.clear_access_channels(websocketpp::log::alevel::all); 
@@ -16,9 +17,9 @@ WebSocketServer::WebSocketServer(	boost::asio::io_service& ios,
 	m_socket.init_asio(&ios);
 
 	//Configure the callbacks
-	m_socket.set_open_handler(std::move(openCbk));
-	m_socket.set_close_handler(std::move(closeCbk));
-	m_socket.set_message_handler(std::move(msgCbk));
+	setConnectionOpenCallback(std::move(openCbk));
+	setConnectionCloseCallback(std::move(closeCbk));
+	setMessageCallback(std::move(msgCbk));
 
 	//Configure the port
 	m_socket.listen(port);		
@@ -27,15 +28,38 @@ WebSocketServer::WebSocketServer(	boost::asio::io_service& ios,
 
 
 void WebSocketServer::setConnectionOpenCallback(ConnectionOpenCallback cbk) {
-	m_socket.set_open_handler(std::move(cbk));
+	//Keep track of the sessions for the metrics. State is shared with
+	//the handlers, as this object may be moved
+	m_socket.set_open_handler(
+		[cbk = std::move(cbk), statistics = m_statistics] (SessionPtr connection) {
+			statistics->sessions.insert(connection);
+			if(cbk) {
+				cbk(std::move(connection));
+			}
+		}
+	);
 }
 
 void WebSocketServer::setConnectionCloseCallback(ConnectionCloseCallback cbk) {
-	m_socket.set_close_handler(std::move(cbk));
+	m_socket.set_close_handler(
+		[cbk = std::move(cbk), statistics = m_statistics] (SessionPtr connection) {
+			statistics->sessions.erase(connection);
+			if(cbk) {
+				cbk(std::move(connection));
+			}
+		}
+	);
 }
 
 void WebSocketServer::setMessageCallback(MessageCallback cbk) {
-	m_socket.set_message_handler(std::move(cbk));
+	//Time the handling of each message. The histogram is a part
+	//of the shared state, so alias it
+	m_socket.set_message_handler(
+		MetricsHistogram::timeCallback(
+			std::shared_ptr<MetricsHistogram>(m_statistics, &m_statistics->commandTime),
+			std::move(cbk)
+		)
+	);
 }
 
 
@@ -54,5 +78,41 @@ void WebSocketServer::send(SessionPtr connection, const std::string& msg) {
 		);
 	}
 }
+
+
+void WebSocketServer::collectMetrics(Metrics::Writer& writer) const {
+	const Metrics::Labels labels = {
+		{ "view", "websocket" }
+	};
+
+	writer.histogram(
+		"cenital_command_seconds",
+		"Time spent handling each control command",
+		labels,
+		m_statistics->commandTime
+	);
+
+	//Websocketpp only reports the amount of buffered bytes
+	auto& socket = const_cast<Socket&>(m_socket); //get_con_from_hdl is not const
+	for(const auto& session : m_statistics->sessions) {
+		websocketpp::lib::error_code error;
+		const auto connection = socket.get_con_from_hdl(session, error);
+		if(!error && connection) {
+			writer.gauge(
+				"cenital_session_queue_bytes",
+				"Outgoing bytes waiting to be sent to a session",
+				{ { "view", "websocket" }, { "session", connection->get_remote_endpoint() } },
+				connection->get_buffered_amount()
+			);
+		}
+	}
+
+	writer.gauge(
+		"cenital_sessions",
+		"Open control sessions",
+		labels,
+		m_statistics->sessions.size()
+	);
+}
 	
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include <DumpDirectory.h>
+
+namespace Cenital {
+
+static std::string& getDumpDirectoryPath() noexcept {
+	static std::string path;
+	return path;
+}
+
+
+
+void DumpDirectory::setPath(std::string path) {
+	//Avoid duplicating the separator when resolving
+	while(path.size() > 1 && path.back() == '/') {
+		path.pop_back();
+	}
+
+	getDumpDirectoryPath() = std::move(path);
+}
+
+const std::string& DumpDirectory::getPath() noexcept {
+	return getDumpDirectoryPath();
+}
+
+
+bool DumpDirectory::isValidName(std::string_view name) noexcept {
+	//Only plain names are allowed. Separators and parent references
+	//would allow escaping the directory
+	return 	!name.empty() &&
+			name.find_first_of(std::string_view("/\\\0", 3)) == std::string_view::npos &&
+			name.find("..") == std::string_view::npos &&
+			name != "." ;
+}
+
+std::string DumpDirectory::resolve(std::string_view name) {
+	std::string result;
+
+	const auto& path = getPath();
+	if(!path.empty() && isValidName(name)) {
+		result.reserve(path.size() + 1 + name.size());
+		result.append(path);
+		if(result.back() != '/') {
+			result.push_back('/');
+		}
+		result.append(name);
+	}
+
+	return result;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include <Easing.h>
+
+#include <zuazo/Math/Trigonometry.h>
+
+namespace Cenital {
+
+static float cubicBezier(float p1, float p2, float t) noexcept {
+	//Evaluates a 1D cubic bezier curve with its endpoints on 0 and 1
+	const auto s = 1.0f - t;
+	return 3.0f*s*s*t*p1 + 3.0f*s*t*t*p2 + t*t*t;
+}
+
+
+
+EasingCurve sanitizeEasingCurve(EasingCurve curve) noexcept {
+	//The x coordinates of the control points need to be within 
+	//[0, 1] so that the curve is a function of x
+	curve[0] = Zuazo::Math::clamp(curve[0], 0.0f, 1.0f);
+	curve[2] = Zuazo::Math::clamp(curve[2], 0.0f, 1.0f);
+	return curve;
+}
+
+float evaluateEasingCurve(const EasingCurve& curve, float x) noexcept {
+	//Easing curves are meant to be sampled into tables, so a simple
+	//bisection is enough to find the curve parameter for x. As the x
+	//coordinates of the control points are within [0, 1], x(t) is monotonic
+	constexpr size_t ITERATION_COUNT = 24;
+	float lo = 0.0f;
+	float hi = 1.0f;
+	float t = x;
+
+	for(size_t i = 0; i < ITERATION_COUNT; ++i) {
+		t = (lo + hi) / 2.0f;
+		if(cubicBezier(curve[0], curve[2], t) < x) {
+			lo = t;
+		} else {
+			hi = t;
+		}
+	}
+
+	return cubicBezier(curve[1], curve[3], t);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <FrameClock.h>
+
+#include <cassert>
+
+namespace Cenital {
+
+FrameClock::FrameClock() noexcept
+	: m_remainder(Duration::zero())
+{
+}
+
+
+
+void FrameClock::reset() noexcept {
+	m_remainder = Duration::zero();
+}
+
+FrameClock::FrameCount FrameClock::advance(Duration deltaTime, Duration period) noexcept {
+	assert(period > Duration::zero());
+
+	m_remainder += deltaTime;
+	const auto result = getFrameCount(m_remainder, period);
+	m_remainder -= result * period;
+
+	return result;
+}
+
+
+
+FrameClock::FrameCount FrameClock::getFrameCount(Duration duration, Duration period) noexcept {
+	assert(period > Duration::zero());
+	return (duration + period / 2) / period;
+}
+
+}
\ No newline at end of file
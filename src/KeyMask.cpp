@@ -0,0 +1,339 @@
+#include <KeyMask.h>
+
+#include <VideoDecoder.h>
+#include <WeakCache.h>
+
+#include <zuazo/Utils/StaticId.h>
+
+extern "C" {
+	#include <libavutil/pixdesc.h>
+}
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+
+namespace Cenital {
+
+using namespace Zuazo;
+
+/*
+ * KeyMask
+ */
+
+//Bigger images are downscaled. This is the minimum size guaranteed by Vulkan
+static constexpr int MAX_MASK_SIZE = 4096;
+
+KeyMask::KeyMask(	std::string path,
+					uint32_t width,
+					uint32_t height,
+					std::vector<uint8_t> pixels )
+	: m_path(std::move(path))
+	, m_width(width)
+	, m_height(height)
+	, m_pixels(std::move(pixels))
+{
+	assert(m_pixels.size() == static_cast<size_t>(m_width)*m_height);
+}
+
+
+
+const std::string& KeyMask::getPath() const noexcept {
+	return m_path;
+}
+
+uint32_t KeyMask::getWidth() const noexcept {
+	return m_width;
+}
+
+uint32_t KeyMask::getHeight() const noexcept {
+	return m_height;
+}
+
+const std::vector<uint8_t>& KeyMask::getPixels() const noexcept {
+	return m_pixels;
+}
+
+
+
+static std::shared_ptr<const KeyMask> decode(const std::string& filename, std::string path) {
+	//Decode the first frame of the file
+	VideoDecoder decoder(filename);
+	const auto* frame = decoder.decode();
+	if(!frame || frame->width <= 0 || frame->height <= 0) {
+		throw std::runtime_error("Could not decode " + filename);
+	}
+
+	//Silhouettes are usually stored in the alpha channel, so use it
+	//when present. Otherwise use the luminance. Values are used as-is,
+	//without linearizing them, as they do not represent a colour
+	const auto sourceFormat = static_cast<AVPixelFormat>(frame->format);
+	const auto* descriptor = av_pix_fmt_desc_get(sourceFormat);
+	const bool hasAlpha = descriptor && (descriptor->flags & AV_PIX_FMT_FLAG_ALPHA);
+	const auto destinationFormat = hasAlpha ? AV_PIX_FMT_YA8 : AV_PIX_FMT_GRAY8;
+	const size_t channelCount = hasAlpha ? 2 : 1;
+
+	//Downscale the images which are too big, keeping their aspect ratio
+	const auto scale = std::min(1.0, static_cast<double>(MAX_MASK_SIZE) / std::max(frame->width, frame->height));
+	const auto width = std::max(static_cast<int>(frame->width*scale), 1);
+	const auto height = std::max(static_cast<int>(frame->height*scale), 1);
+
+	std::vector<uint8_t> converted(static_cast<size_t>(width)*height*channelCount);
+	decoder.convert(
+		*frame,
+		destinationFormat,
+		width, height,
+		converted.data(), static_cast<int>(width*channelCount)
+	);
+
+	//Keep only the last channel, which is either the luminance or the alpha
+	std::vector<uint8_t> pixels;
+	if(channelCount == 1) {
+		pixels = std::move(converted);
+	} else {
+		pixels.resize(static_cast<size_t>(width)*height);
+		for(size_t i = 0; i < pixels.size(); ++i) {
+			pixels[i] = converted[i*channelCount + channelCount - 1];
+		}
+	}
+
+	return std::make_shared<const KeyMask>(
+		std::move(path),
+		static_cast<uint32_t>(width),
+		static_cast<uint32_t>(height),
+		std::move(pixels)
+	);
+}
+
+std::shared_ptr<const KeyMask> KeyMask::load(std::string_view path) {
+	//The same mask is shared while it is in use
+	static FileCache<KeyMask> cache;
+
+	return cache.get(
+		path,
+		[path] (const std::filesystem::path& canonicalPath) -> std::shared_ptr<const KeyMask> {
+			return decode(canonicalPath.string(), std::string(path));
+		}
+	);
+}
+
+std::shared_ptr<const KeyMask> KeyMask::identity() {
+	//A single opaque pixel, which leaves the alpha untouched
+	static const std::shared_ptr<const KeyMask> result = std::make_shared<const KeyMask>(
+		"",
+		1, 1,
+		std::vector<uint8_t>(1, std::numeric_limits<uint8_t>::max())
+	);
+
+	return result;
+}
+
+
+
+/*
+ * KeyMask::Texture
+ */
+
+//Sampled images and linear filtering are mandatory for this format
+static constexpr vk::Format MASK_FORMAT = vk::Format::eR8Unorm;
+
+static vk::UniqueImage createImage(const Graphics::Vulkan& vulkan, uint32_t width, uint32_t height) {
+	const vk::ImageCreateInfo createInfo(
+		{},													//Flags
+		vk::ImageType::e2D,									//Image type
+		MASK_FORMAT,										//Format
+		vk::Extent3D(width, height, 1),						//Extent
+		1, 1,												//Mip levels and array layers
+		vk::SampleCountFlagBits::e1,						//Sample count
+		vk::ImageTiling::eOptimal,							//Tiling
+		vk::ImageUsageFlagBits::eTransferDst |
+		vk::ImageUsageFlagBits::eSampled,					//Usage
+		vk::SharingMode::eExclusive,						//Sharing mode
+		0, nullptr,											//Queue family indices
+		vk::ImageLayout::eUndefined							//Initial layout
+	);
+
+	return vulkan.getDevice().createImageUnique(createInfo, nullptr, vulkan.getDispatcher());
+}
+
+static vk::UniqueDeviceMemory allocateImageMemory(const Graphics::Vulkan& vulkan, vk::Image image) {
+	const auto& dispatcher = vulkan.getDispatcher();
+	const auto device = vulkan.getDevice();
+
+	const auto requirements = device.getImageMemoryRequirements(image, dispatcher);
+	auto result = vulkan.allocateMemory(requirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+	device.bindImageMemory(image, *result, 0, dispatcher);
+
+	return result;
+}
+
+static vk::UniqueImageView createImageView(const Graphics::Vulkan& vulkan, vk::Image image) {
+	const vk::ImageViewCreateInfo createInfo(
+		{},													//Flags
+		image,												//Image
+		vk::ImageViewType::e2D,								//View type
+		MASK_FORMAT,										//Format
+		vk::ComponentMapping(),								//Swizzle
+		vk::ImageSubresourceRange(
+			vk::ImageAspectFlagBits::eColor,				//Aspect
+			0, 1, 0, 1										//Mip levels and array layers
+		)
+	);
+
+	return vulkan.getDevice().createImageViewUnique(createInfo, nullptr, vulkan.getDispatcher());
+}
+
+static vk::UniqueSampler createSampler(const Graphics::Vulkan& vulkan) {
+	//Clamping to the edge extends the border pixels of the mask
+	const vk::SamplerCreateInfo createInfo(
+		{},													//Flags
+		vk::Filter::eLinear,								//Mag filter
+		vk::Filter::eLinear,								//Min filter
+		vk::SamplerMipmapMode::eNearest,					//Mipmap mode
+		vk::SamplerAddressMode::eClampToEdge,				//U address mode
+		vk::SamplerAddressMode::eClampToEdge,				//V address mode
+		vk::SamplerAddressMode::eClampToEdge,				//W address mode
+		0.0f,												//Mip LOD bias
+		false, 1.0f,										//Anisotropy
+		false, vk::CompareOp::eNever,						//Comparison
+		0.0f, 0.0f,											//Min and max LOD
+		vk::BorderColor::eFloatOpaqueBlack,					//Border color
+		false 												//Unnormalized coordinates
+	);
+
+	return vulkan.getDevice().createSamplerUnique(createInfo, nullptr, vulkan.getDispatcher());
+}
+
+static vk::UniqueDescriptorPool createDescriptorPool(const Graphics::Vulkan& vulkan) {
+	const std::array poolSizes = {
+		vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, 1)
+	};
+
+	const vk::DescriptorPoolCreateInfo createInfo(
+		{},													//Flags
+		1,													//Descriptor set count
+		poolSizes.size(), poolSizes.data()					//Pool sizes
+	);
+
+	return vulkan.createDescriptorPool(createInfo);
+}
+
+static std::unique_ptr<TextureUpload> createUpload(	const Graphics::Vulkan& vulkan, 
+													vk::Image image,
+													const KeyMask& mask )
+{
+	const auto& pixels = mask.getPixels();
+
+	return Utils::makeUnique<TextureUpload>(
+		vulkan,
+		image,
+		vk::Extent3D(mask.getWidth(), mask.getHeight(), 1),
+		pixels.size(),
+		[&pixels] (std::byte* data) {
+			std::memcpy(data, pixels.data(), pixels.size());
+		}
+	);
+}
+
+
+
+KeyMask::Texture::Texture(const Graphics::Vulkan& vulkan, std::shared_ptr<const KeyMask> mask)
+	: m_mask(std::move(mask))
+	, m_image(createImage(vulkan, m_mask->getWidth(), m_mask->getHeight()))
+	, m_memory(allocateImageMemory(vulkan, *m_image))
+	, m_imageView(createImageView(vulkan, *m_image))
+	, m_sampler(createSampler(vulkan))
+	, m_descriptorPool(createDescriptorPool(vulkan))
+	, m_descriptorSet(vulkan.allocateDescriptorSet(*m_descriptorPool, getDescriptorSetLayout(vulkan)).release())
+	, m_upload(createUpload(vulkan, *m_image, *m_mask))
+{
+
+	const vk::DescriptorImageInfo imageInfo(
+		*m_sampler,											//Sampler
+		*m_imageView,										//Image view
+		vk::ImageLayout::eShaderReadOnlyOptimal				//Layout
+	);
+
+	const vk::WriteDescriptorSet write(
+		m_descriptorSet,									//Descriptor set
+		0,													//Binding
+		0, 													//Index
+		1,													//Descriptor count
+		vk::DescriptorType::eCombinedImageSampler,			//Descriptor type
+		&imageInfo,											//Images
+		nullptr,											//Buffers
+		nullptr												//Texel buffers
+	);
+
+	vulkan.getDevice().updateDescriptorSets(write, {}, vulkan.getDispatcher());
+}
+
+
+
+const KeyMask& KeyMask::Texture::getKeyMask() const noexcept {
+	assert(m_mask);
+	return *m_mask;
+}
+
+vk::DescriptorSet KeyMask::Texture::getDescriptorSet() const noexcept {
+	return m_descriptorSet;
+}
+
+void KeyMask::Texture::releaseStaging() const {
+	if(m_upload && m_upload->isComplete()) {
+		m_upload.reset();
+	}
+}
+
+
+
+vk::DescriptorSetLayout KeyMask::Texture::getDescriptorSetLayout(const Graphics::Vulkan& vulkan) {
+	static const Utils::StaticId id;
+	auto result = vulkan.createDescriptorSetLayout(id);
+
+	if(!result) {
+		//Create the bindings
+		const std::array bindings = {
+			vk::DescriptorSetLayoutBinding(	//Sampler binding
+				0,												//Binding
+				vk::DescriptorType::eCombinedImageSampler,		//Type
+				1,												//Count
+				vk::ShaderStageFlagBits::eFragment,				//Shader stage
+				nullptr											//Immutable samplers
+			),
+		};
+
+		const vk::DescriptorSetLayoutCreateInfo createInfo(
+			{},
+			bindings.size(), bindings.data()
+		);
+
+		result = vulkan.createDescriptorSetLayout(id, createInfo);
+	}
+
+	return result;
+}
+
+std::shared_ptr<const KeyMask::Texture> KeyMask::Texture::get(	const Graphics::Vulkan& vulkan,
+																std::shared_ptr<const KeyMask> mask )
+{
+	using Key = std::pair<const Graphics::Vulkan*, const KeyMask*>;
+	static WeakCache<Key, Texture> cache;
+
+	//As the textures keep their mask alive, the mask
+	//address is not reused while it is listed
+	assert(mask);
+	const Key key(&vulkan, mask.get());
+	return cache.get(
+		key,
+		[&vulkan, &mask] () -> std::shared_ptr<const Texture> {
+			return std::make_shared<const Texture>(vulkan, std::move(mask));
+		}
+	);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include <Metrics.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace Cenital {
+
+using namespace Zuazo;
+
+/*
+ * MetricsHistogram
+ */
+
+MetricsHistogram::MetricsHistogram() noexcept
+	: m_buckets()
+	, m_count(0)
+	, m_sum(0)
+{
+	for(auto& bucket : m_buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+void MetricsHistogram::observe(Duration value) noexcept {
+	const auto seconds = std::chrono::duration<double>(value).count();
+	const auto ite = std::lower_bound(BUCKETS.cbegin(), BUCKETS.cend(), seconds);
+	const auto index = static_cast<size_t>(std::distance(BUCKETS.cbegin(), ite));
+
+	m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(value.count(), std::memory_order_relaxed);
+}
+
+uint64_t MetricsHistogram::getBucketCount(size_t index) const noexcept {
+	return m_buckets.at(index).load(std::memory_order_relaxed);
+}
+
+uint64_t MetricsHistogram::getCount() const noexcept {
+	return m_count.load(std::memory_order_relaxed);
+}
+
+MetricsHistogram::Duration MetricsHistogram::getSum() const noexcept {
+	return Duration(m_sum.load(std::memory_order_relaxed));
+}
+
+
+
+/*
+ * Metrics::Writer
+ */
+
+static std::string formatBound(double bound) {
+	std::ostringstream oss;
+	oss << bound;
+	return oss.str();
+}
+
+void Metrics::Writer::counter(	std::string_view name,
+								std::string_view help,
+								Labels labels,
+								double value )
+{
+	auto& family = getFamily(name, help, Type::counter);
+	family.samples.push_back(Sample{ std::string(name), std::move(labels), value });
+}
+
+void Metrics::Writer::gauge(std::string_view name,
+							std::string_view help,
+							Labels labels,
+							double value )
+{
+	auto& family = getFamily(name, help, Type::gauge);
+	family.samples.push_back(Sample{ std::string(name), std::move(labels), value });
+}
+
+void Metrics::Writer::histogram(std::string_view name,
+								std::string_view help,
+								Labels labels,
+								const MetricsHistogram& histogram )
+{
+	auto& family = getFamily(name, help, Type::histogram);
+	const std::string baseName(name);
+
+	//Buckets are cumulative and they have an additional "le" label
+	uint64_t count = 0;
+	for(size_t i = 0; i <= MetricsHistogram::BUCKET_COUNT; ++i) {
+		count += histogram.getBucketCount(i);
+
+		auto bucketLabels = labels;
+		bucketLabels.emplace_back(
+			"le", 
+			i < MetricsHistogram::BUCKET_COUNT ? formatBound(MetricsHistogram::BUCKETS[i]) : "+Inf"
+		);
+
+		family.samples.push_back(Sample{ baseName + "_bucket", std::move(bucketLabels), static_cast<double>(count) });
+	}
+
+	const auto sum = std::chrono::duration<double>(histogram.getSum()).count();
+	family.samples.push_back(Sample{ baseName + "_sum", labels, sum });
+	family.samples.push_back(Sample{ baseName + "_count", std::move(labels), static_cast<double>(histogram.getCount()) });
+}
+
+const std::vector<Metrics::Family>& Metrics::Writer::getFamilies() const noexcept {
+	return m_families;
+}
+
+Metrics::Family& Metrics::Writer::getFamily(std::string_view name, std::string_view help, Type type) {
+	auto ite = std::find_if(
+		m_families.begin(), m_families.end(),
+		[name] (const Family& family) -> bool {
+			return family.name == name;
+		}
+	);
+
+	if(ite == m_families.end()) {
+		m_families.push_back(Family{ std::string(name), std::string(help), type, {} });
+		ite = std::prev(m_families.end());
+	}
+
+	assert(ite->type == type);
+	return *ite;
+}
+
+
+
+/*
+ * Metrics
+ */
+
+static std::mutex& getCollectorMutex() noexcept {
+	static std::mutex mutex;
+	return mutex;
+}
+
+static std::map<Metrics::CollectorId, Metrics::Collector>& getCollectors() noexcept {
+	static std::map<Metrics::CollectorId, Metrics::Collector> collectors;
+	return collectors;
+}
+
+static void writePrometheusLabels(std::ostream& os, const Metrics::Labels& labels) {
+	if(!labels.empty()) {
+		os << '{';
+
+		for(size_t i = 0; i < labels.size(); ++i) {
+			if(i > 0) {
+				os << ',';
+			}
+
+			os << labels[i].first << "=\"";
+			for(const auto c : labels[i].second) {
+				switch(c) {
+				case '\\':	os << "\\\\"; break;
+				case '"':	os << "\\\""; break;
+				case '\n':	os << "\\n"; break;
+				default:	os << c; break;
+				}
+			}
+			os << '"';
+		}
+
+		os << '}';
+	}
+}
+
+static void writePrometheusValue(std::ostream& os, double value) {
+	if(std::isinf(value)) {
+		os << (value > 0 ? "+Inf" : "-Inf");
+	} else if(std::isnan(value)) {
+		os << "NaN";
+	} else {
+		os << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+	}
+}
+
+
+
+Metrics::CollectorId Metrics::addCollector(Collector collector) {
+	static CollectorId nextId = 0;
+
+	std::lock_guard<std::mutex> lock(getCollectorMutex());
+	const auto id = nextId++;
+	getCollectors().emplace(id, std::move(collector));
+	return id;
+}
+
+void Metrics::removeCollector(CollectorId id) {
+	std::lock_guard<std::mutex> lock(getCollectorMutex());
+	getCollectors().erase(id);
+}
+
+
+void Metrics::collect(Writer& writer) {
+	std::lock_guard<std::mutex> lock(getCollectorMutex());
+	for(const auto& collector : getCollectors()) {
+		collector.second(writer);
+	}
+}
+
+void Metrics::writePrometheus(std::ostream& os) {
+	Writer writer;
+	collect(writer);
+
+	const auto precision = os.precision();
+	for(const auto& family : writer.getFamilies()) {
+		os << "# HELP " << family.name << ' ' << family.help << '\n';
+		os << "# TYPE " << family.name << ' ' << toString(family.type) << '\n';
+
+		for(const auto& sample : family.samples) {
+			os << sample.name;
+			writePrometheusLabels(os, sample.labels);
+			os << ' ';
+			writePrometheusValue(os, sample.value);
+			os << '\n';
+		}
+	}
+	os.precision(precision);
+}
+
+}
\ No newline at end of file
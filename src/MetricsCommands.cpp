@@ -0,0 +1,76 @@
+#include <Metrics.h>
+
+#include <Control/Controller.h>
+#include <Control/Node.h>
+#include <Control/Message.h>
+
+#include <sstream>
+
+namespace Cenital {
+
+using namespace Zuazo;
+using namespace Control;
+
+static std::string getSampleKey(const Metrics::Sample& sample) {
+	std::ostringstream oss;
+
+	oss << sample.name;
+	if(!sample.labels.empty()) {
+		oss << '{';
+		for(size_t i = 0; i < sample.labels.size(); ++i) {
+			if(i > 0) {
+				oss << ',';
+			}
+			oss << sample.labels[i].first << '=' << sample.labels[i].second;
+		}
+		oss << '}';
+	}
+
+	return oss.str();
+}
+
+static std::string getSampleValue(const Metrics::Sample& sample) {
+	std::ostringstream oss;
+	oss << sample.value;
+	return oss.str();
+}
+
+static void getMetrics(	Controller&,
+						ZuazoBase&,
+						const Message& request,
+						size_t level,
+						Message& response )
+{
+	const auto& tokens = request.getPayload();
+
+	//Optionally, only the families starting with the given prefix are returned
+	if(tokens.size() == level || tokens.size() == level + 1) {
+		const std::string_view prefix = tokens.size() > level ? std::string_view(tokens[level]) : std::string_view();
+
+		Metrics::Writer writer;
+		Metrics::collect(writer);
+
+		response.setType(Message::Type::response);
+		auto& payload = response.getPayload();
+		payload.clear();
+
+		for(const auto& family : writer.getFamilies()) {
+			if(family.name.compare(0, prefix.size(), prefix) == 0) {
+				for(const auto& sample : family.samples) {
+					payload.emplace_back(getSampleKey(sample));
+					payload.emplace_back(getSampleValue(sample));
+				}
+			}
+		}
+	}
+}
+
+
+
+void Metrics::registerCommands(Controller& controller) {
+	auto& rootNode = controller.getRootNode();
+
+	rootNode.addPath("metrics",			Cenital::getMetrics);
+}
+
+}
\ No newline at end of file
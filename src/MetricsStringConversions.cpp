@@ -0,0 +1,18 @@
+#include <Metrics.h>
+
+#include <zuazo/StringConversions.h>
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Metrics::Type type) noexcept {
+	switch(type){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Metrics::Type, counter )
+	ZUAZO_ENUM2STR_CASE( Cenital::Metrics::Type, gauge )
+	ZUAZO_ENUM2STR_CASE( Cenital::Metrics::Type, histogram )
+
+	default: return "";
+	}
+}
+
+}
\ No newline at end of file
@@ -2,17 +2,27 @@
 
 #include <Transitions/Mix.h>
 #include <Transitions/DVE.h>
+#include <Transitions/Wipe.h>
+#include <Transitions/Stinger.h>
 #include <Overlays/Keyer.h>
+#include <Easing.h>
+#include <FrameClock.h>
+#include <Profiling.h>
 
 #include <zuazo/Player.h>
 #include <zuazo/Signal/DummyPad.h>
 #include <zuazo/Renderers/Compositor.h>
 #include <zuazo/Layers/VideoSurface.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <vector>
 #include <utility>
 #include <bitset>
+#include <cmath>
+#include <optional>
+#include <unordered_map>
 
 namespace Cenital {
 
@@ -46,6 +56,14 @@ struct MixEffectImpl {
 		Overlay(std::unique_ptr<Overlays::Base> overlay = nullptr)
 			: m_overlay(std::move(overlay))
 			, m_state()
+			, m_autoEffect(MixEffect::OverlayEffect::mix)
+			, m_autoDuration(std::chrono::seconds(1))
+			, m_autoProgress(0.0f)
+			, m_autoClock()
+			, m_basePosition()
+			, m_baseOpacity(1.0f)
+			, m_appliedPosition()
+			, m_appliedOpacity(1.0f)
 		{
 		}
 		Overlay(Overlay&& other) = default;
@@ -55,6 +73,7 @@ struct MixEffectImpl {
 
 
 		std::unique_ptr<Overlays::Base> setOverlay(std::unique_ptr<Overlays::Base> overlay) {
+			stopAuto();
 			std::swap(m_overlay, overlay);
 			return overlay;
 		}
@@ -109,10 +128,162 @@ struct MixEffectImpl {
 			return m_state[TRANSITION_ENABLED_BIT];
 		}
 
+
+		void setAutoEffect(MixEffect::OverlayEffect effect) noexcept {
+			m_autoEffect = effect;
+		}
+
+		MixEffect::OverlayEffect getAutoEffect() const noexcept {
+			return m_autoEffect;
+		}
+
+		void setAutoDuration(Duration duration) noexcept {
+			m_autoDuration = duration;
+		}
+
+		Duration getAutoDuration() const noexcept {
+			return m_autoDuration;
+		}
+
+		bool isAutoPlaying() const noexcept {
+			return m_state[AUTO_PLAYING_BIT];
+		}
+
+		void startAuto() {
+			if(m_overlay) {
+				if(isAutoPlaying()) {
+					//Reverse it from the current point
+					m_state.flip(AUTO_ENTERING_BIT);
+				} else {
+					//Save the resting state of the layer, as it will be modified
+					m_basePosition = m_appliedPosition = m_overlay->getTransform().getPosition();
+					m_baseOpacity = m_appliedOpacity = m_overlay->getOpacity();
+
+					//Enter if hidden and leave otherwise. The overlay 
+					//is shown while it is being animated
+					m_state[AUTO_ENTERING_BIT] = !getVisible();
+					m_autoProgress = getVisible() ? 1.0f : 0.0f;
+					m_autoClock.reset();
+					m_state[AUTO_PLAYING_BIT] = true;
+					setVisible(true);
+				}
+			}
+		}
+
+		void advanceAuto(Duration deltaTime, Duration period, Math::Vec2f viewportSize) {
+			assert(isAutoPlaying());
+			assert(m_overlay);
+
+			//Advance the progress on the appropriate direction
+			const bool entering = m_state[AUTO_ENTERING_BIT];
+			if(period > Duration::zero()) {
+				//Clock it in whole output frames, as the transitions. The
+				//progress is kept on the frame grid, so that it always lasts
+				//the same amount of frames
+				const auto frameCount = FrameClock::getFrameCount(m_autoDuration, period);
+				const auto elapsedFrames = m_autoClock.advance(deltaTime, period);
+				const auto step = (frameCount > 0) ? 
+					static_cast<float>(elapsedFrames) / frameCount : 
+					1.0f ;
+				m_autoProgress = Math::clamp(m_autoProgress + (entering ? step : -step), 0.0f, 1.0f);
+				if(frameCount > 0) {
+					m_autoProgress = std::round(m_autoProgress*frameCount) / frameCount;
+				}
+			} else {
+				//Frame rate is unknown, advance by the wall-clock
+				const auto step = (m_autoDuration > Duration::zero()) ?
+					std::chrono::duration_cast<std::chrono::duration<float>>(deltaTime) / 
+					std::chrono::duration_cast<std::chrono::duration<float>>(m_autoDuration) :
+					1.0f ;
+				m_autoProgress = Math::clamp(m_autoProgress + (entering ? step : -step), 0.0f, 1.0f);
+			}
+
+			if(m_autoProgress == (entering ? 1.0f : 0.0f)) {
+				//Ended. Hide if it was leaving
+				stopAuto();
+				setVisible(entering);
+			} else {
+				//Only the position and opacity of the layer are modified, 
+				//so that the layers don't need to be reconfigured. They are
+				//applied as an offset and a factor over the resting state
+				updateBase();
+				const auto x = evaluateEasingCurve(EASE_IN_OUT_CURVE, m_autoProgress);
+				auto offset = Math::Vec3f(0.0f, 0.0f, 0.0f);
+				auto factor = 1.0f;
+
+				switch(m_autoEffect) {
+				case MixEffect::OverlayEffect::flyLeft:
+					offset = (x - 1.0f)*Math::Vec3f(viewportSize.x, 0.0f, 0.0f);
+					break;
+				case MixEffect::OverlayEffect::flyRight:
+					offset = (1.0f - x)*Math::Vec3f(viewportSize.x, 0.0f, 0.0f);
+					break;
+				case MixEffect::OverlayEffect::flyTop:
+					offset = (1.0f - x)*Math::Vec3f(0.0f, viewportSize.y, 0.0f);
+					break;
+				case MixEffect::OverlayEffect::flyBottom:
+					offset = (x - 1.0f)*Math::Vec3f(0.0f, viewportSize.y, 0.0f);
+					break;
+				default: //mix
+					factor = x;
+					break;
+				}
+
+				apply(m_basePosition + offset, m_baseOpacity*factor);
+			}
+		}
+
+		void stopAuto() {
+			if(isAutoPlaying()) {
+				//Restore the resting state of the layer
+				if(m_overlay) {
+					updateBase();
+					apply(m_basePosition, m_baseOpacity);
+				}
+
+				m_state[AUTO_PLAYING_BIT] = false;
+			}
+		}
+
 	private:
+		void updateBase() {
+			assert(m_overlay);
+
+			//Values which differ from the ones applied by the auto have
+			//been set meanwhile (i.e. by a command or an animation), so 
+			//they become the resting state. Compared per component, as
+			//animations may only set some of them
+			const auto select = [] (float current, float applied, float base) -> float {
+				return (current != applied) ? current : base;
+			};
+
+			const auto& position = m_overlay->getTransform().getPosition();
+			m_basePosition = Math::Vec3f(
+				select(position.x, m_appliedPosition.x, m_basePosition.x),
+				select(position.y, m_appliedPosition.y, m_basePosition.y),
+				select(position.z, m_appliedPosition.z, m_basePosition.z)
+			);
+			m_baseOpacity = select(m_overlay->getOpacity(), m_appliedOpacity, m_baseOpacity);
+		}
+
+		void apply(const Math::Vec3f& position, float opacity) {
+			assert(m_overlay);
+
+			//The rest of the transform is kept as is
+			auto transform = m_overlay->getTransform();
+			transform.setPosition(position);
+			m_overlay->setTransform(transform);
+			m_overlay->setOpacity(opacity);
+
+			m_appliedPosition = position;
+			m_appliedOpacity = opacity;
+		}
+
 		enum Bits {
 			VISIBLE_BIT,
 			TRANSITION_ENABLED_BIT,
+			AUTO_PLAYING_BIT,
+			AUTO_ENTERING_BIT,
 
 			BIT_COUNT
 		};
@@ -120,6 +291,15 @@ struct MixEffectImpl {
 		std::unique_ptr<Overlays::Base>		m_overlay;
 		std::bitset<BIT_COUNT>				m_state;
 
+		MixEffect::OverlayEffect			m_autoEffect;
+		Duration							m_autoDuration;
+		float								m_autoProgress;
+		FrameClock							m_autoClock;
+		Math::Vec3f							m_basePosition;
+		float								m_baseOpacity;
+		Math::Vec3f							m_appliedPosition;
+		float								m_appliedOpacity;
+
 	};
 
 	using Input = Signal::DummyPad<Video>;
@@ -127,6 +307,8 @@ struct MixEffectImpl {
 	using Compositor = Renderers::Compositor;
 	using VideoSurface = Layers::VideoSurface;
 	using TransitionMap = std::unordered_map<std::string_view, std::unique_ptr<Transitions::Base>>;
+	using SourcePtr = decltype(std::declval<const Signal::PadProxy<Signal::Input<Video>>&>().getSource());
+	using InputIndexMap = std::unordered_map<SourcePtr, size_t>;
 	
 	static constexpr auto UPDATE_PRIORITY = Instance::playerPriority; //Animation-like
 	static constexpr auto OUTPUT_BUS_CNT = static_cast<size_t>(MixEffect::OutputBus::count);
@@ -135,50 +317,82 @@ struct MixEffectImpl {
 	std::reference_wrapper<MixEffect>				owner;
 
 	std::vector<Input>								inputs;
+	InputIndexMap									inputIndices;
 	std::array<Output, OUTPUT_BUS_CNT>				outputs;
+	std::array<Output, OUTPUT_BUS_CNT>				cleanOutputs;
 
 	std::array<Compositor, OUTPUT_BUS_CNT> 			compositors;
 	std::array<Compositor, OUTPUT_BUS_CNT> 			intermediateCompositors;
+	std::array<Compositor, OUTPUT_BUS_CNT> 			cleanCompositors;
 	Compositor&										referenceCompositor;
 
 	std::array<VideoSurface, OUTPUT_BUS_CNT> 		backgroundLayers;
-	VideoSurface									intermediateLayer;
+	std::array<VideoSurface, OUTPUT_BUS_CNT> 		intermediateLayers;
+	std::array<VideoSurface, OUTPUT_BUS_CNT> 		cleanLayers;
+	std::bitset<OUTPUT_BUS_CNT>						cleanFeedEnabled;
+	bool											transitionConfigured;
+	bool											upstreamShared;
 
 	TransitionMap									transitions;
 	TransitionMap::iterator							selectedTransition;
 	MixEffect::OutputBus							transitionSlot;
 	Duration										transitionDuration;
+	std::optional<size_t>							transitionRate;
+	FrameClock										transitionClock;
 
 	std::array<std::vector<Overlay>, OVERLAY_CNT>	overlays;
 
+	MixEffect::TallyCallback						tallyCallback;
+	MixEffect::OverlayAnimationCallback				overlayAnimationCallback;
+
 	MixEffectImpl(	MixEffect& owner, 
 					Instance& instance,
 					const std::string& name )
 		: owner(owner)
 		, inputs{}
+		, inputIndices{}
 		, outputs{
 			Output(owner, "pgmOut"), 
 			Output(owner, "pvwOut") }
+		, cleanOutputs{
+			Output(owner, "pgmCleanOut"), 
+			Output(owner, "pvwCleanOut") }
 		, compositors{
 			Compositor(instance, name + " - Program Compositor"),
 			Compositor(instance, name + " - Preview Compositor") }
 		, intermediateCompositors{
 			Compositor(instance, name + " - Program Intermediate Compositor"),
 			Compositor(instance, name + " - Preview Intermediate Compositor") }
+		, cleanCompositors{
+			Compositor(instance, name + " - Program Clean Compositor"),
+			Compositor(instance, name + " - Preview Clean Compositor") }
 		, referenceCompositor(compositors.front()) //Arbitrarily choosen
 		, backgroundLayers{
 			createBackgroundLayer(instance, name + " - Program Layer", referenceCompositor),
 			createBackgroundLayer(instance, name + " - Preview Layer", referenceCompositor) }
-		, intermediateLayer(createBackgroundLayer(instance, name + " - Intermediary Layer", referenceCompositor))
+		, intermediateLayers{
+			createBackgroundLayer(instance, name + " - Program Intermediary Layer", referenceCompositor),
+			createBackgroundLayer(instance, name + " - Preview Intermediary Layer", referenceCompositor) }
+		, cleanLayers{
+			createBackgroundLayer(instance, name + " - Program Clean Layer", referenceCompositor),
+			createBackgroundLayer(instance, name + " - Preview Clean Layer", referenceCompositor) }
+		, cleanFeedEnabled()
+		, transitionConfigured(false)
+		, upstreamShared(false)
 		, transitions()
 		, selectedTransition(transitions.end())
 		, transitionSlot(MixEffect::OutputBus::program)
 		, transitionDuration(std::chrono::seconds(1))
+		, transitionRate()
+		, transitionClock()
 		, overlays{}
+		, tallyCallback()
+		, overlayAnimationCallback()
 	{
 		//Route the signals
 		for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
 			outputs[i] << compositors[i];
+			cleanOutputs[i] << cleanCompositors[i];
 		}
 
 		//Configure the callbacks
@@ -206,6 +420,10 @@ struct MixEffectImpl {
 		for(auto& pad : outputs) {
 			pad.setLayout(base);
 		}
+
+		for(auto& pad : cleanOutputs) {
+			pad.setLayout(base);
+		}
 		
 	}
 
@@ -217,9 +435,11 @@ struct MixEffectImpl {
 		for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
 			openHelper(compositors[i], lock);
 			openHelper(intermediateCompositors[i], lock);
+			openHelper(cleanCompositors[i], lock);
 			openHelper(backgroundLayers[i], lock);
+			openHelper(intermediateLayers[i], lock);
+			openHelper(cleanLayers[i], lock);
 		}
-		openHelper(intermediateLayer, lock);
 
 		for(auto& overlaySlot : overlays) {
 			for(auto& overlay : overlaySlot) {
@@ -256,9 +476,11 @@ struct MixEffectImpl {
 		for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
 			closeHelper(compositors[i], lock);
 			closeHelper(intermediateCompositors[i], lock);
+			closeHelper(cleanCompositors[i], lock);
 			closeHelper(backgroundLayers[i], lock);
+			closeHelper(intermediateLayers[i], lock);
+			closeHelper(cleanLayers[i], lock);
 		}
-		closeHelper(intermediateLayer, lock);
 
 		for(auto& overlaySlot : overlays) {
 			for(auto& overlay : overlaySlot) {
@@ -285,25 +507,61 @@ struct MixEffectImpl {
 	}
 
 	void update() {
+		CENITAL_PROFILE_SCOPE("MixEffect::update");
+		const auto deltaTime = owner.get().getInstance().getDeltaT();
 		auto* transition = getSelectedTransition();
 
 		//Act as a player for the transition
 		if(transition) {
 			if(transition->isPlaying()) {
-				const auto deltaTime = owner.get().getInstance().getDeltaT();
-
-				//Advance the time for the transition
+				const auto period = getFramePeriod();
 				transition->setRepeat(ClipBase::Repeat::none); //Ensure that it won't repeat
-				transition->setDuration(transitionDuration);
-				transition->advanceNormalSpeed(deltaTime);
+
+				if(period > Duration::zero()) {
+					//Clock the transition in whole output frames, so that it always
+					//produces the same amount of distinct frames
+					const auto frameCount = getTransitionFrameCount(*transition, period);
+					const auto elapsedFrames = transitionClock.advance(deltaTime, period);
+
+					transition->setDuration(frameCount * period);
+					transition->setTime(std::min(
+						transition->getTime() + elapsedFrames * period, 
+						TimePoint(transition->getDuration())
+					));
+				} else {
+					//Frame rate is unknown, advance by the wall-clock
+					transition->setDuration(transitionDuration);
+					transition->advanceNormalSpeed(deltaTime);
+				}
 
 				//If transition has ended, cut. This will also stop and rewind the transition
+				//As this happens outside any command, let the tally know about it
 				if(transition->getTime().time_since_epoch() == transition->getDuration()) {
 					finishTransition();
+					Utils::invokeIf(tallyCallback, owner.get());
 				}
 			}
 		}
 
+		//Act as a player for the overlays. Layers only need to be 
+		//reconfigured when an overlay has left
+		bool overlaysChanged = false;
+		const auto viewportSize = referenceCompositor.getViewportSize();
+		const auto period = getFramePeriod();
+		for(auto& overlaySlot : overlays) {
+			for(auto& overlay : overlaySlot) {
+				if(overlay.isAutoPlaying()) {
+					overlay.advanceAuto(deltaTime, period, viewportSize);
+					overlaysChanged = overlaysChanged || !overlay.getVisible();
+				}
+			}
+		}
+
+		if(overlaysChanged) {
+			configureLayers(isTransitionConfigured());
+			Utils::invokeIf(tallyCallback, owner.get());
+		}
+
 	}
 
 
@@ -321,6 +579,7 @@ struct MixEffectImpl {
 
 		for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
 			compositors[i].setVideoMode(videoMode);
+			cleanCompositors[i].setVideoMode(videoMode);
 			intermediateCompositors[i].setVideoMode(intermediateVideoMode);
 		}
 	}
@@ -374,13 +633,18 @@ struct MixEffectImpl {
 				}
 			}
 
-			//Register all the pads again
-			for(auto& input : inputs) {
-				mixEffect.registerPad(input.getInput());
+			//Register all the pads again and rebuild the reverse
+			//lookup table, as addresses might have changed
+			inputIndices.clear();
+			inputIndices.reserve(inputs.size());
+			for(size_t i = 0; i < inputs.size(); ++i) {
+				mixEffect.registerPad(inputs[i].getInput());
+				inputIndices.emplace(&inputs[i].getOutput(), i);
 			}
 		}
 
 		assert(inputs.size() == count);
+		assert(inputIndices.size() == count);
 	}
 
 	size_t getInputCount() const noexcept {
@@ -404,9 +668,34 @@ struct MixEffectImpl {
 		return outputs.at(static_cast<size_t>(bus)).getOutput();
 	}
 
+	MixEffect::Output& getCleanOutput(MixEffect::OutputBus bus) noexcept {
+		return cleanOutputs.at(static_cast<size_t>(bus)).getOutput();
+	}
+
+	const MixEffect::Output& getCleanOutput(MixEffect::OutputBus bus) const noexcept {
+		return cleanOutputs.at(static_cast<size_t>(bus)).getOutput();
+	}
+
+	void setCleanFeedEnabled(MixEffect::OutputBus bus, bool ena) {
+		const auto index = static_cast<size_t>(bus);
+		if(cleanFeedEnabled.test(index) != ena) {
+			cleanFeedEnabled.set(index, ena);
+			configureLayers(isTransitionConfigured());
+		}
+	}
+
+	bool getCleanFeedEnabled(MixEffect::OutputBus bus) const {
+		return cleanFeedEnabled.test(static_cast<size_t>(bus));
+	}
+
 
 	void setBackground(MixEffect::OutputBus bus, size_t idx) {
 		setSource(backgroundLayers.at(static_cast<size_t>(bus)).getInput(), idx);
+
+		//Upstream sharing depends on the backgrounds
+		if(isTransitionConfigured() || cleanFeedEnabled.any()) {
+			configureLayers(isTransitionConfigured());
+		}
 	}
 
 	size_t getBackground(MixEffect::OutputBus bus) const noexcept {
@@ -451,6 +740,7 @@ struct MixEffectImpl {
 
 		if(transition) {
 			//Start playing
+			transitionClock.reset();
 			transition->play();
 
 			//Configure the layers if necessary
@@ -534,8 +824,7 @@ struct MixEffectImpl {
 			transition->setSize(referenceCompositor.getViewportSize());
 
 			//Route the intermediate compositions to the transition
-			transition->getPrevIn() << intermediateCompositors[static_cast<size_t>(MixEffect::OutputBus::program)];
-			transition->getPostIn() << intermediateCompositors[static_cast<size_t>(MixEffect::OutputBus::preview)];
+			routeTransition(*transition);
 
 			//Store the reference to the transition, as rehashing might invalidate iterators
 			const auto* selected = getSelectedTransition();
@@ -611,10 +900,57 @@ struct MixEffectImpl {
 
 	void setTransitionDuration(Duration duration) {
 		transitionDuration = duration;
+		transitionRate.reset();
 	}
 
 	Duration getTransitionDuration() const noexcept {
-		return transitionDuration;
+		//Rate is expressed in frames, so it can only be 
+		//converted when the frame rate is known
+		const auto period = getFramePeriod();
+		return (transitionRate.has_value() && period > Duration::zero()) ?
+			static_cast<Duration::rep>(transitionRate.value()) * period :
+			transitionDuration ;
+	}
+
+	void setTransitionRate(size_t frames) {
+		//Keep it in frames, so that it is applied once the frame
+		//rate is known and it is preserved when it changes
+		transitionRate = frames;
+	}
+
+	size_t getTransitionRate() const noexcept {
+		size_t result = 0;
+
+		if(transitionRate.has_value()) {
+			result = transitionRate.value();
+		} else {
+			//Round to the nearest frame count
+			const auto period = getFramePeriod();
+			if(period > Duration::zero()) {
+				result = static_cast<size_t>(FrameClock::getFrameCount(transitionDuration, period));
+			}
+		}
+
+		return result;
+	}
+
+	FrameClock::FrameCount getTransitionFrameCount(	const Transitions::Base& transition,
+													Duration period ) const noexcept
+	{
+		//Stingers last as long as their clip, so that it is played frame by frame
+		const auto* stinger = dynamic_cast<const Transitions::Stinger*>(&transition);
+		if(stinger && stinger->getFrameCount() > 0) {
+			return static_cast<FrameClock::FrameCount>(stinger->getFrameCount());
+		}
+
+		return transitionRate.has_value() ?
+			static_cast<FrameClock::FrameCount>(transitionRate.value()) :
+			FrameClock::getFrameCount(transitionDuration, period) ;
+	}
+
+	Duration getFramePeriod() const noexcept {
+		const auto frameRate = owner.get().getVideoMode().getFrameRateValue();
+		return (frameRate > Rate(0)) ? getPeriod(frameRate) : Duration::zero();
 	}
 
 
@@ -647,6 +983,8 @@ struct MixEffectImpl {
 			if(me.isOpen()) {
 				selection.back().getOverlay()->open();
 			}
+
+			installAnimationCallback(selection.back().getOverlay());
 		}
 
 		//Remove elements if necessary
@@ -661,7 +999,15 @@ struct MixEffectImpl {
 
 	std::unique_ptr<Overlays::Base> setOverlay(MixEffect::OverlaySlot slot, size_t idx, std::unique_ptr<Overlays::Base> overlay) {
 		auto result = findOverlay(slot, idx).setOverlay(std::move(overlay));
+		installAnimationCallback(getOverlay(slot, idx));
 		configureLayers(isTransitionConfigured());
+
+		//The previous overlay no longer belongs to us
+		auto* keyer = dynamic_cast<Overlays::Keyer*>(result.get());
+		if(keyer) {
+			keyer->setAnimationCallback({});
+		}
+
 		return result;
 	}
 
@@ -674,7 +1020,9 @@ struct MixEffectImpl {
 	}
 
 	void setOverlayVisible(MixEffect::OverlaySlot slot, size_t idx, bool visible) {
-		findOverlay(slot, idx).setVisible(visible);
+		auto& overlay = findOverlay(slot, idx);
+		overlay.stopAuto();
+		overlay.setVisible(visible);
 		configureLayers(isTransitionConfigured());
 	}
 
@@ -699,8 +1047,115 @@ struct MixEffectImpl {
 		return getSource(Signal::getInput<Video>(*getOverlay(slot, overlay), port));
 	}
 
+	void autoOverlay(MixEffect::OverlaySlot slot, size_t idx) {
+		auto& overlay = findOverlay(slot, idx);
+		const bool wasVisible = overlay.getVisible();
+		overlay.startAuto();
+
+		//Layers only need to be reconfigured when it becomes visible
+		if(overlay.getVisible() != wasVisible) {
+			configureLayers(isTransitionConfigured());
+		}
+	}
+
+	bool isOverlayAutoPlaying(MixEffect::OverlaySlot slot, size_t idx) const {
+		return findOverlay(slot, idx).isAutoPlaying();
+	}
+
+	void setOverlayAutoEffect(MixEffect::OverlaySlot slot, size_t idx, MixEffect::OverlayEffect effect) {
+		findOverlay(slot, idx).setAutoEffect(effect);
+	}
+
+	MixEffect::OverlayEffect getOverlayAutoEffect(MixEffect::OverlaySlot slot, size_t idx) const {
+		return findOverlay(slot, idx).getAutoEffect();
+	}
+
+	void setOverlayAutoDuration(MixEffect::OverlaySlot slot, size_t idx, Duration duration) {
+		findOverlay(slot, idx).setAutoDuration(duration);
+	}
+
+	Duration getOverlayAutoDuration(MixEffect::OverlaySlot slot, size_t idx) const {
+		return findOverlay(slot, idx).getAutoDuration();
+	}
+
+
+	std::vector<MixEffect::Tally> getTally(bool includeDownstream = true) const {
+		std::vector<MixEffect::Tally> result(inputs.size(), MixEffect::Tally::none);
+
+		//When a transition is taking place on the program bus, the
+		//upstream composition of the preview bus is also on air.
+		const bool onAirTransition = 	isTransitionConfigured() && 
+										transitionSlot == MixEffect::OutputBus::program;
+
+		for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
+			const auto outputBus = static_cast<MixEffect::OutputBus>(i);
+			const auto busFlags = (outputBus == MixEffect::OutputBus::program) ? 
+									MixEffect::Tally::program : 
+									MixEffect::Tally::preview ;
+			const auto upstreamFlags = 	(onAirTransition && outputBus == MixEffect::OutputBus::preview) ?
+										(busFlags | MixEffect::Tally::program) :
+										busFlags ;
+
+			//Background
+			addTally(result, backgroundLayers[i].getInput(), upstreamFlags);
+
+			//Upstream overlays
+			for(const auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::upstream)]) {
+				if(overlay.isRendered(outputBus)) {
+					addTally(result, overlay, upstreamFlags);
+				}
+			}
+
+			//Downstream overlays. They are not part of the clean feeds
+			if(includeDownstream) {
+				for(const auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::downstream)]) {
+					if(overlay.isRendered(outputBus)) {
+						addTally(result, overlay, busFlags);
+					}
+				}
+			}
+		}
+
+		return result;
+	}
+
+	void setTallyCallback(MixEffect::TallyCallback cbk) {
+		tallyCallback = std::move(cbk);
+	}
+
+	const MixEffect::TallyCallback& getTallyCallback() const noexcept {
+		return tallyCallback;
+	}
+
+	void setOverlayAnimationCallback(MixEffect::OverlayAnimationCallback cbk) {
+		overlayAnimationCallback = std::move(cbk);
+	}
+
+	const MixEffect::OverlayAnimationCallback& getOverlayAnimationCallback() const noexcept {
+		return overlayAnimationCallback;
+	}
+
 
 private:
+	void installAnimationCallback(Overlays::Base* overlay) {
+		//Keyers report the end of their animations from their update,
+		//so forward it along with the location of the overlay
+		auto* keyer = dynamic_cast<Overlays::Keyer*>(overlay);
+		if(keyer) {
+			keyer->setAnimationCallback(
+				[this] (Overlays::Keyer& animated) -> void {
+					for(size_t i = 0; i < overlays.size(); ++i) {
+						for(size_t j = 0; j < overlays[i].size(); ++j) {
+							if(overlays[i][j].getOverlay() == &animated) {
+								Utils::invokeIf(overlayAnimationCallback, owner.get(), static_cast<MixEffect::OverlaySlot>(i), j);
+							}
+						}
+					}
+				}
+			);
+		}
+	}
+
 	void setSource(Signal::PadProxy<Signal::Input<Video>>& pad, size_t idx) {
 		if(idx < inputs.size()) {
 			pad << inputs.at(idx);
@@ -714,25 +1169,42 @@ private:
 
 		const auto source = pad.getSource();
 		if(source) {
-			//Find the source among the inputs. This could be done
-			//with some ptr trickery in O(1) time, however, it would
-			//be ugly. Hope the compiler does it
-			const auto ite = std::find_if(
-				inputs.cbegin(), inputs.cend(),
-				[source] (const Input& input) {
-					return &input.getOutput() == source;
-				}
-			);
+			//Find the source among the inputs
+			const auto ite = inputIndices.find(source);
 
 			//The input should be valid
-			assert(ite != inputs.cend());
+			assert(ite != inputIndices.cend());
 
-			result = std::distance(inputs.cbegin(), ite);
+			if(ite != inputIndices.cend()) {
+				result = ite->second;
+			}
 		}
 
 		return result;
 	}
 
+	void addTally(	std::vector<MixEffect::Tally>& tally, 
+					const Signal::PadProxy<Signal::Input<Video>>& pad, 
+					MixEffect::Tally flags ) const noexcept
+	{
+		const auto index = getSource(pad);
+		if(index < tally.size()) {
+			tally[index] = tally[index] | flags;
+		}
+	}
+
+	void addTally(	std::vector<MixEffect::Tally>& tally, 
+					const Overlay& overlay, 
+					MixEffect::Tally flags ) const
+	{
+		const auto* layer = overlay.getOverlay();
+		assert(layer);
+
+		for(const Signal::PadProxy<Signal::Input<Video>>& pad : layer->getPads<Signal::Input<Video>>()) {
+			addTally(tally, pad, flags);
+		}
+	}
+
 
 	Overlay& findOverlay(MixEffect::OverlaySlot slot, size_t idx) {
 		return overlays.at(static_cast<size_t>(slot)).at(idx);
@@ -744,73 +1216,141 @@ private:
 	
 
 	bool isTransitionConfigured() const noexcept {
-		return intermediateLayer.getInput().getSource() != nullptr;
+		return transitionConfigured;
+	}
+
+	bool isUpstreamShareable() const {
+		constexpr auto programIndex = static_cast<size_t>(MixEffect::OutputBus::program);
+		constexpr auto previewIndex = static_cast<size_t>(MixEffect::OutputBus::preview);
+
+		//Both buses need to have the same background...
+		bool result = 	backgroundLayers[programIndex].getInput().getSource() == 
+						backgroundLayers[previewIndex].getInput().getSource() ;
+
+		//...and the same upstream overlays
+		for(const auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::upstream)]) {
+			if(!result) {
+				break;
+			}
+
+			result = 	overlay.isRendered(MixEffect::OutputBus::program) == 
+						overlay.isRendered(MixEffect::OutputBus::preview) ;
+		}
+
+		return result;
+	}
+
+	Compositor& getUpstreamCompositor(size_t bus) noexcept {
+		return intermediateCompositors[upstreamShared ? static_cast<size_t>(MixEffect::OutputBus::program) : bus];
+	}
+
+	void routeTransition(Transitions::Base& transition) {
+		transition.getPrevIn() << getUpstreamCompositor(static_cast<size_t>(MixEffect::OutputBus::program));
+		transition.getPostIn() << getUpstreamCompositor(static_cast<size_t>(MixEffect::OutputBus::preview));
 	}
 
 	void configureLayers(bool useTransition) {
+		CENITAL_PROFILE_SCOPE("MixEffect::configureLayers");
 		std::vector<RendererBase::LayerRef> layers;
 		auto* transition = getSelectedTransition();
+		useTransition = useTransition && transition;
 
-		if(transition && useTransition) {
-			//A transition is in progress. Configure USK and DSK separately
-			for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
-				const auto outputBus = static_cast<MixEffect::OutputBus>(i);
+		//When both buses render the same upstream image, only render it once.
+		//Intermediate compositions are only needed by the transitions
+		const bool shareUpstream = useTransition && isUpstreamShareable();
+		if(upstreamShared != shareUpstream) {
+			upstreamShared = shareUpstream;
 
-				//Obtain the upsetream layers
-				layers = { backgroundLayers[i] };
+			for(auto& entry : transitions) {
+				routeTransition(*entry.second);
+			}
+		}
 
-				for(auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::upstream)]) {
-					if(overlay.isRendered(outputBus)) {
-						layers.emplace_back(*overlay.getOverlay());
+		//Likewise, both clean feeds may show the same image
+		const bool shareClean = !useTransition && cleanFeedEnabled.all() && isUpstreamShareable();
+
+		for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
+			const auto outputBus = static_cast<MixEffect::OutputBus>(i);
+
+			//Obtain the upstream result
+			if(useTransition) {
+				//Configure USK and DSK separately
+				auto& upstreamCompositor = getUpstreamCompositor(i);
+
+				if(&upstreamCompositor == &intermediateCompositors[i]) {
+					layers = { backgroundLayers[i] };
+
+					for(auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::upstream)]) {
+						if(overlay.isRendered(outputBus)) {
+							layers.emplace_back(*overlay.getOverlay());
+						}
 					}
-				}
 
-				intermediateCompositors[i].setLayers(layers);
+					intermediateCompositors[i].setLayers(layers);
+				} else {
+					//Rendered by the other bus
+					intermediateCompositors[i].setLayers({});
+				}
 
-				//Obtain the downstream layers
 				if(outputBus == transitionSlot) {
 					//Transition is active on this bus
 					const auto transitionLayers = transition->getLayers();
 					layers.clear();
 					layers.insert(layers.cend(), transitionLayers.cbegin(), transitionLayers.cend());
+					intermediateLayers[i].getInput() << Signal::noSignal;
 				} else {
 					//Transition is not active on this layer. Use the intermediate layer
-					layers = { intermediateLayer };
-					intermediateLayer << intermediateCompositors[i];
+					layers = { intermediateLayers[i] };
+					intermediateLayers[i] << upstreamCompositor;
 				}
+			} else {
+				//The upstream layers are composited together with the rest
+				layers = { backgroundLayers[i] };
 
-				for(auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::downstream)]) {
+				for(auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::upstream)]) {
 					if(overlay.isRendered(outputBus)) {
 						layers.emplace_back(*overlay.getOverlay());
 					}
 				}
 
-				compositors[i].setLayers(layers);
+				//Signal that the intermediate compositing is not used
+				intermediateCompositors[i].setLayers({});
+				intermediateLayers[i].getInput() << Signal::noSignal;
 			}
-			
-		} else {
-			//Configure the downstream and upstream composition altogether
-			for(size_t i = 0; i < OUTPUT_BUS_CNT; ++i) {
-				const auto outputBus = static_cast<MixEffect::OutputBus>(i);
 
-				//Obtain the layers
-				layers = { backgroundLayers[i] };
-				
-				for(auto& overlaySlot : overlays) {
-					for(auto& overlay : overlaySlot) {
-						if(overlay.isRendered(outputBus)) {
-							layers.emplace_back(*overlay.getOverlay());
-						}
-					}
+			//When requested, the clean feed composites the upstream result
+			//and the program takes it as its only upstream layer. This way
+			//each layer belongs to a single compositor
+			if(cleanFeedEnabled[i]) {
+				auto& cleanCompositor = cleanCompositors[shareClean ? static_cast<size_t>(MixEffect::OutputBus::program) : i];
+
+				if(&cleanCompositor == &cleanCompositors[i]) {
+					cleanCompositors[i].setLayers(layers);
+				} else {
+					//Rendered by the other bus
+					cleanCompositors[i].setLayers({});
 				}
 
-				//Write changes
-				compositors[i].setLayers(layers);
+				cleanOutputs[i] << cleanCompositor;
+				cleanLayers[i] << cleanCompositor;
+				layers = { cleanLayers[i] };
+			} else {
+				cleanCompositors[i].setLayers({});
+				cleanOutputs[i] << cleanCompositors[i];
+				cleanLayers[i].getInput() << Signal::noSignal;
 			}
 
-			//Signal that the intermediate compositing is not used
-			intermediateLayer.getInput() << Signal::noSignal;
+			//Obtain the downstream layers
+			for(auto& overlay : overlays[static_cast<size_t>(MixEffect::OverlaySlot::downstream)]) {
+				if(overlay.isRendered(outputBus)) {
+					layers.emplace_back(*overlay.getOverlay());
+				}
+			}
+
+			compositors[i].setLayers(layers);
 		}
+
+		transitionConfigured = useTransition;
 	}
 
 	void configureCamera(Math::Vec2f viewportSize) {
@@ -832,6 +1372,10 @@ private:
 		for(auto& compositor : compositors) {
 			compositor.setCamera(camera);
 		}
+
+		for(auto& compositor : cleanCompositors) {
+			compositor.setCamera(camera);
+		}
 	}
 
 	void finishTransition() {
@@ -855,7 +1399,14 @@ private:
 		for(auto& bkgdLayer : backgroundLayers) {
 			bkgdLayer.setSize(size);
 		}
-		intermediateLayer.setSize(size);
+
+		for(auto& intermediateLayer : intermediateLayers) {
+			intermediateLayer.setSize(size);
+		}
+
+		for(auto& cleanLayer : cleanLayers) {
+			cleanLayer.setSize(size);
+		}
 
 		for(auto& transition : transitions) {
 			if(transition.second) {
@@ -915,6 +1466,8 @@ MixEffect::MixEffect(	Zuazo::Instance& instance,
 	//Register output pads
 	registerPad(getOutput(OutputBus::program));
 	registerPad(getOutput(OutputBus::preview));
+	registerPad(getCleanOutput(OutputBus::program));
+	registerPad(getCleanOutput(OutputBus::preview));
 
 	//Set compatibility to a known state
 	setVideoModeCompatibility((*this)->getVideoModeCompatibility());
@@ -929,6 +1482,8 @@ MixEffect::MixEffect(	Zuazo::Instance& instance,
 	//Add the default transitions
 	addTransition(Utils::makeUnique<Transitions::Mix>(instance, "Mix"));
 	addTransition(Utils::makeUnique<Transitions::DVE>(instance, "DVE"));
+	addTransition(Utils::makeUnique<Transitions::Wipe>(instance, "Wipe"));
+	addTransition(Utils::makeUnique<Transitions::Stinger>(instance, "Stinger"));
 	setSelectedTransition("Mix");
 }
 
@@ -965,6 +1520,22 @@ const MixEffect::Output& MixEffect::getOutput(OutputBus bus) const {
 	return (*this)->getOutput(bus);
 }
 
+MixEffect::Output& MixEffect::getCleanOutput(OutputBus bus) {
+	return (*this)->getCleanOutput(bus);
+}
+
+const MixEffect::Output& MixEffect::getCleanOutput(OutputBus bus) const {
+	return (*this)->getCleanOutput(bus);
+}
+
+void MixEffect::setCleanFeedEnabled(OutputBus bus, bool ena) {
+	(*this)->setCleanFeedEnabled(bus, ena);
+}
+
+bool MixEffect::getCleanFeedEnabled(OutputBus bus) const {
+	return (*this)->getCleanFeedEnabled(bus);
+}
+
 
 
 void MixEffect::setBackground(OutputBus bus, size_t idx) {
@@ -1049,6 +1620,14 @@ Duration MixEffect::getTransitionDuration() const noexcept {
 	return (*this)->getTransitionDuration();
 }
 
+void MixEffect::setTransitionRate(size_t frames) {
+	(*this)->setTransitionRate(frames);
+}
+
+size_t MixEffect::getTransitionRate() const noexcept {
+	return (*this)->getTransitionRate();
+}
+
 
 
 
@@ -1093,4 +1672,54 @@ size_t MixEffect::getOverlaySignal(OverlaySlot slot, size_t overlay, std::string
 	return (*this)->getOverlaySignal(slot, overlay, port);
 }
 
+void MixEffect::autoOverlay(OverlaySlot slot, size_t idx) {
+	(*this)->autoOverlay(slot, idx);
+}
+
+bool MixEffect::isOverlayAutoPlaying(OverlaySlot slot, size_t idx) const {
+	return (*this)->isOverlayAutoPlaying(slot, idx);
+}
+
+void MixEffect::setOverlayAutoEffect(OverlaySlot slot, size_t idx, OverlayEffect effect) {
+	(*this)->setOverlayAutoEffect(slot, idx, effect);
+}
+
+MixEffect::OverlayEffect MixEffect::getOverlayAutoEffect(OverlaySlot slot, size_t idx) const {
+	return (*this)->getOverlayAutoEffect(slot, idx);
+}
+
+void MixEffect::setOverlayAutoDuration(OverlaySlot slot, size_t idx, Duration duration) {
+	(*this)->setOverlayAutoDuration(slot, idx, duration);
+}
+
+Duration MixEffect::getOverlayAutoDuration(OverlaySlot slot, size_t idx) const {
+	return (*this)->getOverlayAutoDuration(slot, idx);
+}
+
+
+
+std::vector<MixEffect::Tally> MixEffect::getTally() const {
+	return (*this)->getTally();
+}
+
+std::vector<MixEffect::Tally> MixEffect::getCleanTally() const {
+	return (*this)->getTally(false);
+}
+
+void MixEffect::setTallyCallback(TallyCallback cbk) {
+	(*this)->setTallyCallback(std::move(cbk));
+}
+
+const MixEffect::TallyCallback& MixEffect::getTallyCallback() const noexcept {
+	return (*this)->getTallyCallback();
+}
+
+void MixEffect::setOverlayAnimationCallback(OverlayAnimationCallback cbk) {
+	(*this)->setOverlayAnimationCallback(std::move(cbk));
+}
+
+const MixEffect::OverlayAnimationCallback& MixEffect::getOverlayAnimationCallback() const noexcept {
+	return (*this)->getOverlayAnimationCallback();
+}
+
 }
\ No newline at end of file
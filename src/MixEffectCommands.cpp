@@ -229,6 +229,68 @@ static void getTransitionPreview(	Controller& controller,
 	);
 }
 
+static void setCleanFeedEnabled(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response,
+									MixEffect::OutputBus bus ) 
+{
+	invokeSetter<MixEffect, bool>( 
+		std::bind(&MixEffect::setCleanFeedEnabled, std::placeholders::_1, bus, std::placeholders::_2),
+		controller, base, request, level, response
+	);
+}
+
+static void getCleanFeedEnabled(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response,
+									MixEffect::OutputBus bus ) 
+{
+	invokeGetter<bool, MixEffect>( 
+		std::bind(&MixEffect::getCleanFeedEnabled, std::placeholders::_1, bus),
+		controller, base, request, level, response
+	);
+}
+
+static void setProgramCleanFeedEnabled(	Controller& controller,
+										ZuazoBase& base,
+										const Message& request,
+										size_t level,
+										Message& response ) 
+{
+	setCleanFeedEnabled(controller, base, request, level, response, MixEffect::OutputBus::program);
+}
+
+static void getProgramCleanFeedEnabled(	Controller& controller,
+										ZuazoBase& base,
+										const Message& request,
+										size_t level,
+										Message& response ) 
+{
+	getCleanFeedEnabled(controller, base, request, level, response, MixEffect::OutputBus::program);
+}
+
+static void setPreviewCleanFeedEnabled(	Controller& controller,
+										ZuazoBase& base,
+										const Message& request,
+										size_t level,
+										Message& response ) 
+{
+	setCleanFeedEnabled(controller, base, request, level, response, MixEffect::OutputBus::preview);
+}
+
+static void getPreviewCleanFeedEnabled(	Controller& controller,
+										ZuazoBase& base,
+										const Message& request,
+										size_t level,
+										Message& response ) 
+{
+	getCleanFeedEnabled(controller, base, request, level, response, MixEffect::OutputBus::preview);
+}
+
 static void setTransitionDuration(	Controller& controller,
 									ZuazoBase& base,
 									const Message& request,
@@ -253,6 +315,30 @@ static void getTransitionDuration(	Controller& controller,
 	);
 }
 
+static void setTransitionRate(	Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter<MixEffect, size_t>( 
+		&MixEffect::setTransitionRate,
+		controller, base, request, level, response
+	);
+}
+
+static void getTransitionRate(	Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter<size_t, MixEffect>( 
+		&MixEffect::getTransitionRate,
+		controller, base, request, level, response
+	);
+}
+
 
 
 
@@ -739,6 +825,255 @@ static void unsetDownstreamOverlayFeed(	Controller& controller,
 }
 
 
+static void autoOverlay(	Controller& controller,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response,
+						MixEffect::OverlaySlot slot ) 
+{
+	invokeSetter<MixEffect, size_t>(
+		std::bind(&MixEffect::autoOverlay, std::placeholders::_1, slot, std::placeholders::_2),
+		[slot] (const MixEffect& mixEffect, size_t index) -> bool {
+			return index < mixEffect.getOverlayCount(slot);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void getOverlayAutoPlaying(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response,
+									MixEffect::OverlaySlot slot ) 
+{
+	invokeGetter<bool, MixEffect, size_t>(
+		std::bind(&MixEffect::isOverlayAutoPlaying, std::placeholders::_1, slot, std::placeholders::_2),
+		[slot] (const MixEffect& mixEffect, size_t index) -> bool {
+			return index < mixEffect.getOverlayCount(slot);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void autoUpstreamOverlay(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	autoOverlay(controller, base, request, level, response, MixEffect::OverlaySlot::upstream);
+}
+
+static void getUpstreamOverlayAutoPlaying(	Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	getOverlayAutoPlaying(controller, base, request, level, response, MixEffect::OverlaySlot::upstream);
+}
+
+static void autoDownstreamOverlay(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response ) 
+{
+	autoOverlay(controller, base, request, level, response, MixEffect::OverlaySlot::downstream);
+}
+
+static void getDownstreamOverlayAutoPlaying(Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	getOverlayAutoPlaying(controller, base, request, level, response, MixEffect::OverlaySlot::downstream);
+}
+
+
+static void setOverlayAutoEffect(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response,
+									MixEffect::OverlaySlot slot ) 
+{
+	invokeSetter<MixEffect, size_t, MixEffect::OverlayEffect>(
+		std::bind(&MixEffect::setOverlayAutoEffect, std::placeholders::_1, slot, std::placeholders::_2, std::placeholders::_3),
+		[slot] (const MixEffect& mixEffect, size_t index, MixEffect::OverlayEffect effect) -> bool {
+			return 	index < mixEffect.getOverlayCount(slot) &&
+					effect > MixEffect::OverlayEffect::none && 
+					effect < MixEffect::OverlayEffect::count ;
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void getOverlayAutoEffect(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response,
+									MixEffect::OverlaySlot slot ) 
+{
+	invokeGetter<MixEffect::OverlayEffect, MixEffect, size_t>(
+		std::bind(&MixEffect::getOverlayAutoEffect, std::placeholders::_1, slot, std::placeholders::_2),
+		[slot] (const MixEffect& mixEffect, size_t index) -> bool {
+			return index < mixEffect.getOverlayCount(slot);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void enumOverlayAutoEffect(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response ) 
+{
+	enumerate<MixEffect::OverlayEffect>(controller, base, request, level, response);
+}
+
+static void setUpstreamOverlayAutoEffect(	Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	setOverlayAutoEffect(controller, base, request, level, response, MixEffect::OverlaySlot::upstream);
+}
+
+static void getUpstreamOverlayAutoEffect(	Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	getOverlayAutoEffect(controller, base, request, level, response, MixEffect::OverlaySlot::upstream);
+}
+
+static void setDownstreamOverlayAutoEffect(	Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	setOverlayAutoEffect(controller, base, request, level, response, MixEffect::OverlaySlot::downstream);
+}
+
+static void getDownstreamOverlayAutoEffect(	Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	getOverlayAutoEffect(controller, base, request, level, response, MixEffect::OverlaySlot::downstream);
+}
+
+
+static void setOverlayAutoDuration(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response,
+									MixEffect::OverlaySlot slot ) 
+{
+	invokeSetter<MixEffect, size_t, Duration>(
+		std::bind(&MixEffect::setOverlayAutoDuration, std::placeholders::_1, slot, std::placeholders::_2, std::placeholders::_3),
+		[slot] (const MixEffect& mixEffect, size_t index, Duration) -> bool {
+			return index < mixEffect.getOverlayCount(slot);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void getOverlayAutoDuration(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response,
+									MixEffect::OverlaySlot slot ) 
+{
+	invokeGetter<Duration, MixEffect, size_t>(
+		std::bind(&MixEffect::getOverlayAutoDuration, std::placeholders::_1, slot, std::placeholders::_2),
+		[slot] (const MixEffect& mixEffect, size_t index) -> bool {
+			return index < mixEffect.getOverlayCount(slot);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void setUpstreamOverlayAutoDuration(	Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	setOverlayAutoDuration(controller, base, request, level, response, MixEffect::OverlaySlot::upstream);
+}
+
+static void getUpstreamOverlayAutoDuration(	Controller& controller,
+											ZuazoBase& base,
+											const Message& request,
+											size_t level,
+											Message& response ) 
+{
+	getOverlayAutoDuration(controller, base, request, level, response, MixEffect::OverlaySlot::upstream);
+}
+
+static void setDownstreamOverlayAutoDuration(	Controller& controller,
+												ZuazoBase& base,
+												const Message& request,
+												size_t level,
+												Message& response ) 
+{
+	setOverlayAutoDuration(controller, base, request, level, response, MixEffect::OverlaySlot::downstream);
+}
+
+static void getDownstreamOverlayAutoDuration(	Controller& controller,
+												ZuazoBase& base,
+												const Message& request,
+												size_t level,
+												Message& response ) 
+{
+	getOverlayAutoDuration(controller, base, request, level, response, MixEffect::OverlaySlot::downstream);
+}
+
+
+
+
+static void getTally(	Controller&,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response )
+{
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level) {
+		assert(typeid(base) == typeid(MixEffect));
+		const auto& mixEffect = static_cast<const MixEffect&>(base);
+
+		//Query all the inputs at once
+		const auto tally = mixEffect.getTally();
+
+		//Elaborate the response. One token per input
+		std::vector<std::string>& payload = response.getPayload();
+		payload.clear();
+		payload.reserve(tally.size());
+		std::transform(
+			tally.cbegin(), tally.cend(),
+			std::back_inserter(payload),
+			[] (MixEffect::Tally flags) -> std::string {
+				return std::string(toString(flags));
+			}
+		);
+
+		response.setType(Message::Type::response);
+	}
+}
 
 
 
@@ -774,6 +1109,10 @@ void MixEffect::registerCommands(Control::Controller& controller) {
 														Cenital::getPreview,
 														{},
 														Cenital::unsetPreview) },
+		{ "pgm:clean",				makeAttributeNode(	Cenital::setProgramCleanFeedEnabled, 
+														Cenital::getProgramCleanFeedEnabled) },
+		{ "pvw:clean",				makeAttributeNode(	Cenital::setPreviewCleanFeedEnabled, 
+														Cenital::getPreviewCleanFeedEnabled) },
 
 		{ "cut",					Cenital::cut },
 		{ "transition", 			Cenital::transition },
@@ -784,6 +1123,8 @@ void MixEffect::registerCommands(Control::Controller& controller) {
 														Cenital::getTransitionPreview) },
 		{ "transition:duration",	makeAttributeNode(	Cenital::setTransitionDuration, 
 														Cenital::getTransitionDuration) },
+		{ "transition:rate",		makeAttributeNode(	Cenital::setTransitionRate, 
+														Cenital::getTransitionRate) },
 		{ "transition:effect",		std::move(transitionEffectNode) },
 
 		{ "us-overlay",				std::move(upstreamOverlayNode) },
@@ -808,6 +1149,25 @@ void MixEffect::registerCommands(Control::Controller& controller) {
 														Cenital::getDownstreamOverlayFeed,
 														{},
 														Cenital::unsetDownstreamOverlayFeed ) },
+		{ "us-overlay:auto",		Cenital::autoUpstreamOverlay },
+		{ "ds-overlay:auto",		Cenital::autoDownstreamOverlay },
+		{ "us-overlay:auto:playing",makeAttributeNode(	{},
+														Cenital::getUpstreamOverlayAutoPlaying ) },
+		{ "ds-overlay:auto:playing",makeAttributeNode(	{},
+														Cenital::getDownstreamOverlayAutoPlaying ) },
+		{ "us-overlay:auto:effect",	makeAttributeNode(	Cenital::setUpstreamOverlayAutoEffect, 
+														Cenital::getUpstreamOverlayAutoEffect,
+														Cenital::enumOverlayAutoEffect ) },
+		{ "ds-overlay:auto:effect",	makeAttributeNode(	Cenital::setDownstreamOverlayAutoEffect, 
+														Cenital::getDownstreamOverlayAutoEffect,
+														Cenital::enumOverlayAutoEffect ) },
+		{ "us-overlay:auto:duration",makeAttributeNode(	Cenital::setUpstreamOverlayAutoDuration, 
+														Cenital::getUpstreamOverlayAutoDuration ) },
+		{ "ds-overlay:auto:duration",makeAttributeNode(	Cenital::setDownstreamOverlayAutoDuration, 
+														Cenital::getDownstreamOverlayAutoDuration ) },
+
+		{ "tally",					makeAttributeNode(	{},
+														Cenital::getTally ) },
 
 	});
 
@@ -0,0 +1,52 @@
+#include <MixEffect.h>
+
+#include <zuazo/StringConversions.h>
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::MixEffect::OverlayEffect effect) noexcept {
+	switch(effect){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::MixEffect::OverlayEffect, mix )
+	ZUAZO_ENUM2STR_CASE( Cenital::MixEffect::OverlayEffect, flyLeft )
+	ZUAZO_ENUM2STR_CASE( Cenital::MixEffect::OverlayEffect, flyRight )
+	ZUAZO_ENUM2STR_CASE( Cenital::MixEffect::OverlayEffect, flyTop )
+	ZUAZO_ENUM2STR_CASE( Cenital::MixEffect::OverlayEffect, flyBottom )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::MixEffect::OverlayEffect& effect) {
+	//HACK. Using a lambda to call toString as otherwise it fails due to include ordering
+	return enumFromString(
+		str, effect,
+		[] (const Cenital::MixEffect::OverlayEffect& effect) -> std::string_view {
+			return toString(effect);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::MixEffect::OverlayEffect effect) {
+	return os << toString(effect);
+}
+
+
+
+std::string_view toString(Cenital::MixEffect::Tally tally) noexcept {
+	switch(tally){
+
+	case Cenital::MixEffect::Tally::none:		return "none";
+	case Cenital::MixEffect::Tally::program:	return "pgm";
+	case Cenital::MixEffect::Tally::preview:	return "pvw";
+	case Cenital::MixEffect::Tally::all:		return "pgm+pvw";
+
+	default: return "";
+	}
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::MixEffect::Tally tally) {
+	return os << toString(tally);
+}
+
+}
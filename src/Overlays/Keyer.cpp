@@ -1,9 +1,15 @@
 #include <Overlays/Keyer.h>
 
 #include <Shapes.h>
+#include <ColorLUT.h>
+#include <KeyMask.h>
+#include <Profiling.h>
+#include <BackgroundJob.h>
 
 #include <zuazo/Signal/Input.h>
 #include <zuazo/Signal/Output.h>
+#include <zuazo/Signal/DummyPad.h>
+#include <zuazo/Renderers/Compositor.h>
 #include <zuazo/Utils/StaticId.h>
 #include <zuazo/Utils/Hasher.h>
 #include <zuazo/Utils/Pool.h>
@@ -13,8 +19,14 @@
 #include <zuazo/Graphics/ColorTransfer.h>
 #include <zuazo/Math/Geometry.h>
 #include <zuazo/Math/Absolute.h>
+#include <zuazo/Math/Trigonometry.h>
 #include <zuazo/Math/LoopBlinn/OutlineProcessor.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <utility>
 #include <memory>
 #include <unordered_map>
@@ -23,6 +35,40 @@ namespace Cenital::Overlays {
 
 using namespace Zuazo;
 
+static void openHelper(ZuazoBase& base, std::unique_lock<Instance>* lock) {
+	if(lock) {
+		base.asyncOpen(*lock);
+	} else {
+		base.open();
+	}
+}
+
+static void closeHelper(ZuazoBase& base, std::unique_lock<Instance>* lock) {
+	if(lock) {
+		base.asyncClose(*lock);
+	} else {
+		base.close();
+	}
+}
+
+static bool isSameCrop(Utils::BufferView<const Shape> a, Utils::BufferView<const Shape> b) noexcept {
+	return std::equal(
+		a.cbegin(), a.cend(),
+		b.cbegin(), b.cend(),
+		[] (const Shape& a, const Shape& b) -> bool {
+			return std::equal(
+				a.cbegin(), a.cend(),
+				b.cbegin(), b.cend(),
+				[] (const Shape::value_type& a, const Shape::value_type& b) -> bool {
+					return a.x == b.x && a.y == b.y;
+				}
+			);
+		}
+	);
+}
+
+
+
 struct KeyerImpl {
 	struct Open {
 		struct Vertex {
@@ -40,18 +86,30 @@ struct KeyerImpl {
 			Math::Vec3f klm;
 		};
 
+		//Straight outline segment. Its outwards normal is on the right
+		struct Edge {
+			Math::Vec2f begin;
+			Math::Vec2f end;
+		};
+
 		struct FragmentConstants {
 			FragmentConstants() = default;
 			FragmentConstants(	uint32_t sampleMode,
 								VkBool32 sameKeyFill, 
 								VkBool32 lumaKeyEnabled, 
 								VkBool32 chromaKeyEnabled,
-								int32_t linearKeyType ) noexcept
+								int32_t linearKeyType,
+								VkBool32 colorLUTEnabled,
+								int32_t debugView,
+								VkBool32 maskEnabled ) noexcept
 				: sampleMode(sampleMode)
 				, sameKeyFill(sameKeyFill)
 				, lumaKeyEnabled(lumaKeyEnabled)
 				, chromaKeyEnabled(chromaKeyEnabled)
 				, linearKeyType(linearKeyType)
+				, colorLUTEnabled(colorLUTEnabled)
+				, debugView(debugView)
+				, maskEnabled(maskEnabled)
 			{
 			}
 
@@ -60,10 +118,16 @@ struct KeyerImpl {
 			VkBool32		lumaKeyEnabled;
 			VkBool32		chromaKeyEnabled;
 			int32_t			linearKeyType;
+			VkBool32		colorLUTEnabled;
+			int32_t			debugView;
+			VkBool32		maskEnabled;
 
 		};
 
 		using Index = uint16_t;
+		static constexpr Index PRIMITIVE_RESTART_INDEX = std::numeric_limits<Index>::max();
+		static constexpr size_t EDGE_VERTEX_COUNT = 4; //Quad as a triangle strip
+		static constexpr size_t EDGE_INDEX_COUNT = EDGE_VERTEX_COUNT + 1; //Plus the restart
 
 		enum VertexBufferBindings {
 			VERTEX_BUFFER_BINDING,
@@ -79,11 +143,25 @@ struct KeyerImpl {
 			VERTEX_LOCATION_COUNT
 		};
 
+		//Boxes are drawn as instances, so each one only takes 32 bytes
+		static_assert(sizeof(Box) == 8*sizeof(float), "Box must be packed");
+		static constexpr uint32_t BOX_VERTEX_COUNT = 4; //Triangle strip quad
+
+		enum BoxLayout {
+			BOX_LOCATION_RECT,
+			BOX_LOCATION_RADII,
+
+			BOX_LOCATION_COUNT
+		};
+
 		enum DescriptorSets {
 			DESCRIPTOR_SET_RENDERER = RendererBase::DESCRIPTOR_SET,
 			DESCRIPTOR_SET_KEYER,
 			DESCRIPTOR_SET_KEYFRAME,
 			DESCRIPTOR_SET_FILLFRAME,
+			DESCRIPTOR_SET_COLOR_LUT,
+			DESCRIPTOR_SET_MASK,
+			DESCRIPTOR_SET_MATTE, //Only when the matte is computed
 
 			DESCRIPTOR_SET_COUNT
 		};
@@ -95,12 +173,25 @@ struct KeyerImpl {
 			DESCRIPTOR_COUNT
 		};
 
+		//The texture coordinate transform and the margin follow the model
+		//matrix. They are only used by the boxes, as the outlines have 
+		//them baked into the vertices
+		static constexpr size_t MODEL_UNIFORM_TEXCOORD_TRANSFORM_OFFSET = sizeof(Math::Mat4x4f);
+		static constexpr size_t MODEL_UNIFORM_BOX_MARGIN_OFFSET = MODEL_UNIFORM_TEXCOORD_TRANSFORM_OFFSET + sizeof(Math::Vec4f);
+		static constexpr size_t MODEL_UNIFORM_SIZE = MODEL_UNIFORM_BOX_MARGIN_OFFSET + sizeof(float);
+
+		//Avoids degenerate edge widths when the keyer is scaled to zero
+		static constexpr float MIN_MODEL_SCALE = 1e-3f;
+
 		enum FragmentConstantId {
 			FRAGMENT_CONSTANT_ID_SAMPLE_MODE,
 			FRAGMENT_CONSTANT_ID_SAME_KEY_FILL,
 			FRAGMENT_CONSTANT_ID_LUMA_KEY_ENABLED,
 			FRAGMENT_CONSTANT_ID_CHROMA_KEY_ENABLED,
 			FRAGMENT_CONSTANT_ID_LINEAR_KEY_TYPE,
+			FRAGMENT_CONSTANT_ID_COLOR_LUT_ENABLED,
+			FRAGMENT_CONSTANT_ID_DEBUG_VIEW,
+			FRAGMENT_CONSTANT_ID_MASK_ENABLED,
 
 			FRAGMENT_CONSTANT_ID_COUNT
 		};
@@ -116,6 +207,11 @@ struct KeyerImpl {
 			LAYERDATA_UNIFORM_CHROMAKEY_VALUE_THRESHOLD,
 			LAYERDATA_UNIFORM_CHROMAKEY_VALUE_SMOOTHNESS,
 			LAYERDATA_UNIFORM_OPACITY,
+			LAYERDATA_UNIFORM_CHROMAKEY_DESPILL_COLOR,
+			LAYERDATA_UNIFORM_CHROMAKEY_DESPILL_STRENGTH,
+			LAYERDATA_UNIFORM_COLOR_LUT_SCALE,
+			LAYERDATA_UNIFORM_COLOR_LUT_OFFSET,
+			LAYERDATA_UNIFORM_FEATHER,
 
 			LAYERDATA_UNIFORM_COUNT
 		};
@@ -131,6 +227,70 @@ struct KeyerImpl {
 			Utils::Area(9*sizeof(float),	sizeof(float)),	//LAYERDATA_UNIFORM_CHROMAKEY_VALUE_THRESHOLD 
 			Utils::Area(10*sizeof(float),	sizeof(float)),	//LAYERDATA_UNIFORM_CHROMAKEY_VALUE_SMOOTHNESS 
 			Utils::Area(12*sizeof(float),	sizeof(float)),	//LAYERDATA_UNIFORM_OPACITY 
+			Utils::Area(16*sizeof(float),	3*sizeof(float)),//LAYERDATA_UNIFORM_CHROMAKEY_DESPILL_COLOR 
+			Utils::Area(19*sizeof(float),	sizeof(float)),	//LAYERDATA_UNIFORM_CHROMAKEY_DESPILL_STRENGTH 
+			Utils::Area(20*sizeof(float),	3*sizeof(float)),//LAYERDATA_UNIFORM_COLOR_LUT_SCALE 
+			Utils::Area(24*sizeof(float),	3*sizeof(float)),//LAYERDATA_UNIFORM_COLOR_LUT_OFFSET 
+			Utils::Area(27*sizeof(float),	sizeof(float)),	//LAYERDATA_UNIFORM_FEATHER 
+		};
+
+		//Matte pre-pass. Sizes must match the ones at keyer_matte.comp
+		static constexpr uint32_t MATTE_TILE_SIZE = 16;
+		static constexpr int32_t MATTE_MAX_RADIUS = 4;
+		static constexpr vk::Format MATTE_FORMAT = vk::Format::eR8G8B8A8Unorm; //Storage and linear filtering are mandatory
+		static constexpr vk::Format MATTE_KEY_FORMAT = vk::Format::eR16G16B16A16Sfloat; //Color attachment and sampling are mandatory
+
+		enum MatteDescriptorSets {
+			MATTE_DESCRIPTOR_SET_MATTE,
+
+			MATTE_DESCRIPTOR_SET_COUNT
+		};
+
+		enum MatteDescriptorBindings {
+			MATTE_DESCRIPTOR_BINDING_MATTEDATA,
+			MATTE_DESCRIPTOR_BINDING_OUTPUT,
+			MATTE_DESCRIPTOR_BINDING_KEY,
+
+			MATTE_DESCRIPTOR_COUNT
+		};
+
+		//Frame descriptor sets are only visible to the fragment stage. 
+		//Thus, the key frame is drawn into an image owned by the matte
+		//before the compute shader reads it
+		enum MatteKeyDescriptorSets {
+			MATTE_KEY_DESCRIPTOR_SET_KEYFRAME,
+
+			MATTE_KEY_DESCRIPTOR_SET_COUNT
+		};
+
+		enum MatteDataUniforms {
+			MATTEDATA_UNIFORM_CHROMAKEY_HUE,
+			MATTEDATA_UNIFORM_CHROMAKEY_HUE_THRESHOLD,
+			MATTEDATA_UNIFORM_CHROMAKEY_HUE_SMOOTHNESS,
+			MATTEDATA_UNIFORM_CHROMAKEY_SATURATION_THRESHOLD,
+			MATTEDATA_UNIFORM_CHROMAKEY_SATURATION_SMOOTHNESS,
+			MATTEDATA_UNIFORM_CHROMAKEY_VALUE_THRESHOLD,
+			MATTEDATA_UNIFORM_CHROMAKEY_VALUE_SMOOTHNESS,
+			MATTEDATA_UNIFORM_CLIP,
+			MATTEDATA_UNIFORM_GAIN,
+			MATTEDATA_UNIFORM_ERODE,
+			MATTEDATA_UNIFORM_BLUR,
+
+			MATTEDATA_UNIFORM_COUNT
+		};
+
+		static constexpr std::array<Utils::Area, MATTEDATA_UNIFORM_COUNT> MATTEDATA_UNIFORM_LAYOUT = {
+			Utils::Area(0*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CHROMAKEY_HUE 
+			Utils::Area(1*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CHROMAKEY_HUE_THRESHOLD 
+			Utils::Area(2*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CHROMAKEY_HUE_SMOOTHNESS 
+			Utils::Area(3*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CHROMAKEY_SATURATION_THRESHOLD 
+			Utils::Area(4*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CHROMAKEY_SATURATION_SMOOTHNESS 
+			Utils::Area(5*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CHROMAKEY_VALUE_THRESHOLD 
+			Utils::Area(6*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CHROMAKEY_VALUE_SMOOTHNESS 
+			Utils::Area(8*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_CLIP 
+			Utils::Area(9*sizeof(float),	sizeof(float)),	//MATTEDATA_UNIFORM_GAIN 
+			Utils::Area(10*sizeof(float),	sizeof(int32_t)),//MATTEDATA_UNIFORM_ERODE 
+			Utils::Area(11*sizeof(float),	sizeof(int32_t)),//MATTEDATA_UNIFORM_BLUR 
 		};
 
 		static constexpr std::array<vk::SpecializationMapEntry, FRAGMENT_CONSTANT_ID_COUNT> FRAGMENT_SPECIALIZATION_LAYOUT = {
@@ -159,14 +319,32 @@ struct KeyerImpl {
 				offsetof(FragmentConstants, linearKeyType),
 				sizeof(FragmentConstants::linearKeyType)
 			),
+			vk::SpecializationMapEntry(
+				FRAGMENT_CONSTANT_ID_COLOR_LUT_ENABLED,
+				offsetof(FragmentConstants, colorLUTEnabled),
+				sizeof(FragmentConstants::colorLUTEnabled)
+			),
+			vk::SpecializationMapEntry(
+				FRAGMENT_CONSTANT_ID_DEBUG_VIEW,
+				offsetof(FragmentConstants, debugView),
+				sizeof(FragmentConstants::debugView)
+			),
+			vk::SpecializationMapEntry(
+				FRAGMENT_CONSTANT_ID_MASK_ENABLED,
+				offsetof(FragmentConstants, maskEnabled),
+				sizeof(FragmentConstants::maskEnabled)
+			),
 		};
 
 		struct Resources {
 			Resources(	Graphics::UniformBuffer uniformBuffer,
+						Graphics::UniformBuffer matteUniformBuffer,
 						vk::UniqueDescriptorPool descriptorPool )
 				: vertexBuffer()
 				, indexBuffer()
+				, boxBuffer()
 				, uniformBuffer(std::move(uniformBuffer))
+				, matteUniformBuffer(std::move(matteUniformBuffer))
 				, descriptorPool(std::move(descriptorPool))
 			{
 			}
@@ -175,8 +353,307 @@ struct KeyerImpl {
 
 			Graphics::StagedBuffer								vertexBuffer;
 			Graphics::StagedBuffer								indexBuffer;
+			Graphics::StagedBuffer								boxBuffer;
 			Graphics::UniformBuffer								uniformBuffer;
+			Graphics::UniformBuffer								matteUniformBuffer;
+			vk::UniqueDescriptorPool							descriptorPool;
+		};
+
+		//Target of the matte pre-pass. Its lifetime is extended by the 
+		//command buffers which use it, so it owns everything it needs
+		struct Matte {
+			Matte(	const Graphics::Vulkan& vulkan,
+					vk::Extent2D extent,
+					const Graphics::UniformBuffer& uniformBuffer )
+				: vulkan(vulkan)
+				, extent(extent)
+				, image(createImage(vulkan, extent, MATTE_FORMAT, vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled))
+				, memory(allocateMemory(vulkan, *image))
+				, imageView(createImageView(vulkan, *image, MATTE_FORMAT))
+				, keyImage(createImage(vulkan, extent, MATTE_KEY_FORMAT, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eSampled))
+				, keyMemory(allocateMemory(vulkan, *keyImage))
+				, keyImageView(createImageView(vulkan, *keyImage, MATTE_KEY_FORMAT))
+				, keyRenderPass(createKeyRenderPass(vulkan))
+				, keyFramebuffer(createKeyFramebuffer(vulkan, *keyRenderPass, *keyImageView, extent))
+				, sampler(createSampler(vulkan))
+				, descriptorPool(createDescriptorPool(vulkan))
+				, computeDescriptorSet(vulkan.allocateDescriptorSet(*descriptorPool, getMatteDescriptorSetLayout(vulkan)).release())
+				, fragmentDescriptorSet(vulkan.allocateDescriptorSet(*descriptorPool, getMatteSamplerDescriptorSetLayout(vulkan)).release())
+				, commandPool(createCommandPool(vulkan))
+				, commandBuffer(createCommandBuffer(vulkan, *commandPool))
+				, fence(createFence(vulkan))
+			{
+				uniformBuffer.writeDescirptorSet(vulkan, computeDescriptorSet);
+				writeDescriptorSets();
+			}
+
+			Matte(const Matte& other) = delete;
+
+			~Matte() {
+				//Ensure the pre-pass is not using it
+				vulkan.getDevice().waitForFences(*fence, true, std::numeric_limits<uint64_t>::max(), vulkan.getDispatcher());
+			}
+
+			Matte& operator=(const Matte& other) = delete;
+
+			const Graphics::Vulkan&								vulkan;
+			vk::Extent2D										extent;
+			vk::UniqueImage										image;
+			vk::UniqueDeviceMemory								memory;
+			vk::UniqueImageView									imageView;
+			vk::UniqueImage										keyImage;
+			vk::UniqueDeviceMemory								keyMemory;
+			vk::UniqueImageView									keyImageView;
+			vk::UniqueRenderPass								keyRenderPass;
+			vk::UniqueFramebuffer								keyFramebuffer;
+			vk::UniqueSampler									sampler;
 			vk::UniqueDescriptorPool							descriptorPool;
+			vk::DescriptorSet									computeDescriptorSet;
+			vk::DescriptorSet									fragmentDescriptorSet;
+			vk::UniqueCommandPool								commandPool;
+			vk::UniqueCommandBuffer								commandBuffer;
+			vk::UniqueFence										fence;
+
+		private:
+			void writeDescriptorSets() {
+				const vk::DescriptorImageInfo storageImageInfo(
+					nullptr,											//Sampler
+					*imageView,											//Image view
+					vk::ImageLayout::eGeneral							//Layout
+				);
+				const vk::DescriptorImageInfo sampledImageInfo(
+					*sampler,											//Sampler
+					*imageView,											//Image view
+					vk::ImageLayout::eShaderReadOnlyOptimal				//Layout
+				);
+				const vk::DescriptorImageInfo keyImageInfo(
+					*sampler,											//Sampler
+					*keyImageView,										//Image view
+					vk::ImageLayout::eShaderReadOnlyOptimal				//Layout
+				);
+
+				const std::array writes = {
+					vk::WriteDescriptorSet(
+						computeDescriptorSet,							//Descriptor set
+						MATTE_DESCRIPTOR_BINDING_OUTPUT,				//Binding
+						0, 												//Index
+						1,												//Descriptor count
+						vk::DescriptorType::eStorageImage,				//Descriptor type
+						&storageImageInfo,								//Images 
+						nullptr,										//Buffers
+						nullptr											//Texel buffers
+					),
+					vk::WriteDescriptorSet(
+						computeDescriptorSet,							//Descriptor set
+						MATTE_DESCRIPTOR_BINDING_KEY,					//Binding
+						0, 												//Index
+						1,												//Descriptor count
+						vk::DescriptorType::eCombinedImageSampler,		//Descriptor type
+						&keyImageInfo,									//Images 
+						nullptr,										//Buffers
+						nullptr											//Texel buffers
+					),
+					vk::WriteDescriptorSet(
+						fragmentDescriptorSet,							//Descriptor set
+						0,												//Binding
+						0, 												//Index
+						1,												//Descriptor count
+						vk::DescriptorType::eCombinedImageSampler,		//Descriptor type
+						&sampledImageInfo,								//Images 
+						nullptr,										//Buffers
+						nullptr											//Texel buffers
+					)
+				};
+
+				vulkan.getDevice().updateDescriptorSets(writes, {}, vulkan.getDispatcher());
+			}
+
+			static vk::UniqueImage createImage(	const Graphics::Vulkan& vulkan, 
+												vk::Extent2D extent,
+												vk::Format format,
+												vk::ImageUsageFlags usage )
+			{
+				const vk::ImageCreateInfo createInfo(
+					{},													//Flags
+					vk::ImageType::e2D,									//Image type
+					format,												//Format
+					vk::Extent3D(extent, 1),							//Extent
+					1, 1,												//Mip levels and array layers
+					vk::SampleCountFlagBits::e1,						//Sample count
+					vk::ImageTiling::eOptimal,							//Tiling
+					usage,												//Usage
+					vk::SharingMode::eExclusive,						//Sharing mode
+					0, nullptr,											//Queue family indices
+					vk::ImageLayout::eUndefined							//Initial layout
+				);
+
+				return vulkan.getDevice().createImageUnique(createInfo, nullptr, vulkan.getDispatcher());
+			}
+
+			static vk::UniqueDeviceMemory allocateMemory(const Graphics::Vulkan& vulkan, vk::Image image) {
+				const auto& dispatcher = vulkan.getDispatcher();
+				const auto device = vulkan.getDevice();
+
+				const auto requirements = device.getImageMemoryRequirements(image, dispatcher);
+				auto result = vulkan.allocateMemory(requirements, vk::MemoryPropertyFlagBits::eDeviceLocal);
+				device.bindImageMemory(image, *result, 0, dispatcher);
+
+				return result;
+			}
+
+			static vk::UniqueImageView createImageView(	const Graphics::Vulkan& vulkan, 
+														vk::Image image,
+														vk::Format format )
+			{
+				const vk::ImageViewCreateInfo createInfo(
+					{},													//Flags
+					image,												//Image
+					vk::ImageViewType::e2D,								//View type
+					format,												//Format
+					vk::ComponentMapping(),								//Swizzle
+					vk::ImageSubresourceRange(
+						vk::ImageAspectFlagBits::eColor,				//Aspect
+						0, 1, 0, 1										//Mip levels and array layers
+					)
+				);
+
+				return vulkan.getDevice().createImageViewUnique(createInfo, nullptr, vulkan.getDispatcher());
+			}
+
+			static vk::UniqueRenderPass createKeyRenderPass(const Graphics::Vulkan& vulkan) {
+				//Previous contents are not needed, as the whole image is drawn.
+				//At the end, leave it ready for the compute shader
+				const std::array attachments = {
+					vk::AttachmentDescription(
+						{},												//Flags
+						MATTE_KEY_FORMAT,								//Format
+						vk::SampleCountFlagBits::e1,					//Sample count
+						vk::AttachmentLoadOp::eDontCare,				//Color attachment load operation
+						vk::AttachmentStoreOp::eStore,					//Color attachment store operation
+						vk::AttachmentLoadOp::eDontCare,				//Stencil attachment load operation
+						vk::AttachmentStoreOp::eDontCare,				//Stencil attachment store operation
+						vk::ImageLayout::eUndefined,					//Initial layout
+						vk::ImageLayout::eShaderReadOnlyOptimal			//Final layout
+					)
+				};
+
+				const std::array colorAttachments = {
+					vk::AttachmentReference(0, vk::ImageLayout::eColorAttachmentOptimal)
+				};
+
+				const std::array subpasses = {
+					vk::SubpassDescription(
+						{},												//Flags
+						vk::PipelineBindPoint::eGraphics,				//Pipeline bind point
+						0, nullptr,										//Input attachments
+						colorAttachments.size(), colorAttachments.data(), //Color attachments
+						nullptr,										//Resolve attachments
+						nullptr,										//Depth / Stencil attachment
+						0, nullptr										//Preserve attachments
+					)
+				};
+
+				const std::array dependencies = {
+					vk::SubpassDependency(
+						0,												//Source subpass
+						VK_SUBPASS_EXTERNAL,							//Destination subpass
+						vk::PipelineStageFlagBits::eColorAttachmentOutput,//Source stage
+						vk::PipelineStageFlagBits::eComputeShader,		//Destination stage
+						vk::AccessFlagBits::eColorAttachmentWrite,		//Source access
+						vk::AccessFlagBits::eShaderRead,				//Destination access
+						{}												//Dependency flags
+					)
+				};
+
+				const vk::RenderPassCreateInfo createInfo(
+					{},													//Flags
+					attachments.size(), attachments.data(),				//Attachments
+					subpasses.size(), subpasses.data(),					//Subpasses
+					dependencies.size(), dependencies.data()			//Dependencies
+				);
+
+				return vulkan.getDevice().createRenderPassUnique(createInfo, nullptr, vulkan.getDispatcher());
+			}
+
+			static vk::UniqueFramebuffer createKeyFramebuffer(	const Graphics::Vulkan& vulkan,
+																vk::RenderPass renderPass,
+																vk::ImageView imageView,
+																vk::Extent2D extent )
+			{
+				const vk::FramebufferCreateInfo createInfo(
+					{},													//Flags
+					renderPass,											//Render pass
+					1, &imageView,										//Attachments
+					extent.width, extent.height,						//Size
+					1													//Layers
+				);
+
+				return vulkan.getDevice().createFramebufferUnique(createInfo, nullptr, vulkan.getDispatcher());
+			}
+
+			static vk::UniqueSampler createSampler(const Graphics::Vulkan& vulkan) {
+				const vk::SamplerCreateInfo createInfo(
+					{},													//Flags
+					vk::Filter::eLinear,								//Mag filter
+					vk::Filter::eLinear,								//Min filter
+					vk::SamplerMipmapMode::eNearest,					//Mipmap mode
+					vk::SamplerAddressMode::eClampToEdge,				//U address mode
+					vk::SamplerAddressMode::eClampToEdge,				//V address mode
+					vk::SamplerAddressMode::eClampToEdge,				//W address mode
+					0.0f,												//Mip LOD bias
+					false, 1.0f,										//Anisotropy
+					false, vk::CompareOp::eNever,						//Comparison
+					0.0f, 0.0f,											//Min and max LOD
+					vk::BorderColor::eFloatOpaqueBlack,					//Border color
+					false 												//Unnormalized coordinates
+				);
+
+				return vulkan.getDevice().createSamplerUnique(createInfo, nullptr, vulkan.getDispatcher());
+			}
+
+			static vk::UniqueDescriptorPool createDescriptorPool(const Graphics::Vulkan& vulkan) {
+				const std::array poolSizes = {
+					vk::DescriptorPoolSize(vk::DescriptorType::eUniformBuffer, 1),
+					vk::DescriptorPoolSize(vk::DescriptorType::eStorageImage, 1),
+					vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler, 2)
+				};
+
+				const vk::DescriptorPoolCreateInfo createInfo(
+					{},													//Flags
+					2,													//Descriptor set count
+					poolSizes.size(), poolSizes.data()					//Pool sizes
+				);
+
+				return vulkan.createDescriptorPool(createInfo);
+			}
+
+			static vk::UniqueCommandPool createCommandPool(const Graphics::Vulkan& vulkan) {
+				const vk::CommandPoolCreateInfo createInfo(
+					vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+					vulkan.getGraphicsQueueIndex()
+				);
+
+				return vulkan.createCommandPool(createInfo);
+			}
+
+			static vk::UniqueCommandBuffer createCommandBuffer(	const Graphics::Vulkan& vulkan,
+																vk::CommandPool pool )
+			{
+				const vk::CommandBufferAllocateInfo allocInfo(
+					pool,
+					vk::CommandBufferLevel::ePrimary,
+					1
+				);
+
+				return vulkan.allocateCommandBuffer(allocInfo);
+			}
+
+			static vk::UniqueFence createFence(const Graphics::Vulkan& vulkan) {
+				//Signaled, so that the first wait does not block
+				const vk::FenceCreateInfo createInfo(vk::FenceCreateFlagBits::eSignaled);
+				return vulkan.getDevice().createFenceUnique(createInfo, nullptr, vulkan.getDispatcher());
+			}
+
 		};
 
 		const Graphics::Vulkan&								vulkan;
@@ -185,45 +662,100 @@ struct KeyerImpl {
 		vk::DescriptorSet									descriptorSet;
 
 		Math::LoopBlinn::OutlineProcessor<float, uint16_t>	outlineProcessor;
+		std::vector<Edge>									edges;
+		float												feather;
+		float												modelScale;
 		Graphics::Frame::Geometry							frameGeometry;
 
 		bool												flushVertexBuffer;
 		bool												flushIndexBuffer;
 
+		std::vector<Box>									boxes;
+		bool												boxesEnabled;
+		size_t												flushBoxBegin;
+		size_t												flushBoxEnd;
+
 		FragmentConstants									fragmentConstants;											
+		bool												matteEnabled;
+		vk::RenderPass										debugRenderPass;
+		FragmentConstants									debugFragmentConstants;
+		vk::PipelineLayout									debugPipelineLayout;
+		vk::Pipeline										debugPipeline;
+		std::pair<Video, std::shared_ptr<Matte>>			lastMatte;
+		std::shared_ptr<const ColorLUT>						colorLUT;
+		std::shared_ptr<const ColorLUT::Texture>			colorLUTTexture;
+		std::shared_ptr<const KeyMask>						mask;
+		std::shared_ptr<const KeyMask::Texture>				maskTexture;
 		vk::DescriptorSetLayout								keyFrameDescriptorSetLayout;
 		vk::DescriptorSetLayout								fillFrameDescriptorSetLayout;
 		vk::PipelineLayout									pipelineLayout;
 		vk::Pipeline										pipeline;
 
+		std::vector<std::shared_ptr<Matte>>					mattes;
+		vk::DescriptorSetLayout								matteKeyFrameDescriptorSetLayout;
+		uint32_t											matteSampleMode;
+		vk::PipelineLayout									matteKeyPipelineLayout;
+		vk::Pipeline										matteKeyPipeline;
+		vk::PipelineLayout									mattePipelineLayout;
+		vk::Pipeline										mattePipeline;
+
 		Open(	const Graphics::Vulkan& vulkan,
 				Math::Vec2f size,
 				ScalingMode scalingMode ) 
 			: vulkan(vulkan)
 			, resources(Utils::makeShared<Resources>(	createUniformBuffer(vulkan),
+														createMatteUniformBuffer(vulkan),
 														createDescriptorPool(vulkan) ))
 			, descriptorSet(createDescriptorSet(vulkan, *resources->descriptorPool))
 			, outlineProcessor()
+			, edges()
+			, feather(0.0f)
+			, modelScale(1.0f)
 			, frameGeometry(scalingMode, size)
 			, flushVertexBuffer(false)
 			, flushIndexBuffer(false)
+			, boxes()
+			, boxesEnabled(false)
+			, flushBoxBegin(0)
+			, flushBoxEnd(0)
 			, fragmentConstants()
+			, matteEnabled(false)
+			, debugRenderPass()
+			, debugFragmentConstants()
+			, debugPipelineLayout()
+			, debugPipeline()
+			, lastMatte()
+			, colorLUT()
+			, colorLUTTexture()
+			, mask()
+			, maskTexture()
 			, keyFrameDescriptorSetLayout()
 			, fillFrameDescriptorSetLayout()
 			, pipelineLayout()
 			, pipeline()
+			, mattes()
+			, matteKeyFrameDescriptorSetLayout()
+			, matteSampleMode(0)
+			, matteKeyPipelineLayout()
+			, matteKeyPipeline()
+			, mattePipelineLayout()
+			, mattePipeline()
 		{
 			resources->uniformBuffer.writeDescirptorSet(vulkan, descriptorSet);
 		}
 
 		~Open() {
 			resources->vertexBuffer.waitCompletion(vulkan);
+			resources->indexBuffer.waitCompletion(vulkan);
+			resources->boxBuffer.waitCompletion(vulkan);
 			resources->uniformBuffer.waitCompletion(vulkan);
+			resources->matteUniformBuffer.waitCompletion(vulkan);
 		}
 
 		void recreate() {
 			//Force pipeline creation
 			keyFrameDescriptorSetLayout = nullptr;
+			debugRenderPass = nullptr;
 		}
 
 		void draw(	Graphics::CommandBuffer& cmd, 
@@ -234,93 +766,61 @@ struct KeyerImpl {
 					BlendingMode blendingMode,
 					RenderingLayer renderingLayer ) 
 		{				
-			assert(resources);			
-			assert(keyFrame);
-			assert(fillFrame);
-
-			//Update the vertex buffer if needed
-			if(frameGeometry.useFrame(*fillFrame)) {
-				//Size has changed. Recalculate the vertex buffer
-				flushVertexBuffer = true;
+			if(prepare(*keyFrame, *fillFrame, filter)) {
+				configurePipeline(renderPass, blendingMode, renderingLayer);
+				record(cmd, keyFrame, fillFrame, filter, pipeline);
 			}
+		}
 
-			//Upload vertex and index data if necessary
-			fillVertexBuffer();
-			fillIndexBuffer();
-
-			//Only draw if geometry is defined
-			if(resources->indexBuffer.size()) {
-				assert(resources->vertexBuffer.size());
-
-				//Flush the unform buffer
-				resources->uniformBuffer.flush(vulkan);
-
-				//Configure the samplers for propper operation
-				configureSamplers(*keyFrame, *fillFrame, filter, renderPass, blendingMode, renderingLayer);
-				assert(keyFrameDescriptorSetLayout);
-				assert(fillFrameDescriptorSetLayout);
-				assert(pipelineLayout);
-				assert(pipeline);
-
-				//Bind the pipeline and its descriptor sets
-				cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
-
-				cmd.bindVertexBuffers(
-					VERTEX_BUFFER_BINDING,											//Binding
-					resources->vertexBuffer.getBuffer(),							//Vertex buffers
-					0UL																//Offsets
-				);
-
-				cmd.bindIndexBuffer(
-					resources->indexBuffer.getBuffer(),								//Index buffer
-					0,																//Offset
-					vk::IndexType::eUint16											//Index type
-				);
-
-				cmd.bindDescriptorSets(
-					vk::PipelineBindPoint::eGraphics,								//Pipeline bind point
-					pipelineLayout,													//Pipeline layout
-					DESCRIPTOR_SET_KEYER,											//First index
-					descriptorSet,													//Descriptor sets
-					{}																//Dynamic offsets
-				);
-
-				keyFrame->bind(
-					cmd.get(), 														//Commandbuffer
-					pipelineLayout, 												//Pipeline layout
-					DESCRIPTOR_SET_KEYFRAME, 										//Descriptor set index
-					filter															//Filter
-				);
-				fillFrame->bind(
-					cmd.get(), 														//Commandbuffer
-					pipelineLayout, 												//Pipeline layout
-					DESCRIPTOR_SET_FILLFRAME, 										//Descriptor set index
-					filter															//Filter
-				);
-
-				//Draw the frame and finish recording
-				cmd.drawIndexed(
-					resources->indexBuffer.size() / sizeof(Index),					//Index count
-					1, 																//Instance count
-					0, 																//First index
-					0, 																//First vertex
-					0																//First instance
-				);
-
-				//Add the dependencies to the command buffer
-				cmd.addDependencies({ resources, keyFrame, fillFrame });
-
-			}		
+		void drawDebug(	Graphics::CommandBuffer& cmd, 
+						const Video& keyFrame,
+						const Video& fillFrame,
+						ScalingFilter filter,
+						vk::RenderPass debugRenderPass,
+						Keyer::DebugView debugView ) 
+		{
+			//Only the debug pipeline is configured, as the keyer may
+			//not be on air
+			if(prepare(*keyFrame, *fillFrame, filter)) {
+				configureDebugPipeline(debugRenderPass, debugView);
+				record(cmd, keyFrame, fillFrame, filter, debugPipeline);
+			}
 		}
 
 		void setCrop(Utils::BufferView<const Shape> crop) {
 			outlineProcessor.clear();
 			outlineProcessor.addOutline(crop);
+			calculateEdges(edges, crop);
 			
 			flushIndexBuffer = true;
 			flushVertexBuffer = true;
 		}
 
+		void setCropBoxes(Utils::BufferView<const Box> crop) {
+			//Boxes replace the outlines when present
+			const bool ena = !crop.empty();
+			if(boxesEnabled != ena) {
+				boxesEnabled = ena;
+				recreate();
+			}
+
+			boxes.assign(crop.cbegin(), crop.cend());
+			flushBoxBegin = 0;
+			flushBoxEnd = boxes.size();
+		}
+
+		void setCropBox(size_t index, const Box& box) {
+			//Only upload the modified box
+			boxes.at(index) = box;
+			if(flushBoxBegin < flushBoxEnd) {
+				flushBoxBegin = std::min(flushBoxBegin, index);
+				flushBoxEnd = std::max(flushBoxEnd, index + 1);
+			} else {
+				flushBoxBegin = index;
+				flushBoxEnd = index + 1;
+			}
+		}
+
 
 
 		void updateLumaKeyEnabledConstant(VkBool32 ena) {
@@ -335,6 +835,52 @@ struct KeyerImpl {
 			updateFragmentConstant(FRAGMENT_CONSTANT_ID_LINEAR_KEY_TYPE, calculateLinearKeyType(enabled, inverted, channel));
 		}
 
+		void setColorLUT(std::shared_ptr<const ColorLUT> lut) {
+			colorLUT = std::move(lut);
+			updateFragmentConstant(FRAGMENT_CONSTANT_ID_COLOR_LUT_ENABLED, static_cast<VkBool32>(colorLUT != nullptr));
+
+			if(colorLUT) {
+				//Map the domain to the centers of the edge texels
+				const auto size = static_cast<float>(colorLUT->getSize());
+				const auto& domainMin = colorLUT->getDomainMin();
+				const auto& domainMax = colorLUT->getDomainMax();
+				const auto calculateScale = [size] (float min, float max) -> float {
+					return (size - 1.0f) / (size * (max - min));
+				};
+				const Math::Vec3f scale(
+					calculateScale(domainMin.x, domainMax.x),
+					calculateScale(domainMin.y, domainMax.y),
+					calculateScale(domainMin.z, domainMax.z)
+				);
+				const Math::Vec3f offset(
+					0.5f / size - domainMin.x*scale.x,
+					0.5f / size - domainMin.y*scale.y,
+					0.5f / size - domainMin.z*scale.z
+				);
+
+				updateFragmentUniform(LAYERDATA_UNIFORM_COLOR_LUT_SCALE, scale);
+				updateFragmentUniform(LAYERDATA_UNIFORM_COLOR_LUT_OFFSET, offset);
+			}
+		}
+
+		void setMask(std::shared_ptr<const KeyMask> mask) {
+			this->mask = std::move(mask);
+			updateFragmentConstant(FRAGMENT_CONSTANT_ID_MASK_ENABLED, static_cast<VkBool32>(this->mask != nullptr));
+		}
+
+		void updateMatteEnabled(bool ena) {
+			if(matteEnabled != ena) {
+				matteEnabled = ena;
+				recreate();
+
+				//Release the unused mattes
+				lastMatte = {};
+				if(!matteEnabled) {
+					mattes.clear();
+				}
+			}
+		}
+
 
 		void updateModelMatrixUniform(const Math::Transformf& transform) {
 			assert(resources);
@@ -347,6 +893,41 @@ struct KeyerImpl {
 				&mtx,
 				sizeof(mtx)
 			);
+
+			//Edge width is expressed in model units, so it depends on 
+			//the smallest scale
+			const auto& scale = transform.getScale();
+			const auto newModelScale = std::max(
+				std::min(Math::abs(scale.x), Math::abs(scale.y)), 
+				MIN_MODEL_SCALE
+			);
+			if(modelScale != newModelScale) {
+				modelScale = newModelScale;
+				updateEdgeWidth();
+			}
+		}
+
+
+		void updateTexCoordTransformUniform() {
+			assert(resources);
+			resources->uniformBuffer.waitCompletion(vulkan);
+
+			//Same mapping as the one used for the outline vertices
+			const auto surfaceSize = frameGeometry.calculateSurfaceSize();
+			const Math::Vec4f transform(
+				surfaceSize.second.x / surfaceSize.first.x,
+				surfaceSize.second.y / surfaceSize.first.y,
+				0.5f,
+				0.5f
+			);
+
+			resources->uniformBuffer.write(
+				vulkan,
+				DESCRIPTOR_BINDING_MODEL_MATRIX,
+				&transform,
+				sizeof(transform),
+				MODEL_UNIFORM_TEXCOORD_TRANSFORM_OFFSET
+			);
 		}
 
 
@@ -364,108 +945,562 @@ struct KeyerImpl {
 			constexpr auto deg2turn = 1.0f/360.0f;
 			hue = Math::mod(Math::mod(deg2turn*hue, 1.0f) + 1.0f, 1.0f); //First positive turn
 			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_HUE, hue);
+			updateMatteUniform(MATTEDATA_UNIFORM_CHROMAKEY_HUE, hue);
+			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_DESPILL_COLOR, calculateKeyColor(hue));
 		}
 
 		void updateChromaKeyHueThresholdUniform(float threshold) {
 			constexpr auto deg2turn = 1.0f/360.0f;
 			threshold *= deg2turn;
 			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_HUE_THRESHOLD, threshold);
+			updateMatteUniform(MATTEDATA_UNIFORM_CHROMAKEY_HUE_THRESHOLD, threshold);
 		}
 
 		void updateChromaKeyHueSmoothnessUniform(float smoothness) {
 			constexpr auto deg2turn = 1.0f/360.0f;
 			smoothness *= deg2turn;
 			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_HUE_SMOOTHNESS, smoothness);
+			updateMatteUniform(MATTEDATA_UNIFORM_CHROMAKEY_HUE_SMOOTHNESS, smoothness);
 		}
 
 		void updateChromaKeySaturationThresholdUniform(float threshold) {
 			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_SATURATION_THRESHOLD, threshold);
+			updateMatteUniform(MATTEDATA_UNIFORM_CHROMAKEY_SATURATION_THRESHOLD, threshold);
 		}
 
 		void updateChromaKeySaturationSmoothnessUniform(float smoothness) {
 			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_SATURATION_SMOOTHNESS, smoothness);
+			updateMatteUniform(MATTEDATA_UNIFORM_CHROMAKEY_SATURATION_SMOOTHNESS, smoothness);
 		}
 
 		void updateChromaKeyValueThresholdUniform(float threshold) {
 			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_VALUE_THRESHOLD, threshold);
+			updateMatteUniform(MATTEDATA_UNIFORM_CHROMAKEY_VALUE_THRESHOLD, threshold);
 		}
 
 		void updateChromaKeyValueSmoothnessUniform(float smoothness) {
 			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_VALUE_SMOOTHNESS, smoothness);
+			updateMatteUniform(MATTEDATA_UNIFORM_CHROMAKEY_VALUE_SMOOTHNESS, smoothness);
 		}
 
 
-		void updateOpacityUniform(float opa) {
-			updateFragmentUniform(LAYERDATA_UNIFORM_OPACITY, opa);
+		void updateChromaKeyDespillUniform(float strength) {
+			updateFragmentUniform(LAYERDATA_UNIFORM_CHROMAKEY_DESPILL_STRENGTH, strength);
 		}
 
-	private:
-		void configureSamplers(	const Graphics::Frame& keyFrame, 
-								const Graphics::Frame& fillFrame, 
-								ScalingFilter filter,
-								vk::RenderPass renderPass,
-								BlendingMode blendingMode,
-								RenderingLayer renderingLayer ) 
-		{
-			const auto newKeyDescriptorSetLayout = keyFrame.getDescriptorSetLayout(filter);
-			const auto newFillDescriptorSetLayout = fillFrame.getDescriptorSetLayout(filter);
-			const auto newSampleMode = fillFrame.getSamplingMode(filter);
-			const auto newSameKeyFill = &keyFrame == &fillFrame; //Check if the pointed is the same
-
-			if(	keyFrameDescriptorSetLayout != newKeyDescriptorSetLayout ||
-				fillFrameDescriptorSetLayout != newFillDescriptorSetLayout ||
-				fragmentConstants.sampleMode != newSampleMode ||
-				fragmentConstants.sameKeyFill != newSameKeyFill ) 
-			{
-				keyFrameDescriptorSetLayout = newKeyDescriptorSetLayout;
-				fillFrameDescriptorSetLayout = newFillDescriptorSetLayout;
-				fragmentConstants.sampleMode = newSampleMode;
-				fragmentConstants.sameKeyFill = newSameKeyFill;
+		void updateChromaKeyClipUniform(float clip) {
+			updateMatteUniform(MATTEDATA_UNIFORM_CLIP, clip);
+		}
 
-				//Recreate stuff
-				pipelineLayout = createPipelineLayout(vulkan, keyFrameDescriptorSetLayout, fillFrameDescriptorSetLayout);
-				pipeline = createPipeline(
-					vulkan, 
-					pipelineLayout, 
-					renderPass,
-					blendingMode, 
-					renderingLayer,
-					fragmentConstants
-				);
-			}
+		void updateChromaKeyGainUniform(float gain) {
+			updateMatteUniform(MATTEDATA_UNIFORM_GAIN, gain);
 		}
 
-		void fillVertexBuffer() {
-			assert(resources);
+		void updateChromaKeyErodeUniform(int32_t erode) {
+			erode = Math::clamp(erode, -MATTE_MAX_RADIUS, MATTE_MAX_RADIUS);
+			updateMatteUniform(MATTEDATA_UNIFORM_ERODE, erode);
+		}
 
-			if(flushVertexBuffer) {
-				const auto surfaceSize = frameGeometry.calculateSurfaceSize();
-				const auto& vertices = outlineProcessor.getVertices();
+		void updateChromaKeyBlurUniform(int32_t blur) {
+			blur = Math::clamp(blur, 0, MATTE_MAX_RADIUS);
+			updateMatteUniform(MATTEDATA_UNIFORM_BLUR, blur);
+		}
 
-				//Wait for any previous transfers
-				resources->vertexBuffer.waitCompletion(vulkan);
 
-				//Recreate if size has changed
-				if(resources->vertexBuffer.size() != vertices.size()*sizeof(Vertex)) {
-					resources->vertexBuffer = createVertexBuffer(vulkan, vertices.size());
-				}
+		void updateOpacityUniform(float opa) {
+			updateFragmentUniform(LAYERDATA_UNIFORM_OPACITY, opa);
+		}
 
-				//Obtain the buffer data
-				Utils::BufferView<Vertex> vertexBufferData(
-					reinterpret_cast<Vertex*>(resources->vertexBuffer.data()),
-					resources->vertexBuffer.size() / sizeof(Vertex)
-				);
+		void updateFeather(float width) {
+			feather = std::max(width, 0.0f);
+			updateFragmentUniform(LAYERDATA_UNIFORM_FEATHER, feather);
 
-				//Ensure the size is correct
-				assert(vertexBufferData.size() == vertices.size());
+			//Edge width depends on it
+			updateEdgeWidth();
+		}
 
-				//Copy the data
-				for(size_t i = 0; i < vertexBufferData.size(); ++i) {
+	private:
+		bool prepare(	const Graphics::Frame& keyFrame,
+						const Graphics::Frame& fillFrame,
+						ScalingFilter filter ) 
+		{
+			assert(resources);
+
+			//Update the vertex buffer if needed
+			if(frameGeometry.useFrame(fillFrame)) {
+				//Size has changed. Recalculate the vertex buffer
+				flushVertexBuffer = true;
+				updateTexCoordTransformUniform();
+			}
+
+			//Upload vertex and index data if necessary
+			bool hasGeometry;
+			if(boxesEnabled) {
+				fillBoxBuffer();
+				hasGeometry = resources->boxBuffer.size();
+			} else {
+				fillVertexBuffer();
+				fillIndexBuffer();
+				hasGeometry = resources->indexBuffer.size();
+				assert(!hasGeometry || resources->vertexBuffer.size());
+			}
+
+			//Only draw if geometry is defined
+			if(hasGeometry) {
+				//Flush the unform buffer
+				resources->uniformBuffer.flush(vulkan);
+
+				//Upload the colour table and the mask if they have changed. 
+				//This is done here, as the graphics queue is not being used
+				configureColorLUT();
+				configureMask();
+
+				//Configure the samplers for propper operation
+				configureSamplers(keyFrame, fillFrame, filter);
+				assert(keyFrameDescriptorSetLayout);
+				assert(fillFrameDescriptorSetLayout);
+				assert(pipelineLayout);
+
+				return true;
+			} else {
+				return false;
+			}
+		}
+
+		void record(Graphics::CommandBuffer& cmd, 
+					const Video& keyFrame,
+					const Video& fillFrame,
+					ScalingFilter filter,
+					vk::Pipeline pipeline ) 
+		{
+			assert(keyFrame);
+			assert(fillFrame);
+			assert(pipeline);
+
+			//Compute the chroma key matte before the renderer uses it
+			std::shared_ptr<Matte> matte;
+			if(matteEnabled) {
+				matte = getMatte(keyFrame, filter);
+			}
+
+			//Bind the pipeline and its descriptor sets
+			cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+
+			if(boxesEnabled) {
+				cmd.bindVertexBuffers(
+					VERTEX_BUFFER_BINDING,										//Binding
+					resources->boxBuffer.getBuffer(),							//Vertex buffers
+					0UL															//Offsets
+				);
+			} else {
+				cmd.bindVertexBuffers(
+					VERTEX_BUFFER_BINDING,										//Binding
+					resources->vertexBuffer.getBuffer(),						//Vertex buffers
+					0UL															//Offsets
+				);
+
+				cmd.bindIndexBuffer(
+					resources->indexBuffer.getBuffer(),							//Index buffer
+					0,															//Offset
+					vk::IndexType::eUint16										//Index type
+				);
+			}
+
+			cmd.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics,								//Pipeline bind point
+				pipelineLayout,													//Pipeline layout
+				DESCRIPTOR_SET_KEYER,											//First index
+				descriptorSet,													//Descriptor sets
+				{}																//Dynamic offsets
+			);
+
+			keyFrame->bind(
+				cmd.get(), 														//Commandbuffer
+				pipelineLayout, 												//Pipeline layout
+				DESCRIPTOR_SET_KEYFRAME, 										//Descriptor set index
+				filter															//Filter
+			);
+			fillFrame->bind(
+				cmd.get(), 														//Commandbuffer
+				pipelineLayout, 												//Pipeline layout
+				DESCRIPTOR_SET_FILLFRAME, 										//Descriptor set index
+				filter															//Filter
+			);
+
+			cmd.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics,								//Pipeline bind point
+				pipelineLayout,													//Pipeline layout
+				DESCRIPTOR_SET_COLOR_LUT,										//First index
+				colorLUTTexture->getDescriptorSet(),							//Descriptor sets
+				{}																//Dynamic offsets
+			);
+
+			cmd.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics,								//Pipeline bind point
+				pipelineLayout,													//Pipeline layout
+				DESCRIPTOR_SET_MASK,											//First index
+				maskTexture->getDescriptorSet(),								//Descriptor sets
+				{}																//Dynamic offsets
+			);
+
+			if(matte) {
+				cmd.bindDescriptorSets(
+					vk::PipelineBindPoint::eGraphics,							//Pipeline bind point
+					pipelineLayout,												//Pipeline layout
+					DESCRIPTOR_SET_MATTE,										//First index
+					matte->fragmentDescriptorSet,								//Descriptor sets
+					{}															//Dynamic offsets
+				);
+			}
+
+			//Draw the frame and finish recording
+			if(boxesEnabled) {
+				cmd.draw(
+					BOX_VERTEX_COUNT,											//Vertex count
+					resources->boxBuffer.size() / sizeof(Box),					//Instance count
+					0, 															//First vertex
+					0															//First instance
+				);
+			} else {
+				cmd.drawIndexed(
+					resources->indexBuffer.size() / sizeof(Index),				//Index count
+					1, 															//Instance count
+					0, 															//First index
+					0, 															//First vertex
+					0															//First instance
+				);
+			}
+
+			//Add the dependencies to the command buffer
+			cmd.addDependencies({ resources, keyFrame, fillFrame, colorLUTTexture, maskTexture });
+			if(matte) {
+				cmd.addDependencies({ std::move(matte) });
+			}
+		}
+
+		void configurePipeline(	vk::RenderPass renderPass,
+								BlendingMode blendingMode,
+								RenderingLayer renderingLayer ) 
+		{
+			//Cleared when the samplers change
+			if(!pipeline) {
+				pipeline = createPipeline(
+					vulkan, 
+					pipelineLayout, 
+					renderPass,
+					blendingMode, 
+					renderingLayer,
+					fragmentConstants,
+					matteEnabled,
+					boxesEnabled
+				);
+			}
+
+			assert(pipeline);
+		}
+
+		void configureDebugPipeline(vk::RenderPass renderPass, Keyer::DebugView view) {
+			//Same as the main pipeline, but rendering the requested view
+			auto newFragmentConstants = fragmentConstants;
+			newFragmentConstants.debugView = calculateDebugView(view);
+
+			if(	debugRenderPass != renderPass ||
+				debugPipelineLayout != pipelineLayout ||
+				std::memcmp(&debugFragmentConstants, &newFragmentConstants, sizeof(FragmentConstants)) != 0 )
+			{
+				debugRenderPass = renderPass;
+				debugPipelineLayout = pipelineLayout;
+				debugFragmentConstants = newFragmentConstants;
+
+				//It is the only layer of its renderer, so simply write
+				debugPipeline = createPipeline(
+					vulkan, 
+					debugPipelineLayout, 
+					debugRenderPass,
+					BlendingMode::write, 
+					RenderingLayer::scene,
+					debugFragmentConstants,
+					matteEnabled,
+					boxesEnabled
+				);
+			}
+
+			assert(debugPipeline);
+		}
+
+		std::shared_ptr<Matte> getMatte(const Video& keyFrame, ScalingFilter filter) {
+			//The matte is shared among all the draws of the same key frame
+			if(lastMatte.first != keyFrame) {
+				lastMatte = std::make_pair(keyFrame, computeMatte(*keyFrame, filter));
+			}
+
+			assert(lastMatte.second);
+			return lastMatte.second;
+		}
+
+		void configureSamplers(	const Graphics::Frame& keyFrame, 
+								const Graphics::Frame& fillFrame, 
+								ScalingFilter filter ) 
+		{
+			const auto newKeyDescriptorSetLayout = keyFrame.getDescriptorSetLayout(filter);
+			const auto newFillDescriptorSetLayout = fillFrame.getDescriptorSetLayout(filter);
+			const auto newSampleMode = fillFrame.getSamplingMode(filter);
+			const auto newSameKeyFill = &keyFrame == &fillFrame; //Check if the pointed is the same
+
+			if(	keyFrameDescriptorSetLayout != newKeyDescriptorSetLayout ||
+				fillFrameDescriptorSetLayout != newFillDescriptorSetLayout ||
+				fragmentConstants.sampleMode != newSampleMode ||
+				fragmentConstants.sameKeyFill != newSameKeyFill ) 
+			{
+				keyFrameDescriptorSetLayout = newKeyDescriptorSetLayout;
+				fillFrameDescriptorSetLayout = newFillDescriptorSetLayout;
+				fragmentConstants.sampleMode = newSampleMode;
+				fragmentConstants.sameKeyFill = newSameKeyFill;
+
+				//Recreate stuff
+				pipelineLayout = createPipelineLayout(vulkan, keyFrameDescriptorSetLayout, fillFrameDescriptorSetLayout, matteEnabled);
+				pipeline = nullptr; //Will be recreated when drawing on air
+			}
+		}
+
+		void configureColorLUT() {
+			//When disabled, an identity table is bound, so that the 
+			//descriptor set is always valid
+			const auto& lut = colorLUT ? colorLUT : ColorLUT::identity();
+			if(!colorLUTTexture || &(colorLUTTexture->getColorLUT()) != lut.get()) {
+				colorLUTTexture = ColorLUT::Texture::get(vulkan, lut);
+			}
+
+			assert(colorLUTTexture);
+			colorLUTTexture->releaseStaging();
+		}
+
+		void configureMask() {
+			//When disabled, an opaque pixel is bound, so that the 
+			//descriptor set is always valid
+			const auto& currentMask = mask ? mask : KeyMask::identity();
+			if(!maskTexture || &(maskTexture->getKeyMask()) != currentMask.get()) {
+				maskTexture = KeyMask::Texture::get(vulkan, currentMask);
+			}
+
+			assert(maskTexture);
+			maskTexture->releaseStaging();
+		}
+
+		std::shared_ptr<Matte> computeMatte(const Graphics::Frame& keyFrame, ScalingFilter filter) {
+			CENITAL_PROFILE_SCOPE("Keyer::computeMatte");
+			const auto& dispatcher = vulkan.getDispatcher();
+
+			//The matte has the resolution of the key frame. When planar, 
+			//the first plane has the full resolution
+			const auto frameExtent = keyFrame.getImage().getPlanes().front().getExtent();
+			const vk::Extent2D extent(frameExtent.width, frameExtent.height);
+
+			auto matte = acquireMatte(extent);
+			configureMattePipeline(keyFrame, filter, *(matte->keyRenderPass));
+			resources->matteUniformBuffer.flush(vulkan);
+
+			//Record the pre-pass. It is submitted on its own before the
+			//renderer submits its commands on the same queue, so that the
+			//barrier at the end makes the matte available to the renderer
+			const auto cmd = *(matte->commandBuffer);
+			const vk::ImageSubresourceRange range(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
+			cmd.begin(
+				vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit),
+				dispatcher
+			);
+
+			//Convert the key frame into the key image. The render pass
+			//leaves it ready to be read by the compute shader
+			const vk::Rect2D renderArea({0, 0}, extent);
+			cmd.beginRenderPass(
+				vk::RenderPassBeginInfo(
+					*(matte->keyRenderPass),									//Render pass
+					*(matte->keyFramebuffer),									//Framebuffer
+					renderArea,													//Render area
+					0, nullptr													//Clear values (none)
+				),
+				vk::SubpassContents::eInline,
+				dispatcher
+			);
+
+			const vk::Viewport viewport(
+				0.0f, 0.0f,														//Origin
+				static_cast<float>(extent.width), 
+				static_cast<float>(extent.height),								//Size
+				0.0f, 1.0f														//Depth range
+			);
+			cmd.setViewport(0, viewport, dispatcher);
+			cmd.setScissor(0, renderArea, dispatcher);
+
+			cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, matteKeyPipeline, dispatcher);
+			cmd.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics,								//Pipeline bind point
+				matteKeyPipelineLayout,											//Pipeline layout
+				MATTE_KEY_DESCRIPTOR_SET_KEYFRAME,								//First index
+				keyFrame.getDescriptorSet(filter),								//Descriptor sets
+				{},																//Dynamic offsets
+				dispatcher
+			);
+			cmd.draw(3, 1, 0, 0, dispatcher); //Full screen triangle
+			cmd.endRenderPass(dispatcher);
+
+			const vk::ImageMemoryBarrier toGeneral(
+				{},
+				vk::AccessFlagBits::eShaderWrite,
+				vk::ImageLayout::eUndefined, //Previous contents are discarded
+				vk::ImageLayout::eGeneral,
+				VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+				*(matte->image),
+				range
+			);
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTopOfPipe,
+				vk::PipelineStageFlagBits::eComputeShader,
+				{}, {}, {}, toGeneral,
+				dispatcher
+			);
+
+			cmd.bindPipeline(vk::PipelineBindPoint::eCompute, mattePipeline, dispatcher);
+			cmd.bindDescriptorSets(
+				vk::PipelineBindPoint::eCompute,								//Pipeline bind point
+				mattePipelineLayout,											//Pipeline layout
+				MATTE_DESCRIPTOR_SET_MATTE,										//First index
+				matte->computeDescriptorSet,									//Descriptor sets
+				{},																//Dynamic offsets
+				dispatcher
+			);
+			cmd.dispatch(
+				(extent.width + MATTE_TILE_SIZE - 1) / MATTE_TILE_SIZE,
+				(extent.height + MATTE_TILE_SIZE - 1) / MATTE_TILE_SIZE,
+				1,
+				dispatcher
+			);
+
+			const vk::ImageMemoryBarrier toShader(
+				vk::AccessFlagBits::eShaderWrite,
+				vk::AccessFlagBits::eShaderRead,
+				vk::ImageLayout::eGeneral,
+				vk::ImageLayout::eShaderReadOnlyOptimal,
+				VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+				*(matte->image),
+				range
+			);
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eComputeShader,
+				vk::PipelineStageFlagBits::eFragmentShader,
+				{}, {}, {}, toShader,
+				dispatcher
+			);
+
+			cmd.end(dispatcher);
+
+			const vk::SubmitInfo submitInfo({}, {}, cmd, {});
+			vulkan.getGraphicsQueue().submit(submitInfo, *(matte->fence), dispatcher);
+
+			return matte;
+		}
+
+		std::shared_ptr<Matte> acquireMatte(vk::Extent2D extent) {
+			const auto& dispatcher = vulkan.getDispatcher();
+			const auto device = vulkan.getDevice();
+
+			//A matte is free when no command buffer references it
+			const auto isFree = [] (const std::shared_ptr<Matte>& matte) -> bool {
+				return matte.use_count() == 1;
+			};
+
+			auto ite = std::find_if(
+				mattes.cbegin(), mattes.cend(),
+				[extent, &isFree] (const std::shared_ptr<Matte>& matte) -> bool {
+					return isFree(matte) && matte->extent == extent;
+				}
+			);
+
+			if(ite == mattes.cend()) {
+				//Forget the ones with another resolution and create a new one
+				mattes.erase(
+					std::remove_if(
+						mattes.begin(), mattes.end(),
+						[extent, &isFree] (const std::shared_ptr<Matte>& matte) -> bool {
+							return isFree(matte) && matte->extent != extent;
+						}
+					),
+					mattes.end()
+				);
+
+				mattes.push_back(Utils::makeShared<Matte>(vulkan, extent, resources->matteUniformBuffer));
+				ite = std::prev(mattes.cend());
+			}
+
+			//Wait for its previous pre-pass
+			device.waitForFences(*((*ite)->fence), true, std::numeric_limits<uint64_t>::max(), dispatcher);
+			device.resetFences(*((*ite)->fence), dispatcher);
+
+			return *ite;
+		}
+
+		void configureMattePipeline(const Graphics::Frame& keyFrame, 
+									ScalingFilter filter,
+									vk::RenderPass keyRenderPass ) 
+		{
+			const auto newKeyDescriptorSetLayout = keyFrame.getDescriptorSetLayout(filter);
+			const auto newSampleMode = keyFrame.getSamplingMode(filter);
+
+			//Only the conversion of the key frame depends on its layout. All 
+			//the key render passes are compatible, so any of them can be used
+			if(	matteKeyFrameDescriptorSetLayout != newKeyDescriptorSetLayout ||
+				matteSampleMode != newSampleMode ) 
+			{
+				matteKeyFrameDescriptorSetLayout = newKeyDescriptorSetLayout;
+				matteSampleMode = newSampleMode;
+
+				matteKeyPipelineLayout = createMatteKeyPipelineLayout(vulkan, matteKeyFrameDescriptorSetLayout);
+				matteKeyPipeline = createMatteKeyPipeline(vulkan, matteKeyPipelineLayout, keyRenderPass, matteSampleMode);
+			}
+
+			if(!mattePipeline) {
+				mattePipelineLayout = createMattePipelineLayout(vulkan);
+				mattePipeline = createMattePipeline(vulkan, mattePipelineLayout);
+			}
+
+			assert(matteKeyPipelineLayout);
+			assert(matteKeyPipeline);
+			assert(mattePipelineLayout);
+			assert(mattePipeline);
+		}
+
+		void fillVertexBuffer() {
+			assert(resources);
+
+			if(flushVertexBuffer) {
+				const auto surfaceSize = frameGeometry.calculateSurfaceSize();
+				const auto& vertices = outlineProcessor.getVertices();
+				const auto vertexCount = vertices.size() + EDGE_VERTEX_COUNT*edges.size();
+
+				//Wait for any previous transfers
+				resources->vertexBuffer.waitCompletion(vulkan);
+
+				//Recreate if size has changed
+				if(resources->vertexBuffer.size() != vertexCount*sizeof(Vertex)) {
+					resources->vertexBuffer = createVertexBuffer(vulkan, vertexCount);
+				}
+
+				//Obtain the buffer data
+				Utils::BufferView<Vertex> vertexBufferData(
+					reinterpret_cast<Vertex*>(resources->vertexBuffer.data()),
+					resources->vertexBuffer.size() / sizeof(Vertex)
+				);
+
+				//Ensure the size is correct
+				assert(vertexBufferData.size() == vertexCount);
+
+				const auto makeVertex = [&surfaceSize] (const Math::Vec2f& pos, const Math::Vec3f& klm) -> Vertex {
 					//Obtain the interpolation parameter based on the position
 					const auto t = Math::ilerp(
 						-surfaceSize.first / 2.0f, 
 						+surfaceSize.first / 2.0f, 
-						vertices[i].pos
+						pos
 					);
 
 					//Interpolate the texture coordinates
@@ -475,13 +1510,34 @@ struct KeyerImpl {
 						t
 					);
 
-					vertexBufferData[i] = Vertex(
-						vertices[i].pos,
-						texCoord,
-						vertices[i].klm
-					);
+					return Vertex(pos, texCoord, klm);
+				};
+
+				//Copy the data
+				auto ite = vertexBufferData.begin();
+				for(const auto& vertex : vertices) {
+					*(ite++) = makeVertex(vertex.pos, vertex.klm);
+				}
 
+				//Add a fringe centred at each straight edge. Its klm coordinates
+				//are chosen so that the implicit function of the curve 
+				//(k^3 - l*m) becomes the signed distance to the edge. This way,
+				//the same analytic coverage is used for all the edges, which
+				//reaches one half at the edge itself
+				const auto width = calculateEdgeWidth();
+				for(const auto& edge : edges) {
+					const auto direction = edge.end - edge.begin;
+					const auto normal = Math::normalize(Math::Vec2f(direction.y, -direction.x));
+					const auto offset = (width/2.0f)*normal;
+					const Math::Vec3f inner(0.0f, +width/2.0f, 1.0f);
+					const Math::Vec3f outer(0.0f, -width/2.0f, 1.0f);
+
+					*(ite++) = makeVertex(edge.begin - offset, inner);
+					*(ite++) = makeVertex(edge.end - offset, inner);
+					*(ite++) = makeVertex(edge.begin + offset, outer);
+					*(ite++) = makeVertex(edge.end + offset, outer);
 				}
+				assert(ite == vertexBufferData.end());
 
 				//Flush the buffer
 				resources->vertexBuffer.flushData(
@@ -497,30 +1553,85 @@ struct KeyerImpl {
 			assert(!flushVertexBuffer);
 		}
 
+		void fillBoxBuffer() {
+			assert(resources);
+
+			if(flushBoxBegin < flushBoxEnd) {
+				//Wait for any previous transfers
+				resources->boxBuffer.waitCompletion(vulkan);
+
+				//Recreate if size has changed. All the boxes need to be uploaded
+				if(resources->boxBuffer.size() != boxes.size()*sizeof(Box)) {
+					resources->boxBuffer = createBoxBuffer(vulkan, boxes.size());
+					flushBoxBegin = 0;
+					flushBoxEnd = boxes.size();
+				}
+
+				//Copy only the modified range
+				assert(flushBoxEnd <= boxes.size());
+				const auto offset = flushBoxBegin*sizeof(Box);
+				const auto size = (flushBoxEnd - flushBoxBegin)*sizeof(Box);
+				if(size) {
+					std::memcpy(
+						reinterpret_cast<std::byte*>(resources->boxBuffer.data()) + offset,
+						boxes.data() + flushBoxBegin,
+						size
+					);
+
+					//Flush the buffer
+					resources->boxBuffer.flushData(
+						vulkan, 
+						offset,
+						size,
+						vulkan.getTransferQueueIndex(), 
+						vk::AccessFlagBits::eVertexAttributeRead,
+						vk::PipelineStageFlagBits::eVertexInput
+					);
+				}
+
+				flushBoxBegin = flushBoxEnd = 0;
+			}
+
+			assert(flushBoxBegin == flushBoxEnd);
+		}
+
 		void fillIndexBuffer() {
 			assert(resources);
 
 			if(flushIndexBuffer) {
 				const auto& indices = outlineProcessor.getIndices();
+				const auto indexCount = indices.size() + EDGE_INDEX_COUNT*edges.size();
 
 				//Wait for any previous transfers
 				resources->indexBuffer.waitCompletion(vulkan);
 
 				//Recreate if size has changed
-				if(resources->indexBuffer.size() != indices.size()*sizeof(Index)) {
-					resources->indexBuffer = createIndexBuffer(vulkan, indices.size());
+				if(resources->indexBuffer.size() != indexCount*sizeof(Index)) {
+					resources->indexBuffer = createIndexBuffer(vulkan, indexCount);
 				}
 
 				//Ensure the size is correct
-				assert(resources->indexBuffer.size() == indices.size()*sizeof(Index));
+				assert(resources->indexBuffer.size() == indexCount*sizeof(Index));
 
 				//Copy the data
+				const auto data = reinterpret_cast<Index*>(resources->indexBuffer.data());
 				std::memcpy(
-					resources->indexBuffer.data(), 
+					data, 
 					indices.data(), 
 					indices.size()*sizeof(Index)
 				);
 
+				//Edge fringes are placed after the outline vertices
+				auto* ite = data + indices.size();
+				Index base = outlineProcessor.getVertices().size();
+				for(size_t i = 0; i < edges.size(); ++i) {
+					*(ite++) = PRIMITIVE_RESTART_INDEX;
+					for(size_t j = 0; j < EDGE_VERTEX_COUNT; ++j) {
+						*(ite++) = base++;
+					}
+				}
+				assert(ite == data + indexCount);
+
 				//Flush the buffer
 				resources->indexBuffer.flushData(
 					vulkan, 
@@ -561,6 +1672,113 @@ struct KeyerImpl {
 			);
 		}
 
+		template<typename T>
+		void updateMatteUniform(MatteDataUniforms binding, const T& value) {
+			assert(resources);
+			lastMatte = {}; //Needs to be computed again
+			resources->matteUniformBuffer.waitCompletion(vulkan);			
+
+			resources->matteUniformBuffer.write(
+				vulkan,
+				MATTE_DESCRIPTOR_BINDING_MATTEDATA,
+				&value,
+				sizeof(value),
+				MATTEDATA_UNIFORM_LAYOUT[binding].offset()
+			);
+		}
+
+
+		void updateEdgeWidth() {
+			assert(resources);
+			resources->uniformBuffer.waitCompletion(vulkan);
+
+			const float boxMargin = calculateEdgeWidth();
+			resources->uniformBuffer.write(
+				vulkan,
+				DESCRIPTOR_BINDING_MODEL_MATRIX,
+				&boxMargin,
+				sizeof(boxMargin),
+				MODEL_UNIFORM_BOX_MARGIN_OFFSET
+			);
+
+			flushVertexBuffer = true;
+		}
+
+		float calculateEdgeWidth() const noexcept {
+			//One pixel for antialiasing plus the feather, in model units. 
+			//The camera maps a model unit to a pixel when unscaled
+			return (1.0f + feather) / modelScale;
+		}
+
+		static void calculateEdges(std::vector<Edge>& result, Utils::BufferView<const Shape> crop) {
+			result.clear();
+
+			std::vector<Math::Vec2f> points;
+			float area = 0.0f;
+			for(const auto& shape : crop) {
+				points.assign(shape.cbegin(), shape.cend());
+				const auto degree = Shape::degree();
+				assert((points.size() % degree) == 0);
+
+				for(size_t i = 0; i < points.size(); i += degree) {
+					const auto& p0 = points[i + 0];
+					const auto& p1 = points[i + 1];
+					const auto& p2 = points[i + 2];
+					const auto& p3 = points[(i + degree) % points.size()];
+
+					//Accumulate the area of the control polygon to determine the winding
+					for(size_t j = 0; j < degree; ++j) {
+						const auto& a = points[i + j];
+						const auto& b = points[(i + j + 1) % points.size()];
+						area += a.x*b.y - a.y*b.x;
+					}
+
+					//Only straight segments need a fringe, as curves are 
+					//already antialiased by their klm coordinates
+					const auto d = p3 - p0;
+					const auto d1 = p1 - p0;
+					const auto d2 = p2 - p0;
+					const auto tolerance = 1e-4f * (d.x*d.x + d.y*d.y);
+					if(	(d.x != 0.0f || d.y != 0.0f) &&
+						Math::abs(d.x*d1.y - d.y*d1.x) <= tolerance &&
+						Math::abs(d.x*d2.y - d.y*d2.x) <= tolerance )
+					{
+						result.push_back(Edge{p0, p3});
+					}
+				}
+			}
+
+			//Outer contours are expected to be counter-clockwise, so that the 
+			//right side is the outside. Otherwise, mirror the edges
+			if(area < 0.0f) {
+				for(auto& edge : result) {
+					std::swap(edge.begin, edge.end);
+				}
+			}
+		}
+
+		static int32_t calculateDebugView(Keyer::DebugView view) noexcept {
+			//Must match the definitions at keyer.glsl
+			constexpr int32_t DEBUG_VIEW_NONE = 0x00;
+			constexpr int32_t DEBUG_VIEW_MATTE = 0x01;
+			constexpr int32_t DEBUG_VIEW_FILL = 0x02;
+
+			switch(view) {
+			case Keyer::DebugView::matte:	return DEBUG_VIEW_MATTE;
+			case Keyer::DebugView::fill:	return DEBUG_VIEW_FILL;
+			default:						return DEBUG_VIEW_NONE; //Also composite
+			}
+		}
+
+		static Math::Vec3f calculateKeyColor(float hue) {
+			//HSV to RGB conversion with full saturation and value. Hue in turns
+			const auto channel = [hue] (float offset) -> float {
+				const auto x = Math::mod(6.0f*hue + offset, 6.0f);
+				return Math::clamp(std::abs(x - 3.0f) - 1.0f, 0.0f, 1.0f);
+			};
+
+			return Math::Vec3f(channel(0.0f), channel(4.0f), channel(2.0f));
+		}
 
 		static int32_t calculateLinearKeyType(bool enabled, bool inverted, Keyer::LinearKeyChannel channel) {
 			int32_t result;
@@ -605,12 +1823,24 @@ struct KeyerImpl {
 			}
 		}
 
-		static Graphics::StagedBuffer createIndexBuffer(const Graphics::Vulkan& vulkan, size_t indexCount) {
-			if(indexCount > 0) {
+		static Graphics::StagedBuffer createBoxBuffer(const Graphics::Vulkan& vulkan, size_t boxCount) {
+			if(boxCount > 0) {
 				return Graphics::StagedBuffer(
 					vulkan,
-					vk::BufferUsageFlagBits::eIndexBuffer,
-					sizeof(Index) * indexCount
+					vk::BufferUsageFlagBits::eVertexBuffer,
+					sizeof(Box) * boxCount
+				);
+			} else {
+				return {};
+			}
+		}
+
+		static Graphics::StagedBuffer createIndexBuffer(const Graphics::Vulkan& vulkan, size_t indexCount) {
+			if(indexCount > 0) {
+				return Graphics::StagedBuffer(
+					vulkan,
+					vk::BufferUsageFlagBits::eIndexBuffer,
+					sizeof(Index) * indexCount
 				);
 			} else {
 				return {};
@@ -652,60 +1882,426 @@ struct KeyerImpl {
 			return result;
 		}
 
+		static vk::DescriptorSetLayout getMatteDescriptorSetLayout(const Graphics::Vulkan& vulkan) {
+			static const Utils::StaticId id;
+			auto result = vulkan.createDescriptorSetLayout(id);
+
+			if(!result) {
+				//Create the bindings
+				const std::array bindings = {
+					vk::DescriptorSetLayoutBinding(	//UBO binding
+						MATTE_DESCRIPTOR_BINDING_MATTEDATA,				//Binding
+						vk::DescriptorType::eUniformBuffer,				//Type
+						1,												//Count
+						vk::ShaderStageFlagBits::eCompute,				//Shader stage
+						nullptr											//Immutable samplers
+					), 
+					vk::DescriptorSetLayoutBinding(	//Output binding
+						MATTE_DESCRIPTOR_BINDING_OUTPUT,				//Binding
+						vk::DescriptorType::eStorageImage,				//Type
+						1,												//Count
+						vk::ShaderStageFlagBits::eCompute,				//Shader stage
+						nullptr											//Immutable samplers
+					), 
+					vk::DescriptorSetLayoutBinding(	//Key binding
+						MATTE_DESCRIPTOR_BINDING_KEY,					//Binding
+						vk::DescriptorType::eCombinedImageSampler,		//Type
+						1,												//Count
+						vk::ShaderStageFlagBits::eCompute,				//Shader stage
+						nullptr											//Immutable samplers
+					), 
+				};
+
+				const vk::DescriptorSetLayoutCreateInfo createInfo(
+					{},
+					bindings.size(), bindings.data()
+				);
+
+				result = vulkan.createDescriptorSetLayout(id, createInfo);
+			}
+
+			return result;
+		}
+
+		static vk::DescriptorSetLayout getMatteSamplerDescriptorSetLayout(const Graphics::Vulkan& vulkan) {
+			static const Utils::StaticId id;
+			auto result = vulkan.createDescriptorSetLayout(id);
+
+			if(!result) {
+				//Create the bindings
+				const std::array bindings = {
+					vk::DescriptorSetLayoutBinding(	//Sampler binding
+						0,												//Binding
+						vk::DescriptorType::eCombinedImageSampler,		//Type
+						1,												//Count
+						vk::ShaderStageFlagBits::eFragment,				//Shader stage
+						nullptr											//Immutable samplers
+					), 
+				};
+
+				const vk::DescriptorSetLayoutCreateInfo createInfo(
+					{},
+					bindings.size(), bindings.data()
+				);
+
+				result = vulkan.createDescriptorSetLayout(id, createInfo);
+			}
+
+			return result;
+		}
+
 		static Utils::BufferView<const std::pair<uint32_t, size_t>> getUniformBufferSizes() noexcept {
 			static const std::array uniformBufferSizes = {
-				std::make_pair<uint32_t, size_t>(DESCRIPTOR_BINDING_MODEL_MATRIX, 	sizeof(Math::Mat4x4f) ),
+				std::make_pair<uint32_t, size_t>(DESCRIPTOR_BINDING_MODEL_MATRIX, 	MODEL_UNIFORM_SIZE ),
 				std::make_pair<uint32_t, size_t>(DESCRIPTOR_BINDING_LAYERDATA,		LAYERDATA_UNIFORM_LAYOUT.back().end() )
 			};
 
-			return uniformBufferSizes;
-		}
+			return uniformBufferSizes;
+		}
+
+		static Graphics::UniformBuffer createUniformBuffer(const Graphics::Vulkan& vulkan) {
+			return Graphics::UniformBuffer(vulkan, getUniformBufferSizes());
+		}
+
+		static Utils::BufferView<const std::pair<uint32_t, size_t>> getMatteUniformBufferSizes() noexcept {
+			static const std::array uniformBufferSizes = {
+				std::make_pair<uint32_t, size_t>(MATTE_DESCRIPTOR_BINDING_MATTEDATA, MATTEDATA_UNIFORM_LAYOUT.back().end() )
+			};
+
+			return uniformBufferSizes;
+		}
+
+		static Graphics::UniformBuffer createMatteUniformBuffer(const Graphics::Vulkan& vulkan) {
+			return Graphics::UniformBuffer(vulkan, getMatteUniformBufferSizes());
+		}
+
+		static vk::UniqueDescriptorPool createDescriptorPool(const Graphics::Vulkan& vulkan){
+			const std::array poolSizes = {
+				vk::DescriptorPoolSize(
+					vk::DescriptorType::eUniformBuffer,					//Descriptor type
+					getUniformBufferSizes().size()						//Descriptor count
+				)
+			};
+
+			const vk::DescriptorPoolCreateInfo createInfo(
+				{},														//Flags
+				1,														//Descriptor set count
+				poolSizes.size(), poolSizes.data()						//Pool sizes
+			);
+
+			return vulkan.createDescriptorPool(createInfo);
+		}
+
+		static vk::DescriptorSet createDescriptorSet(	const Graphics::Vulkan& vulkan,
+														vk::DescriptorPool pool )
+		{
+			const auto layout = getDescriptorSetLayout(vulkan);
+			return vulkan.allocateDescriptorSet(pool, layout).release();
+		}
+
+		static vk::PipelineLayout createPipelineLayout(	const Graphics::Vulkan& vulkan,
+														vk::DescriptorSetLayout keyFrameDescriptorSetLayout,
+														vk::DescriptorSetLayout fillFrameDescriptorSetLayout,
+														bool matteEnabled ) 
+		{
+			using Index = std::tuple<vk::DescriptorSetLayout, vk::DescriptorSetLayout, bool>;
+			static std::unordered_map<Index, const Utils::StaticId, Utils::Hasher<Index>> ids; 
+
+			const Index index(keyFrameDescriptorSetLayout, fillFrameDescriptorSetLayout, matteEnabled);
+			const auto& id = ids[index]; //TODO make it thread safe
+
+			auto result = vulkan.createPipelineLayout(id);
+			if(!result) {
+				const std::array layouts = {
+					RendererBase::getDescriptorSetLayout(vulkan), 			//DESCRIPTOR_SET_RENDERER
+					getDescriptorSetLayout(vulkan), 						//DESCRIPTOR_SET_KEYER
+					keyFrameDescriptorSetLayout, 							//DESCRIPTOR_SET_KEYFRAME
+					fillFrameDescriptorSetLayout, 							//DESCRIPTOR_SET_FILLFRAME
+					ColorLUT::Texture::getDescriptorSetLayout(vulkan),		//DESCRIPTOR_SET_COLOR_LUT
+					KeyMask::Texture::getDescriptorSetLayout(vulkan),		//DESCRIPTOR_SET_MASK
+					getMatteSamplerDescriptorSetLayout(vulkan)				//DESCRIPTOR_SET_MATTE
+				};
+
+				//The matte set is only used when it is enabled
+				const uint32_t layoutCount = matteEnabled ? DESCRIPTOR_SET_COUNT : DESCRIPTOR_SET_MATTE;
+				assert(layoutCount <= layouts.size());
+
+				const vk::PipelineLayoutCreateInfo createInfo(
+					{},													//Flags
+					layoutCount, layouts.data(),						//Descriptor set layouts
+					0, nullptr											//Push constants
+				);
+
+				result = vulkan.createPipelineLayout(id, createInfo);
+			}
+
+			return result;
+		}
+
+		static vk::Pipeline createPipeline(	const Graphics::Vulkan& vulkan,
+											vk::PipelineLayout layout,
+											vk::RenderPass renderPass,
+											BlendingMode blendingMode,
+											RenderingLayer renderingLayer,
+											const FragmentConstants& fragmentConstants,
+											bool matteEnabled,
+											bool boxesEnabled )
+		{
+			using Index = std::tuple<	vk::PipelineLayout,
+										vk::RenderPass,
+										BlendingMode,
+										RenderingLayer,
+										std::array<std::byte, sizeof(FragmentConstants)>,
+										bool,
+										bool >;
+			static std::unordered_map<Index, const Utils::StaticId, Utils::Hasher<Index>> ids;
+
+			//Create a index for gathering the id
+			std::array<std::byte, sizeof(FragmentConstants)> constantData;
+			std::memcpy(&constantData, &fragmentConstants, constantData.size());
+			const Index index(
+				layout,
+				renderPass,
+				blendingMode,
+				renderingLayer,
+				constantData,
+				matteEnabled,
+				boxesEnabled
+			);
+
+			//Try to retrieve the result from cache
+			const auto& id = ids[index];
+			auto result = vulkan.createGraphicsPipeline(id);
+			if(!result) {
+				//No luck, create it
+				static //So that its ptr can be used as an identifier
+				#include <keyer_vert.h>
+				static
+				#include <keyer_box_vert.h>
+				static
+				#include <keyer_frag.h>
+				static
+				#include <keyer_matte_frag.h>
+				static
+				#include <keyer_box_frag.h>
+				static
+				#include <keyer_box_matte_frag.h>
+
+				//The box variant expands instanced boxes instead of 
+				//using the outline vertices
+				const auto vertexCode = boxesEnabled ? 
+					Utils::BufferView<const uint32_t>(keyer_box_vert) : 
+					Utils::BufferView<const uint32_t>(keyer_vert) ;
+				const size_t vertId = reinterpret_cast<uintptr_t>(vertexCode.data());
+
+				//The matte variant samples the chroma key from the pre-pass
+				Utils::BufferView<const uint32_t> fragmentCode;
+				if(boxesEnabled) {
+					fragmentCode = matteEnabled ? 
+						Utils::BufferView<const uint32_t>(keyer_box_matte_frag) : 
+						Utils::BufferView<const uint32_t>(keyer_box_frag) ;
+				} else {
+					fragmentCode = matteEnabled ? 
+						Utils::BufferView<const uint32_t>(keyer_matte_frag) : 
+						Utils::BufferView<const uint32_t>(keyer_frag) ;
+				}
+				const size_t fragId = reinterpret_cast<uintptr_t>(fragmentCode.data());
+
+				//Try to retrive modules from cache
+				auto vertexShader = vulkan.createShaderModule(vertId);
+				if(!vertexShader) {
+					//Modules isn't in cache. Create it
+					vertexShader = vulkan.createShaderModule(vertId, vertexCode);
+				}
+
+				auto fragmentShader = vulkan.createShaderModule(fragId);
+				if(!fragmentShader) {
+					//Modules isn't in cache. Create it
+					fragmentShader = vulkan.createShaderModule(fragId, fragmentCode);
+				}
+
+				assert(vertexShader);
+				assert(fragmentShader);
+
+				//Set the specialization constants
+				const vk::SpecializationInfo fragmentSpecializationInfo(
+					FRAGMENT_SPECIALIZATION_LAYOUT.size(), FRAGMENT_SPECIALIZATION_LAYOUT.data(),
+					sizeof(fragmentConstants), &fragmentConstants
+				);
+
+				//Define the shader modules
+				constexpr auto SHADER_ENTRY_POINT = "main";
+				const std::array shaderStages = {
+					vk::PipelineShaderStageCreateInfo(		
+						{},												//Flags
+						vk::ShaderStageFlagBits::eVertex,				//Shader type
+						vertexShader,									//Shader handle
+						SHADER_ENTRY_POINT,								//Shader entry point
+						nullptr											//Specialization constants
+					),							
+					vk::PipelineShaderStageCreateInfo(		
+						{},												//Flags
+						vk::ShaderStageFlagBits::eFragment,				//Shader type
+						fragmentShader,									//Shader handle
+						SHADER_ENTRY_POINT, 							//Shader entry point
+						&fragmentSpecializationInfo						//Specialization constants
+					),						
+				};
+
+				constexpr std::array vertexBindings = {
+					vk::VertexInputBindingDescription(
+						VERTEX_BUFFER_BINDING,
+						sizeof(Vertex),
+						vk::VertexInputRate::eVertex
+					)
+				};
+
+				constexpr std::array vertexAttributes = {
+					vk::VertexInputAttributeDescription(
+						VERTEX_LOCATION_POSITION,
+						VERTEX_BUFFER_BINDING,
+						vk::Format::eR32G32Sfloat,
+						offsetof(Vertex, position)
+					),
+					vk::VertexInputAttributeDescription(
+						VERTEX_LOCATION_TEXCOORD,
+						VERTEX_BUFFER_BINDING,
+						vk::Format::eR32G32Sfloat,
+						offsetof(Vertex, texCoord)
+					),
+					vk::VertexInputAttributeDescription(
+						VERTEX_LOCATION_KLM,
+						VERTEX_BUFFER_BINDING,
+						vk::Format::eR32G32B32Sfloat,
+						offsetof(Vertex, klm)
+					)
+				};
+
+				constexpr std::array boxBindings = {
+					vk::VertexInputBindingDescription(
+						VERTEX_BUFFER_BINDING,
+						sizeof(Box),
+						vk::VertexInputRate::eInstance
+					)
+				};
+
+				constexpr std::array boxAttributes = {
+					vk::VertexInputAttributeDescription(
+						BOX_LOCATION_RECT,
+						VERTEX_BUFFER_BINDING,
+						vk::Format::eR32G32B32A32Sfloat,
+						offsetof(Box, center) //Followed by the size
+					),
+					vk::VertexInputAttributeDescription(
+						BOX_LOCATION_RADII,
+						VERTEX_BUFFER_BINDING,
+						vk::Format::eR32G32B32A32Sfloat,
+						offsetof(Box, radii)
+					)
+				};
+
+				const auto vertexInput = boxesEnabled ? 
+					vk::PipelineVertexInputStateCreateInfo(
+						{},
+						boxBindings.size(), boxBindings.data(),			//Vertex bindings
+						boxAttributes.size(), boxAttributes.data()		//Vertex attributes
+					) :
+					vk::PipelineVertexInputStateCreateInfo(
+						{},
+						vertexBindings.size(), vertexBindings.data(),	//Vertex bindings
+						vertexAttributes.size(), vertexAttributes.data()//Vertex attributes
+					) ;
+
+				constexpr vk::PipelineInputAssemblyStateCreateInfo inputAssembly(
+					{},													//Flags
+					vk::PrimitiveTopology::eTriangleStrip,				//Topology
+					true												//Restart enable
+				);
+
+				constexpr vk::PipelineViewportStateCreateInfo viewport(
+					{},													//Flags
+					1, nullptr,											//Viewports (dynamic)
+					1, nullptr											//Scissors (dynamic)
+				);
+
+				constexpr vk::PipelineRasterizationStateCreateInfo rasterizer(
+					{},													//Flags
+					false, 												//Depth clamp enabled
+					false,												//Rasterizer discard enable
+					vk::PolygonMode::eFill,								//Polygon mode
+					vk::CullModeFlagBits::eNone, 						//Cull faces
+					vk::FrontFace::eClockwise,							//Front face direction
+					false, 0.0f, 0.0f, 0.0f,							//Depth bias
+					1.0f												//Line width
+				);
+
+				constexpr vk::PipelineMultisampleStateCreateInfo multisample(
+					{},													//Flags
+					vk::SampleCountFlagBits::e1,						//Sample count
+					false, 1.0f,										//Sample shading enable, min sample shading
+					nullptr,											//Sample mask
+					false, false										//Alpha to coverage, alpha to 1 enable
+				);
+
+				const auto depthStencil = Graphics::getDepthStencilConfiguration(renderingLayer);
+
+				const std::array colorBlendAttachments = {
+					Graphics::getBlendingConfiguration(blendingMode)
+				};
+
+				const vk::PipelineColorBlendStateCreateInfo colorBlend(
+					{},													//Flags
+					false,												//Enable logic operation
+					vk::LogicOp::eCopy,									//Logic operation
+					colorBlendAttachments.size(), colorBlendAttachments.data() //Blend attachments
+				);
 
-		static Graphics::UniformBuffer createUniformBuffer(const Graphics::Vulkan& vulkan) {
-			return Graphics::UniformBuffer(vulkan, getUniformBufferSizes());
-		}
+				constexpr std::array dynamicStates = {
+					vk::DynamicState::eViewport,
+					vk::DynamicState::eScissor
+				};
 
-		static vk::UniqueDescriptorPool createDescriptorPool(const Graphics::Vulkan& vulkan){
-			const std::array poolSizes = {
-				vk::DescriptorPoolSize(
-					vk::DescriptorType::eUniformBuffer,					//Descriptor type
-					getUniformBufferSizes().size()						//Descriptor count
-				)
-			};
+				const vk::PipelineDynamicStateCreateInfo dynamicState(
+					{},													//Flags
+					dynamicStates.size(), dynamicStates.data()			//Dynamic states
+				);
 
-			const vk::DescriptorPoolCreateInfo createInfo(
-				{},														//Flags
-				1,														//Descriptor set count
-				poolSizes.size(), poolSizes.data()						//Pool sizes
-			);
+				const vk::GraphicsPipelineCreateInfo createInfo(
+					{},													//Flags
+					shaderStages.size(), shaderStages.data(),			//Shader stages
+					&vertexInput,										//Vertex input
+					&inputAssembly,										//Vertex assembly
+					nullptr,											//Tesselation
+					&viewport,											//Viewports
+					&rasterizer,										//Rasterizer
+					&multisample,										//Multisampling
+					&depthStencil,										//Depth / Stencil tests
+					&colorBlend,										//Color blending
+					&dynamicState,										//Dynamic states
+					layout,												//Pipeline layout
+					renderPass, 0,										//Renderpasses
+					nullptr, 0											//Inherit
+				);
 
-			return vulkan.createDescriptorPool(createInfo);
-		}
+				result = vulkan.createGraphicsPipeline(id, createInfo);
+			}
 
-		static vk::DescriptorSet createDescriptorSet(	const Graphics::Vulkan& vulkan,
-														vk::DescriptorPool pool )
-		{
-			const auto layout = getDescriptorSetLayout(vulkan);
-			return vulkan.allocateDescriptorSet(pool, layout).release();
+			assert(result);
+			return result;
 		}
 
-		static vk::PipelineLayout createPipelineLayout(	const Graphics::Vulkan& vulkan,
-														vk::DescriptorSetLayout keyFrameDescriptorSetLayout,
-														vk::DescriptorSetLayout fillFrameDescriptorSetLayout ) 
+		static vk::PipelineLayout createMatteKeyPipelineLayout(	const Graphics::Vulkan& vulkan,
+																vk::DescriptorSetLayout keyFrameDescriptorSetLayout ) 
 		{
-			using Index = std::tuple<vk::DescriptorSetLayout, vk::DescriptorSetLayout>;
+			using Index = vk::DescriptorSetLayout;
 			static std::unordered_map<Index, const Utils::StaticId, Utils::Hasher<Index>> ids; 
 
-			const Index index(keyFrameDescriptorSetLayout, fillFrameDescriptorSetLayout);
-			const auto& id = ids[index]; //TODO make it thread safe
+			const auto& id = ids[keyFrameDescriptorSetLayout]; //TODO make it thread safe
 
 			auto result = vulkan.createPipelineLayout(id);
 			if(!result) {
 				const std::array layouts = {
-					RendererBase::getDescriptorSetLayout(vulkan), 			//DESCRIPTOR_SET_RENDERER
-					getDescriptorSetLayout(vulkan), 						//DESCRIPTOR_SET_KEYER
-					keyFrameDescriptorSetLayout, 							//DESCRIPTOR_SET_KEYFRAME
-					fillFrameDescriptorSetLayout 							//DESCRIPTOR_SET_FILLFRAME
+					keyFrameDescriptorSetLayout 							//MATTE_KEY_DESCRIPTOR_SET_KEYFRAME
 				};
 
 				const vk::PipelineLayoutCreateInfo createInfo(
@@ -720,63 +2316,49 @@ struct KeyerImpl {
 			return result;
 		}
 
-		static vk::Pipeline createPipeline(	const Graphics::Vulkan& vulkan,
-											vk::PipelineLayout layout,
-											vk::RenderPass renderPass,
-											BlendingMode blendingMode,
-											RenderingLayer renderingLayer,
-											const FragmentConstants& fragmentConstants )
+		static vk::Pipeline createMatteKeyPipeline(	const Graphics::Vulkan& vulkan,
+													vk::PipelineLayout layout,
+													vk::RenderPass renderPass,
+													uint32_t sampleMode )
 		{
-			using Index = std::tuple<	vk::PipelineLayout,
-										vk::RenderPass,
-										BlendingMode,
-										RenderingLayer,
-										std::array<std::byte, sizeof(FragmentConstants)> >;
+			//The render pass is not part of the index, as all the
+			//key render passes are compatible
+			using Index = std::tuple<vk::PipelineLayout, uint32_t>;
 			static std::unordered_map<Index, const Utils::StaticId, Utils::Hasher<Index>> ids;
 
-			//Create a index for gathering the id
-			std::array<std::byte, sizeof(FragmentConstants)> constantData;
-			std::memcpy(&constantData, &fragmentConstants, constantData.size());
-			const Index index(
-				layout,
-				renderPass,
-				blendingMode,
-				renderingLayer,
-				constantData
-			);
-
 			//Try to retrieve the result from cache
-			const auto& id = ids[index];
+			const auto& id = ids[Index(layout, sampleMode)];
 			auto result = vulkan.createGraphicsPipeline(id);
 			if(!result) {
 				//No luck, create it
 				static //So that its ptr can be used as an identifier
-				#include <keyer_vert.h>
-				const size_t vertId = reinterpret_cast<uintptr_t>(keyer_vert);
+				#include <keyer_matte_key_vert.h>
 				static
-				#include <keyer_frag.h>
-				const size_t fragId = reinterpret_cast<uintptr_t>(keyer_frag);
+				#include <keyer_matte_key_frag.h>
+				const size_t vertId = reinterpret_cast<uintptr_t>(keyer_matte_key_vert);
+				const size_t fragId = reinterpret_cast<uintptr_t>(keyer_matte_key_frag);
 
 				//Try to retrive modules from cache
 				auto vertexShader = vulkan.createShaderModule(vertId);
 				if(!vertexShader) {
 					//Modules isn't in cache. Create it
-					vertexShader = vulkan.createShaderModule(vertId, keyer_vert);
+					vertexShader = vulkan.createShaderModule(vertId, keyer_matte_key_vert);
 				}
 
 				auto fragmentShader = vulkan.createShaderModule(fragId);
 				if(!fragmentShader) {
 					//Modules isn't in cache. Create it
-					fragmentShader = vulkan.createShaderModule(fragId, keyer_frag);
+					fragmentShader = vulkan.createShaderModule(fragId, keyer_matte_key_frag);
 				}
 
 				assert(vertexShader);
 				assert(fragmentShader);
 
-				//Set the specialization constants
+				//Set the specialization constants. Only the sample mode is used
+				const vk::SpecializationMapEntry specializationEntry(0, 0, sizeof(sampleMode));
 				const vk::SpecializationInfo fragmentSpecializationInfo(
-					FRAGMENT_SPECIALIZATION_LAYOUT.size(), FRAGMENT_SPECIALIZATION_LAYOUT.data(),
-					sizeof(fragmentConstants), &fragmentConstants
+					1, &specializationEntry,
+					sizeof(sampleMode), &sampleMode
 				);
 
 				//Define the shader modules
@@ -798,45 +2380,17 @@ struct KeyerImpl {
 					),						
 				};
 
-				constexpr std::array vertexBindings = {
-					vk::VertexInputBindingDescription(
-						VERTEX_BUFFER_BINDING,
-						sizeof(Vertex),
-						vk::VertexInputRate::eVertex
-					)
-				};
-
-				constexpr std::array vertexAttributes = {
-					vk::VertexInputAttributeDescription(
-						VERTEX_LOCATION_POSITION,
-						VERTEX_BUFFER_BINDING,
-						vk::Format::eR32G32Sfloat,
-						offsetof(Vertex, position)
-					),
-					vk::VertexInputAttributeDescription(
-						VERTEX_LOCATION_TEXCOORD,
-						VERTEX_BUFFER_BINDING,
-						vk::Format::eR32G32Sfloat,
-						offsetof(Vertex, texCoord)
-					),
-					vk::VertexInputAttributeDescription(
-						VERTEX_LOCATION_KLM,
-						VERTEX_BUFFER_BINDING,
-						vk::Format::eR32G32B32Sfloat,
-						offsetof(Vertex, klm)
-					)
-				};
-
-				const vk::PipelineVertexInputStateCreateInfo vertexInput(
+				//Vertices are generated by the shader
+				constexpr vk::PipelineVertexInputStateCreateInfo vertexInput(
 					{},
-					vertexBindings.size(), vertexBindings.data(),		//Vertex bindings
-					vertexAttributes.size(), vertexAttributes.data()	//Vertex attributes
+					0, nullptr,											//Vertex bindings
+					0, nullptr											//Vertex attributes
 				);
 
 				constexpr vk::PipelineInputAssemblyStateCreateInfo inputAssembly(
 					{},													//Flags
-					vk::PrimitiveTopology::eTriangleStrip,				//Topology
-					true												//Restart enable
+					vk::PrimitiveTopology::eTriangleList,				//Topology
+					false												//Restart enable
 				);
 
 				constexpr vk::PipelineViewportStateCreateInfo viewport(
@@ -864,10 +2418,9 @@ struct KeyerImpl {
 					false, false										//Alpha to coverage, alpha to 1 enable
 				);
 
-				const auto depthStencil = Graphics::getDepthStencilConfiguration(renderingLayer);
-
+				//The frame is copied as is
 				const std::array colorBlendAttachments = {
-					Graphics::getBlendingConfiguration(blendingMode)
+					Graphics::getBlendingConfiguration(BlendingMode::write)
 				};
 
 				const vk::PipelineColorBlendStateCreateInfo colorBlend(
@@ -896,7 +2449,7 @@ struct KeyerImpl {
 					&viewport,											//Viewports
 					&rasterizer,										//Rasterizer
 					&multisample,										//Multisampling
-					&depthStencil,										//Depth / Stencil tests
+					nullptr,											//Depth / Stencil tests (no attachment)
 					&colorBlend,										//Color blending
 					&dynamicState,										//Dynamic states
 					layout,												//Pipeline layout
@@ -911,18 +2464,93 @@ struct KeyerImpl {
 			return result;
 		}
 
+		static vk::PipelineLayout createMattePipelineLayout(const Graphics::Vulkan& vulkan) {
+			static const Utils::StaticId id;
+
+			auto result = vulkan.createPipelineLayout(id);
+			if(!result) {
+				const std::array layouts = {
+					getMatteDescriptorSetLayout(vulkan) 					//MATTE_DESCRIPTOR_SET_MATTE
+				};
+
+				const vk::PipelineLayoutCreateInfo createInfo(
+					{},													//Flags
+					layouts.size(), layouts.data(),						//Descriptor set layouts
+					0, nullptr											//Push constants
+				);
+
+				result = vulkan.createPipelineLayout(id, createInfo);
+			}
+
+			return result;
+		}
+
+		static vk::Pipeline createMattePipeline(const Graphics::Vulkan& vulkan,
+												vk::PipelineLayout layout )
+		{
+			using Index = vk::PipelineLayout;
+			static std::unordered_map<Index, const Utils::StaticId, Utils::Hasher<Index>> ids;
+
+			//Try to retrieve the result from cache
+			const auto& id = ids[layout];
+			auto result = vulkan.createComputePipeline(id);
+			if(!result) {
+				//No luck, create it
+				static //So that its ptr can be used as an identifier
+				#include <keyer_matte_comp.h>
+				const size_t compId = reinterpret_cast<uintptr_t>(keyer_matte_comp);
+
+				//Try to retrive the module from cache
+				auto computeShader = vulkan.createShaderModule(compId);
+				if(!computeShader) {
+					//Modules isn't in cache. Create it
+					computeShader = vulkan.createShaderModule(compId, keyer_matte_comp);
+				}
+
+				assert(computeShader);
+
+				constexpr auto SHADER_ENTRY_POINT = "main";
+				const vk::PipelineShaderStageCreateInfo shaderStage(		
+					{},												//Flags
+					vk::ShaderStageFlagBits::eCompute,				//Shader type
+					computeShader,									//Shader handle
+					SHADER_ENTRY_POINT,								//Shader entry point
+					nullptr											//Specialization constants
+				);
+
+				const vk::ComputePipelineCreateInfo createInfo(
+					{},												//Flags
+					shaderStage,									//Shader stage
+					layout,											//Pipeline layout
+					nullptr, 0										//Inherit
+				);
+
+				result = vulkan.createComputePipeline(id, createInfo);
+			}
+
+			assert(result);
+			return result;
+		}
+
 	};
 
 	using Input = Signal::Input<Video>;
+	using Output = Signal::DummyPad<Video>;
+	using Compositor = Renderers::Compositor;
 	using LastFrames = std::unordered_map<const RendererBase*, std::pair<Video, Video>>;
 
+	static constexpr auto UPDATE_PRIORITY = Instance::playerPriority; //Animation-like
+
 	std::reference_wrapper<Keyer>			owner;
 
 	Input									keyIn;
 	Input									fillIn;
+	Output									debugOut;
 
 	Math::Vec2f								size;
 	std::vector<Shape>						crop;
+	std::vector<Box>						cropBoxes;
+	float									feather;
 
 	bool 									lumaKeyEnabled;
 	bool									chromaKeyEnabled;
@@ -939,22 +2567,49 @@ struct KeyerImpl {
 	float									chromaKeySaturationSmoothness;
 	float									chromaKeyValueThreshold;
 	float									chromaKeyValueSmoothness;
+	Keyer::ChromaKeyMode					chromaKeyMode;
+	float									chromaKeyDespill;
+	float									chromaKeyClip;
+	float									chromaKeyGain;
+	int32_t									chromaKeyErode;
+	int32_t									chromaKeyBlur;
 
 	bool									linearKeyInverted;
 	Keyer::LinearKeyChannel					linearKeyChannel;
 
+	std::string								colorLUTPath;
+	std::shared_ptr<const ColorLUT>			colorLUT;
+	BackgroundJob							colorLUTLoader;
+	std::string								maskPath;
+	std::shared_ptr<const KeyMask>			mask;
+	BackgroundJob							maskLoader;
+
+	Keyer::DebugView						debugView;
+	Compositor								debugCompositor;
+	Base									debugLayer;
+
+	KeyerAnimation							animation;
+	float									animationTime;
+	bool									animationPlaying;
+	Keyer::AnimationCallback				animationCallback;
+
 	std::unique_ptr<Open>					opened;
 	LastFrames								lastFrames;
 	
 
 	KeyerImpl(	Keyer& owner, 
+				Instance& instance,
+				const std::string& name,
 				Math::Vec2f size )
 		: owner(owner)
 		, keyIn(owner, "keyIn")
 		, fillIn(owner, "fillIn")
+		, debugOut(owner, "debugOut")
 
 		, size(size)
 		, crop(1) //We'll fill its contents later
+		, cropBoxes()
+		, feather(0.0f)
 
 		, lumaKeyEnabled(false)
 		, chromaKeyEnabled(false)
@@ -971,13 +2626,55 @@ struct KeyerImpl {
 		, chromaKeySaturationSmoothness(0.1f)
 		, chromaKeyValueThreshold(0.3f)
 		, chromaKeyValueSmoothness(0.1f)
+		, chromaKeyMode(Keyer::ChromaKeyMode::basic)
+		, chromaKeyDespill(0.0f)
+		, chromaKeyClip(0.0f)
+		, chromaKeyGain(1.0f)
+		, chromaKeyErode(0)
+		, chromaKeyBlur(0)
 
 		, linearKeyInverted(false)
 		, linearKeyChannel(Keyer::LinearKeyChannel::fillA)
 
+		, colorLUTPath()
+		, colorLUT()
+		, colorLUTLoader()
+		, maskPath()
+		, mask()
+		, maskLoader()
+
+		, debugView(Keyer::DebugView::none)
+		, debugCompositor(instance, name + " - Debug Compositor")
+		, debugLayer(
+			instance,
+			name + " - Debug Layer",
+			{}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {},
+			std::bind(&KeyerImpl::debugHasChangedCallback, this, std::placeholders::_2),
+			std::bind(&KeyerImpl::debugHasAlphaCallback, this),
+			std::bind(&KeyerImpl::debugDrawCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+			std::bind(&KeyerImpl::debugRenderPassCallback, this, std::placeholders::_2) )
+
+		, animation()
+		, animationTime(0.0f)
+		, animationPlaying(false)
+		, animationCallback()
+
 	{
 		//We'll set a rectangle as our default crop
 		generateRectangle(crop.front(), size);
+
+		//Route the debug signal. The layer will only be added when
+		//a debug view is selected, so that nothing is rendered otherwise
+		debugOut << debugCompositor;
+		debugLayer.setBlendingMode(BlendingMode::write);
+
+		//Configure the callbacks
+		debugCompositor.setViewportSizeCallback(
+			std::bind(&KeyerImpl::configureDebugCamera, this, std::placeholders::_2)
+		);
+
+		//Define the camera settings
+		configureDebugCamera(debugCompositor.getViewportSize());
 	}
 
 	~KeyerImpl() = default;
@@ -986,14 +2683,32 @@ struct KeyerImpl {
 		owner = static_cast<Keyer&>(base);
 		keyIn.setLayout(base);
 		fillIn.setLayout(base);
+		debugOut.setLayout(base);
 	}
 
 	void open(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
 		auto& keyer = static_cast<Keyer&>(base);
 		assert(&owner.get() == &keyer);
+
+		openHelper(debugCompositor, lock);
+		openHelper(debugLayer, lock);
+		openKeyer(keyer, lock);
+
+		keyer.enableRegularUpdate(UPDATE_PRIORITY);
+	}
+
+	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		open(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+	void openKeyer(Keyer& keyer, std::unique_lock<Instance>* lock) {
+		assert(&owner.get() == &keyer);
 		assert(!opened);
 
-		if(keyer.getRenderPass()) {
+		//Also needed to render the debug view while off air
+		if(keyer.getRenderPass() || debugLayer.getRenderPass()) {
 			//Create in a unlocked environment
 			if(lock) lock->unlock();
 			auto newOpened = Utils::makeUnique<Open>(
@@ -1007,6 +2722,8 @@ struct KeyerImpl {
 			newOpened->updateOpacityUniform(keyer.getOpacity());
 
 			newOpened->setCrop(getCrop());
+			newOpened->setCropBoxes(getCropBoxes());
+			newOpened->updateFeather(getFeather());
 
 			newOpened->updateLumaKeyEnabledConstant(getLumaKeyEnabled());
 			newOpened->updateLumaKeyThresholdUniform(
@@ -1023,6 +2740,12 @@ struct KeyerImpl {
 			newOpened->updateChromaKeySaturationSmoothnessUniform(getChromaKeySaturationSmoothness());
 			newOpened->updateChromaKeyValueThresholdUniform(getChromaKeyValueThreshold());
 			newOpened->updateChromaKeyValueSmoothnessUniform(getChromaKeyValueSmoothness());
+			newOpened->updateChromaKeyDespillUniform(getChromaKeyDespill());
+			newOpened->updateChromaKeyClipUniform(getChromaKeyClip());
+			newOpened->updateChromaKeyGainUniform(getChromaKeyGain());
+			newOpened->updateChromaKeyErodeUniform(getChromaKeyErode());
+			newOpened->updateChromaKeyBlurUniform(getChromaKeyBlur());
+			newOpened->updateMatteEnabled(isMatteEnabled());
 
 			newOpened->updateLinearKeyTypeConstant(
 				getLinearKeyEnabled(),
@@ -1030,6 +2753,9 @@ struct KeyerImpl {
 				getLinearKeyChannel()
 			);
 
+			newOpened->setColorLUT(colorLUT);
+			newOpened->setMask(mask);
+
 			if(lock) lock->lock();
 
 			//Write changes after locking back
@@ -1039,16 +2765,15 @@ struct KeyerImpl {
 		assert(lastFrames.empty()); //Any hasChanged() should return true
 	}
 
-	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
-		assert(lock.owns_lock());
-		open(base, &lock);
-		assert(lock.owns_lock());
-	}
-
 
 	void close(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
 		auto& keyer = static_cast<Keyer&>(base);
-		assert(&owner.get() == &keyer); (void)(keyer);
+		assert(&owner.get() == &keyer);
+
+		keyer.disableRegularUpdate();
+
+		closeHelper(debugLayer, lock);
+		closeHelper(debugCompositor, lock);
 
 		//Write changes
 		keyIn.reset();
@@ -1072,6 +2797,30 @@ struct KeyerImpl {
 		assert(lock.owns_lock());
 	}
 
+	void update() {
+		CENITAL_PROFILE_SCOPE("Keyer::update");
+
+		//Deliver the tables and masks loaded in the background
+		colorLUTLoader.poll();
+		maskLoader.poll();
+
+		//Act as a player for the animation
+		if(animationPlaying) {
+			const auto deltaTime = owner.get().getInstance().getDeltaT();
+			const auto duration = animation.getDuration();
+			animationTime += std::chrono::duration_cast<std::chrono::duration<float>>(deltaTime).count();
+			animationTime = std::min(animationTime, duration);
+			applyAnimation(animationTime);
+
+			//If the animation has ended, stop. As this happens 
+			//outside any command, let the listener know about it
+			if(animationTime >= duration) {
+				animationPlaying = false;
+				Utils::invokeIf(animationCallback, owner.get());
+			}
+		}
+	}
+
 	bool hasChangedCallback(const LayerBase& base, const RendererBase& renderer) const {
 		const auto& keyer = static_cast<const Keyer&>(base);
 		assert(&owner.get() == &keyer); (void)(keyer);
@@ -1133,10 +2882,15 @@ struct KeyerImpl {
 	}
 
 	void drawCallback(const LayerBase& base, const RendererBase& renderer, Graphics::CommandBuffer& cmd) {
+		CENITAL_PROFILE_SCOPE("Keyer::draw");
 		const auto& keyer = static_cast<const Keyer&>(base);
 		assert(&owner.get() == &keyer); (void)(keyer);
 
-		if(opened) {
+		//It may only be opened for the debug view
+		const bool isOnAir = 	keyer.getRenderPass() && 
+								keyer.getBlendingMode() > BlendingMode::none ;
+
+		if(opened && isOnAir) {
 			const auto& keyFrame = keyIn.pull();
 			const auto& fillFrame = fillIn.pull();
 			
@@ -1158,6 +2912,41 @@ struct KeyerImpl {
 		}
 	}
 
+	bool debugHasChangedCallback(const RendererBase& renderer) const {
+		//Frames are tracked per renderer, so it can be shared
+		return hasChangedCallback(owner.get(), renderer);
+	}
+
+	bool debugHasAlphaCallback() const noexcept {
+		return hasAlphaCallback(owner.get());
+	}
+
+	void debugDrawCallback(const LayerBase& base, const RendererBase& renderer, Graphics::CommandBuffer& cmd) {
+		CENITAL_PROFILE_SCOPE("Keyer::drawDebug");
+		const auto& keyer = owner.get();
+		assert(&base == &debugLayer);
+
+		if(opened) {
+			const auto& keyFrame = keyIn.pull();
+			const auto& fillFrame = fillIn.pull();
+			
+			//Draw reusing the keyer's resources
+			if(keyFrame && fillFrame) {
+				opened->drawDebug(
+					cmd, 
+					keyFrame, 
+					fillFrame,
+					keyer.getScalingFilter(),
+					base.getRenderPass(),
+					debugView
+				);
+			}
+
+			//Update the state for next hasChanged()
+			lastFrames[&renderer] = std::make_pair(keyFrame, fillFrame);
+		}
+	}
+
 	void transformCallback(LayerBase& base, const Math::Transformf& transform) {
 		auto& keyer = static_cast<Keyer&>(base);
 		assert(&owner.get() == &keyer); (void)(keyer);
@@ -1182,17 +2971,22 @@ struct KeyerImpl {
 
 	void blendingModeCallback(LayerBase& base, BlendingMode mode) {
 		auto& keyer = static_cast<Keyer&>(base);
-		recreateCallback(keyer, keyer.getRenderPass(), mode);
+		recreateCallback(keyer, keyer.getRenderPass(), mode, debugLayer.getRenderPass());
 	}
 
 	void renderingLayerCallback(LayerBase& base, RenderingLayer) {
 		auto& keyer = static_cast<Keyer&>(base);
-		recreateCallback(keyer, keyer.getRenderPass(), keyer.getBlendingMode());
+		recreateCallback(keyer, keyer.getRenderPass(), keyer.getBlendingMode(), debugLayer.getRenderPass());
 	}
 
 	void renderPassCallback(LayerBase& base, vk::RenderPass renderPass) {
 		auto& keyer = static_cast<Keyer&>(base);
-		recreateCallback(keyer, renderPass, keyer.getBlendingMode());
+		recreateCallback(keyer, renderPass, keyer.getBlendingMode(), debugLayer.getRenderPass());
+	}
+
+	void debugRenderPassCallback(vk::RenderPass renderPass) {
+		auto& keyer = owner.get();
+		recreateCallback(keyer, keyer.getRenderPass(), keyer.getBlendingMode(), renderPass);
 	}
 
 	void scalingModeCallback(VideoScalerBase& base, ScalingMode mode) {
@@ -1233,6 +3027,11 @@ struct KeyerImpl {
 
 
 	void setCrop(Utils::BufferView<const Shape> shapes) {
+		//Avoid tessellating again when the same crop is set
+		if(isSameCrop(this->crop, shapes)) {
+			return;
+		}
+
 		this->crop.clear();
 		this->crop.insert(this->crop.cend(), shapes.cbegin(), shapes.cend());
 
@@ -1243,8 +3042,48 @@ struct KeyerImpl {
 		lastFrames.clear(); //Will force hasChanged() to true
 	}
 
-	Utils::BufferView<const Shape> getCrop() const {
-		return crop;
+	Utils::BufferView<const Shape> getCrop() const {
+		return crop;
+	}
+
+	void setCropBoxes(Utils::BufferView<const Box> boxes) {
+		cropBoxes.assign(boxes.cbegin(), boxes.cend());
+
+		if(opened) {
+			opened->setCropBoxes(cropBoxes);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	void setCropBox(size_t index, const Box& box) {
+		cropBoxes.at(index) = box;
+
+		if(opened) {
+			opened->setCropBox(index, box);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	Utils::BufferView<const Box> getCropBoxes() const {
+		return cropBoxes;
+	}
+
+	void setFeather(float width) {
+		if(feather != width) {
+			feather = width;
+
+			if(opened) {
+				opened->updateFeather(feather);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	float getFeather() const noexcept {
+		return feather;
 	}
 	
 
@@ -1336,6 +3175,7 @@ struct KeyerImpl {
 
 			if(opened) {
 				opened->updateChromaKeyEnabledConstant(chromaKeyEnabled);
+				opened->updateMatteEnabled(isMatteEnabled());
 			}
 
 			lastFrames.clear(); //Will force hasChanged() to true
@@ -1466,6 +3306,112 @@ struct KeyerImpl {
 	}
 
 
+	void setChromaKeyMode(Keyer::ChromaKeyMode mode) {
+		if(chromaKeyMode != mode) {
+			chromaKeyMode = mode;
+
+			if(opened) {
+				opened->updateMatteEnabled(isMatteEnabled());
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	Keyer::ChromaKeyMode getChromaKeyMode() const noexcept {
+		return chromaKeyMode;
+	}
+
+
+	void setChromaKeyDespill(float strength) {
+		if(chromaKeyDespill != strength) {
+			chromaKeyDespill = strength;
+
+			if(opened) {
+				opened->updateChromaKeyDespillUniform(chromaKeyDespill);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	float getChromaKeyDespill() const noexcept {
+		return chromaKeyDespill;
+	}
+
+
+	void setChromaKeyClip(float clip) {
+		if(chromaKeyClip != clip) {
+			chromaKeyClip = clip;
+
+			if(opened) {
+				opened->updateChromaKeyClipUniform(chromaKeyClip);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	float getChromaKeyClip() const noexcept {
+		return chromaKeyClip;
+	}
+
+
+	void setChromaKeyGain(float gain) {
+		if(chromaKeyGain != gain) {
+			chromaKeyGain = gain;
+
+			if(opened) {
+				opened->updateChromaKeyGainUniform(chromaKeyGain);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	float getChromaKeyGain() const noexcept {
+		return chromaKeyGain;
+	}
+
+
+	void setChromaKeyErode(int32_t erode) {
+		if(chromaKeyErode != erode) {
+			chromaKeyErode = erode;
+
+			if(opened) {
+				opened->updateChromaKeyErodeUniform(chromaKeyErode);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	int32_t getChromaKeyErode() const noexcept {
+		return chromaKeyErode;
+	}
+
+
+	void setChromaKeyBlur(int32_t blur) {
+		if(chromaKeyBlur != blur) {
+			chromaKeyBlur = blur;
+
+			if(opened) {
+				opened->updateChromaKeyBlurUniform(chromaKeyBlur);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	int32_t getChromaKeyBlur() const noexcept {
+		return chromaKeyBlur;
+	}
+
+	bool isMatteEnabled() const noexcept {
+		return chromaKeyEnabled && chromaKeyMode == Keyer::ChromaKeyMode::refined;
+	}
+
+
 
 	void setLinearKeyEnabled(bool ena) {
 		if(linearKeyEnabled != ena) {
@@ -1528,18 +3474,220 @@ struct KeyerImpl {
 	Keyer::LinearKeyChannel getLinearKeyChannel() const noexcept {
 		return linearKeyChannel;
 	}
+
+
+
+	void setColorLUTPath(std::string path) {
+		if(colorLUTPath != path) {
+			colorLUTPath = std::move(path);
+			loadColorLUT();
+		}
+	}
+
+	const std::string& getColorLUTPath() const noexcept {
+		return colorLUTPath;
+	}
+
+	void setMaskPath(std::string path) {
+		if(maskPath != path) {
+			maskPath = std::move(path);
+			loadMask();
+		}
+	}
+
+	const std::string& getMaskPath() const noexcept {
+		return maskPath;
+	}
+
+
+
+	Keyer::Output& getDebugOutput() noexcept {
+		return debugOut.getOutput();
+	}
+
+	const Keyer::Output& getDebugOutput() const noexcept {
+		return debugOut.getOutput();
+	}
+
+	void setDebugView(Keyer::DebugView view) {
+		if(debugView != view) {
+			debugView = view;
+
+			//Only render when needed
+			if(debugView != Keyer::DebugView::none) {
+				debugCompositor.setLayers({ debugLayer });
+			} else {
+				debugCompositor.setLayers({});
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	Keyer::DebugView getDebugView() const noexcept {
+		return debugView;
+	}
+
+
+
+	void setAnimation(KeyerAnimation anim) {
+		animation = std::move(anim);
+		animationTime = std::min(animationTime, animation.getDuration());
+	}
+
+	const KeyerAnimation& getAnimation() const noexcept {
+		return animation;
+	}
+
+	void play() {
+		//Always start from the beginning
+		animationTime = 0.0f;
+		animationPlaying = true;
+		applyAnimation(animationTime);
+	}
+
+	void stop() {
+		animationPlaying = false;
+	}
+
+	bool isPlaying() const noexcept {
+		return animationPlaying;
+	}
+
+	float getAnimationTime() const noexcept {
+		return animationTime;
+	}
+
+	void setAnimationCallback(Keyer::AnimationCallback cbk) {
+		animationCallback = std::move(cbk);
+	}
+
+	const Keyer::AnimationCallback& getAnimationCallback() const noexcept {
+		return animationCallback;
+	}
+
+	void applyAnimation(float time) {
+		using Track = KeyerAnimation::Track;
+		auto& keyer = owner.get();
+
+		//Only the tracks with keyframes are applied, the rest 
+		//of the parameters keep their current value
+		const auto isAnimated = [this] (Track track) -> bool {
+			return !animation.getKeyframes(track).empty();
+		};
+		const auto evaluate = [this, time, &isAnimated] (Track track, float value) -> float {
+			return isAnimated(track) ? animation.evaluate(track, time) : value;
+		};
+
+		//Transform
+		const bool positionAnimated = 
+			isAnimated(Track::positionX) || 
+			isAnimated(Track::positionY) || 
+			isAnimated(Track::positionZ) ;
+		const bool rotationAnimated = 
+			isAnimated(Track::rotationAxisX) || 
+			isAnimated(Track::rotationAxisY) || 
+			isAnimated(Track::rotationAxisZ) || 
+			isAnimated(Track::rotationAngle) ;
+		const bool scaleAnimated = 
+			isAnimated(Track::scaleX) || 
+			isAnimated(Track::scaleY) || 
+			isAnimated(Track::scaleZ) ;
+
+		if(positionAnimated || rotationAnimated || scaleAnimated) {
+			auto transform = keyer.getTransform();
+
+			if(positionAnimated) {
+				const auto& position = transform.getPosition();
+				transform.setPosition(Math::Vec3f(
+					evaluate(Track::positionX, position.x),
+					evaluate(Track::positionY, position.y),
+					evaluate(Track::positionZ, position.z)
+				));
+			}
+
+			if(rotationAnimated) {
+				//Rotation is expressed as an axis and an angle, which can not be 
+				//obtained from the current rotation. By default, rotate on the Z 
+				//axis. Fallback to the identity if the axis is null
+				const Math::Vec3f axis(
+					evaluate(Track::rotationAxisX, 0.0f),
+					evaluate(Track::rotationAxisY, 0.0f),
+					evaluate(Track::rotationAxisZ, 1.0f)
+				);
+				const auto axisLength = Math::length(axis);
+				transform.setRotation((axisLength > 0.0f) ?
+					Math::rotateAbout(axis / axisLength, Math::deg2rad(evaluate(Track::rotationAngle, 0.0f)), Math::normalized) :
+					Math::Quaternionf()
+				);
+			}
+
+			if(scaleAnimated) {
+				const auto& scale = transform.getScale();
+				transform.setScale(Math::Vec3f(
+					evaluate(Track::scaleX, scale.x),
+					evaluate(Track::scaleY, scale.y),
+					evaluate(Track::scaleZ, scale.z)
+				));
+			}
+
+			keyer.setTransform(transform);
+		}
+
+		if(isAnimated(Track::opacity)) {
+			keyer.setOpacity(evaluate(Track::opacity, keyer.getOpacity()));
+		}
+
+		//Keyer parameters. Setters ignore unchanged values
+		setFeather(evaluate(Track::feather, feather));
+		setLumaKeyMinThreshold(evaluate(Track::lumaKeyMinThreshold, lumaKeyMinThreshold));
+		setLumaKeyMaxThreshold(evaluate(Track::lumaKeyMaxThreshold, lumaKeyMaxThreshold));
+		setChromaKeyHueThreshold(evaluate(Track::chromaKeyHueThreshold, chromaKeyHueThreshold));
+		setChromaKeySaturationThreshold(evaluate(Track::chromaKeySaturationThreshold, chromaKeySaturationThreshold));
+		setChromaKeyValueThreshold(evaluate(Track::chromaKeyValueThreshold, chromaKeyValueThreshold));
+
+		//Crop morph. The crop is evaluated in place to reuse its storage
+		if(!animation.getCropKeyframes().empty()) {
+			animation.evaluateCrop(time, crop);
+
+			if(opened) {
+				opened->setCrop(crop);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	void setVideoMode(VideoBase& base, const VideoMode& videoMode) {
+		auto& keyer = static_cast<Keyer&>(base);
+		assert(&owner.get() == &keyer); (void)(keyer);
+
+		debugCompositor.setVideoMode(videoMode);
+	}
+
+	const std::vector<VideoMode>& getVideoModeCompatibility() const noexcept {
+		return debugCompositor.getVideoModeCompatibility();
+	}
+
+	VideoMode videoModeNegotiationCallback(const std::vector<VideoMode>& compatibility) {
+		auto& keyer = owner.get();
+		keyer.setVideoModeCompatibility(compatibility); //Will call the underlaying callback
+		return keyer.getVideoMode();
+	}
 		
 
 private:
 	void recreateCallback(	Keyer& keyer, 
 							vk::RenderPass renderPass,
-							BlendingMode blendingMode )
+							BlendingMode blendingMode,
+							vk::RenderPass debugRenderPass )
 	{
 		assert(&owner.get() == &keyer);
 
 		if(keyer.isOpen()) {
-			const bool isValid = 	renderPass &&
-									blendingMode > BlendingMode::none ;
+			//The debug view may be rendered while off air
+			const bool isValid = 	(renderPass && blendingMode > BlendingMode::none) ||
+									debugRenderPass ;
 
 			if(opened && isValid) {
 				//It remains valid
@@ -1551,7 +3699,100 @@ private:
 				opened.reset();
 			} else if(!opened && isValid) {
 				//It has become valid
-				open(keyer, nullptr);
+				openKeyer(keyer, nullptr);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	void configureDebugCamera(Math::Vec2f viewportSize) {
+		//Same as the one used by the mix effects, so that the
+		//transform of the keyer is rendered equally
+		constexpr auto verticalFov = Math::deg2rad(60.0f);
+		const auto distance = viewportSize.y / (2.0f * Math::tan(verticalFov/2.0f));
+
+		const Compositor::Camera camera(
+			Math::Transformf(Math::Vec3f(0.0f, 0.0f, -distance)),
+			Compositor::Camera::Projection::frustum,
+			1.0f,
+			std::numeric_limits<float>::infinity(),
+			verticalFov
+		);
+
+		debugCompositor.setCamera(camera);
+	}
+
+	void loadColorLUT() {
+		if(colorLUTPath.empty()) {
+			colorLUTLoader.cancel();
+			setColorLUT(nullptr);
+		} else {
+			//Parse it on a worker thread, as large tables take a while. 
+			//Meanwhile, the previous table is kept
+			colorLUTLoader.start(
+				[path = colorLUTPath] (const BackgroundJob::CancelFlag&) -> std::shared_ptr<const ColorLUT> {
+					try {
+						return ColorLUT::load(path);
+					} catch(...) {
+						return nullptr;
+					}
+				},
+				[this] (std::shared_ptr<const ColorLUT> lut) -> void {
+					if(!lut) {
+						ZUAZO_BASE_LOG(owner.get(), Severity::error, "Could not load " + colorLUTPath);
+					}
+
+					setColorLUT(std::move(lut));
+				}
+			);
+		}
+	}
+
+	void setColorLUT(std::shared_ptr<const ColorLUT> lut) {
+		if(colorLUT != lut) {
+			colorLUT = std::move(lut);
+
+			if(opened) {
+				opened->setColorLUT(colorLUT);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	void loadMask() {
+		if(maskPath.empty()) {
+			maskLoader.cancel();
+			setMask(nullptr);
+		} else {
+			//Decode it on a worker thread, as it takes a while. 
+			//Meanwhile, the previous mask is kept
+			maskLoader.start(
+				[path = maskPath] (const BackgroundJob::CancelFlag&) -> std::shared_ptr<const KeyMask> {
+					try {
+						return KeyMask::load(path);
+					} catch(...) {
+						return nullptr;
+					}
+				},
+				[this] (std::shared_ptr<const KeyMask> mask) -> void {
+					if(!mask) {
+						ZUAZO_BASE_LOG(owner.get(), Severity::error, "Could not load " + maskPath);
+					}
+
+					setMask(std::move(mask));
+				}
+			);
+		}
+	}
+
+	void setMask(std::shared_ptr<const KeyMask> mask) {
+		if(this->mask != mask) {
+			this->mask = std::move(mask);
+
+			if(opened) {
+				opened->setMask(this->mask);
 			}
 
 			lastFrames.clear(); //Will force hasChanged() to true
@@ -1566,7 +3807,7 @@ private:
 Keyer::Keyer(	Instance& instance,
 				std::string name,
 				Math::Vec2f size )
-	: Utils::Pimpl<KeyerImpl>({}, *this, size)
+	: Utils::Pimpl<KeyerImpl>({}, *this, instance, name, size)
 	, Base(
 		instance, 
 		std::move(name),
@@ -1576,7 +3817,7 @@ Keyer::Keyer(	Instance& instance,
 		std::bind(&KeyerImpl::asyncOpen, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
 		std::bind(&KeyerImpl::close, std::ref(**this), std::placeholders::_1, nullptr),
 		std::bind(&KeyerImpl::asyncClose, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
-		{},
+		std::bind(&KeyerImpl::update, std::ref(**this)),
 		std::bind(&KeyerImpl::transformCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
 		std::bind(&KeyerImpl::opacityCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
 		std::bind(&KeyerImpl::blendingModeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
@@ -1585,10 +3826,23 @@ Keyer::Keyer(	Instance& instance,
 		std::bind(&KeyerImpl::hasAlphaCallback, std::ref(**this), std::placeholders::_1),
 		std::bind(&KeyerImpl::drawCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
 		std::bind(&KeyerImpl::renderPassCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
+	, VideoBase(
+		std::bind(&KeyerImpl::setVideoMode, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
 	, VideoScalerBase(
 		std::bind(&KeyerImpl::scalingModeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
 		std::bind(&KeyerImpl::scalingFilterCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
 {
+	//Register output pads
+	registerPad(getDebugOutput());
+
+	//Set compatibility to a known state
+	setVideoModeCompatibility((*this)->getVideoModeCompatibility());
+
+	//Configure the callbacks. Note this callbacks need to be set here 
+	//as they make use of this class
+	(*this)->debugCompositor.setVideoModeNegotiationCallback(
+		std::bind(&KeyerImpl::videoModeNegotiationCallback, this->get(), std::placeholders::_2)
+	);
 }
 
 Keyer::Keyer(Keyer&& other) = default;
@@ -1615,6 +3869,26 @@ Utils::BufferView<const Shape> Keyer::getCrop() const noexcept {
 	return (*this)->getCrop();
 }
 
+void Keyer::setCropBoxes(Utils::BufferView<const Box> boxes) {
+	(*this)->setCropBoxes(boxes);
+}
+
+void Keyer::setCropBox(size_t index, const Box& box) {
+	(*this)->setCropBox(index, box);
+}
+
+Utils::BufferView<const Box> Keyer::getCropBoxes() const noexcept {
+	return (*this)->getCropBoxes();
+}
+
+void Keyer::setFeather(float width) {
+	(*this)->setFeather(width);
+}
+
+float Keyer::getFeather() const noexcept {
+	return (*this)->getFeather();
+}
+
 
 
 void Keyer::setLumaKeyEnabled(bool ena) {
@@ -1726,6 +4000,54 @@ float Keyer::getChromaKeyValueSmoothness() const noexcept {
 	return (*this)->getChromaKeyValueSmoothness();
 }
 
+void Keyer::setChromaKeyMode(ChromaKeyMode mode) {
+	(*this)->setChromaKeyMode(mode);
+}
+
+Keyer::ChromaKeyMode Keyer::getChromaKeyMode() const noexcept {
+	return (*this)->getChromaKeyMode();
+}
+
+void Keyer::setChromaKeyDespill(float strength) {
+	(*this)->setChromaKeyDespill(strength);
+}
+
+float Keyer::getChromaKeyDespill() const noexcept {
+	return (*this)->getChromaKeyDespill();
+}
+
+void Keyer::setChromaKeyClip(float clip) {
+	(*this)->setChromaKeyClip(clip);
+}
+
+float Keyer::getChromaKeyClip() const noexcept {
+	return (*this)->getChromaKeyClip();
+}
+
+void Keyer::setChromaKeyGain(float gain) {
+	(*this)->setChromaKeyGain(gain);
+}
+
+float Keyer::getChromaKeyGain() const noexcept {
+	return (*this)->getChromaKeyGain();
+}
+
+void Keyer::setChromaKeyErode(int32_t erode) {
+	(*this)->setChromaKeyErode(erode);
+}
+
+int32_t Keyer::getChromaKeyErode() const noexcept {
+	return (*this)->getChromaKeyErode();
+}
+
+void Keyer::setChromaKeyBlur(int32_t blur) {
+	(*this)->setChromaKeyBlur(blur);
+}
+
+int32_t Keyer::getChromaKeyBlur() const noexcept {
+	return (*this)->getChromaKeyBlur();
+}
+
 
 
 void Keyer::setLinearKeyEnabled(bool ena) {
@@ -1754,4 +4076,76 @@ Keyer::LinearKeyChannel Keyer::getLinearKeyChannel() const noexcept {
 	return (*this)->getLinearKeyChannel();
 }
 
+
+
+void Keyer::setColorLUTPath(std::string path) {
+	(*this)->setColorLUTPath(std::move(path));
+}
+
+const std::string& Keyer::getColorLUTPath() const noexcept {
+	return (*this)->getColorLUTPath();
+}
+
+void Keyer::setMaskPath(std::string path) {
+	(*this)->setMaskPath(std::move(path));
+}
+
+const std::string& Keyer::getMaskPath() const noexcept {
+	return (*this)->getMaskPath();
+}
+
+
+
+Keyer::Output& Keyer::getDebugOutput() noexcept {
+	return (*this)->getDebugOutput();
+}
+
+const Keyer::Output& Keyer::getDebugOutput() const noexcept {
+	return (*this)->getDebugOutput();
+}
+
+void Keyer::setDebugView(DebugView view) {
+	(*this)->setDebugView(view);
+}
+
+Keyer::DebugView Keyer::getDebugView() const noexcept {
+	return (*this)->getDebugView();
+}
+
+
+
+void Keyer::setAnimation(KeyerAnimation animation) {
+	(*this)->setAnimation(std::move(animation));
+}
+
+const KeyerAnimation& Keyer::getAnimation() const noexcept {
+	return (*this)->getAnimation();
+}
+
+
+void Keyer::play() {
+	(*this)->play();
+}
+
+void Keyer::stop() {
+	(*this)->stop();
+}
+
+bool Keyer::isPlaying() const noexcept {
+	return (*this)->isPlaying();
+}
+
+float Keyer::getAnimationTime() const noexcept {
+	return (*this)->getAnimationTime();
+}
+
+
+void Keyer::setAnimationCallback(AnimationCallback cbk) {
+	(*this)->setAnimationCallback(std::move(cbk));
+}
+
+const Keyer::AnimationCallback& Keyer::getAnimationCallback() const noexcept {
+	return (*this)->getAnimationCallback();
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include <Overlays/KeyerAnimation.h>
+
+#include <zuazo/StringConversions.h>
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <cassert>
+
+namespace Cenital::Overlays {
+
+using namespace Zuazo;
+
+template<typename T>
+static auto findNextKeyframe(const std::vector<T>& keyframes, float time) noexcept {
+	//When several keyframes share the same time, the last one
+	//is used, so that steps can be defined
+	return std::upper_bound(
+		keyframes.cbegin(), keyframes.cend(),
+		time,
+		[] (float time, const T& keyframe) -> bool {
+			return time < keyframe.time;
+		}
+	);
+}
+
+template<typename T>
+static void sortKeyframes(std::vector<T>& keyframes) {
+	//Keyframes need to be ordered by time, keeping the
+	//insertion order for equal times, as it is used for steps
+	for(auto& keyframe : keyframes) {
+		keyframe.time = std::max(keyframe.time, 0.0f);
+		keyframe.easing = sanitizeEasingCurve(keyframe.easing);
+	}
+	std::stable_sort(
+		keyframes.begin(), keyframes.end(),
+		[] (const T& a, const T& b) -> bool {
+			return a.time < b.time;
+		}
+	);
+}
+
+static bool isMorphable(const std::vector<Shape>& a, const std::vector<Shape>& b) noexcept {
+	return std::equal(
+		a.cbegin(), a.cend(),
+		b.cbegin(), b.cend(),
+		[] (const Shape& a, const Shape& b) -> bool {
+			return a.size() == b.size();
+		}
+	);
+}
+
+static void tokenize(const std::string& line, std::vector<std::string>& tokens) {
+	std::istringstream lineStream(line);
+	std::string token;
+
+	tokens.clear();
+	while(lineStream >> token) {
+		tokens.push_back(std::move(token));
+	}
+}
+
+static bool parseEasing(const std::vector<std::string>& tokens, size_t first, EasingCurve& easing) {
+	bool success = true;
+
+	if(tokens.size() == first + 4) {
+		for(size_t i = 0; i < 4 && success; ++i) {
+			success = fromString(tokens[first + i], easing[i]);
+		}
+	} else {
+		success = tokens.size() == first;
+		easing = KeyerAnimation::LINEAR_EASING;
+	}
+
+	return success;
+}
+
+static void writeEasing(std::ostream& os, const EasingCurve& easing) {
+	os 	<< easing[0] << ' '
+		<< easing[1] << ' '
+		<< easing[2] << ' '
+		<< easing[3];
+}
+
+
+
+void KeyerAnimation::setKeyframes(Track track, std::vector<Keyframe> keyframes) {
+	const auto trackIndex = static_cast<size_t>(track);
+	assert(trackIndex < m_tracks.size());
+
+	sortKeyframes(keyframes);
+	m_tracks[trackIndex] = std::move(keyframes);
+}
+
+const std::vector<KeyerAnimation::Keyframe>& KeyerAnimation::getKeyframes(Track track) const noexcept {
+	const auto trackIndex = static_cast<size_t>(track);
+	assert(trackIndex < m_tracks.size());
+
+	return m_tracks[trackIndex];
+}
+
+void KeyerAnimation::addKeyframe(Track track, const Keyframe& keyframe) {
+	auto keyframes = getKeyframes(track);
+	keyframes.push_back(keyframe);
+	setKeyframes(track, std::move(keyframes));
+}
+
+
+void KeyerAnimation::setCropKeyframes(std::vector<CropKeyframe> keyframes) {
+	sortKeyframes(keyframes);
+	m_cropKeyframes = std::move(keyframes);
+}
+
+const std::vector<KeyerAnimation::CropKeyframe>& KeyerAnimation::getCropKeyframes() const noexcept {
+	return m_cropKeyframes;
+}
+
+void KeyerAnimation::addCropKeyframe(CropKeyframe keyframe) {
+	auto keyframes = getCropKeyframes();
+	keyframes.push_back(std::move(keyframe));
+	setCropKeyframes(std::move(keyframes));
+}
+
+
+void KeyerAnimation::clear() {
+	*this = KeyerAnimation();
+}
+
+bool KeyerAnimation::empty() const noexcept {
+	return 	m_cropKeyframes.empty() &&
+			std::all_of(
+				m_tracks.cbegin(), m_tracks.cend(),
+				[] (const std::vector<Keyframe>& keyframes) -> bool {
+					return keyframes.empty();
+				}
+			);
+}
+
+float KeyerAnimation::getDuration() const noexcept {
+	//Keyframes are sorted, so only the last one of each track matters
+	float result = m_cropKeyframes.empty() ? 0.0f : m_cropKeyframes.back().time;
+	for(const auto& keyframes : m_tracks) {
+		if(!keyframes.empty()) {
+			result = std::max(result, keyframes.back().time);
+		}
+	}
+
+	return result;
+}
+
+
+
+float KeyerAnimation::evaluate(Track track, float time) const noexcept {
+	const auto& keyframes = getKeyframes(track);
+	assert(!keyframes.empty());
+	float result;
+
+	if(time <= keyframes.front().time) {
+		result = keyframes.front().value;
+	} else if(time >= keyframes.back().time) {
+		result = keyframes.back().value;
+	} else {
+		//Find the segment containing the time
+		const auto next = findNextKeyframe(keyframes, time);
+		assert(next != keyframes.cbegin());
+		assert(next != keyframes.cend());
+		const auto prev = std::prev(next);
+
+		//Interpolate between both keyframes
+		const auto x = (time - prev->time) / (next->time - prev->time);
+		const auto y = evaluateEasingCurve(prev->easing, x);
+		result = prev->value + (next->value - prev->value)*y;
+	}
+
+	return result;
+}
+
+void KeyerAnimation::evaluateCrop(float time, std::vector<Shape>& result) const {
+	assert(!m_cropKeyframes.empty());
+
+	if(time <= m_cropKeyframes.front().time) {
+		result = m_cropKeyframes.front().crop;
+	} else if(time >= m_cropKeyframes.back().time) {
+		result = m_cropKeyframes.back().crop;
+	} else {
+		//Find the segment containing the time
+		const auto next = findNextKeyframe(m_cropKeyframes, time);
+		assert(next != m_cropKeyframes.cbegin());
+		assert(next != m_cropKeyframes.cend());
+		const auto prev = std::prev(next);
+
+		if(isMorphable(prev->crop, next->crop)) {
+			//Interpolate point by point
+			const auto x = (time - prev->time) / (next->time - prev->time);
+			const auto y = evaluateEasingCurve(prev->easing, x);
+			std::vector<Shape::value_type> points;
+
+			result.clear();
+			result.reserve(prev->crop.size());
+			for(size_t i = 0; i < prev->crop.size(); ++i) {
+				const auto& prevShape = prev->crop[i];
+				const auto& nextShape = next->crop[i];
+
+				points.clear();
+				std::transform(
+					prevShape.cbegin(), prevShape.cend(),
+					nextShape.cbegin(),
+					std::back_inserter(points),
+					[y] (const Shape::value_type& a, const Shape::value_type& b) -> Shape::value_type {
+						return a + (b - a)*y;
+					}
+				);
+
+				assert((points.size() % Shape::degree()) == 0);
+				result.emplace_back(
+					Utils::BufferView<const Shape::segment_data>(
+						reinterpret_cast<const Shape::segment_data*>(points.data()),
+						points.size() / Shape::degree()
+					)
+				);
+			}
+		} else {
+			//Hold the previous shape
+			result = prev->crop;
+		}
+	}
+}
+
+
+
+bool KeyerAnimation::load(std::istream& is) {
+	//Each line contains either a keyframe:
+	//<track> <time> <value> [<x1> <y1> <x2> <y2>]
+	//a crop keyframe:
+	//crop <time> [<x1> <y1> <x2> <y2>]
+	//or a contour of the preceding crop keyframe:
+	//contour <x0> <y0> <x1> <y1> ...
+	//Empty lines and lines starting with '#' are ignored
+	KeyerAnimation result;
+	std::vector<CropKeyframe> cropKeyframes;
+	bool success = true;
+	std::string line;
+	std::vector<std::string> tokens;
+
+	while(success && std::getline(is, line)) {
+		tokenize(line, tokens);
+
+		if(tokens.empty() || tokens.front().front() == '#') {
+			continue; //Nothing to do
+		} else if(tokens.front() == "crop") {
+			CropKeyframe keyframe = { 0.0f, {}, LINEAR_EASING };
+
+			success = tokens.size() >= 2 && fromString(tokens[1], keyframe.time);
+			success = success && parseEasing(tokens, 2, keyframe.easing);
+
+			if(success) {
+				cropKeyframes.push_back(std::move(keyframe));
+			}
+		} else if(tokens.front() == "contour") {
+			//Points are given as coordinate pairs, which must form whole segments
+			std::vector<Shape::value_type> points((tokens.size() - 1) / 2);
+
+			success = !cropKeyframes.empty();
+			success = success && (tokens.size() - 1) == 2*points.size();
+			success = success && (points.size() % Shape::degree()) == 0;
+			for(size_t i = 0; i < points.size() && success; ++i) {
+				success = 	fromString(tokens[2*i + 1], points[i].x) &&
+							fromString(tokens[2*i + 2], points[i].y) ;
+			}
+
+			if(success) {
+				cropKeyframes.back().crop.emplace_back(
+					Utils::BufferView<const Shape::segment_data>(
+						reinterpret_cast<const Shape::segment_data*>(points.data()),
+						points.size() / Shape::degree()
+					)
+				);
+			}
+		} else if(tokens.size() >= 3) {
+			Track track;
+			Keyframe keyframe = { 0.0f, 0.0f, LINEAR_EASING };
+
+			success = fromString(tokens[0], track) && track > Track::none && track < Track::count;
+			success = success && fromString(tokens[1], keyframe.time);
+			success = success && fromString(tokens[2], keyframe.value);
+			success = success && parseEasing(tokens, 3, keyframe.easing);
+
+			if(success) {
+				result.addKeyframe(track, keyframe);
+			}
+		} else {
+			success = false;
+		}
+	}
+
+	//Only apply the changes if everything was correctly parsed
+	if(success) {
+		result.setCropKeyframes(std::move(cropKeyframes));
+		*this = std::move(result);
+	}
+
+	return success;
+}
+
+void KeyerAnimation::save(std::ostream& os) const {
+	for(auto track = Utils::EnumTraits<Track>::first(); track <= Utils::EnumTraits<Track>::last(); ++track) {
+		for(const auto& keyframe : getKeyframes(track)) {
+			os 	<< track << ' '
+				<< keyframe.time << ' '
+				<< keyframe.value << ' ';
+			writeEasing(os, keyframe.easing);
+			os << '\n';
+		}
+	}
+
+	for(const auto& keyframe : getCropKeyframes()) {
+		os << "crop " << keyframe.time << ' ';
+		writeEasing(os, keyframe.easing);
+		os << '\n';
+
+		for(const auto& shape : keyframe.crop) {
+			os << "contour";
+			for(auto ite = shape.cbegin(); ite != shape.cend(); ++ite) {
+				os << ' ' << ite->x << ' ' << ite->y;
+			}
+			os << '\n';
+		}
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <Overlays/KeyerAnimation.h>
+
+#include <zuazo/StringConversions.h>
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Overlays::KeyerAnimation::Track track) noexcept {
+	switch(track){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, positionX )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, positionY )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, positionZ )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, rotationAxisX )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, rotationAxisY )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, rotationAxisZ )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, rotationAngle )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, scaleX )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, scaleY )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, scaleZ )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, opacity )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, feather )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, lumaKeyMinThreshold )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, lumaKeyMaxThreshold )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, chromaKeyHueThreshold )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, chromaKeySaturationThreshold )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::KeyerAnimation::Track, chromaKeyValueThreshold )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::Overlays::KeyerAnimation::Track& track) {
+	//HACK. Using a lambda to call toString as otherwise it fails due to include ordering
+	return enumFromString(
+		str, track,
+		[] (const Cenital::Overlays::KeyerAnimation::Track& track) -> std::string_view {
+			return toString(track);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::Overlays::KeyerAnimation::Track track) {
+	return os << toString(track);
+}
+
+}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include <Overlays/Keyer.h>
 
 #include <Control/Generic.h>
+#include <Control/VideoModeCommands.h>
 #include <Control/VideoScalingCommands.h>
 
+#include <cctype>
+#include <fstream>
 #include <sstream>
 
 namespace Cenital::Overlays {
@@ -35,69 +38,107 @@ static void getSize(Controller& controller,
 }
 
 
-static void setShape(	Controller&,
-						ZuazoBase& base,
-						const Message& request,
-						size_t level,
-						Message& response ) 
-{
-	const auto& tokens = request.getPayload();
-
-	//Each token will be a disctinct contour
-	std::vector<Shape> contours;
+static bool parseContour(std::string_view token, Shape& result) {
 	std::vector<Shape::value_type> contourPoints;
 	bool success = true;
 	size_t read;
-	while(level < tokens.size() && success) {
-		std::string_view token = tokens[level++];
-
-		//Read all the available points
-		contourPoints.clear();
-		while(!token.empty() && success) {
-			contourPoints.emplace_back();
-			read = fromString(token, contourPoints.back());
-
-			//Determine if it was successful. If so, pop out the parsed
-			//characters
-			if(read) {
-				token.remove_prefix(read);
-
-				//If not empty, try to obtain the separator:
-				if(!token.empty()) {
-					char separator;
-					read = fromString(token, separator);
-					if(read && separator == ';') {
-						token.remove_prefix(read);
-					} else {
-						success = false;
-					}
-				}
 
-			} else {
-				success = false;
+	//Read all the available points
+	while(!token.empty() && success) {
+		contourPoints.emplace_back();
+		read = fromString(token, contourPoints.back());
+
+		//Determine if it was successful. If so, pop out the parsed
+		//characters
+		if(read) {
+			token.remove_prefix(read);
+
+			//If not empty, try to obtain the separator:
+			if(!token.empty()) {
+				char separator;
+				read = fromString(token, separator);
+				if(read && separator == ';') {
+					token.remove_prefix(read);
+				} else {
+					success = false;
+				}
 			}
-		}			
 
-		//Check if the point count is correct, it must be divisible by 3
-		success = success && (contourPoints.size() % Shape::degree()) == 0;
+		} else {
+			success = false;
+		}
+	}			
 
-		//If all went OK, add the new contour to the list
-		if(success) {
-			//As the multiple of degree constrain is satisfied at this point,
-			//It is safe to cast the data to a packed array of arrays
-			assert((contourPoints.size() % Shape::degree()) == 0);
-
-			contours.emplace_back(
-				Utils::BufferView<const Shape::segment_data>(
-					reinterpret_cast<const Shape::segment_data*>(contourPoints.data()),
-					contourPoints.size() / Shape::degree()
-				)
-			);
+	//Check if the point count is correct, it must be divisible by 3
+	success = success && (contourPoints.size() % Shape::degree()) == 0;
+
+	//If all went OK, write the contour
+	if(success) {
+		//As the multiple of degree constrain is satisfied at this point,
+		//It is safe to cast the data to a packed array of arrays
+		assert((contourPoints.size() % Shape::degree()) == 0);
+
+		result = Shape(
+			Utils::BufferView<const Shape::segment_data>(
+				reinterpret_cast<const Shape::segment_data*>(contourPoints.data()),
+				contourPoints.size() / Shape::degree()
+			)
+		);
+	}
+
+	return success;
+}
+
+static bool isSVGPath(std::string_view token) noexcept {
+	//SVG paths always start with a command letter, whilst
+	//point lists start with a number
+	const auto ite = std::find_if_not(
+		token.cbegin(), token.cend(),
+		[] (char c) -> bool {
+			return std::isspace(static_cast<unsigned char>(c));
+		}
+	);
+
+	return ite != token.cend() && std::isalpha(static_cast<unsigned char>(*ite));
+}
+
+static bool parseContours(	const std::vector<std::string>& tokens, 
+							size_t first, 
+							std::vector<Shape>& result ) 
+{
+	//Each token will be a disctinct contour, unless it is given as
+	//a SVG path, which may contain several of them
+	bool success = true;
+
+	result.clear();
+	result.reserve(tokens.size() - std::min(first, tokens.size()));
+	for(size_t i = first; i < tokens.size() && success; ++i) {
+		if(isSVGPath(tokens[i])) {
+			const auto path = loadSVGPath(tokens[i]);
+			success = static_cast<bool>(path);
+			if(success) {
+				result.insert(result.cend(), path->cbegin(), path->cend());
+			}
+		} else {
+			result.emplace_back();
+			success = parseContour(tokens[i], result.back());
 		}
 	}
 
+	return success;
+}
+
+static void setShape(	Controller&,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+	std::vector<Shape> contours;
+
 	//Check if everithing succeeded
-	if(success) {
+	if(parseContours(tokens, level, contours)) {
 		//Perform mutations
 		assert(typeid(base) == typeid(Keyer));
 		Keyer& keyer = static_cast<Keyer&>(base);
@@ -149,6 +190,175 @@ static void getShape(	Controller&,
 }
 
 
+static void setFeather(	Controller& controller,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setFeather,
+		controller, base, request, level, response
+	);
+}
+
+static void getFeather(	Controller& controller,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getFeather,
+		controller, base, request, level, response
+	);
+}
+
+
+//Boxes are written as "center;size;radii"
+static bool parseBox(std::string_view token, Box& box) {
+	size_t read;
+	char separator;
+
+	read = fromString(token, box.center);
+	if(!read) return false;
+	token.remove_prefix(read);
+
+	read = fromString(token, separator);
+	if(!read || separator != ';') return false;
+	token.remove_prefix(read);
+
+	read = fromString(token, box.size);
+	if(!read) return false;
+	token.remove_prefix(read);
+
+	read = fromString(token, separator);
+	if(!read || separator != ';') return false;
+	token.remove_prefix(read);
+
+	read = fromString(token, box.radii);
+	if(!read) return false;
+	token.remove_prefix(read);
+
+	return token.empty();
+}
+
+static std::string boxToString(const Box& box) {
+	std::stringstream ss;
+	ss << box.center << ';' << box.size << ';' << box.radii;
+	return ss.str();
+}
+
+static void setBoxes(	Controller&,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+
+	//Each token will be a disctinct box
+	std::vector<Box> boxes;
+	bool success = true;
+	while(level < tokens.size() && success) {
+		boxes.emplace_back();
+		success = parseBox(tokens[level++], boxes.back());
+	}
+
+	//Check if everithing succeeded
+	if(success) {
+		//Perform mutations
+		assert(typeid(base) == typeid(Keyer));
+		Keyer& keyer = static_cast<Keyer&>(base);
+		keyer.setCropBoxes(boxes);
+
+		//Elaborate the response
+		response.setType(Message::Type::broadcast);
+		response.getPayload() = tokens;
+	}
+}
+
+static void getBoxes(	Controller&,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level) {
+		assert(typeid(base) == typeid(Keyer));
+		const Keyer& keyer = static_cast<const Keyer&>(base);
+		const auto& boxes = keyer.getCropBoxes();
+
+		//Elaborate the response
+		response.setType(Message::Type::response);
+		auto& payload = response.getPayload();
+		payload.clear();
+		payload.reserve(boxes.size());
+		std::transform(
+			boxes.cbegin(), boxes.cend(),
+			std::back_inserter(payload),
+			boxToString
+ 		);
+	}
+}
+
+static void setBox(	Controller&,
+					ZuazoBase& base,
+					const Message& request,
+					size_t level,
+					Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level + 2) {
+		assert(typeid(base) == typeid(Keyer));
+		Keyer& keyer = static_cast<Keyer&>(base);
+
+		//Only a existing box can be modified
+		size_t index;
+		Box box;
+		if(	fromString(tokens[level + 0], index) == tokens[level + 0].size() &&
+			index < keyer.getCropBoxes().size() &&
+			parseBox(tokens[level + 1], box) )
+		{
+			keyer.setCropBox(index, box);
+
+			//Elaborate the response
+			response.setType(Message::Type::broadcast);
+			response.getPayload() = tokens;
+		}
+	}
+}
+
+static void getBox(	Controller&,
+					ZuazoBase& base,
+					const Message& request,
+					size_t level,
+					Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level + 1) {
+		assert(typeid(base) == typeid(Keyer));
+		const Keyer& keyer = static_cast<const Keyer&>(base);
+		const auto& boxes = keyer.getCropBoxes();
+
+		size_t index;
+		if(	fromString(tokens[level], index) == tokens[level].size() &&
+			index < boxes.size() )
+		{
+			//Elaborate the response
+			response.setType(Message::Type::response);
+			auto& payload = response.getPayload();
+			payload.clear();
+			payload.emplace_back(boxToString(boxes[index]));
+		}
+	}
+}
+
+
 
 static void setBlendingMode(Controller& controller,
 							ZuazoBase& base,
@@ -604,6 +814,165 @@ static void getChromaKeyValueSmoothness(Controller& controller,
 }
 
 
+static void setChromaKeyMode(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setChromaKeyMode,
+		controller, base, request, level, response
+	);
+}
+
+static void getChromaKeyMode(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getChromaKeyMode,
+		controller, base, request, level, response
+	);
+}
+
+static void enumChromaKeyMode(	Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	enumerate<Keyer::ChromaKeyMode>(controller, base, request, level, response);
+}
+
+
+static void setChromaKeyDespill(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setChromaKeyDespill,
+		controller, base, request, level, response
+	);
+}
+
+static void getChromaKeyDespill(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getChromaKeyDespill,
+		controller, base, request, level, response
+	);
+}
+
+
+static void setChromaKeyClip(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setChromaKeyClip,
+		controller, base, request, level, response
+	);
+}
+
+static void getChromaKeyClip(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getChromaKeyClip,
+		controller, base, request, level, response
+	);
+}
+
+
+static void setChromaKeyGain(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setChromaKeyGain,
+		controller, base, request, level, response
+	);
+}
+
+static void getChromaKeyGain(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getChromaKeyGain,
+		controller, base, request, level, response
+	);
+}
+
+
+static void setChromaKeyErode(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setChromaKeyErode,
+		controller, base, request, level, response
+	);
+}
+
+static void getChromaKeyErode(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getChromaKeyErode,
+		controller, base, request, level, response
+	);
+}
+
+
+static void setChromaKeyBlur(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setChromaKeyBlur,
+		controller, base, request, level, response
+	);
+}
+
+static void getChromaKeyBlur(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getChromaKeyBlur,
+		controller, base, request, level, response
+	);
+}
+
+
 
 static void setLinearKeyEnabled(Controller& controller,
 								ZuazoBase& base,
@@ -689,6 +1058,342 @@ static void enumLinearKeyChannel(	Controller& controller,
 
 
 
+static void setColorLUT(Controller& controller,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	//The file is parsed in the background, so that the 
+	//instance is not kept locked meanwhile
+	invokeSetter<Keyer, std::string>( 
+		&Keyer::setColorLUTPath,
+		controller, base, request, level, response
+	);
+}
+
+static void getColorLUT(Controller& controller,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter<const std::string&, Keyer>(
+		&Keyer::getColorLUTPath,
+		controller, base, request, level, response
+	);
+}
+
+
+
+static void setMask(Controller& controller,
+					ZuazoBase& base,
+					const Message& request,
+					size_t level,
+					Message& response ) 
+{
+	//The image is decoded in the background, so that the 
+	//instance is not kept locked meanwhile
+	invokeSetter<Keyer, std::string>( 
+		&Keyer::setMaskPath,
+		controller, base, request, level, response
+	);
+}
+
+static void getMask(Controller& controller,
+					ZuazoBase& base,
+					const Message& request,
+					size_t level,
+					Message& response ) 
+{
+	invokeGetter<const std::string&, Keyer>(
+		&Keyer::getMaskPath,
+		controller, base, request, level, response
+	);
+}
+
+
+static void setDebugView(	Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	invokeSetter(
+		&Keyer::setDebugView,
+		controller, base, request, level, response
+	);
+}
+
+static void getDebugView(	Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getDebugView,
+		controller, base, request, level, response
+	);
+}
+
+static void enumDebugView(	Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	enumerate<Keyer::DebugView>(controller, base, request, level, response);
+}
+
+
+static bool validateTrack(KeyerAnimation::Track track) noexcept {
+	return track > KeyerAnimation::Track::none && track < KeyerAnimation::Track::count;
+}
+
+static void setAnimationKeyframe(	Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response ) 
+{
+	const auto addKeyframe = [] (	Keyer& keyer, 
+									KeyerAnimation::Track track, 
+									const KeyerAnimation::Keyframe& keyframe )
+	{
+		auto animation = keyer.getAnimation();
+		animation.addKeyframe(track, keyframe);
+		keyer.setAnimation(std::move(animation));
+	};
+
+	//Easing is optional. Linear is used if not provided
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level + 3) {
+		invokeSetter<Keyer, KeyerAnimation::Track, float, float>(
+			[addKeyframe] (Keyer& keyer, KeyerAnimation::Track track, float time, float value) {
+				addKeyframe(keyer, track, KeyerAnimation::Keyframe{ time, value, KeyerAnimation::LINEAR_EASING });
+			},
+			[] (const Keyer&, KeyerAnimation::Track track, float, float) -> bool {
+				return validateTrack(track);
+			},
+			controller, base, request, level, response
+		);
+	} else {
+		invokeSetter<Keyer, KeyerAnimation::Track, float, float, float, float, float, float>(
+			[addKeyframe] (	Keyer& keyer, KeyerAnimation::Track track, float time, float value,
+							float x1, float y1, float x2, float y2 ) 
+			{
+				addKeyframe(keyer, track, KeyerAnimation::Keyframe{ time, value, Math::Vec4f(x1, y1, x2, y2) });
+			},
+			[] (const Keyer&, KeyerAnimation::Track track, float, float, float, float, float, float) -> bool {
+				return validateTrack(track);
+			},
+			controller, base, request, level, response
+		);
+	}
+}
+
+static void getAnimationKeyframes(	Controller&,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level + 1) {
+		KeyerAnimation::Track track;
+
+		if(fromString(tokens[level], track) && validateTrack(track)) {
+			assert(typeid(base) == typeid(Keyer));
+			const auto& keyer = static_cast<const Keyer&>(base);
+			const auto& keyframes = keyer.getAnimation().getKeyframes(track);
+
+			//Elaborate the response. Each keyframe is 
+			//expressed as time, value and easing
+			response.setType(Message::Type::response);
+			auto& payload = response.getPayload();
+			payload.clear();
+			payload.reserve(keyframes.size() * 6);
+			for(const auto& keyframe : keyframes) {
+				payload.emplace_back(toString(keyframe.time));
+				payload.emplace_back(toString(keyframe.value));
+				for(size_t i = 0; i < 4; ++i) {
+					payload.emplace_back(toString(keyframe.easing[i]));
+				}
+			}
+		}
+	}
+}
+
+static void unsetAnimationKeyframes(Controller& controller,
+									ZuazoBase& base,
+									const Message& request,
+									size_t level,
+									Message& response ) 
+{
+	invokeSetter<Keyer, KeyerAnimation::Track>(
+		[] (Keyer& keyer, KeyerAnimation::Track track) {
+			auto animation = keyer.getAnimation();
+			animation.setKeyframes(track, {});
+			keyer.setAnimation(std::move(animation));
+		},
+		[] (const Keyer&, KeyerAnimation::Track track) -> bool {
+			return validateTrack(track);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void enumAnimationTrack(	Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	enumerate<KeyerAnimation::Track>(controller, base, request, level, response);
+}
+
+
+static void setAnimationCropKeyframe(	Controller&,
+										ZuazoBase& base,
+										const Message& request,
+										size_t level,
+										Message& response ) 
+{
+	//Time and easing followed by the contours, 
+	//as in the shape command
+	const auto& tokens = request.getPayload();
+	if(tokens.size() >= level + 5) {
+		KeyerAnimation::CropKeyframe keyframe = { 0.0f, {}, KeyerAnimation::LINEAR_EASING };
+
+		bool success = fromString(tokens[level], keyframe.time);
+		for(size_t i = 0; i < 4 && success; ++i) {
+			success = fromString(tokens[level + 1 + i], keyframe.easing[i]);
+		}
+		success = success && parseContours(tokens, level + 5, keyframe.crop);
+
+		if(success) {
+			//Perform mutations
+			assert(typeid(base) == typeid(Keyer));
+			Keyer& keyer = static_cast<Keyer&>(base);
+			auto animation = keyer.getAnimation();
+			animation.addCropKeyframe(std::move(keyframe));
+			keyer.setAnimation(std::move(animation));
+
+			//Elaborate the response
+			response.setType(Message::Type::broadcast);
+			response.getPayload() = tokens;
+		}
+	}
+}
+
+static void unsetAnimationCropKeyframes(Controller& controller,
+										ZuazoBase& base,
+										const Message& request,
+										size_t level,
+										Message& response ) 
+{
+	invokeSetter<Keyer>(
+		[] (Keyer& keyer) {
+			auto animation = keyer.getAnimation();
+			animation.setCropKeyframes({});
+			keyer.setAnimation(std::move(animation));
+		},
+		controller, base, request, level, response
+	);
+}
+
+
+static void clearAnimation(	Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	invokeSetter<Keyer>(
+		[] (Keyer& keyer) {
+			keyer.setAnimation(KeyerAnimation());
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void loadAnimation(	Controller&,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level + 1) {
+		std::ifstream file(tokens[level]);
+		KeyerAnimation animation;
+
+		if(file.is_open() && animation.load(file)) {
+			//Perform mutations
+			assert(typeid(base) == typeid(Keyer));
+			Keyer& keyer = static_cast<Keyer&>(base);
+			keyer.setAnimation(std::move(animation));
+
+			//Elaborate the response
+			response.setType(Message::Type::broadcast);
+			response.getPayload() = tokens;
+		}
+	}
+}
+
+
+static void playAnimation(	Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	//The end of the animation is broadcasted by the AnimationNotifier
+	invokeSetter(
+		&Keyer::play,
+		controller, base, request, level, response
+	);
+}
+
+static void stopAnimation(	Controller& controller,
+							ZuazoBase& base,
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	invokeSetter(
+		&Keyer::stop,
+		controller, base, request, level, response
+	);
+}
+
+static void getAnimationPlaying(Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::isPlaying,
+		controller, base, request, level, response
+	);
+}
+
+static void getAnimationTime(	Controller& controller,
+								ZuazoBase& base,
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeGetter(
+		&Keyer::getAnimationTime,
+		controller, base, request, level, response
+	);
+}
+
+
+
 
 
 void Keyer::registerCommands(Controller& controller) {
@@ -698,6 +1403,12 @@ void Keyer::registerCommands(Controller& controller) {
 																	Overlays::getSize) );
 	configNode.addPath("shape",					makeAttributeNode(	Overlays::setShape,
 																	Overlays::getShape) );
+	configNode.addPath("boxes",					makeAttributeNode(	Overlays::setBoxes,
+																	Overlays::getBoxes) );
+	configNode.addPath("box",					makeAttributeNode(	Overlays::setBox,
+																	Overlays::getBox) );
+	configNode.addPath("feather",				makeAttributeNode(	Overlays::setFeather,
+																	Overlays::getFeather) );
 
 	configNode.addPath("blending:mode",			makeAttributeNode(	Overlays::setBlendingMode,
 																	Overlays::getBlendingMode,
@@ -737,6 +1448,19 @@ void Keyer::registerCommands(Controller& controller) {
 																	Overlays::getChromaKeyValueThreshold) );
 	configNode.addPath("chroma-key:val:smooth",	makeAttributeNode(	Overlays::setChromaKeyValueSmoothness,
 																	Overlays::getChromaKeyValueSmoothness) );
+	configNode.addPath("chroma-key:mode",		makeAttributeNode(	Overlays::setChromaKeyMode,
+																	Overlays::getChromaKeyMode,
+																	Overlays::enumChromaKeyMode) );
+	configNode.addPath("chroma-key:despill",	makeAttributeNode(	Overlays::setChromaKeyDespill,
+																	Overlays::getChromaKeyDespill) );
+	configNode.addPath("chroma-key:clip",		makeAttributeNode(	Overlays::setChromaKeyClip,
+																	Overlays::getChromaKeyClip) );
+	configNode.addPath("chroma-key:gain",		makeAttributeNode(	Overlays::setChromaKeyGain,
+																	Overlays::getChromaKeyGain) );
+	configNode.addPath("chroma-key:erode",		makeAttributeNode(	Overlays::setChromaKeyErode,
+																	Overlays::getChromaKeyErode) );
+	configNode.addPath("chroma-key:blur",		makeAttributeNode(	Overlays::setChromaKeyBlur,
+																	Overlays::getChromaKeyBlur) );
 
 	configNode.addPath("linear-key:ena",		makeAttributeNode(	Overlays::setLinearKeyEnabled,
 																	Overlays::getLinearKeyEnabled) );
@@ -746,6 +1470,45 @@ void Keyer::registerCommands(Controller& controller) {
 																	Overlays::getLinearKeyChannel,
 																	Overlays::enumLinearKeyChannel) );
 
+	configNode.addPath("color-lut",				makeAttributeNode(	Overlays::setColorLUT,
+																	Overlays::getColorLUT) );
+
+	configNode.addPath("mask",					makeAttributeNode(	Overlays::setMask,
+																	Overlays::getMask) );
+
+	configNode.addPath("debug:view",			makeAttributeNode(	Overlays::setDebugView,
+																	Overlays::getDebugView,
+																	Overlays::enumDebugView) );
+
+	configNode.addPath("animation:key",			makeAttributeNode(	Overlays::setAnimationKeyframe,
+																	Overlays::getAnimationKeyframes,
+																	Overlays::enumAnimationTrack,
+																	Overlays::unsetAnimationKeyframes ));
+	configNode.addPath("animation:crop",		makeAttributeNode(	Overlays::setAnimationCropKeyframe,
+																	{},
+																	{},
+																	Overlays::unsetAnimationCropKeyframes ));
+	configNode.addPath("animation:clear",		Overlays::clearAnimation);
+	configNode.addPath("animation:load",		Overlays::loadAnimation);
+	configNode.addPath("animation:play",		Overlays::playAnimation);
+	configNode.addPath("animation:stop",		Overlays::stopAnimation);
+	configNode.addPath("animation:playing",		makeAttributeNode(	{},
+																	Overlays::getAnimationPlaying) );
+	configNode.addPath("animation:time",		makeAttributeNode(	{},
+																	Overlays::getAnimationTime) );
+
+	//The debug output is configured as any other video source
+	constexpr auto videoModeWr = 
+		VideoModeAttributes::resolution |
+		VideoModeAttributes::pixelAspectRatio |
+		VideoModeAttributes::colorPrimaries |
+		VideoModeAttributes::colorTransferFunction |
+		VideoModeAttributes::colorFormat ;
+	constexpr auto videoModeRd = 
+		VideoModeAttributes::all &
+		~VideoModeAttributes::frameRate ;
+	registerVideoModeCommands<Keyer>(configNode, videoModeWr, videoModeRd, "debug:video-mode");
+
 	constexpr auto videoScalingWr = 
 		VideoScalingAttributes::mode |
 		VideoScalingAttributes::filter ;
@@ -35,4 +35,58 @@ std::ostream& operator<<(std::ostream& os, Cenital::Overlays::Keyer::LinearKeyCh
 	return os << toString(channel);
 }
 
+
+
+
+std::string_view toString(Cenital::Overlays::Keyer::ChromaKeyMode mode) noexcept {
+	switch(mode){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::Keyer::ChromaKeyMode, basic )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::Keyer::ChromaKeyMode, refined )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::Overlays::Keyer::ChromaKeyMode& mode) {
+	return enumFromString(
+		str, mode, 
+		[] (const Cenital::Overlays::Keyer::ChromaKeyMode& mode) -> std::string_view { 
+			return toString(mode);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::Overlays::Keyer::ChromaKeyMode mode) {
+	return os << toString(mode);
+}
+
+
+
+
+std::string_view toString(Cenital::Overlays::Keyer::DebugView view) noexcept {
+	switch(view){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::Keyer::DebugView, none )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::Keyer::DebugView, matte )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::Keyer::DebugView, fill )
+	ZUAZO_ENUM2STR_CASE( Cenital::Overlays::Keyer::DebugView, composite )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::Overlays::Keyer::DebugView& view) {
+	return enumFromString(
+		str, view, 
+		[] (const Cenital::Overlays::Keyer::DebugView& view) -> std::string_view { 
+			return toString(view);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::Overlays::Keyer::DebugView view) {
+	return os << toString(view);
+}
+
 }
\ No newline at end of file
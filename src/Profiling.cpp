@@ -0,0 +1,254 @@
+#include <Profiling.h>
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Cenital {
+
+/*
+ * ProfilingCounter
+ */
+
+//Counters are registered on static initialization, so the list
+//needs to be created on demand to avoid initialization order issues
+static std::mutex& getRegistryMutex() noexcept {
+	static std::mutex mutex;
+	return mutex;
+}
+
+static ProfilingCounter*& getRegistryHead() noexcept {
+	static ProfilingCounter* head = nullptr;
+	return head;
+}
+
+
+
+ProfilingCounter::ProfilingCounter(std::string_view name) noexcept
+	: m_name(name)
+	, m_callCount(0)
+	, m_totalTime(0)
+	, m_next(nullptr)
+{
+	std::lock_guard<std::mutex> lock(getRegistryMutex());
+	auto& head = getRegistryHead();
+	m_next = head;
+	head = this;
+}
+
+
+
+void ProfilingCounter::forEach(const Callback& cbk) {
+	std::lock_guard<std::mutex> lock(getRegistryMutex());
+	for(auto* counter = getRegistryHead(); counter; counter = counter->m_next) {
+		cbk(*counter);
+	}
+}
+
+void ProfilingCounter::resetAll() noexcept {
+	std::lock_guard<std::mutex> lock(getRegistryMutex());
+	for(auto* counter = getRegistryHead(); counter; counter = counter->m_next) {
+		counter->reset();
+	}
+}
+
+
+
+/*
+ * Tracing
+ */
+
+class TraceBuffer {
+public:
+	struct Event {
+		std::string_view	name;
+		int64_t				begin;
+		int64_t				end;
+	};
+
+	explicit TraceBuffer(size_t threadId) noexcept
+		: m_threadId(threadId)
+		, m_head(0)
+		, m_tail(0)
+		, m_slots()
+	{
+	}
+
+	TraceBuffer(const TraceBuffer& other) = delete;
+	~TraceBuffer() = default;
+
+	TraceBuffer& operator=(const TraceBuffer& other) = delete;
+
+	size_t getThreadId() const noexcept {
+		return m_threadId;
+	}
+
+	void push(std::string_view name, int64_t begin, int64_t end) noexcept {
+		//Only called by the owning thread. Each slot has a sequence number
+		//which is odd while it is being written, so that readers can detect
+		//slots which are being overwritten
+		const auto index = m_head.load(std::memory_order_relaxed);
+		auto& slot = m_slots[index % m_slots.size()];
+
+		slot.sequence.store(2*index + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.name.store(name.data(), std::memory_order_relaxed);
+		slot.nameSize.store(name.size(), std::memory_order_relaxed);
+		slot.begin.store(begin, std::memory_order_relaxed);
+		slot.end.store(end, std::memory_order_relaxed);
+		slot.sequence.store(2*index + 2, std::memory_order_release);
+
+		m_head.store(index + 1, std::memory_order_release);
+	}
+
+	template<typename F>
+	void forEach(F&& func) const {
+		const auto head = m_head.load(std::memory_order_acquire);
+		const auto tail = m_tail.load(std::memory_order_relaxed);
+		const auto first = std::max(tail, head > m_slots.size() ? head - m_slots.size() : uint64_t(0));
+
+		for(auto index = first; index < head; ++index) {
+			const auto& slot = m_slots[index % m_slots.size()];
+
+			//Skip the slot if it is being overwritten
+			const auto sequence = slot.sequence.load(std::memory_order_acquire);
+			if(sequence != 2*index + 2) {
+				continue;
+			}
+
+			const Event event = {
+				std::string_view(
+					slot.name.load(std::memory_order_relaxed),
+					slot.nameSize.load(std::memory_order_relaxed)
+				),
+				slot.begin.load(std::memory_order_relaxed),
+				slot.end.load(std::memory_order_relaxed)
+			};
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if(slot.sequence.load(std::memory_order_relaxed) == sequence) {
+				func(event);
+			}
+		}
+	}
+
+	void clear() noexcept {
+		m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+
+private:
+	struct Slot {
+		std::atomic<uint64_t>		sequence = {0};
+		std::atomic<const char*>	name = {nullptr};
+		std::atomic<size_t>			nameSize = {0};
+		std::atomic<int64_t>		begin = {0};
+		std::atomic<int64_t>		end = {0};
+	};
+
+	size_t									m_threadId;
+	std::atomic<uint64_t>					m_head;
+	std::atomic<uint64_t>					m_tail;
+	std::array<Slot, Tracing::BUFFER_SIZE>	m_slots;
+
+};
+
+
+
+//Buffers are shared with the registry, so that the events of
+//finished threads can still be exported
+static std::mutex& getTraceRegistryMutex() noexcept {
+	static std::mutex mutex;
+	return mutex;
+}
+
+static std::vector<std::shared_ptr<TraceBuffer>>& getTraceRegistry() noexcept {
+	static std::vector<std::shared_ptr<TraceBuffer>> buffers;
+	return buffers;
+}
+
+static TraceBuffer& getTraceBuffer() {
+	//Only locks the first time each thread records an event
+	thread_local const std::shared_ptr<TraceBuffer> buffer = [] () {
+		std::lock_guard<std::mutex> lock(getTraceRegistryMutex());
+		auto& registry = getTraceRegistry();
+		auto result = std::make_shared<TraceBuffer>(registry.size() + 1);
+		registry.push_back(result);
+		return result;
+	}();
+
+	return *buffer;
+}
+
+static int64_t toNanoseconds(ProfilingCounter::Clock::time_point tp) noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+static void writeJSONString(std::ostream& os, std::string_view str) {
+	os << '"';
+	for(const auto c : str) {
+		if(c == '"' || c == '\\') {
+			os << '\\';
+		}
+		os << c;
+	}
+	os << '"';
+}
+
+
+
+void Tracing::record(	std::string_view name,
+						ProfilingCounter::Clock::time_point begin,
+						ProfilingCounter::Clock::time_point end ) noexcept
+{
+	getTraceBuffer().push(name, toNanoseconds(begin), toNanoseconds(end));
+}
+
+void Tracing::clear() {
+	std::lock_guard<std::mutex> lock(getTraceRegistryMutex());
+	for(const auto& buffer : getTraceRegistry()) {
+		buffer->clear();
+	}
+}
+
+void Tracing::write(std::ostream& os) {
+	//Complete events ("ph": "X") with timestamps in microseconds
+	std::lock_guard<std::mutex> lock(getTraceRegistryMutex());
+	const auto flags = os.flags();
+	const auto precision = os.precision();
+	bool first = true;
+
+	os << std::fixed << std::setprecision(3);
+	os << "{\"traceEvents\":[";
+	for(const auto& buffer : getTraceRegistry()) {
+		const auto threadId = buffer->getThreadId();
+
+		buffer->forEach(
+			[&os, &first, threadId] (const TraceBuffer::Event& event) {
+				os << (first ? "\n" : ",\n");
+				os << "{\"name\":";
+				writeJSONString(os, event.name);
+				os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId;
+				os << ",\"ts\":" << event.begin / 1e3;
+				os << ",\"dur\":" << (event.end - event.begin) / 1e3 << "}";
+				first = false;
+			}
+		);
+	}
+	os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	os.flags(flags);
+	os.precision(precision);
+}
+
+
+
+/*
+ * ProfilingScope
+ */
+
+std::atomic<uint32_t> ProfilingScope::s_flags(static_cast<uint32_t>(ProfilingFlags::none));
+
+}
\ No newline at end of file
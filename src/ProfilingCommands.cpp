@@ -0,0 +1,102 @@
+#include <Profiling.h>
+
+#include <DumpDirectory.h>
+
+#include <Control/Controller.h>
+#include <Control/Node.h>
+#include <Control/Message.h>
+#include <Control/Generic.h>
+
+#include <fstream>
+
+namespace Cenital {
+
+using namespace Zuazo;
+using namespace Control;
+
+static void setTracingEnabled(	Controller&,
+								ZuazoBase&,
+								const Message& request,
+								size_t level,
+								Message& response )
+{
+	const auto& tokens = request.getPayload();
+
+	bool ena;
+	if(tokens.size() == level + 1 && fromString(tokens[level], ena)) {
+		Tracing::setEnabled(ena);
+
+		response.setType(Message::Type::broadcast);
+		response.getPayload() = tokens;
+	}
+}
+
+static void getTracingEnabled(	Controller&,
+								ZuazoBase&,
+								const Message& request,
+								size_t level,
+								Message& response )
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level) {
+		response.setType(Message::Type::response);
+		response.getPayload() = { std::string(toString(Tracing::isEnabled())) };
+	}
+}
+
+static void dumpTrace(	Controller&,
+						ZuazoBase&,
+						const Message& request,
+						size_t level,
+						Message& response )
+{
+	const auto& tokens = request.getPayload();
+
+	//The timeline is written to a file, as it is too 
+	//large to be sent through the control connection.
+	//Only names inside the dump directory are accepted
+	if(tokens.size() == level + 1) {
+		const auto path = DumpDirectory::resolve(tokens[level]);
+		if(path.empty()) {
+			return;
+		}
+
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+		if(file.is_open()) {
+			Tracing::write(file);
+
+			if(file.good()) {
+				response.setType(Message::Type::response);
+			}
+		}
+	}
+}
+
+static void clearTrace(	Controller&,
+						ZuazoBase&,
+						const Message& request,
+						size_t level,
+						Message& response )
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level) {
+		Tracing::clear();
+		response.setType(Message::Type::response);
+	}
+}
+
+
+
+void Tracing::registerCommands(Controller& controller) {
+	auto& rootNode = controller.getRootNode();
+
+	rootNode.addPath("trace:ena",		makeAttributeNode(	Cenital::setTracingEnabled,
+															Cenital::getTracingEnabled ));
+	rootNode.addPath("trace:dump",		Cenital::dumpTrace);
+	rootNode.addPath("trace:clear",		Cenital::clearTrace);
+}
+
+}
\ No newline at end of file
@@ -2,11 +2,74 @@
 
 #include <zuazo/Math/Trigonometry.h>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
 
 namespace Cenital {
 
+//Distance from the end-points to the control points of a cubic 
+//Bézier approximating a quarter of a circle
+static constexpr float KAPPA = 0.5522847498f;
+
+//Amount of parsed SVG paths kept by loadSVGPath()
+static constexpr size_t SVG_PATH_CACHE_SIZE = 64;
+
+static std::vector<Shape::value_type>& getScratchPoints() {
+	//Reused across calls to avoid allocating on every update
+	thread_local std::vector<Shape::value_type> points;
+	return points;
+}
+
+static void writeShape(Shape& result, const std::vector<Shape::value_type>& points) {
+	assert((points.size() % Shape::degree()) == 0);
+
+	if(result.size() == points.size()) {
+		//Same topology. Overwrite the points in place
+		std::copy(points.cbegin(), points.cend(), result.begin());
+	} else {
+		result = Shape(
+			Zuazo::Utils::BufferView<const Shape::segment_data>(
+				reinterpret_cast<const Shape::segment_data*>(points.data()),
+				points.size() / Shape::degree()
+			)
+		);
+	}
+}
+
+static void appendLine(	std::vector<Shape::value_type>& points, 
+						Zuazo::Math::Vec2f p0, 
+						Zuazo::Math::Vec2f p1 )
+{
+	//Straight segment with evenly spaced control points. The
+	//end-point is given by the next segment
+	const auto delta = p1 - p0;
+	points.push_back(p0);
+	points.push_back(p0 + delta / 3.0f);
+	points.push_back(p0 + delta * (2.0f / 3.0f));
+}
+
+static void appendCubic(std::vector<Shape::value_type>& points, 
+						Zuazo::Math::Vec2f p0, 
+						Zuazo::Math::Vec2f c0, 
+						Zuazo::Math::Vec2f c1 )
+{
+	points.push_back(p0);
+	points.push_back(c0);
+	points.push_back(c1);
+}
+
+static bool isSamePoint(Zuazo::Math::Vec2f a, Zuazo::Math::Vec2f b) noexcept {
+	return a.x == b.x && a.y == b.y;
+}
+
 void generateStar(Shape& result, size_t count, float radius0, float radius1, float angle) {
 	//Start over
 	result.clear();
@@ -54,46 +117,48 @@ void generateHeart(Shape& result, float size) {
 	};
 
 	//Resize the heart to the desired size
-	auto points = HEART_POINTS;
-	for(auto& segmentData : points) {
-		for(auto& point : segmentData) {
-			point *= size;
+	auto& points = getScratchPoints();
+	points.clear();
+	for(const auto& segmentData : HEART_POINTS) {
+		for(const auto& point : segmentData) {
+			points.push_back(point * size);
 		}
 	}
 
 	//Add the points
-	//FIXME avoid reallocation
-	result = Shape(Zuazo::Utils::BufferView<const decltype(points)::value_type>(points)); 
+	writeShape(result, points);
 }
 
 void generateEllipse(Shape& result, Zuazo::Math::Vec2f size) {
-	//This is not actually a ellipse, but is similar (polynomial approx)
+	//Each quadrant is approximated by a cubic Bézier. The maximum
+	//radial error is below 0.03%
+	constexpr float K = KAPPA / 2;
 	constexpr std::array<std::array<Shape::value_type, Shape::degree()>, 4> ELLIPSE_POINTS = {
-		Zuazo::Math::Vec2f(+0.5,	 0.0 ), //Right vertex
-		Zuazo::Math::Vec2f(+0.5,	+0.25),
-		Zuazo::Math::Vec2f(+0.25,	+0.5 ),
-		Zuazo::Math::Vec2f( 0.0,	+0.5 ),	//Top vertex
-		Zuazo::Math::Vec2f(-0.25,	+0.5 ),
-		Zuazo::Math::Vec2f(-0.5,	+0.25),
-		Zuazo::Math::Vec2f(-0.5,	 0.0 ),	//Left vertex
-		Zuazo::Math::Vec2f(-0.5,	-0.25),
-		Zuazo::Math::Vec2f(-0.25,	-0.5 ),
-		Zuazo::Math::Vec2f( 0.0,	-0.5 ), //Bottom vertex
-		Zuazo::Math::Vec2f(+0.25,	-0.5 ),
-		Zuazo::Math::Vec2f(+0.5,	-0.25)
+		Zuazo::Math::Vec2f(+0.5,	 0.0),	//Right vertex
+		Zuazo::Math::Vec2f(+0.5,	+K	),
+		Zuazo::Math::Vec2f(+K,		+0.5),
+		Zuazo::Math::Vec2f( 0.0,	+0.5),	//Top vertex
+		Zuazo::Math::Vec2f(-K,		+0.5),
+		Zuazo::Math::Vec2f(-0.5,	+K	),
+		Zuazo::Math::Vec2f(-0.5,	 0.0),	//Left vertex
+		Zuazo::Math::Vec2f(-0.5,	-K	),
+		Zuazo::Math::Vec2f(-K,		-0.5),
+		Zuazo::Math::Vec2f( 0.0,	-0.5),	//Bottom vertex
+		Zuazo::Math::Vec2f(+K,		-0.5),
+		Zuazo::Math::Vec2f(+0.5,	-K	)
 	};
 
-	//Resize the heart to the desired size
-	auto points = ELLIPSE_POINTS;
-	for(auto& segmentData : points) {
-		for(auto& point : segmentData) {
-			point *= size;
+	//Resize the ellipse to the desired size
+	auto& points = getScratchPoints();
+	points.clear();
+	for(const auto& segmentData : ELLIPSE_POINTS) {
+		for(const auto& point : segmentData) {
+			points.push_back(point * size);
 		}
 	}
 
 	//Add the points
-	//FIXME avoid reallocation
-	result = Shape(Zuazo::Utils::BufferView<const decltype(points)::value_type>(points)); 
+	writeShape(result, points);
 }
 
 void generateRectangle(Shape& result, Zuazo::Math::Vec2f size) {
@@ -111,4 +176,362 @@ void generateRectangle(Shape& result, Zuazo::Math::Vec2f size) {
 	}
 }
 
+void generateRoundedRectangle(Shape& result, Zuazo::Math::Vec2f size, Zuazo::Math::Vec4f radii) {
+	//Corners and the direction in which the contour arrives to them,
+	//both counter-clockwise starting from the (+x, +y) corner
+	constexpr std::array<Zuazo::Math::Vec2f, 4> CORNERS = {
+		Zuazo::Math::Vec2f(+0.5, +0.5),
+		Zuazo::Math::Vec2f(-0.5, +0.5),
+		Zuazo::Math::Vec2f(-0.5, -0.5),
+		Zuazo::Math::Vec2f(+0.5, -0.5),
+	};
+	constexpr std::array<Zuazo::Math::Vec2f, 4> DIRECTIONS = {
+		Zuazo::Math::Vec2f( 0.0, +1.0),
+		Zuazo::Math::Vec2f(-1.0,  0.0),
+		Zuazo::Math::Vec2f( 0.0, -1.0),
+		Zuazo::Math::Vec2f(+1.0,  0.0),
+	};
+
+	//Radii can not exceed half of the shortest side
+	const auto maxRadius = std::min(std::abs(size.x), std::abs(size.y)) / 2;
+	for(size_t i = 0; i < CORNERS.size(); ++i) {
+		radii[i] = std::clamp(radii[i], 0.0f, maxRadius);
+	}
+
+	//Obtain where each of the arcs start and end
+	std::array<Zuazo::Math::Vec2f, 4> arcBegin;
+	std::array<Zuazo::Math::Vec2f, 4> arcEnd;
+	for(size_t i = 0; i < CORNERS.size(); ++i) {
+		const auto corner = CORNERS[i] * size;
+		arcBegin[i] = corner - radii[i]*DIRECTIONS[i];
+		arcEnd[i] = corner + radii[i]*DIRECTIONS[(i + 1) % DIRECTIONS.size()];
+	}
+
+	//Add the arcs and the sides between them. Degenerate ones are 
+	//skipped, so that a zero radius results in a sharp corner
+	auto& points = getScratchPoints();
+	points.clear();
+	for(size_t i = 0; i < CORNERS.size(); ++i) {
+		const auto next = (i + 1) % CORNERS.size();
+
+		if(radii[i] > 0.0f) {
+			appendCubic(
+				points,
+				arcBegin[i],
+				arcBegin[i] + KAPPA*radii[i]*DIRECTIONS[i],
+				arcEnd[i] - KAPPA*radii[i]*DIRECTIONS[next]
+			);
+		}
+
+		if(!isSamePoint(arcEnd[i], arcBegin[next])) {
+			appendLine(points, arcEnd[i], arcBegin[next]);
+		}
+	}
+
+	writeShape(result, points);
+}
+
+void generatePolygon(Shape& result, Zuazo::Utils::BufferView<const Zuazo::Math::Vec2f> vertices) {
+	result.clear();
+	for(const auto& vertex : vertices) {
+		result.lineTo(vertex);
+	}
+}
+
+void generateRegularPolygon(Shape& result, size_t count, float radius, float angle) {
+	//Start over
+	result.clear();
+
+	const float stepAngle = 2*M_PI / count;
+
+	for(size_t i = 0; i < count; ++i) {
+		const auto theta = angle + stepAngle*i;
+		result.lineTo(radius*Zuazo::Math::Vec2f(
+			Zuazo::Math::cos(theta),
+			Zuazo::Math::sin(theta)
+		));
+	}
+	assert(result.size() == Shape::degree()*count);
+}
+
+
+
+static void skipSVGSeparators(std::string_view& str) noexcept {
+	while(!str.empty() && (std::isspace(static_cast<unsigned char>(str.front())) || str.front() == ',')) {
+		str.remove_prefix(1);
+	}
+}
+
+static bool parseSVGNumber(std::string_view& str, float& result) {
+	skipSVGSeparators(str);
+
+	//Obtain the extent of the number. Numbers are not necessarily 
+	//separated, ie "1-2" or "0.5.5" contain 2 numbers
+	const auto isDigit = [&str] (size_t i) -> bool {
+		return i < str.size() && std::isdigit(static_cast<unsigned char>(str[i]));
+	};
+
+	size_t length = 0;
+	size_t digitCount = 0;
+	if(length < str.size() && (str[length] == '+' || str[length] == '-')) {
+		++length;
+	}
+	while(isDigit(length)) {
+		++length;
+		++digitCount;
+	}
+	if(length < str.size() && str[length] == '.') {
+		++length;
+		while(isDigit(length)) {
+			++length;
+			++digitCount;
+		}
+	}
+	if(digitCount > 0 && length < str.size() && (str[length] == 'e' || str[length] == 'E')) {
+		//Only consume the exponent if it is well formed
+		auto exponentLength = length + 1;
+		if(exponentLength < str.size() && (str[exponentLength] == '+' || str[exponentLength] == '-')) {
+			++exponentLength;
+		}
+		if(isDigit(exponentLength)) {
+			length = exponentLength;
+			while(isDigit(length)) {
+				++length;
+			}
+		}
+	}
+
+	//Copy it so that it is null terminated
+	std::array<char, 64> buffer;
+	const bool success = digitCount > 0 && length < buffer.size();
+	if(success) {
+		std::copy_n(str.cbegin(), length, buffer.begin());
+		buffer[length] = '\0';
+		result = std::strtof(buffer.data(), nullptr);
+		str.remove_prefix(length);
+	}
+
+	return success;
+}
+
+static bool parseSVGPoint(std::string_view& str, Zuazo::Math::Vec2f& result) {
+	return parseSVGNumber(str, result.x) && parseSVGNumber(str, result.y);
+}
+
+bool parseSVGPath(std::string_view path, std::vector<Shape>& result) {
+	auto& points = getScratchPoints();
+	size_t contourCount = 0;
+	Zuazo::Math::Vec2f start(0.0f);
+	Zuazo::Math::Vec2f current(0.0f);
+	Zuazo::Math::Vec2f lastControl(0.0f);
+	char lastCommand = '\0';
+	bool success = true;
+
+	const auto closeContour = [&] {
+		if(!points.empty()) {
+			if(!isSamePoint(current, start)) {
+				appendLine(points, current, start);
+			}
+
+			//Reuse the existing contours when possible
+			if(contourCount < result.size()) {
+				writeShape(result[contourCount], points);
+			} else {
+				result.emplace_back(
+					Zuazo::Utils::BufferView<const Shape::segment_data>(
+						reinterpret_cast<const Shape::segment_data*>(points.data()),
+						points.size() / Shape::degree()
+					)
+				);
+			}
+			++contourCount;
+		}
+
+		points.clear();
+		current = start;
+	};
+
+	points.clear();
+	while(success) {
+		skipSVGSeparators(path);
+		if(path.empty()) {
+			break;
+		}
+
+		//Obtain the command. When omitted, the previous one is repeated,
+		//except for moves, which are followed by lines
+		char command;
+		if(std::isalpha(static_cast<unsigned char>(path.front()))) {
+			command = path.front();
+			path.remove_prefix(1);
+		} else if(lastCommand == 'M') {
+			command = 'L';
+		} else if(lastCommand == 'm') {
+			command = 'l';
+		} else if(lastCommand != '\0' && lastCommand != 'Z' && lastCommand != 'z') {
+			command = lastCommand;
+		} else {
+			success = false;
+			break;
+		}
+
+		const auto upperCommand = static_cast<char>(std::toupper(static_cast<unsigned char>(command)));
+		const auto upperLastCommand = static_cast<char>(std::toupper(static_cast<unsigned char>(lastCommand)));
+		const auto origin = std::islower(static_cast<unsigned char>(command)) ? current : Zuazo::Math::Vec2f(0.0f);
+		Zuazo::Math::Vec2f point0, point1, point2;
+
+		switch(upperCommand) {
+		case 'M':
+			success = parseSVGPoint(path, point0);
+			if(success) {
+				closeContour();
+				start = current = origin + point0;
+			}
+			break;
+
+		case 'L':
+			success = parseSVGPoint(path, point0);
+			if(success) {
+				appendLine(points, current, origin + point0);
+				current = origin + point0;
+			}
+			break;
+
+		case 'H':
+			success = parseSVGNumber(path, point0.x);
+			if(success) {
+				point0 = Zuazo::Math::Vec2f(origin.x + point0.x, current.y);
+				appendLine(points, current, point0);
+				current = point0;
+			}
+			break;
+
+		case 'V':
+			success = parseSVGNumber(path, point0.y);
+			if(success) {
+				point0 = Zuazo::Math::Vec2f(current.x, origin.y + point0.y);
+				appendLine(points, current, point0);
+				current = point0;
+			}
+			break;
+
+		case 'C':
+			success = 	parseSVGPoint(path, point0) &&
+						parseSVGPoint(path, point1) &&
+						parseSVGPoint(path, point2) ;
+			if(success) {
+				appendCubic(points, current, origin + point0, origin + point1);
+				lastControl = origin + point1;
+				current = origin + point2;
+			}
+			break;
+
+		case 'S':
+			success = 	parseSVGPoint(path, point1) &&
+						parseSVGPoint(path, point2) ;
+			if(success) {
+				//First control point is the reflection of the previous one
+				point0 = (upperLastCommand == 'C' || upperLastCommand == 'S') ? 2.0f*current - lastControl : current;
+				appendCubic(points, current, point0, origin + point1);
+				lastControl = origin + point1;
+				current = origin + point2;
+			}
+			break;
+
+		case 'Q':
+			success = 	parseSVGPoint(path, point0) &&
+						parseSVGPoint(path, point1) ;
+			if(success) {
+				//Elevate the quadratic curve to a cubic one
+				point0 += origin;
+				point1 += origin;
+				appendCubic(
+					points, 
+					current, 
+					current + (point0 - current) * (2.0f / 3.0f),
+					point1 + (point0 - point1) * (2.0f / 3.0f)
+				);
+				lastControl = point0;
+				current = point1;
+			}
+			break;
+
+		case 'T':
+			success = parseSVGPoint(path, point1);
+			if(success) {
+				//Control point is the reflection of the previous one
+				point0 = (upperLastCommand == 'Q' || upperLastCommand == 'T') ? 2.0f*current - lastControl : current;
+				point1 += origin;
+				appendCubic(
+					points, 
+					current, 
+					current + (point0 - current) * (2.0f / 3.0f),
+					point1 + (point0 - point1) * (2.0f / 3.0f)
+				);
+				lastControl = point0;
+				current = point1;
+			}
+			break;
+
+		case 'Z':
+			closeContour();
+			break;
+
+		default:
+			//Unsupported command (ie arcs)
+			success = false;
+			break;
+		}
+
+		lastCommand = command;
+	}
+
+	if(success) {
+		//Finish the last subpath and remove the unused contours
+		closeContour();
+		result.erase(std::next(result.begin(), contourCount), result.end());
+	}
+
+	return success;
+}
+
+std::shared_ptr<const std::vector<Shape>> loadSVGPath(std::string_view path) {
+	using Entry = std::pair<std::string, std::shared_ptr<const std::vector<Shape>>>;
+
+	//The most recently used paths are kept alive, even if nobody 
+	//references them, as the callers only copy the contours. The 
+	//least recently used ones are at the back
+	static std::mutex mutex;
+	static std::list<Entry> entries;
+	static std::map<std::string_view, std::list<Entry>::iterator> cache;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	//Try to reuse a previously parsed path
+	std::shared_ptr<const std::vector<Shape>> result;
+	const auto ite = cache.find(path);
+	if(ite != cache.cend()) {
+		entries.splice(entries.begin(), entries, ite->second);
+		result = ite->second->second;
+	} else {
+		auto shapes = std::make_shared<std::vector<Shape>>();
+		if(parseSVGPath(path, *shapes)) {
+			result = std::move(shapes);
+
+			//The key refers to the string owned by the entry
+			entries.emplace_front(std::string(path), result);
+			cache.emplace(entries.front().first, entries.begin());
+
+			//Evict the least recently used path if full
+			if(entries.size() > SVG_PATH_CACHE_SIZE) {
+				cache.erase(entries.back().first);
+				entries.pop_back();
+			}
+		}
+	}
+
+	assert(cache.size() == entries.size());
+	return result;
+}
+
 }
\ No newline at end of file
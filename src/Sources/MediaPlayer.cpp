@@ -1,5 +1,7 @@
 #include <Sources/MediaPlayer.h>
 
+#include <Profiling.h>
+
 #include <zuazo/Player.h>
 #include <zuazo/Signal/DummyPad.h>
 
@@ -106,6 +108,8 @@ struct MediaPlayerImpl {
 	}
 
 	void update() {
+		CENITAL_PROFILE_SCOPE("MediaPlayer::update");
+
 		//Act as a player for the transition
 		if(currentClip != clips.cend()) {
 			const auto& mp = owner.get();
@@ -0,0 +1,294 @@
+#include <Tally.h>
+
+#include <Control/Message.h>
+
+#include <zuazo/Utils/Functions.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include <cassert>
+
+namespace Cenital {
+
+using namespace Zuazo;
+
+static constexpr auto OUTPUT_BUS_CNT = static_cast<size_t>(MixEffect::OutputBus::count);
+
+//Tally of each M/E, either for its full or its clean outputs
+using TallyCache = std::map<std::pair<const MixEffect*, bool>, std::vector<MixEffect::Tally>>;
+
+static const std::vector<MixEffect::Tally>& getCachedTally(	TallyCache& cache, 
+															const MixEffect& mixEffect,
+															bool clean )
+{
+	const auto key = std::make_pair(&mixEffect, clean);
+	auto ite = cache.find(key);
+	if(ite == cache.cend()) {
+		std::tie(ite, std::ignore) = cache.emplace(
+			key, 
+			clean ? mixEffect.getCleanTally() : mixEffect.getTally()
+		);
+	}
+
+	assert(ite != cache.cend());
+	return ite->second;
+}
+
+static void propagate(	const MixEffect& mixEffect,
+						MixEffect::OutputBus bus,
+						bool clean,
+						MixEffect::Tally flags,
+						Tally::TallyMap& result,
+						TallyCache& cache,
+						size_t depth )
+{
+	//Avoid looping forever on cyclic routings
+	if(depth > cache.size() + 1) {
+		return;
+	}
+
+	const auto busFlags = 	(bus == MixEffect::OutputBus::program) ?
+							MixEffect::Tally::program :
+							MixEffect::Tally::preview ;
+	const auto& tally = getCachedTally(cache, mixEffect, clean);
+	assert(tally.size() == mixEffect.getInputCount());
+
+	for(size_t i = 0; i < tally.size(); ++i) {
+		//Only consider inputs used on the requested bus
+		if((tally[i] & busFlags) == MixEffect::Tally::none) {
+			continue;
+		}
+
+		const auto* source = mixEffect.getInput(i).getSource();
+		if(source) {
+			const auto& element = source->getLayout();
+			const auto* upstream = dynamic_cast<const MixEffect*>(&element);
+
+			if(upstream) {
+				//Cascaded M/E. Find out which of its buses is being used.
+				//Clean feeds only carry the background and upstream keys
+				for(size_t j = 0; j < OUTPUT_BUS_CNT; ++j) {
+					const auto upstreamBus = static_cast<MixEffect::OutputBus>(j);
+					if(upstream->getOutput(upstreamBus).getName() == source->getName()) {
+						propagate(*upstream, upstreamBus, false, flags, result, cache, depth + 1);
+					} else if(upstream->getCleanOutput(upstreamBus).getName() == source->getName()) {
+						propagate(*upstream, upstreamBus, true, flags, result, cache, depth + 1);
+					}
+				}
+			} else {
+				//Plain source
+				auto& entry = result[element.getName()];
+				entry = entry | flags;
+			}
+		}
+	}
+}
+
+
+
+static bool isTallyRelevant(const Control::Message& msg) {
+	//MixEffect attributes which may change what is on air
+	constexpr std::array<std::string_view, 19> MIX_EFFECT_ATTRIBUTES = {
+		"input:count",
+		"pgm",
+		"pvw",
+		"pgm:clean",
+		"pvw:clean",
+		"cut",
+		"transition",
+		"transition:bar",
+		"transition:pvw",
+		"us-overlay:count",
+		"ds-overlay:count",
+		"us-overlay:ena",
+		"ds-overlay:ena",
+		"us-overlay:transition",
+		"ds-overlay:transition",
+		"us-overlay:feed",
+		"ds-overlay:feed",
+		"us-overlay:auto",
+		"ds-overlay:auto",
+	};
+
+	const auto& tokens = msg.getPayload();
+	bool result;
+
+	if(tokens.empty() || tokens.front() == "tally") {
+		//Nothing to do, or our own broadcasts
+		result = false;
+	} else if(tokens.front() == "config") {
+		//Only some of the attributes matter
+		result = 	tokens.size() > 2 &&
+					std::find(
+						MIX_EFFECT_ATTRIBUTES.cbegin(), MIX_EFFECT_ATTRIBUTES.cend(), 
+						tokens[2]
+					) != MIX_EFFECT_ATTRIBUTES.cend();
+	} else {
+		//Elements and connections
+		result = true;
+	}
+
+	return result;
+}
+
+
+
+Tally::Tally(	Control::Controller& controller,
+				Mixer& mixer )
+	: ViewBase(controller)
+	, m_mixer(mixer)
+	, m_tally()
+	, m_dirty(true)
+	, m_refreshPending(false)
+	, m_invalidateCallback()
+{
+	//Get notified when the state of the existing M/Es changes 
+	//on its own (auto transitions)
+	for(ZuazoBase& element : mixer.listElements(typeid(MixEffect))) {
+		assert(typeid(element) == typeid(MixEffect));
+		installCallback(static_cast<MixEffect&>(element));
+	}
+}
+
+
+
+void Tally::setInvalidateCallback(InvalidateCallback cbk) {
+	m_invalidateCallback = std::move(cbk);
+}
+
+const Tally::InvalidateCallback& Tally::getInvalidateCallback() const noexcept {
+	return m_invalidateCallback;
+}
+
+
+
+void Tally::invalidate() {
+	m_dirty = true;
+
+	//Only request a refresh once, so that bursts of changes
+	//(i.e. T-bar movements) are coalesced into a single one
+	if(!m_refreshPending && m_invalidateCallback) {
+		m_refreshPending = true;
+		m_invalidateCallback(*this);
+	}
+}
+
+void Tally::refresh() {
+	m_refreshPending = false;
+
+	if(m_dirty) {
+		//Recompute the tally from scratch
+		TallyMap tally;
+		compute(tally);
+		m_dirty = false;
+
+		//Elaborate a compact message with the changes
+		Control::Message msg(Control::Message::Type::broadcast, { "tally", "update" });
+		auto& payload = msg.getPayload();
+		for(const auto& entry : tally) {
+			const auto ite = m_tally.find(entry.first);
+			if(ite == m_tally.cend() || ite->second != entry.second) {
+				payload.emplace_back(entry.first);
+				payload.emplace_back(toString(entry.second));
+			}
+		}
+		for(const auto& entry : m_tally) {
+			if(tally.find(entry.first) == tally.cend()) {
+				//Element has been removed
+				payload.emplace_back(entry.first);
+				payload.emplace_back(toString(Flags::none));
+			}
+		}
+
+		m_tally = std::move(tally);
+
+		//Send it only if something has changed. It is ignored
+		//by update() as it does not change the routing
+		if(payload.size() > 2) {
+			getController().broadcast(msg);
+		}
+	}
+
+	assert(!m_dirty);
+}
+
+const Tally::TallyMap& Tally::getTally() {
+	refresh();
+	return m_tally;
+}
+
+
+
+void Tally::update(const Control::Message& msg) {
+	const auto& tokens = msg.getPayload();
+
+	//New M/Es need to notify us when their state changes on their own
+	if(tokens.size() > 2 && tokens.front() == "add") {
+		auto* element = m_mixer.get().getElement(tokens[2]);
+		if(element && typeid(*element) == typeid(MixEffect)) {
+			installCallback(static_cast<MixEffect&>(*element));
+		}
+	}
+
+	//Only recompute when the routing or visibility may have changed.
+	//It is done lazily, as several changes may come in a row
+	if(isTallyRelevant(msg)) {
+		invalidate();
+	}
+}
+
+
+
+void Tally::compute(TallyMap& result) {
+	auto& mixer = m_mixer.get();
+	const auto elements = mixer.listElements();
+	const auto mixEffects = mixer.listElements(typeid(MixEffect));
+
+	//Every plain element starts without tally
+	result.clear();
+	for(const ZuazoBase& element : elements) {
+		if(typeid(element) != typeid(MixEffect)) {
+			result.emplace(element.getName(), Flags::none);
+		}
+	}
+
+	//Find the M/Es which are re-entered on another one
+	std::unordered_set<const ZuazoBase*> cascaded;
+	for(const ZuazoBase& element : mixEffects) {
+		assert(typeid(element) == typeid(MixEffect));
+		const auto& mixEffect = static_cast<const MixEffect&>(element);
+
+		for(size_t i = 0; i < mixEffect.getInputCount(); ++i) {
+			const auto* source = mixEffect.getInput(i).getSource();
+			const auto* upstream = source ? dynamic_cast<const MixEffect*>(&source->getLayout()) : nullptr;
+			if(upstream) {
+				cascaded.insert(upstream);
+			}
+		}
+	}
+
+	//Walk the graph from the last M/Es of each chain
+	TallyCache cache;
+	for(const ZuazoBase& element : mixEffects) {
+		const auto& mixEffect = static_cast<const MixEffect&>(element);
+
+		if(cascaded.count(&mixEffect) == 0) {
+			propagate(mixEffect, MixEffect::OutputBus::program, false, Flags::program, result, cache, 0);
+			propagate(mixEffect, MixEffect::OutputBus::preview, false, Flags::preview, result, cache, 0);
+		}
+	}
+}
+
+void Tally::installCallback(MixEffect& mixEffect) {
+	mixEffect.setTallyCallback(
+		[this] (MixEffect&) {
+			invalidate();
+		}
+	);
+}
+
+}
\ No newline at end of file
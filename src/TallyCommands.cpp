@@ -0,0 +1,56 @@
+#include <Tally.h>
+
+#include <Control/Node.h>
+#include <Control/Message.h>
+#include <Control/Generic.h>
+
+namespace Cenital {
+
+using namespace Zuazo;
+using namespace Control;
+
+static void getTally(	Tally& tally,
+						Controller&,
+						ZuazoBase&,
+						const Message& request,
+						size_t level,
+						Message& response )
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level) {
+		const auto& state = tally.getTally();
+
+		//Elaborate the response as name-state pairs
+		std::vector<std::string>& payload = response.getPayload();
+		payload.clear();
+		payload.reserve(2*state.size());
+		for(const auto& entry : state) {
+			payload.emplace_back(entry.first);
+			payload.emplace_back(toString(entry.second));
+		}
+
+		response.setType(Message::Type::response);
+	}
+}
+
+
+
+void Tally::registerCommands(Controller& controller) {
+	auto& rootNode = controller.getRootNode();
+
+	auto getNode = std::bind(
+		&Cenital::getTally,
+		std::ref(*this),
+		std::placeholders::_1,
+		std::placeholders::_2,
+		std::placeholders::_3,
+		std::placeholders::_4,
+		std::placeholders::_5
+	);
+
+	rootNode.addPath("tally",		makeAttributeNode(	{},
+														std::move(getNode) ));
+}
+
+}
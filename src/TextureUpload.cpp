@@ -0,0 +1,144 @@
+#include <TextureUpload.h>
+
+#include <limits>
+
+namespace Cenital {
+
+using namespace Zuazo;
+
+static vk::UniqueBuffer createStagingBuffer(const Graphics::Vulkan& vulkan, vk::DeviceSize size) {
+	const vk::BufferCreateInfo createInfo(
+		{},													//Flags
+		size,												//Size
+		vk::BufferUsageFlagBits::eTransferSrc,				//Usage
+		vk::SharingMode::eExclusive,						//Sharing mode
+		0, nullptr											//Queue family indices
+	);
+
+	return vulkan.getDevice().createBufferUnique(createInfo, nullptr, vulkan.getDispatcher());
+}
+
+static vk::UniqueDeviceMemory allocateStagingMemory(const Graphics::Vulkan& vulkan, vk::Buffer buffer) {
+	const auto& dispatcher = vulkan.getDispatcher();
+	const auto device = vulkan.getDevice();
+
+	const auto requirements = device.getBufferMemoryRequirements(buffer, dispatcher);
+	auto result = vulkan.allocateMemory(
+		requirements,
+		vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+	);
+	device.bindBufferMemory(buffer, *result, 0, dispatcher);
+
+	return result;
+}
+
+static vk::UniqueCommandPool createCommandPool(const Graphics::Vulkan& vulkan) {
+	const vk::CommandPoolCreateInfo createInfo(
+		vk::CommandPoolCreateFlagBits::eTransient,
+		vulkan.getGraphicsQueueIndex()
+	);
+
+	return vulkan.createCommandPool(createInfo);
+}
+
+static vk::UniqueCommandBuffer createCommandBuffer(const Graphics::Vulkan& vulkan, vk::CommandPool pool) {
+	const vk::CommandBufferAllocateInfo allocInfo(
+		pool,
+		vk::CommandBufferLevel::ePrimary,
+		1
+	);
+
+	return vulkan.allocateCommandBuffer(allocInfo);
+}
+
+
+
+TextureUpload::TextureUpload(	const Graphics::Vulkan& vulkan,
+								vk::Image image,
+								vk::Extent3D extent,
+								vk::DeviceSize size,
+								const FillCallback& fill )
+	: m_vulkan(vulkan)
+	, m_stagingBuffer(createStagingBuffer(vulkan, size))
+	, m_stagingMemory(allocateStagingMemory(vulkan, *m_stagingBuffer))
+	, m_commandPool(createCommandPool(vulkan))
+	, m_commandBuffer(createCommandBuffer(vulkan, *m_commandPool))
+	, m_fence(vulkan.createFence())
+{
+	const auto& dispatcher = vulkan.getDispatcher();
+	const auto device = vulkan.getDevice();
+
+	//Fill the staging buffer
+	auto* data = static_cast<std::byte*>(device.mapMemory(*m_stagingMemory, 0, size, {}, dispatcher));
+	fill(data);
+	device.unmapMemory(*m_stagingMemory, dispatcher);
+
+	//Record the copy
+	const auto cmd = *m_commandBuffer;
+	const vk::ImageSubresourceRange range(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
+	cmd.begin(
+		vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit),
+		dispatcher
+	);
+
+	const vk::ImageMemoryBarrier toTransfer(
+		{},
+		vk::AccessFlagBits::eTransferWrite,
+		vk::ImageLayout::eUndefined,
+		vk::ImageLayout::eTransferDstOptimal,
+		VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+		image,
+		range
+	);
+	cmd.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTopOfPipe,
+		vk::PipelineStageFlagBits::eTransfer,
+		{}, {}, {}, toTransfer,
+		dispatcher
+	);
+
+	const vk::BufferImageCopy region(
+		0, 0, 0,											//Buffer offset, row length and image height
+		vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1),
+		vk::Offset3D(0, 0, 0),
+		extent
+	);
+	cmd.copyBufferToImage(*m_stagingBuffer, image, vk::ImageLayout::eTransferDstOptimal, region, dispatcher);
+
+	//The fragment shaders of the later submissions wait for the copy
+	const vk::ImageMemoryBarrier toShader(
+		vk::AccessFlagBits::eTransferWrite,
+		vk::AccessFlagBits::eShaderRead,
+		vk::ImageLayout::eTransferDstOptimal,
+		vk::ImageLayout::eShaderReadOnlyOptimal,
+		VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+		image,
+		range
+	);
+	cmd.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,
+		vk::PipelineStageFlagBits::eFragmentShader,
+		{}, {}, {}, toShader,
+		dispatcher
+	);
+
+	cmd.end(dispatcher);
+
+	//Submit without waiting. The fence only tells when the staging
+	//resources can be released
+	const vk::SubmitInfo submitInfo({}, {}, cmd, {});
+	vulkan.getGraphicsQueue().submit(submitInfo, *m_fence, dispatcher);
+}
+
+TextureUpload::~TextureUpload() {
+	//Usually it has completed long before, so this does not block
+	m_vulkan.getDevice().waitForFences(*m_fence, true, std::numeric_limits<uint64_t>::max(), m_vulkan.getDispatcher());
+}
+
+
+
+bool TextureUpload::isComplete() const {
+	return m_vulkan.getDevice().getFenceStatus(*m_fence, m_vulkan.getDispatcher()) == vk::Result::eSuccess;
+}
+
+}
\ No newline at end of file
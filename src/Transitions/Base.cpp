@@ -1,5 +1,9 @@
 #include <Transitions/Base.h>
 
+#include <zuazo/Math/Trigonometry.h>
+
+#include <cassert>
+
 namespace Cenital::Transitions {
 
 using namespace Zuazo;
@@ -36,10 +40,15 @@ Base::Base(	Instance& instance,
 	, m_renderer(nullptr)
 	, m_size()
 	, m_sizeCallback(std::move(sizeCbk))
+	, m_easing(Easing::linear)
+	, m_easingCurve(LINEAR_EASING_CURVE)
+	, m_easingTable()
 {
 	//Register the pads
 	registerPad(prevIn);
 	registerPad(postIn);
+
+	updateEasingTable();
 }
 
 
@@ -80,6 +89,50 @@ Math::Vec2f Base::getSize() const noexcept {
 
 
 
+void Base::setEasing(Easing easing) {
+	constexpr std::array<EasingCurve, static_cast<size_t>(Easing::count)> PRESETS = {
+		LINEAR_EASING_CURVE,	//linear
+		EASE_IN_CURVE,			//easeIn
+		EASE_OUT_CURVE,			//easeOut
+		EASE_IN_OUT_CURVE,		//easeInOut
+		LINEAR_EASING_CURVE		//custom (unused)
+	};
+
+	m_easing = easing;
+	if(m_easing != Easing::custom) {
+		const auto index = static_cast<size_t>(m_easing);
+		assert(index < PRESETS.size());
+		m_easingCurve = PRESETS[index];
+		updateEasingTable();
+	}
+}
+
+Base::Easing Base::getEasing() const noexcept {
+	return m_easing;
+}
+
+void Base::setEasingCurve(const EasingCurve& curve) {
+	m_easing = Easing::custom;
+	m_easingCurve = sanitizeEasingCurve(curve);
+	updateEasingTable();
+}
+
+const EasingCurve& Base::getEasingCurve() const noexcept {
+	return m_easingCurve;
+}
+
+
+double Base::getEasedProgress() const noexcept {
+	//This is evaluated on every update, so it is kept as a 
+	//plain lookup with interpolation between samples
+	const auto position = static_cast<float>(getProgress()) * EASING_TABLE_SIZE;
+	const auto index = Math::min(static_cast<size_t>(position), EASING_TABLE_SIZE - 1);
+	const auto fraction = position - index;
+	return m_easingTable[index] + (m_easingTable[index + 1] - m_easingTable[index])*fraction;
+}
+
+
+
 void Base::setPrevIn(Input& in) noexcept {
 	m_prevIn = in;
 }
@@ -103,4 +156,13 @@ const Base::SizeCallback& Base::getSizeCallback() const noexcept {
 	return m_sizeCallback;
 }
 
+
+
+void Base::updateEasingTable() noexcept {
+	for(size_t i = 0; i < m_easingTable.size(); ++i) {
+		const auto x = static_cast<float>(i) / EASING_TABLE_SIZE;
+		m_easingTable[i] = evaluateEasingCurve(m_easingCurve, x);
+	}
+}
+
 }
\ No newline at end of file
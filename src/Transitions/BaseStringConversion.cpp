@@ -0,0 +1,34 @@
+#include <Transitions/Base.h>
+
+#include <zuazo/StringConversions.h>
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Transitions::Base::Easing easing) noexcept {
+	switch(easing){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Base::Easing, linear )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Base::Easing, easeIn )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Base::Easing, easeOut )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Base::Easing, easeInOut )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Base::Easing, custom )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::Transitions::Base::Easing& easing) {
+	//HACK. Using a lambda to call toString as otherwise it fails due to include ordering
+	return enumFromString(
+		str, easing, 
+		[] (const Cenital::Transitions::Base::Easing& easing) -> std::string_view { 
+			return toString(easing);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::Base::Easing easing) {
+	return os << toString(easing);
+}
+
+}
\ No newline at end of file
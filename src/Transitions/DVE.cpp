@@ -1,55 +1,193 @@
 #include <Transitions/DVE.h>
 
+#include <Transitions/TwoInputLayer.h>
+
 #include <zuazo/StringConversions.h>
+#include <zuazo/Signal/Input.h>
 #include <zuazo/Signal/DummyPad.h>
 #include <zuazo/Math/Trigonometry.h>
-#include <zuazo/Layers/VideoSurface.h>
+
+#include <utility>
+#include <memory>
+#include <cstring>
+#include <vector>
+#include <unordered_map>
 
 namespace Cenital::Transitions {
 
 using namespace Zuazo;
 
 struct DVEImpl {
+	struct Open : TwoInputLayer {
+		static constexpr size_t SAMPLE_TABLE_SIZE = static_cast<size_t>(DVEMove::Layer::count) * (DVEMove::SAMPLE_COUNT + 1);
+
+		enum DescriptorBindings {
+			DESCRIPTOR_BINDING_DVEDATA = TwoInputLayer::DESCRIPTOR_BINDING_COUNT,
+			DESCRIPTOR_BINDING_SAMPLES,
+
+			DESCRIPTOR_BINDING_COUNT
+		};
+
+		enum VertexConstantId {
+			VERTEX_CONSTANT_ID_SAMPLE_COUNT,
+
+			VERTEX_CONSTANT_ID_COUNT
+		};
+
+		enum DVEDataUniforms {
+			DVEDATA_UNIFORM_VIEWPORT_SIZE,
+			DVEDATA_UNIFORM_PROGRESS,
+			DVEDATA_UNIFORM_OPACITY,
+
+			DVEDATA_UNIFORM_COUNT
+		};
+
+		static constexpr std::array<Utils::Area, DVEDATA_UNIFORM_COUNT> DVEDATA_UNIFORM_LAYOUT = {
+			Utils::Area(0*sizeof(float),	sizeof(Math::Vec2f)),	//DVEDATA_UNIFORM_VIEWPORT_SIZE
+			Utils::Area(2*sizeof(float),	sizeof(float)),			//DVEDATA_UNIFORM_PROGRESS
+			Utils::Area(3*sizeof(float),	sizeof(float)),			//DVEDATA_UNIFORM_OPACITY
+		};
+
+		Open(	const Graphics::Vulkan& vulkan,
+				Math::Vec2f size )
+			: TwoInputLayer(vulkan, getLayout(), size)
+		{
+			setVertexConstant(VERTEX_CONSTANT_ID_SAMPLE_COUNT, static_cast<int32_t>(DVEMove::SAMPLE_COUNT));
+		}
+
+		void draw(	Graphics::CommandBuffer& cmd,
+					const Video& prevFrame,
+					const Video& postFrame,
+					DVEMove::Layer topLayer,
+					ScalingFilter filter,
+					vk::RenderPass renderPass,
+					BlendingMode blendingMode,
+					RenderingLayer renderingLayer )
+		{
+			//Draw a quad for each layer, the top one last. The instance
+			//index selects the layer of the move in the shaders
+			const auto bottomLayer = (topLayer == DVEMove::Layer::prev) ? DVEMove::Layer::post : DVEMove::Layer::prev;
+			const std::array instances = {
+				static_cast<uint32_t>(bottomLayer),
+				static_cast<uint32_t>(topLayer)
+			};
+
+			TwoInputLayer::draw(
+				cmd,
+				prevFrame,
+				postFrame,
+				filter,
+				renderPass,
+				blendingMode,
+				renderingLayer,
+				instances
+			);
+		}
+
+		void updateViewportSizeUniform(Math::Vec2f size) {
+			updateVertexUniform(DVEDATA_UNIFORM_VIEWPORT_SIZE, size);
+		}
+
+		void updateProgressUniform(float progress) {
+			updateVertexUniform(DVEDATA_UNIFORM_PROGRESS, progress);
+		}
+
+		void updateOpacityUniform(float opa) {
+			updateVertexUniform(DVEDATA_UNIFORM_OPACITY, opa);
+		}
+
+		void updateSamples(const DVEMove& move) {
+			//Copy the sample table of each layer one after the other
+			const auto buffer = writeStorage(DESCRIPTOR_BINDING_SAMPLES);
+			auto* data = buffer.data();
+			for(auto layer = Utils::EnumTraits<DVEMove::Layer>::first(); layer <= Utils::EnumTraits<DVEMove::Layer>::last(); ++layer) {
+				const auto samples = move.getSamples(layer);
+				assert(samples.size() == DVEMove::SAMPLE_COUNT + 1);
+				std::memcpy(data, samples.data(), samples.size()*sizeof(DVEMove::Sample));
+				data += samples.size()*sizeof(DVEMove::Sample);
+			}
+			assert(data == buffer.data() + buffer.size());
+		}
+
+	private:
+		template<typename T>
+		void updateVertexUniform(DVEDataUniforms binding, const T& value) {
+			writeUniform(DESCRIPTOR_BINDING_DVEDATA, DVEDATA_UNIFORM_LAYOUT[binding], value);
+		}
+
+		static const Layout& getLayout() {
+			static
+			#include <dve_vert.h>
+			static
+			#include <dve_frag.h>
+
+			static const std::array bindings = {
+				Binding{
+					DESCRIPTOR_BINDING_DVEDATA,						//Binding
+					vk::DescriptorType::eUniformBuffer,				//Type
+					vk::ShaderStageFlagBits::eVertex,				//Shader stage
+					DVEDATA_UNIFORM_LAYOUT.back().end()				//Size
+				},
+				Binding{
+					DESCRIPTOR_BINDING_SAMPLES,						//Binding
+					vk::DescriptorType::eStorageBuffer,				//Type
+					vk::ShaderStageFlagBits::eVertex,				//Shader stage
+					sizeof(DVEMove::Sample) * SAMPLE_TABLE_SIZE		//Size
+				}
+			};
+
+			static const Layout layout = {
+				dve_vert,											//Vertex shader
+				dve_frag,											//Fragment shader
+				bindings,											//Bindings
+				VERTEX_CONSTANT_ID_COUNT,							//Vertex constant count
+				FRAGMENT_CONSTANT_ID_COUNT							//Fragment constant count
+			};
+
+			return layout;
+		}
+
+	};
+
 	using Input = Signal::DummyPad<Zuazo::Video>;
-	using VideoSurface = Layers::VideoSurface;
+	using FrameInput = Signal::Input<Video>;
+	using LastFrames = std::unordered_map<const RendererBase*, std::pair<Video, Video>>;
 
-	std::reference_wrapper<DVE>	owner;
+	std::reference_wrapper<DVE>				owner;
 
 	Input									prevIn;
 	Input									postIn;
-	
-	VideoSurface							prevSurface;
-	VideoSurface							postSurface;
+	FrameInput								prevFrameIn;
+	FrameInput								postFrameIn;
 
-	std::array<RendererBase::LayerRef, 2>	layerReferences;
+	std::vector<RendererBase::LayerRef>		layerReferences;
 
+	ScalingFilter							scalingFilter;
 	float									angle;
 	DVE::Effect								effect;
-	
+	DVEMove									customMove;
+	DVEMove									presetMove;
+
+	std::unique_ptr<Open>					opened;
+	LastFrames								lastFrames;
 
-	DVEImpl(DVE& owner, Instance& instance)
+
+	DVEImpl(DVE& owner, Instance&)
 		: owner(owner)
 		, prevIn(owner, "prevIn")
 		, postIn(owner, "postIn")
-		, prevSurface(instance, "prevSurface", Math::Vec2f())
-		, postSurface(instance, "postSurface", Math::Vec2f())
-		, layerReferences{ postSurface, prevSurface }
+		, prevFrameIn(owner, "prevFrameIn")
+		, postFrameIn(owner, "postFrameIn")
+		, layerReferences()
+		, scalingFilter(ScalingFilter::linear)
 		, angle(0.0f)
 		, effect(DVE::Effect::uncover)
+		, customMove()
+		, presetMove()
 	{
 		//Route the signals permanently
-		prevSurface << prevIn;
-		postSurface << postIn;
-
-		//Configure the permanent parameters of the surfaces
-		prevSurface.setOpacity(1.0f); //defaults
-		postSurface.setOpacity(1.0f); //defaults
-		prevSurface.setScalingMode(ScalingMode::stretch); //defaults
-		postSurface.setScalingMode(ScalingMode::stretch); //defaults
-		prevSurface.setBlendingMode(BlendingMode::write); //Not the default value
-		postSurface.setBlendingMode(BlendingMode::write); //Not the default value
-		prevSurface.setRenderingLayer(RenderingLayer::background); //Not the default value
-		postSurface.setRenderingLayer(RenderingLayer::background); //Not the default value
+		prevFrameIn << prevIn;
+		postFrameIn << postIn;
 	}
 
 	~DVEImpl() = default;
@@ -58,92 +196,214 @@ struct DVEImpl {
 		owner = static_cast<DVE&>(base);
 		prevIn.setLayout(base);
 		postIn.setLayout(base);
+		prevFrameIn.setLayout(base);
+		postFrameIn.setLayout(base);
+
+		//The layer is ourselves, so the reference needs to be updated
+		layerReferences = { static_cast<LayerBase&>(owner.get()) };
 	}
 
-	void open(ZuazoBase&) {
-		prevSurface.open();
-		postSurface.open();
+	void open(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& dve = static_cast<DVE&>(base);
+		assert(&owner.get() == &dve);
+		assert(!opened);
+
+		if(dve.getRenderPass()) {
+			//Create in a unlocked environment
+			if(lock) lock->unlock();
+			auto newOpened = Utils::makeUnique<Open>(
+					dve.getInstance().getVulkan(),
+					dve.getSize()
+			);
+
+			//Set all the parameters
+			newOpened->updateModelMatrixUniform(dve.getTransform());
+			newOpened->updateOpacityUniform(dve.getOpacity());
+			newOpened->updateViewportSizeUniform(dve.getSize());
+			newOpened->updateProgressUniform(static_cast<float>(dve.getEasedProgress()));
+			newOpened->updateSamples(getActiveMove());
+
+			if(lock) lock->lock();
+
+			//Write changes after locking back
+			opened = std::move(newOpened);
+		}
+
+		assert(lastFrames.empty()); //Any hasChanged() should return true
 	}
 
-	void asyncOpen(ZuazoBase&, std::unique_lock<Instance>& lock) {
+	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
 		assert(lock.owns_lock());
-		prevSurface.asyncOpen(lock);
-		postSurface.asyncOpen(lock);
+		open(base, &lock);
 		assert(lock.owns_lock());
 	}
 
 
-	void close(ZuazoBase&) {
-		prevSurface.close();
-		postSurface.close();
+	void close(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& dve = static_cast<DVE&>(base);
+		assert(&owner.get() == &dve); (void)(dve);
+
+		//Write changes
+		prevFrameIn.reset();
+		postFrameIn.reset();
+		lastFrames.clear();
+		auto oldOpened = std::move(opened);
+
+		//Destroy the object in a unlocked environment
+		if(oldOpened) {
+			if(lock) lock->unlock();
+			oldOpened.reset();
+			if(lock) lock->lock();
+		}
+
+		assert(!opened);
 	}
 
-	void asyncClose(ZuazoBase&, std::unique_lock<Instance>& lock) {
+	void asyncClose(ZuazoBase& base, std::unique_lock<Instance>& lock) {
 		assert(lock.owns_lock());
-		prevSurface.asyncClose(lock);
-		postSurface.asyncClose(lock);
+		close(base, &lock);
 		assert(lock.owns_lock());
 	}
 
 
 
 	void updateCallback() {
-		auto& dveTransition = owner.get();
-		
-		//Obtain the progress
-		const auto progress = static_cast<float>(dveTransition.getProgress());
+		const auto& dve = owner.get();
 
-		//Obtain the viewport size
-		const auto viewportSize = dveTransition.getSize();
-		assert(prevSurface.getSize() == viewportSize);
-		assert(postSurface.getSize() == viewportSize);
+		//Only a uniform needs to be written. The move is
+		//evaluated from the sample table in the vertex shader
+		if(opened) {
+			opened->updateProgressUniform(static_cast<float>(dve.getEasedProgress()));
+		}
 
-		//Configure the layers
-		switch (effect) {
-		case DVE::Effect::uncover:
-			configureSlide(viewportSize, progress, true, false);
-			break;
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
 
-		case DVE::Effect::cover:
-			configureSlide(viewportSize, progress, false, true);
-			break;
+	void sizeCallback(Base&, Math::Vec2f size) {
+		if(opened) {
+			opened->setSize(size);
+			opened->updateViewportSizeUniform(size);
+		}
 
-		case DVE::Effect::slide:
-			configureSlide(viewportSize, progress, true, true);
-			break;
+		//Preset moves depend on the viewport size
+		configureEffect();
+	}
 
-		case DVE::Effect::rotate3D:
-			configureRotate3D(progress);
-			break;
+	bool hasChangedCallback(const LayerBase& base, const RendererBase& renderer) const {
+		const auto& dve = static_cast<const DVE&>(base);
+		assert(&owner.get() == &dve); (void)(dve);
 
-		default:
-			break;
+		const auto ite = lastFrames.find(&renderer);
+		if(ite == lastFrames.cend()) {
+			//There is no frame previously rendered for this renderer
+			return true;
+		}
+
+		if(	ite->second.first != prevFrameIn.getLastElement() ||
+			ite->second.second != postFrameIn.getLastElement() )
+		{
+			//A new frame has arrived since the last rendered one at this renderer
+			return true;
+		}
+
+		if(prevFrameIn.hasChanged() || postFrameIn.hasChanged()) {
+			//A new frame is available
+			return true;
+		}
+
+		//Nothing has changed :-)
+		return false;
+	}
+
+	bool hasAlphaCallback(const LayerBase& base) const noexcept {
+		const auto& dve = static_cast<const DVE&>(base);
+		assert(&owner.get() == &dve); Utils::ignore(dve);
+
+		//Both frames are rendered as a background
+		return false;
+	}
+
+	void drawCallback(const LayerBase& base, const RendererBase& renderer, Graphics::CommandBuffer& cmd) {
+		const auto& dve = static_cast<const DVE&>(base);
+		assert(&owner.get() == &dve); (void)(dve);
+
+		if(opened) {
+			const auto& prevFrame = prevFrameIn.pull();
+			const auto& postFrame = postFrameIn.pull();
+
+			//Draw
+			if(prevFrame && postFrame) {
+				opened->draw(
+					cmd,
+					prevFrame,
+					postFrame,
+					getActiveMove().getTopLayer(),
+					scalingFilter,
+					dve.getRenderPass(),
+					dve.getBlendingMode(),
+					dve.getRenderingLayer()
+				);
+			}
+
+			//Update the state for next hasChanged()
+			lastFrames[&renderer] = std::make_pair(prevFrame, postFrame);
 		}
 	}
 
-	void sizeCallback(Base&, Math::Vec2f size) {
-		prevSurface.setSize(size);
-		postSurface.setSize(size);
-		updateCallback();
+	void transformCallback(LayerBase& base, const Math::Transformf& transform) {
+		auto& dve = static_cast<DVE&>(base);
+		assert(&owner.get() == &dve); (void)(dve);
+
+		if(opened) {
+			opened->updateModelMatrixUniform(transform);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	void opacityCallback(LayerBase& base, float opa) {
+		auto& dve = static_cast<DVE&>(base);
+		assert(&owner.get() == &dve); (void)(dve);
+
+		if(opened) {
+			opened->updateOpacityUniform(opa);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	void blendingModeCallback(LayerBase& base, BlendingMode mode) {
+		auto& dve = static_cast<DVE&>(base);
+		recreateCallback(dve, dve.getRenderPass(), mode);
+	}
+
+	void renderingLayerCallback(LayerBase& base, RenderingLayer) {
+		auto& dve = static_cast<DVE&>(base);
+		recreateCallback(dve, dve.getRenderPass(), dve.getBlendingMode());
+	}
+
+	void renderPassCallback(LayerBase& base, vk::RenderPass renderPass) {
+		auto& dve = static_cast<DVE&>(base);
+		recreateCallback(dve, renderPass, dve.getBlendingMode());
 	}
 
 
 
-	void setScalingFilter(Zuazo::ScalingFilter filter) {
-		prevSurface.setScalingFilter(filter);
-		postSurface.setScalingFilter(filter);
+	void setScalingFilter(ScalingFilter filter) {
+		if(scalingFilter != filter) {
+			scalingFilter = filter;
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
 	}
 
-	Zuazo::ScalingFilter getScalingFilter() const noexcept {
-		const auto result = prevSurface.getScalingFilter();
-		assert(result == postSurface.getScalingFilter());
-		return result;
+	ScalingFilter getScalingFilter() const noexcept {
+		return scalingFilter;
 	}
 
 
 	void setAngle(float angle) {
 		this->angle = angle;
-		updateCallback();
+		configureEffect();
 	}
 
 	float getAngle() const noexcept {
@@ -153,112 +413,179 @@ struct DVEImpl {
 
 	void setEffect(DVE::Effect effect) {
 		this->effect = effect;
-		updateCallback();
+		configureEffect();
 	}
 
 	DVE::Effect getEffect() const noexcept {
 		return effect;
 	}
 
+
+	void setMove(DVEMove move) {
+		customMove = std::move(move);
+		if(effect == DVE::Effect::custom) {
+			configureEffect();
+		}
+	}
+
+	const DVEMove& getMove() const noexcept {
+		return customMove;
+	}
+
+
+	void configureEffect() {
+		//Generate the move for the built-in effects. This
+		//only needs to be done when its parameters change
+		const auto viewportSize = owner.get().getSize();
+		switch (effect) {
+		case DVE::Effect::uncover:
+			generateSlide(presetMove, viewportSize, true, false);
+			presetMove.setTopLayer(DVEMove::Layer::prev); //Prev is animated, so it must be on top
+			break;
+
+		case DVE::Effect::cover:
+			generateSlide(presetMove, viewportSize, false, true);
+			presetMove.setTopLayer(DVEMove::Layer::post); //Post is animated, so it must be on top
+			break;
+
+		case DVE::Effect::slide:
+			generateSlide(presetMove, viewportSize, true, true);
+			break;
+
+		case DVE::Effect::rotate3D:
+			generateRotate3D(presetMove);
+			break;
+
+		default:
+			break;
+		}
+
+		//Upload the sample table of the move, so that the
+		//progress alone determines the transforms
+		if(opened) {
+			opened->updateSamples(getActiveMove());
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
 private:
-	void configureSlide(Math::Vec2f viewportSize, float progress, bool prevAnim, bool postAnim) {
+	const DVEMove& getActiveMove() const noexcept {
+		return (effect == DVE::Effect::custom) ? customMove : presetMove;
+	}
+
+	void recreateCallback(	DVE& dve,
+							vk::RenderPass renderPass,
+							BlendingMode blendingMode )
+	{
+		assert(&owner.get() == &dve);
+
+		if(dve.isOpen()) {
+			const bool isValid = 	renderPass &&
+									blendingMode > BlendingMode::none ;
+
+			if(opened && isValid) {
+				//It remains valid
+				opened->recreate();
+			} else if(opened && !isValid) {
+				//It has become invalid
+				prevFrameIn.reset();
+				postFrameIn.reset();
+				opened.reset();
+			} else if(!opened && isValid) {
+				//It has become valid
+				open(dve, nullptr);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	void generateSlide(DVEMove& move, Math::Vec2f viewportSize, bool prevAnim, bool postAnim) const {
 		//At least one of the layers must be animated
 		assert(prevAnim || postAnim);
+		move.clear();
 
 		//Calculate the length of the viewpot's diagonal
 		const auto viewportLen = Math::length(viewportSize);
 
-		//Obtain the axis on which the transition is performed
-		//As vulkan's Y axis is inverted, use a "-" in the sin
+		//Obtain the axis on which the transition is performed,
+		//relative to the viewport size. As vulkan's Y axis is
+		//inverted, use a "-" in the sin
 		const auto angle = Math::deg2rad(this->angle);
 		const auto direction = Math::Vec2f(Math::cos(angle), -Math::sin(angle));
-		const auto axis = Math::clamp(
-			viewportLen*direction,
-			-viewportSize,
-			+viewportSize
-		);
-
-		//Const identity transform will be used for the static layer
-		const Math::Transformf identityTransform;
-
-		//Set next layer's postion if necessary
+		const auto axis = (viewportSize.x > 0.0f && viewportSize.y > 0.0f) ?
+			Math::Vec2f(
+				Math::clamp(viewportLen*direction.x / viewportSize.x, -1.0f, +1.0f),
+				Math::clamp(viewportLen*direction.y / viewportSize.y, -1.0f, +1.0f)
+			) :
+			Math::Vec2f(0.0f) ;
+
+		//Prev layer moves from the center to the axis
 		if(prevAnim) {
-			const auto pos = Math::lerp(Math::Vec2f(0), +axis, progress);
-
-			//Obtain the transform
-			const Math::Transformf transform(
-				Math::Vec3f(pos, 0)
-			);
-			prevSurface.setTransform(transform);
-		} else {
-			prevSurface.setTransform(identityTransform);
-		}
-		
-		//Set post layer's postion if necessary
-		if(postAnim) {
-			const auto pos = Math::lerp(-axis, Math::Vec2f(0), progress);
-
-			//Obtain the transform
-			const Math::Transformf transform(
-				Math::Vec3f(pos, 0)
-			);
-			postSurface.setTransform(transform);
-		} else {
-			postSurface.setTransform(identityTransform);
+			move.setKeyframes(DVEMove::Layer::prev, DVEMove::Track::positionX, {
+				{ 0.0f, 0.0f, DVEMove::LINEAR_EASING },
+				{ 1.0f, +axis.x, DVEMove::LINEAR_EASING }
+			});
+			move.setKeyframes(DVEMove::Layer::prev, DVEMove::Track::positionY, {
+				{ 0.0f, 0.0f, DVEMove::LINEAR_EASING },
+				{ 1.0f, +axis.y, DVEMove::LINEAR_EASING }
+			});
 		}
 
-		//Reorder if necessary. If both are animated, we dont care about the ordering
-		if(prevAnim != postAnim) {
-			if(prevAnim) {
-				//Prev is animated, so it must be on top
-				layerReferences = { postSurface, prevSurface };
-			} else {
-				//Post is animated, so it must be on top
-				layerReferences = { prevSurface, postSurface };
-			}
+		//Post layer moves from the opposite side of the axis to the center
+		if(postAnim) {
+			move.setKeyframes(DVEMove::Layer::post, DVEMove::Track::positionX, {
+				{ 0.0f, -axis.x, DVEMove::LINEAR_EASING },
+				{ 1.0f, 0.0f, DVEMove::LINEAR_EASING }
+			});
+			move.setKeyframes(DVEMove::Layer::post, DVEMove::Track::positionY, {
+				{ 0.0f, -axis.y, DVEMove::LINEAR_EASING },
+				{ 1.0f, 0.0f, DVEMove::LINEAR_EASING }
+			});
 		}
-		
 	}
 
-	void configureRotate3D(float progress) {
-		//Incactive transform is set when the frame is not visible
-		constexpr Math::Transformf inactiveTransform(
-			Math::Vec3f(0),
-			Math::Quaternionf(),
-			Math::Vec3f(0)
-		);
+	void generateRotate3D(DVEMove& move) const {
+		move.clear();
 
-		//Obtain the axis on which the transition is performed. 
+		//Obtain the axis on which the transition is performed.
 		//The quadrant angle is used as it makes it more intuitive
 		const auto axisAngle = Math::deg2rad(this->angle);
-		const Math::Vec3f axis(Math::sin(axisAngle), Math::cos(axisAngle), 0);		
-
-		//Configure the transformations
-		if(progress < 0.5f) {
-			//Prev surface is only visible on the first half
-			const float rotationAngle = progress*M_PI;
-			const Math::Transformf transform(
-				Math::Vec3f(0),
-				Math::rotateAbout(axis, rotationAngle, Math::normalized),
-				Math::Vec3f(1)
-			);
-			prevSurface.setTransform(transform);
-		} else {
-			prevSurface.setTransform(inactiveTransform);
+		const Math::Vec3f axis(Math::sin(axisAngle), Math::cos(axisAngle), 0);
+
+		for(auto layer = Utils::EnumTraits<DVEMove::Layer>::first(); layer <= Utils::EnumTraits<DVEMove::Layer>::last(); ++layer) {
+			move.setKeyframes(layer, DVEMove::Track::rotationAxisX, { { 0.0f, axis.x, DVEMove::LINEAR_EASING } });
+			move.setKeyframes(layer, DVEMove::Track::rotationAxisY, { { 0.0f, axis.y, DVEMove::LINEAR_EASING } });
+			move.setKeyframes(layer, DVEMove::Track::rotationAxisZ, { { 0.0f, axis.z, DVEMove::LINEAR_EASING } });
 		}
 
-		if(progress > 0.5f) {
-			//Post surface is only visible on the second half. Rotation angle is inverted
-			//so that the result is not flipped
-			const float rotationAngle = (progress + 1.0f)*M_PI;
-			const Math::Transformf transform(
-				Math::Vec3f(0),
-				Math::rotateAbout(axis, rotationAngle, Math::normalized),
-				Math::Vec3f(1)
-			);
-			postSurface.setTransform(transform);
-		} else {
-			postSurface.setTransform(inactiveTransform);
+		//Prev surface is only visible on the first half, where it rotates 90deg
+		move.setKeyframes(DVEMove::Layer::prev, DVEMove::Track::rotationAngle, {
+			{ 0.0f, 0.0f, DVEMove::LINEAR_EASING },
+			{ 0.5f, 90.0f, DVEMove::LINEAR_EASING }
+		});
+
+		//Post surface is only visible on the second half. Rotation angle is
+		//offset so that the result is not flipped
+		move.setKeyframes(DVEMove::Layer::post, DVEMove::Track::rotationAngle, {
+			{ 0.5f, 270.0f, DVEMove::LINEAR_EASING },
+			{ 1.0f, 360.0f, DVEMove::LINEAR_EASING }
+		});
+
+		//Collapse the surfaces when they are not visible. Repeated keyframes
+		//are used for instant steps
+		const std::vector<DVEMove::Keyframe> prevScale = {
+			{ 0.5f, 1.0f, DVEMove::LINEAR_EASING },
+			{ 0.5f, 0.0f, DVEMove::LINEAR_EASING }
+		};
+		const std::vector<DVEMove::Keyframe> postScale = {
+			{ 0.5f, 0.0f, DVEMove::LINEAR_EASING },
+			{ 0.5f, 1.0f, DVEMove::LINEAR_EASING }
+		};
+		for(auto track = DVEMove::Track::scaleX; track <= DVEMove::Track::scaleZ; ++track) {
+			move.setKeyframes(DVEMove::Layer::prev, track, prevScale);
+			move.setKeyframes(DVEMove::Layer::post, track, postScale);
 		}
 	}
 
@@ -273,17 +600,35 @@ DVE::DVE(	Instance& instance,
 		std::move(name),
 		(*this)->prevIn.getInput(),
 		(*this)->postIn.getInput(),
-		(*this)->layerReferences,
+		{},
 		std::bind(&DVEImpl::moved, std::ref(**this), std::placeholders::_1),
-		std::bind(&DVEImpl::open, std::ref(**this), std::placeholders::_1),
+		std::bind(&DVEImpl::open, std::ref(**this), std::placeholders::_1, nullptr),
 		std::bind(&DVEImpl::asyncOpen, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
-		std::bind(&DVEImpl::close, std::ref(**this), std::placeholders::_1),
+		std::bind(&DVEImpl::close, std::ref(**this), std::placeholders::_1, nullptr),
 		std::bind(&DVEImpl::asyncClose, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
 		std::bind(&DVEImpl::updateCallback, std::ref(**this)),
 		std::bind(&DVEImpl::sizeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
+	, LayerBase(
+		std::bind(&DVEImpl::transformCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&DVEImpl::opacityCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&DVEImpl::blendingModeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&DVEImpl::renderingLayerCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&DVEImpl::hasChangedCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&DVEImpl::hasAlphaCallback, std::ref(**this), std::placeholders::_1),
+		std::bind(&DVEImpl::drawCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+		std::bind(&DVEImpl::renderPassCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
 {
+	//This transition is drawn by itself as a single layer.
+	//It can only be referenced once fully constructed
+	(*this)->layerReferences = { static_cast<LayerBase&>(*this) };
+	setLayers((*this)->layerReferences);
+
+	//Configure the permanent parameters of the layer
+	setBlendingMode(BlendingMode::write); //Not the default value
+	setRenderingLayer(RenderingLayer::background); //Not the default value
+
 	//Leave it in a known state
-	(*this)->updateCallback();
+	(*this)->configureEffect();
 }
 
 DVE::DVE(DVE&& other) = default;
@@ -318,4 +663,14 @@ DVE::Effect DVE::getEffect() const noexcept {
 	return (*this)->getEffect();
 }
 
+
+
+void DVE::setMove(DVEMove move) {
+	(*this)->setMove(std::move(move));
+}
+
+const DVEMove& DVE::getMove() const noexcept {
+	return (*this)->getMove();
+}
+
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include <Control/Generic.h>
 #include <Control/VideoScalingCommands.h>
+#include <Control/TransitionCommands.h>
+
+#include <fstream>
 
 namespace Cenital::Transitions {
 
@@ -70,6 +73,192 @@ static void enumEffect(	Controller& controller,
 
 
 
+static bool validateLayerTrack(DVEMove::Layer layer, DVEMove::Track track) noexcept {
+	return 	layer > DVEMove::Layer::none && layer < DVEMove::Layer::count &&
+			track > DVEMove::Track::none && track < DVEMove::Track::count ;
+}
+
+static void setMoveKeyframe(Controller& controller,
+							ZuazoBase& base, 
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	const auto addKeyframe = [] (	DVE& dve, 
+									DVEMove::Layer layer, 
+									DVEMove::Track track, 
+									const DVEMove::Keyframe& keyframe )
+	{
+		auto move = dve.getMove();
+		move.addKeyframe(layer, track, keyframe);
+		dve.setMove(std::move(move));
+	};
+
+	//Easing is optional. Linear is used if not provided
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level + 4) {
+		invokeSetter<DVE, DVEMove::Layer, DVEMove::Track, float, float>(
+			[addKeyframe] (DVE& dve, DVEMove::Layer layer, DVEMove::Track track, float time, float value) {
+				addKeyframe(dve, layer, track, DVEMove::Keyframe{ time, value, DVEMove::LINEAR_EASING });
+			},
+			[] (const DVE&, DVEMove::Layer layer, DVEMove::Track track, float, float) -> bool {
+				return validateLayerTrack(layer, track);
+			},
+			controller, base, request, level, response
+		);
+	} else {
+		invokeSetter<DVE, DVEMove::Layer, DVEMove::Track, float, float, float, float, float, float>(
+			[addKeyframe] (	DVE& dve, DVEMove::Layer layer, DVEMove::Track track, float time, float value,
+							float x1, float y1, float x2, float y2 ) 
+			{
+				addKeyframe(dve, layer, track, DVEMove::Keyframe{ time, value, Math::Vec4f(x1, y1, x2, y2) });
+			},
+			[] (const DVE&, DVEMove::Layer layer, DVEMove::Track track, float, float, float, float, float, float) -> bool {
+				return validateLayerTrack(layer, track);
+			},
+			controller, base, request, level, response
+		);
+	}
+}
+
+static void getMoveKeyframes(	Controller&,
+								ZuazoBase& base, 
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level + 2) {
+		DVEMove::Layer layer;
+		DVEMove::Track track;
+
+		if(fromString(tokens[level+0], layer) && fromString(tokens[level+1], track) && validateLayerTrack(layer, track)) {
+			assert(typeid(base) == typeid(DVE));
+			const auto& dve = static_cast<const DVE&>(base);
+			const auto& keyframes = dve.getMove().getKeyframes(layer, track);
+
+			//Elaborate the response. Each keyframe is 
+			//expressed as time, value and easing
+			response.setType(Message::Type::response);
+			auto& payload = response.getPayload();
+			payload.clear();
+			payload.reserve(keyframes.size() * 6);
+			for(const auto& keyframe : keyframes) {
+				payload.emplace_back(toString(keyframe.time));
+				payload.emplace_back(toString(keyframe.value));
+				for(size_t i = 0; i < 4; ++i) {
+					payload.emplace_back(toString(keyframe.easing[i]));
+				}
+			}
+		}
+	}
+}
+
+static void unsetMoveKeyframes(	Controller& controller,
+								ZuazoBase& base, 
+								const Message& request,
+								size_t level,
+								Message& response ) 
+{
+	invokeSetter<DVE, DVEMove::Layer, DVEMove::Track>(
+		[] (DVE& dve, DVEMove::Layer layer, DVEMove::Track track) {
+			auto move = dve.getMove();
+			move.setKeyframes(layer, track, {});
+			dve.setMove(std::move(move));
+		},
+		[] (const DVE&, DVEMove::Layer layer, DVEMove::Track track) -> bool {
+			return validateLayerTrack(layer, track);
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void enumMoveLayer(	Controller& controller,
+							ZuazoBase& base, 
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	enumerate<DVEMove::Layer>(controller, base, request, level, response);
+}
+
+
+
+static void setMoveTopLayer(Controller& controller,
+							ZuazoBase& base, 
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	invokeSetter<DVE, DVEMove::Layer>(
+		[] (DVE& dve, DVEMove::Layer layer) {
+			auto move = dve.getMove();
+			move.setTopLayer(layer);
+			dve.setMove(std::move(move));
+		},
+		[] (const DVE&, DVEMove::Layer layer) -> bool {
+			return layer > DVEMove::Layer::none && layer < DVEMove::Layer::count;
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void getMoveTopLayer(Controller& controller,
+							ZuazoBase& base, 
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	invokeGetter<DVEMove::Layer, DVE>(
+		[] (const DVE& dve) -> DVEMove::Layer {
+			return dve.getMove().getTopLayer();
+		},
+		controller, base, request, level, response
+	);
+}
+
+
+
+static void clearMove(	Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter<DVE>(
+		[] (DVE& dve) {
+			dve.setMove(DVEMove());
+		},
+		controller, base, request, level, response
+	);
+}
+
+static void loadMove(	Controller&,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+	if(tokens.size() == level + 1) {
+		std::ifstream file(tokens[level]);
+		DVEMove move;
+
+		if(file.is_open() && move.load(file)) {
+			//Perform mutations
+			assert(typeid(base) == typeid(DVE));
+			DVE& dve = static_cast<DVE&>(base);
+			dve.setMove(std::move(move));
+
+			//Elaborate the response
+			response.setType(Message::Type::broadcast);
+			response.getPayload() = tokens;
+		}
+	}
+}
+
+
+
 
 
 void DVE::registerCommands(Controller& controller) {
@@ -80,8 +269,18 @@ void DVE::registerCommands(Controller& controller) {
 	configNode.addPath("effect",		makeAttributeNode(	Transitions::setEffect,
 															Transitions::getEffect,
 															Transitions::enumEffect ));
+	configNode.addPath("move:key",		makeAttributeNode(	Transitions::setMoveKeyframe,
+															Transitions::getMoveKeyframes,
+															{},
+															Transitions::unsetMoveKeyframes ));
+	configNode.addPath("move:top",		makeAttributeNode(	Transitions::setMoveTopLayer,
+															Transitions::getMoveTopLayer,
+															Transitions::enumMoveLayer ));
+	configNode.addPath("move:clear",	Transitions::clearMove);
+	configNode.addPath("move:load",		Transitions::loadMove);
 
 	registerVideoScalingFilterAttribute<DVE>(configNode, true, true);
+	registerTransitionEasingCommands<DVE>(configNode);
 
 	auto& classIndex = controller.getClassIndex();
 	classIndex.registerClass(
@@ -0,0 +1,255 @@
+#include <Transitions/DVEMove.h>
+
+#include <zuazo/StringConversions.h>
+#include <zuazo/Math/Trigonometry.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <cassert>
+
+namespace Cenital::Transitions {
+
+using namespace Zuazo;
+
+static float evaluateTrack(	const std::vector<DVEMove::Keyframe>& keyframes,
+							float defaultValue,
+							float time ) noexcept
+{
+	float result;
+
+	if(keyframes.empty()) {
+		result = defaultValue;
+	} else if(time <= keyframes.front().time) {
+		result = keyframes.front().value;
+	} else if(time >= keyframes.back().time) {
+		result = keyframes.back().value;
+	} else {
+		//Find the segment containing the time. When several keyframes
+		//share the same time, the last one is used, so that steps can
+		//be defined
+		const auto next = std::upper_bound(
+			keyframes.cbegin(), keyframes.cend(),
+			time,
+			[] (float time, const DVEMove::Keyframe& keyframe) -> bool {
+				return time < keyframe.time;
+			}
+		);
+		assert(next != keyframes.cbegin());
+		assert(next != keyframes.cend());
+		const auto prev = std::prev(next);
+
+		//Interpolate between both keyframes
+		const auto x = (time - prev->time) / (next->time - prev->time);
+		const auto y = evaluateEasingCurve(prev->easing, x);
+		result = prev->value + (next->value - prev->value)*y;
+	}
+
+	return result;
+}
+
+
+
+DVEMove::DVEMove()
+	: m_topLayer(Layer::prev)
+	, m_tracks()
+	, m_samples()
+{
+	for(auto layer = Utils::EnumTraits<Layer>::first(); layer <= Utils::EnumTraits<Layer>::last(); ++layer) {
+		for(auto track = Utils::EnumTraits<Track>::first(); track <= Utils::EnumTraits<Track>::last(); ++track) {
+			updateSamples(layer, track);
+		}
+	}
+}
+
+
+
+void DVEMove::setTopLayer(Layer layer) noexcept {
+	m_topLayer = layer;
+}
+
+DVEMove::Layer DVEMove::getTopLayer() const noexcept {
+	return m_topLayer;
+}
+
+
+void DVEMove::setKeyframes(Layer layer, Track track, std::vector<Keyframe> keyframes) {
+	const auto layerIndex = static_cast<size_t>(layer);
+	const auto trackIndex = static_cast<size_t>(track);
+	assert(layerIndex < m_tracks.size());
+	assert(trackIndex < m_tracks[layerIndex].size());
+
+	//Sanitize the keyframes. Keyframes need to be ordered by time, 
+	//keeping the insertion order for equal times, as it is used for steps
+	for(auto& keyframe : keyframes) {
+		keyframe.time = Math::clamp(keyframe.time, 0.0f, 1.0f);
+		keyframe.easing = sanitizeEasingCurve(keyframe.easing);
+	}
+	std::stable_sort(
+		keyframes.begin(), keyframes.end(),
+		[] (const Keyframe& a, const Keyframe& b) -> bool {
+			return a.time < b.time;
+		}
+	);
+
+	m_tracks[layerIndex][trackIndex] = std::move(keyframes);
+	updateSamples(layer, track);
+}
+
+const std::vector<DVEMove::Keyframe>& DVEMove::getKeyframes(Layer layer, Track track) const noexcept {
+	const auto layerIndex = static_cast<size_t>(layer);
+	const auto trackIndex = static_cast<size_t>(track);
+	assert(layerIndex < m_tracks.size());
+	assert(trackIndex < m_tracks[layerIndex].size());
+
+	return m_tracks[layerIndex][trackIndex];
+}
+
+void DVEMove::addKeyframe(Layer layer, Track track, const Keyframe& keyframe) {
+	auto keyframes = getKeyframes(layer, track);
+	keyframes.push_back(keyframe);
+	setKeyframes(layer, track, std::move(keyframes));
+}
+
+void DVEMove::clear() {
+	*this = DVEMove();
+}
+
+
+
+DVEMove::Sample DVEMove::evaluate(Layer layer, float progress) const noexcept {
+	const auto layerIndex = static_cast<size_t>(layer);
+	assert(layerIndex < m_samples.size());
+	const auto& samples = m_samples[layerIndex];
+
+	//Find the surrounding samples
+	const auto position = Math::clamp(progress, 0.0f, 1.0f) * SAMPLE_COUNT;
+	const auto index = std::min(static_cast<size_t>(position), SAMPLE_COUNT - 1);
+	const auto fraction = position - index;
+	const auto& sample0 = samples[index + 0];
+	const auto& sample1 = samples[index + 1];
+
+	//Linearly interpolate between them
+	Sample result;
+	for(size_t i = 0; i < result.size(); ++i) {
+		result[i] = sample0[i] + (sample1[i] - sample0[i])*fraction;
+	}
+
+	return result;
+}
+
+Utils::BufferView<const DVEMove::Sample> DVEMove::getSamples(Layer layer) const noexcept {
+	//SAMPLE_COUNT+1 evenly spaced samples, the last one at progress=1
+	const auto layerIndex = static_cast<size_t>(layer);
+	assert(layerIndex < m_samples.size());
+	return m_samples[layerIndex];
+}
+
+
+
+bool DVEMove::load(std::istream& is) {
+	//Each line contains either the top layer:
+	//top <layer>
+	//or a keyframe:
+	//<layer> <track> <time> <value> [<x1> <y1> <x2> <y2>]
+	//Empty lines and lines starting with '#' are ignored
+	DVEMove result;
+	bool success = true;
+	std::string line;
+
+	while(success && std::getline(is, line)) {
+		std::istringstream lineStream(line);
+		std::vector<std::string> tokens;
+		std::string token;
+		while(lineStream >> token) {
+			tokens.push_back(std::move(token));
+		}
+
+		if(tokens.empty() || tokens.front().front() == '#') {
+			continue; //Nothing to do
+		} else if(tokens.size() == 2 && tokens[0] == "top") {
+			Layer layer;
+			success = fromString(tokens[1], layer) && layer > Layer::none && layer < Layer::count;
+			if(success) {
+				result.setTopLayer(layer);
+			}
+		} else if(tokens.size() == 4 || tokens.size() == 8) {
+			Layer layer;
+			Track track;
+			Keyframe keyframe = { 0.0f, 0.0f, LINEAR_EASING };
+
+			success = fromString(tokens[0], layer) && layer > Layer::none && layer < Layer::count;
+			success = success && fromString(tokens[1], track) && track > Track::none && track < Track::count;
+			success = success && fromString(tokens[2], keyframe.time);
+			success = success && fromString(tokens[3], keyframe.value);
+			for(size_t i = 4; i < tokens.size() && success; ++i) {
+				success = fromString(tokens[i], keyframe.easing[i - 4]);
+			}
+
+			if(success) {
+				result.addKeyframe(layer, track, keyframe);
+			}
+		} else {
+			success = false;
+		}
+	}
+
+	//Only apply the changes if everything was correctly parsed
+	if(success) {
+		*this = std::move(result);
+	}
+
+	return success;
+}
+
+void DVEMove::save(std::ostream& os) const {
+	os << "top " << m_topLayer << '\n';
+
+	for(auto layer = Utils::EnumTraits<Layer>::first(); layer <= Utils::EnumTraits<Layer>::last(); ++layer) {
+		for(auto track = Utils::EnumTraits<Track>::first(); track <= Utils::EnumTraits<Track>::last(); ++track) {
+			for(const auto& keyframe : getKeyframes(layer, track)) {
+				os 	<< layer << ' '
+					<< track << ' '
+					<< keyframe.time << ' '
+					<< keyframe.value << ' '
+					<< keyframe.easing[0] << ' '
+					<< keyframe.easing[1] << ' '
+					<< keyframe.easing[2] << ' '
+					<< keyframe.easing[3] << '\n';
+			}
+		}
+	}
+}
+
+
+
+float DVEMove::getDefaultValue(Track track) noexcept {
+	switch (track) {
+	case Track::rotationAxisZ:
+	case Track::scaleX:
+	case Track::scaleY:
+	case Track::scaleZ:
+	case Track::opacity:
+		return 1.0f;
+
+	default:
+		return 0.0f;
+	}
+}
+
+
+
+void DVEMove::updateSamples(Layer layer, Track track) noexcept {
+	const auto layerIndex = static_cast<size_t>(layer);
+	const auto trackIndex = static_cast<size_t>(track);
+	const auto& keyframes = m_tracks[layerIndex][trackIndex];
+	auto& samples = m_samples[layerIndex];
+	const auto defaultValue = getDefaultValue(track);
+
+	for(size_t i = 0; i < samples.size(); ++i) {
+		const auto time = static_cast<float>(i) / SAMPLE_COUNT;
+		samples[i][trackIndex] = evaluateTrack(keyframes, defaultValue, time);
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <Transitions/DVEMove.h>
+
+#include <zuazo/StringConversions.h>
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Transitions::DVEMove::Layer layer) noexcept {
+	switch(layer){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Layer, prev )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Layer, post )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::Transitions::DVEMove::Layer& layer) {
+	//HACK. Using a lambda to call toString as otherwise it fails due to include ordering
+	return enumFromString(
+		str, layer, 
+		[] (const Cenital::Transitions::DVEMove::Layer& layer) -> std::string_view { 
+			return toString(layer);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::DVEMove::Layer layer) {
+	return os << toString(layer);
+}
+
+
+
+std::string_view toString(Cenital::Transitions::DVEMove::Track track) noexcept {
+	switch(track){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, positionX )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, positionY )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, positionZ )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, rotationAxisX )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, rotationAxisY )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, rotationAxisZ )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, rotationAngle )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, scaleX )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, scaleY )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, scaleZ )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, opacity )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, cropLeft )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, cropRight )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, cropTop )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVEMove::Track, cropBottom )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::Transitions::DVEMove::Track& track) {
+	//HACK. Using a lambda to call toString as otherwise it fails due to include ordering
+	return enumFromString(
+		str, track, 
+		[] (const Cenital::Transitions::DVEMove::Track& track) -> std::string_view { 
+			return toString(track);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::DVEMove::Track track) {
+	return os << toString(track);
+}
+
+}
\ No newline at end of file
@@ -11,6 +11,7 @@ std::string_view toString(Cenital::Transitions::DVE::Effect effect) noexcept {
 	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVE::Effect, cover )
 	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVE::Effect, slide )
 	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVE::Effect, rotate3D )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::DVE::Effect, custom )
 
 	default: return "";
 	}
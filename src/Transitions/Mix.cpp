@@ -1,48 +1,126 @@
 #include <Transitions/Mix.h>
 
+#include <Transitions/TwoInputLayer.h>
+
+#include <zuazo/Signal/Input.h>
 #include <zuazo/Signal/DummyPad.h>
-#include <zuazo/Math/Trigonometry.h>
-#include <zuazo/Layers/VideoSurface.h>
+
+#include <utility>
+#include <memory>
+#include <vector>
+#include <unordered_map>
 
 namespace Cenital::Transitions {
 
 using namespace Zuazo;
 
 struct MixImpl {
+	struct Open : TwoInputLayer {
+		enum DescriptorBindings {
+			DESCRIPTOR_BINDING_MIXDATA = TwoInputLayer::DESCRIPTOR_BINDING_COUNT,
+
+			DESCRIPTOR_BINDING_COUNT
+		};
+
+		enum FragmentConstantId {
+			FRAGMENT_CONSTANT_ID_EFFECT = TwoInputLayer::FRAGMENT_CONSTANT_ID_COUNT,
+
+			FRAGMENT_CONSTANT_ID_COUNT
+		};
+
+		enum MixDataUniforms {
+			MIXDATA_UNIFORM_PROGRESS,
+			MIXDATA_UNIFORM_OPACITY,
+
+			MIXDATA_UNIFORM_COUNT
+		};
+
+		static constexpr std::array<Utils::Area, MIXDATA_UNIFORM_COUNT> MIXDATA_UNIFORM_LAYOUT = {
+			Utils::Area(0*sizeof(float),	sizeof(float)),			//MIXDATA_UNIFORM_PROGRESS
+			Utils::Area(1*sizeof(float),	sizeof(float)),			//MIXDATA_UNIFORM_OPACITY
+		};
+
+		Open(	const Graphics::Vulkan& vulkan,
+				Math::Vec2f size )
+			: TwoInputLayer(vulkan, getLayout(), size)
+		{
+		}
+
+		void updateEffectConstant(Mix::Effect effect) {
+			setFragmentConstant(FRAGMENT_CONSTANT_ID_EFFECT, static_cast<int32_t>(effect));
+		}
+
+		void updateProgressUniform(float progress) {
+			writeUniform(DESCRIPTOR_BINDING_MIXDATA, MIXDATA_UNIFORM_LAYOUT[MIXDATA_UNIFORM_PROGRESS], progress);
+		}
+
+		void updateOpacityUniform(float opa) {
+			writeUniform(DESCRIPTOR_BINDING_MIXDATA, MIXDATA_UNIFORM_LAYOUT[MIXDATA_UNIFORM_OPACITY], opa);
+		}
+
+	private:
+		static const Layout& getLayout() {
+			//The vertex stage is shared with the wipe transition
+			static
+			#include <wipe_vert.h>
+			static
+			#include <mix_frag.h>
+
+			static const std::array bindings = {
+				Binding{
+					DESCRIPTOR_BINDING_MIXDATA,						//Binding
+					vk::DescriptorType::eUniformBuffer,				//Type
+					vk::ShaderStageFlagBits::eFragment,				//Shader stage
+					MIXDATA_UNIFORM_LAYOUT.back().end()				//Size
+				}
+			};
+
+			static const Layout layout = {
+				wipe_vert,											//Vertex shader
+				mix_frag,											//Fragment shader
+				bindings,											//Bindings
+				0,													//Vertex constant count
+				FRAGMENT_CONSTANT_ID_COUNT							//Fragment constant count
+			};
+
+			return layout;
+		}
+
+	};
+
 	using Input = Signal::DummyPad<Zuazo::Video>;
-	using VideoSurface = Layers::VideoSurface;
+	using FrameInput = Signal::Input<Video>;
+	using LastFrames = std::unordered_map<const RendererBase*, std::pair<Video, Video>>;
 
-	std::reference_wrapper<Mix>	owner;
+	std::reference_wrapper<Mix>				owner;
 
 	Input									prevIn;
 	Input									postIn;
-	
-	VideoSurface							prevSurface;
-	VideoSurface							postSurface;
+	FrameInput								prevFrameIn;
+	FrameInput								postFrameIn;
 
-	std::array<RendererBase::LayerRef, 2>	layerReferences;
+	std::vector<RendererBase::LayerRef>		layerReferences;
 
+	ScalingFilter							scalingFilter;
 	Mix::Effect								effect;
-	
 
-	MixImpl(Mix& owner, Instance& instance)
+	std::unique_ptr<Open>					opened;
+	LastFrames								lastFrames;
+
+
+	MixImpl(Mix& owner, Instance&)
 		: owner(owner)
 		, prevIn(owner, "prevIn")
 		, postIn(owner, "postIn")
-		, prevSurface(instance, "prevSurface", Math::Vec2f())
-		, postSurface(instance, "postSurface", Math::Vec2f())
-		, layerReferences{ postSurface, prevSurface }
+		, prevFrameIn(owner, "prevFrameIn")
+		, postFrameIn(owner, "postFrameIn")
+		, layerReferences()
+		, scalingFilter(ScalingFilter::linear)
 		, effect(Mix::Effect::mix)
 	{
 		//Route the signals permanently
-		prevSurface << prevIn;
-		postSurface << postIn;
-
-		//Configure the permanent parameters of the surfaces
-		prevSurface.setScalingMode(ScalingMode::stretch); //defaults
-		postSurface.setScalingMode(ScalingMode::stretch); //defaults
-		prevSurface.setRenderingLayer(RenderingLayer::background); //Not the default value
-		postSurface.setRenderingLayer(RenderingLayer::background); //Not the default value
+		prevFrameIn << prevIn;
+		postFrameIn << postIn;
 	}
 
 	~MixImpl() = default;
@@ -51,142 +129,289 @@ struct MixImpl {
 		owner = static_cast<Mix&>(base);
 		prevIn.setLayout(base);
 		postIn.setLayout(base);
+		prevFrameIn.setLayout(base);
+		postFrameIn.setLayout(base);
+
+		//The layer is ourselves, so the reference needs to be updated
+		layerReferences = { static_cast<LayerBase&>(owner.get()) };
 	}
 
-	void open(ZuazoBase&) {
-		prevSurface.open();
-		postSurface.open();
+	void open(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& mix = static_cast<Mix&>(base);
+		assert(&owner.get() == &mix);
+		assert(!opened);
+
+		if(mix.getRenderPass()) {
+			//Create in a unlocked environment
+			if(lock) lock->unlock();
+			auto newOpened = Utils::makeUnique<Open>(
+					mix.getInstance().getVulkan(),
+					mix.getSize()
+			);
+
+			//Set all the parameters
+			newOpened->updateModelMatrixUniform(mix.getTransform());
+			newOpened->updateOpacityUniform(mix.getOpacity());
+			newOpened->updateProgressUniform(static_cast<float>(mix.getEasedProgress()));
+			newOpened->updateEffectConstant(getEffect());
+
+			if(lock) lock->lock();
+
+			//Write changes after locking back
+			opened = std::move(newOpened);
+		}
+
+		assert(lastFrames.empty()); //Any hasChanged() should return true
 	}
 
-	void asyncOpen(ZuazoBase&, std::unique_lock<Instance>& lock) {
+	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
 		assert(lock.owns_lock());
-		prevSurface.asyncOpen(lock);
-		postSurface.asyncOpen(lock);
+		open(base, &lock);
 		assert(lock.owns_lock());
 	}
 
 
-	void close(ZuazoBase&) {
-		prevSurface.close();
-		postSurface.close();
+	void close(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& mix = static_cast<Mix&>(base);
+		assert(&owner.get() == &mix); (void)(mix);
+
+		//Write changes
+		prevFrameIn.reset();
+		postFrameIn.reset();
+		lastFrames.clear();
+		auto oldOpened = std::move(opened);
+
+		//Destroy the object in a unlocked environment
+		if(oldOpened) {
+			if(lock) lock->unlock();
+			oldOpened.reset();
+			if(lock) lock->lock();
+		}
+
+		assert(!opened);
 	}
 
-	void asyncClose(ZuazoBase&, std::unique_lock<Instance>& lock) {
+	void asyncClose(ZuazoBase& base, std::unique_lock<Instance>& lock) {
 		assert(lock.owns_lock());
-		prevSurface.asyncClose(lock);
-		postSurface.asyncClose(lock);
+		close(base, &lock);
 		assert(lock.owns_lock());
 	}
 
 
 
 	void updateCallback() {
-		auto& mixTransition = owner.get();
-		
-		//Obtain the progress
-		const auto progress = static_cast<float>(mixTransition.getProgress());
+		const auto& mix = owner.get();
 
-		//Obtain the viewport size
-		const auto viewportSize = mixTransition.getSize();
-		assert(prevSurface.getSize() == viewportSize);
-		assert(postSurface.getSize() == viewportSize);
-		Utils::ignore(viewportSize);
+		//Only a uniform needs to be written, so that the
+		//pipeline and the geometry remain untouched
+		if(opened) {
+			opened->updateProgressUniform(static_cast<float>(mix.getEasedProgress()));
+		}
 
-		//Configure the layers
-		switch (effect) {
-		case Mix::Effect::mix:
-			configureMix(progress);
-			break;
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
 
-		case Mix::Effect::add:
-			configureAdd(progress);
-			break;
+	void sizeCallback(Base&, Math::Vec2f size) {
+		if(opened) {
+			opened->setSize(size);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
 
-		case Mix::Effect::fade:
-			configureBlack(progress);
-			break;
+	bool hasChangedCallback(const LayerBase& base, const RendererBase& renderer) const {
+		const auto& mix = static_cast<const Mix&>(base);
+		assert(&owner.get() == &mix); (void)(mix);
 
-		default:
-			break;
+		const auto ite = lastFrames.find(&renderer);
+		if(ite == lastFrames.cend()) {
+			//There is no frame previously rendered for this renderer
+			return true;
 		}
+
+		if(	ite->second.first != prevFrameIn.getLastElement() ||
+			ite->second.second != postFrameIn.getLastElement() )
+		{
+			//A new frame has arrived since the last rendered one at this renderer
+			return true;
+		}
+
+		if(prevFrameIn.hasChanged() || postFrameIn.hasChanged()) {
+			//A new frame is available
+			return true;
+		}
+
+		//Nothing has changed :-)
+		return false;
 	}
 
-	void sizeCallback(Base&, Math::Vec2f size) {
-		prevSurface.setSize(size);
-		postSurface.setSize(size);
-		updateCallback();
+	bool hasAlphaCallback(const LayerBase& base) const noexcept {
+		const auto& mix = static_cast<const Mix&>(base);
+		assert(&owner.get() == &mix); Utils::ignore(mix);
+
+		//Both frames are rendered as a background
+		return false;
+	}
+
+	void drawCallback(const LayerBase& base, const RendererBase& renderer, Graphics::CommandBuffer& cmd) {
+		const auto& mix = static_cast<const Mix&>(base);
+		assert(&owner.get() == &mix); (void)(mix);
+
+		if(opened) {
+			const auto& prevFrame = prevFrameIn.pull();
+			const auto& postFrame = postFrameIn.pull();
+
+			//Draw
+			if(prevFrame && postFrame) {
+				opened->draw(
+					cmd,
+					prevFrame,
+					postFrame,
+					scalingFilter,
+					mix.getRenderPass(),
+					mix.getBlendingMode(),
+					mix.getRenderingLayer()
+				);
+			}
+
+			//Update the state for next hasChanged()
+			lastFrames[&renderer] = std::make_pair(prevFrame, postFrame);
+		}
 	}
 
+	void transformCallback(LayerBase& base, const Math::Transformf& transform) {
+		auto& mix = static_cast<Mix&>(base);
+		assert(&owner.get() == &mix); (void)(mix);
 
+		if(opened) {
+			opened->updateModelMatrixUniform(transform);
+		}
 
-	void setScalingFilter(Zuazo::ScalingFilter filter) {
-		prevSurface.setScalingFilter(filter);
-		postSurface.setScalingFilter(filter);
+		lastFrames.clear(); //Will force hasChanged() to true
 	}
 
-	Zuazo::ScalingFilter getScalingFilter() const noexcept {
-		const auto result = prevSurface.getScalingFilter();
-		assert(result == postSurface.getScalingFilter());
-		return result;
+	void opacityCallback(LayerBase& base, float opa) {
+		auto& mix = static_cast<Mix&>(base);
+		assert(&owner.get() == &mix); (void)(mix);
+
+		if(opened) {
+			opened->updateOpacityUniform(opa);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
 	}
 
+	void blendingModeCallback(LayerBase& base, BlendingMode mode) {
+		auto& mix = static_cast<Mix&>(base);
+		recreateCallback(mix, mix.getRenderPass(), mode);
+	}
 
+	void renderingLayerCallback(LayerBase& base, RenderingLayer) {
+		auto& mix = static_cast<Mix&>(base);
+		recreateCallback(mix, mix.getRenderPass(), mix.getBlendingMode());
+	}
 
-	void setEffect(Mix::Effect effect) {
-		this->effect = effect;
-		updateCallback();
+	void renderPassCallback(LayerBase& base, vk::RenderPass renderPass) {
+		auto& mix = static_cast<Mix&>(base);
+		recreateCallback(mix, renderPass, mix.getBlendingMode());
 	}
 
-	Mix::Effect getEffect() const noexcept {
-		return effect;
+
+
+	void setScalingFilter(ScalingFilter filter) {
+		if(scalingFilter != filter) {
+			scalingFilter = filter;
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
 	}
 
-private:
-	void configureMix(float progress) {
-		//Set complementary gains. As they are adding, this
-		//results in a mixing effect
-		prevSurface.setBlendingMode(BlendingMode::add);
-		postSurface.setBlendingMode(BlendingMode::add);
-		prevSurface.setOpacity(1 - progress);
-		postSurface.setOpacity(0 + progress);
+	ScalingFilter getScalingFilter() const noexcept {
+		return scalingFilter;
 	}
 
-	void configureAdd(float progress) {
-		prevSurface.setBlendingMode(BlendingMode::add);
-		postSurface.setBlendingMode(BlendingMode::add);
-		prevSurface.setOpacity(Math::min(2*(1 - progress), 1.0f));
-		postSurface.setOpacity(Math::min(2*(0 + progress), 1.0f));
+
+	void setEffect(Mix::Effect effect) {
+		if(this->effect != effect) {
+			this->effect = effect;
+
+			if(opened) {
+				opened->updateEffectConstant(this->effect);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	Mix::Effect getEffect() const noexcept {
+		return effect;
 	}
 
-	void configureBlack(float progress) {
-		prevSurface.setBlendingMode(BlendingMode::add);
-		postSurface.setBlendingMode(BlendingMode::add);
-		prevSurface.setOpacity(Math::max(+1 - 2*progress, 0.0f));
-		postSurface.setOpacity(Math::max(-1 + 2*progress, 0.0f));
+private:
+	void recreateCallback(	Mix& mix,
+							vk::RenderPass renderPass,
+							BlendingMode blendingMode )
+	{
+		assert(&owner.get() == &mix);
+
+		if(mix.isOpen()) {
+			const bool isValid = 	renderPass &&
+									blendingMode > BlendingMode::none ;
+
+			if(opened && isValid) {
+				//It remains valid
+				opened->recreate();
+			} else if(opened && !isValid) {
+				//It has become invalid
+				prevFrameIn.reset();
+				postFrameIn.reset();
+				opened.reset();
+			} else if(!opened && isValid) {
+				//It has become valid
+				open(mix, nullptr);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
 	}
 
 };
 
 
 Mix::Mix(	Instance& instance,
-								std::string name )
+			std::string name )
 	: Utils::Pimpl<MixImpl>({}, *this, instance)
 	, Base(
 		instance,
 		std::move(name),
 		(*this)->prevIn.getInput(),
 		(*this)->postIn.getInput(),
-		(*this)->layerReferences,
+		{},
 		std::bind(&MixImpl::moved, std::ref(**this), std::placeholders::_1),
-		std::bind(&MixImpl::open, std::ref(**this), std::placeholders::_1),
+		std::bind(&MixImpl::open, std::ref(**this), std::placeholders::_1, nullptr),
 		std::bind(&MixImpl::asyncOpen, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
-		std::bind(&MixImpl::close, std::ref(**this), std::placeholders::_1),
+		std::bind(&MixImpl::close, std::ref(**this), std::placeholders::_1, nullptr),
 		std::bind(&MixImpl::asyncClose, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
 		std::bind(&MixImpl::updateCallback, std::ref(**this)),
 		std::bind(&MixImpl::sizeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
+	, LayerBase(
+		std::bind(&MixImpl::transformCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&MixImpl::opacityCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&MixImpl::blendingModeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&MixImpl::renderingLayerCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&MixImpl::hasChangedCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&MixImpl::hasAlphaCallback, std::ref(**this), std::placeholders::_1),
+		std::bind(&MixImpl::drawCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+		std::bind(&MixImpl::renderPassCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
 {
-	//Leave it in a known state
-	(*this)->updateCallback();
+	//This transition is drawn by itself as a single layer.
+	//It can only be referenced once fully constructed
+	(*this)->layerReferences = { static_cast<LayerBase&>(*this) };
+	setLayers((*this)->layerReferences);
+
+	//Configure the permanent parameters of the layer. Both frames are
+	//added in the shader, so the result can be simply written
+	setBlendingMode(BlendingMode::write); //Not the default value
+	setRenderingLayer(RenderingLayer::background); //Not the default value
 }
 
 Mix::Mix(Mix&& other) = default;
@@ -1,6 +1,7 @@
 #include <Transitions/Mix.h>
 
 #include <Control/Generic.h>
+#include <Control/TransitionCommands.h>
 
 namespace Cenital::Transitions {
 
@@ -50,6 +51,7 @@ void Mix::registerCommands(Controller& controller) {
 														Transitions::getEffect,
 														Transitions::enumEffect ));
 
+	registerTransitionEasingCommands<Mix>(configNode);
 
 	auto& classIndex = controller.getClassIndex();
 	classIndex.registerClass(
@@ -0,0 +1,428 @@
+#include <Transitions/Stinger.h>
+
+#include <BackgroundJob.h>
+#include <VideoDecoder.h>
+
+#include <zuazo/Signal/DummyPad.h>
+#include <zuazo/Signal/Output.h>
+#include <zuazo/Layers/VideoSurface.h>
+#include <zuazo/Graphics/Uploader.h>
+#include <zuazo/Math/Trigonometry.h>
+
+#include <cstring>
+#include <optional>
+#include <vector>
+
+namespace Cenital::Transitions {
+
+using namespace Zuazo;
+
+static void openHelper(ZuazoBase& base, std::unique_lock<Instance>* lock) {
+	if(lock) {
+		base.asyncOpen(*lock);
+	} else {
+		base.open();
+	}
+}
+
+static void closeHelper(ZuazoBase& base, std::unique_lock<Instance>* lock) {
+	if(lock) {
+		base.asyncClose(*lock);
+	} else {
+		base.close();
+	}
+}
+
+//Frames are converted to 8bit RGBA, as it is always supported
+static constexpr size_t PIXEL_SIZE = 4;
+
+struct DecodedClip {
+	Resolution								resolution;
+	std::vector<std::vector<std::byte>>		frames;
+};
+
+static std::optional<DecodedClip> decodeClip(	const std::string& path,
+												const BackgroundJob::CancelFlag& cancelled )
+{
+	std::optional<DecodedClip> result;
+
+	try {
+		//Decode all the frames of the clip. This does not involve
+		//the instance, so it is done without locking it
+		VideoDecoder decoder(path);
+		DecodedClip clip;
+
+		const AVFrame* frame;
+		while(!cancelled.load() && (frame = decoder.decode())) {
+			//All the frames are converted to the size of the first one
+			if(clip.frames.empty()) {
+				if(frame->width <= 0 || frame->height <= 0) {
+					break;
+				}
+
+				clip.resolution = Resolution(frame->width, frame->height);
+			}
+
+			const auto width = static_cast<int>(clip.resolution.width);
+			const auto height = static_cast<int>(clip.resolution.height);
+			const auto lineSize = static_cast<size_t>(width)*PIXEL_SIZE;
+			auto& pixels = clip.frames.emplace_back(lineSize*height);
+			decoder.convert(
+				*frame,
+				AV_PIX_FMT_RGBA,
+				width, height,
+				reinterpret_cast<uint8_t*>(pixels.data()), static_cast<int>(lineSize)
+			);
+		}
+
+		if(!clip.frames.empty()) {
+			result = std::move(clip);
+		}
+	} catch (...) {
+		result.reset();
+	}
+
+	return result;
+}
+
+
+
+struct StingerImpl {
+	using Input = Signal::DummyPad<Zuazo::Video>;
+	using VideoSurface = Layers::VideoSurface;
+	static constexpr size_t NO_FRAME = std::numeric_limits<size_t>::max();
+
+	std::reference_wrapper<Stinger>	owner;
+
+	Input									prevIn;
+	Input									postIn;
+	Signal::Output<Video>					clipOut;
+
+	VideoSurface							prevSurface;
+	VideoSurface							postSurface;
+	VideoSurface							clipSurface;
+
+	std::array<RendererBase::LayerRef, 3>	layerReferences;
+
+	std::string								clipPath;
+	size_t									cutFrame;
+	std::vector<Video>						frames;
+	size_t									currentFrame;
+	BackgroundJob							loader;
+
+
+	StingerImpl(Stinger& owner, Instance& instance)
+		: owner(owner)
+		, prevIn(owner, "prevIn")
+		, postIn(owner, "postIn")
+		, clipOut(owner, "clipOut")
+		, prevSurface(instance, "prevSurface", Math::Vec2f())
+		, postSurface(instance, "postSurface", Math::Vec2f())
+		, clipSurface(instance, "clipSurface", Math::Vec2f())
+		, layerReferences{ prevSurface, postSurface, clipSurface }
+		, clipPath()
+		, cutFrame(Stinger::DEFAULT_CUT_FRAME)
+		, frames()
+		, currentFrame(NO_FRAME)
+		, loader()
+	{
+		//Route the signals permanently
+		prevSurface << prevIn;
+		postSurface << postIn;
+		clipSurface << clipOut;
+
+		//Configure the permanent parameters of the surfaces. As in the mix
+		//transition, only one of the backgrounds will be visible at a time
+		prevSurface.setScalingMode(ScalingMode::stretch); //defaults
+		postSurface.setScalingMode(ScalingMode::stretch); //defaults
+		clipSurface.setScalingMode(ScalingMode::stretch); //defaults
+		prevSurface.setBlendingMode(BlendingMode::add); //Not the default value
+		postSurface.setBlendingMode(BlendingMode::add); //Not the default value
+		prevSurface.setRenderingLayer(RenderingLayer::background); //Not the default value
+		postSurface.setRenderingLayer(RenderingLayer::background); //Not the default value
+	}
+
+	~StingerImpl() = default;
+
+	void moved(ZuazoBase& base) {
+		owner = static_cast<Stinger&>(base);
+		prevIn.setLayout(base);
+		postIn.setLayout(base);
+		clipOut.setLayout(base);
+	}
+
+	void open(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& stinger = static_cast<Stinger&>(base);
+		assert(&owner.get() == &stinger); (void)(stinger);
+
+		openHelper(prevSurface, lock);
+		openHelper(postSurface, lock);
+		openHelper(clipSurface, lock);
+
+		//Decode the whole clip upfront, so that nothing
+		//needs to be decoded while the transition plays
+		loadFrames();
+	}
+
+	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		open(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+
+	void close(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& stinger = static_cast<Stinger&>(base);
+		assert(&owner.get() == &stinger);
+
+		//Stop decoding and release the frames
+		loader.join();
+		stinger.disableRegularUpdate();
+		clipOut.reset();
+		frames.clear();
+		currentFrame = NO_FRAME;
+
+		closeHelper(prevSurface, lock);
+		closeHelper(postSurface, lock);
+		closeHelper(clipSurface, lock);
+	}
+
+	void asyncClose(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		close(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+
+
+	void updateCallback() {
+		auto& stinger = owner.get();
+
+		//Deliver the clip decoded in the background. Regular
+		//updates are only needed while waiting for it
+		if(loader.poll()) {
+			stinger.disableRegularUpdate();
+		}
+
+		//Obtain the progress. The clip is played at its own pace,
+		//so the easing is not applied
+		const auto progress = static_cast<float>(stinger.getProgress());
+
+		//Select the frame of the clip corresponding to this time. The
+		//transition lasts as many output frames as the clip has, so
+		//the progress is a multiple of their count. Round it to avoid
+		//skipping frames due to precision errors
+		const auto frameCount = frames.size();
+		const auto frameIndex = frameCount > 0 ?
+			Math::min(static_cast<size_t>(progress*frameCount + 0.5f), frameCount - 1) :
+			NO_FRAME ;
+
+		//Cut the background on the cut frame. If no clip is present,
+		//simply cut at the middle
+		const bool cut = (frameIndex != NO_FRAME) ?
+			(frameIndex >= getEffectiveCutFrame()) :
+			(progress >= 0.5f) ;
+		prevSurface.setOpacity(cut ? 0.0f : 1.0f);
+		postSurface.setOpacity(cut ? 1.0f : 0.0f);
+
+		//Show the selected frame. Frames are already in the GPU,
+		//so this only involves a reference
+		if(frameIndex != currentFrame) {
+			currentFrame = frameIndex;
+
+			if(currentFrame != NO_FRAME) {
+				clipOut.push(frames[currentFrame]);
+			} else {
+				clipOut.reset();
+			}
+		}
+	}
+
+	void sizeCallback(Base&, Math::Vec2f size) {
+		prevSurface.setSize(size);
+		postSurface.setSize(size);
+		clipSurface.setSize(size);
+		updateCallback();
+	}
+
+
+
+	void setScalingFilter(Zuazo::ScalingFilter filter) {
+		prevSurface.setScalingFilter(filter);
+		postSurface.setScalingFilter(filter);
+		clipSurface.setScalingFilter(filter);
+	}
+
+	Zuazo::ScalingFilter getScalingFilter() const noexcept {
+		const auto result = prevSurface.getScalingFilter();
+		assert(result == postSurface.getScalingFilter());
+		assert(result == clipSurface.getScalingFilter());
+		return result;
+	}
+
+
+	void setClipPath(std::string path) {
+		if(clipPath != path) {
+			clipPath = std::move(path);
+
+			//Reload the frames if necessary
+			if(owner.get().isOpen()) {
+				loadFrames();
+			}
+		}
+	}
+
+	const std::string& getClipPath() const noexcept {
+		return clipPath;
+	}
+
+
+	void setCutFrame(size_t frame) {
+		cutFrame = frame;
+		updateCallback();
+	}
+
+	size_t getCutFrame() const noexcept {
+		return cutFrame;
+	}
+
+
+	size_t getFrameCount() const noexcept {
+		return frames.size();
+	}
+
+private:
+	size_t getEffectiveCutFrame() const noexcept {
+		return (cutFrame < frames.size()) ? cutFrame : frames.size() / 2;
+	}
+
+	void loadFrames() {
+		auto& stinger = owner.get();
+
+		if(clipPath.empty()) {
+			loader.cancel();
+			stinger.disableRegularUpdate();
+			setFrames({});
+		} else {
+			//Decode it on a worker thread, as it takes a while. Meanwhile,
+			//the previous frames are kept. The result is polled on updates
+			loader.start(
+				std::bind(&decodeClip, clipPath, std::placeholders::_1),
+				[this] (std::optional<DecodedClip> result) -> void {
+					if(!result) {
+						ZUAZO_BASE_LOG(owner.get(), Severity::error, "Could not load " + clipPath);
+					}
+
+					setFrames(result ? uploadClip(std::move(*result)) : std::vector<Video>());
+				}
+			);
+			stinger.enableRegularUpdate(Instance::playerPriority);
+		}
+	}
+
+	std::vector<Video> uploadClip(DecodedClip clip) {
+		std::vector<Video> result;
+		result.reserve(clip.frames.size());
+
+		//Use an explicit video mode, as it is not negotiated
+		const Graphics::Frame::Descriptor descriptor(
+			clip.resolution,
+			AspectRatio(1, 1),
+			ColorPrimaries::bt709,
+			ColorModel::rgb,
+			ColorTransferFunction::iec61966_2_1,
+			ColorSubsampling::rb444,
+			ColorRange::full,
+			ColorFormat::R8G8B8A8
+		);
+		const Graphics::Uploader uploader(owner.get().getInstance().getVulkan(), descriptor);
+
+		for(auto& pixels : clip.frames) {
+			auto frame = uploader.acquireFrame();
+			auto& destination = frame->getPixelData().front();
+			assert(destination.size() == pixels.size());
+			std::memcpy(destination.data(), pixels.data(), pixels.size());
+			frame->flush();
+			result.push_back(std::move(frame));
+
+			//Release the decoded data as soon as possible
+			pixels = {};
+		}
+
+		return result;
+	}
+
+	void setFrames(std::vector<Video> newFrames) {
+		//Start over with the new frames
+		clipOut.reset();
+		frames = std::move(newFrames);
+		currentFrame = NO_FRAME;
+
+		//Shrink the storage, as it will be kept for a long time
+		frames.shrink_to_fit();
+		updateCallback();
+	}
+
+};
+
+
+Stinger::Stinger(	Instance& instance,
+					std::string name )
+	: Utils::Pimpl<StingerImpl>({}, *this, instance)
+	, Base(
+		instance,
+		std::move(name),
+		(*this)->prevIn.getInput(),
+		(*this)->postIn.getInput(),
+		(*this)->layerReferences,
+		std::bind(&StingerImpl::moved, std::ref(**this), std::placeholders::_1),
+		std::bind(&StingerImpl::open, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&StingerImpl::asyncOpen, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&StingerImpl::close, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&StingerImpl::asyncClose, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&StingerImpl::updateCallback, std::ref(**this)),
+		std::bind(&StingerImpl::sizeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
+{
+	//Leave it in a known state
+	(*this)->updateCallback();
+}
+
+Stinger::Stinger(Stinger&& other) = default;
+Stinger::~Stinger() = default;
+
+Stinger& Stinger::operator=(Stinger&& other) = default;
+
+
+
+void Stinger::setScalingFilter(Zuazo::ScalingFilter filter) {
+	(*this)->setScalingFilter(filter);
+}
+
+Zuazo::ScalingFilter Stinger::getScalingFilter() const noexcept {
+	return (*this)->getScalingFilter();
+}
+
+
+void Stinger::setClipPath(std::string path) {
+	(*this)->setClipPath(std::move(path));
+}
+
+const std::string& Stinger::getClipPath() const noexcept {
+	return (*this)->getClipPath();
+}
+
+
+void Stinger::setCutFrame(size_t frame) {
+	(*this)->setCutFrame(frame);
+}
+
+size_t Stinger::getCutFrame() const noexcept {
+	return (*this)->getCutFrame();
+}
+
+
+size_t Stinger::getFrameCount() const noexcept {
+	return (*this)->getFrameCount();
+}
+
+}
\ No newline at end of file
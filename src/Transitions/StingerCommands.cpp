@@ -0,0 +1,106 @@
+#include <Transitions/Stinger.h>
+
+#include <Control/Generic.h>
+#include <Control/VideoScalingCommands.h>
+#include <Control/TransitionCommands.h>
+
+namespace Cenital::Transitions {
+
+using namespace Zuazo;
+using namespace Control;
+
+static void setClipPath(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter<Stinger, std::string>( 
+		&Stinger::setClipPath,
+		controller, base, request, level, response
+	);
+}
+
+static void getClipPath(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter<const std::string&, Stinger>(
+		&Stinger::getClipPath,
+		controller, base, request, level, response
+	);
+}
+
+
+
+static void setCutFrame(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter(
+		&Stinger::setCutFrame,
+		controller, base, request, level, response
+	);
+}
+
+static void getCutFrame(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter(
+		&Stinger::getCutFrame,
+		controller, base, request, level, response
+	);
+}
+
+
+
+static void getFrameCount(	Controller& controller,
+							ZuazoBase& base, 
+							const Message& request,
+							size_t level,
+							Message& response ) 
+{
+	invokeGetter(
+		&Stinger::getFrameCount,
+		controller, base, request, level, response
+	);
+}
+
+
+
+
+
+void Stinger::registerCommands(Controller& controller) {
+	Node configNode;
+
+	configNode.addPath("clip",		 	makeAttributeNode( 	Transitions::setClipPath,
+															Transitions::getClipPath ));
+	configNode.addPath("cut",		 	makeAttributeNode( 	Transitions::setCutFrame,
+															Transitions::getCutFrame ));
+	configNode.addPath("frames",	 	makeAttributeNode( 	{},
+															Transitions::getFrameCount ));
+
+	registerVideoScalingFilterAttribute<Stinger>(configNode, true, true);
+	registerTransitionEasingCommands<Stinger>(configNode);
+
+	auto& classIndex = controller.getClassIndex();
+	classIndex.registerClass(
+		typeid(Stinger),
+		ClassIndex::Entry(
+			"stinger",
+			std::move(configNode),
+			invokeBaseConstructor<Stinger>,
+			typeid(Base)
+		)	
+	);
+
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,744 @@
+#include <Transitions/TwoInputLayer.h>
+
+#include <zuazo/Utils/StaticId.h>
+#include <zuazo/Graphics/StagedBuffer.h>
+#include <zuazo/Graphics/UniformBuffer.h>
+#include <zuazo/Graphics/ColorTransfer.h>
+
+#include <utility>
+#include <tuple>
+#include <map>
+#include <mutex>
+
+namespace Cenital::Transitions {
+
+using namespace Zuazo;
+
+struct Vertex {
+	Vertex(	const Math::Vec2f& position,
+			const Math::Vec2f& texCoord ) noexcept
+		: position(position)
+		, texCoord(texCoord)
+	{
+	}
+
+	Math::Vec2f position;
+	Math::Vec2f texCoord;
+};
+
+static constexpr size_t VERTEX_COUNT = 4;
+
+enum VertexBufferBindings {
+	VERTEX_BUFFER_BINDING,
+
+	VERTEX_BUFFER_COUNT
+};
+
+enum VertexLayout {
+	VERTEX_LOCATION_POSITION,
+	VERTEX_LOCATION_TEXCOORD,
+
+	VERTEX_LOCATION_COUNT
+};
+
+
+
+struct TwoInputLayer::Resources {
+	Resources(	Graphics::StagedBuffer vertexBuffer,
+				std::vector<std::pair<uint32_t, size_t>> uniformBufferSizes,
+				const Graphics::Vulkan& vulkan,
+				vk::UniqueDescriptorPool descriptorPool )
+		: vertexBuffer(std::move(vertexBuffer))
+		, uniformBufferSizes(std::move(uniformBufferSizes))
+		, uniformBuffer(vulkan, this->uniformBufferSizes)
+		, storageBuffers()
+		, descriptorPool(std::move(descriptorPool))
+	{
+	}
+
+	~Resources() = default;
+
+	Graphics::StagedBuffer								vertexBuffer;
+	std::vector<std::pair<uint32_t, size_t>>			uniformBufferSizes;
+	Graphics::UniformBuffer								uniformBuffer;
+	std::vector<Graphics::StagedBuffer>					storageBuffers; //In the order of the layout
+	vk::UniqueDescriptorPool							descriptorPool;
+};
+
+
+
+static Graphics::StagedBuffer createVertexBuffer(const Graphics::Vulkan& vulkan) {
+	return Graphics::StagedBuffer(
+		vulkan,
+		vk::BufferUsageFlagBits::eVertexBuffer,
+		sizeof(Vertex) * VERTEX_COUNT
+	);
+}
+
+static std::vector<std::pair<uint32_t, size_t>> getUniformBufferSizes(const TwoInputLayer::Layout& layout) {
+	std::vector<std::pair<uint32_t, size_t>> result = {
+		std::make_pair<uint32_t, size_t>(TwoInputLayer::DESCRIPTOR_BINDING_MODEL_MATRIX, sizeof(Math::Mat4x4f) )
+	};
+
+	for(const auto& binding : layout.bindings) {
+		if(binding.type == vk::DescriptorType::eUniformBuffer) {
+			result.emplace_back(binding.binding, binding.size);
+		}
+	}
+
+	return result;
+}
+
+static vk::PipelineStageFlags getPipelineStages(vk::ShaderStageFlags stages) noexcept {
+	vk::PipelineStageFlags result = {};
+
+	if(stages & vk::ShaderStageFlagBits::eVertex) {
+		result |= vk::PipelineStageFlagBits::eVertexShader;
+	}
+	if(stages & vk::ShaderStageFlagBits::eFragment) {
+		result |= vk::PipelineStageFlagBits::eFragmentShader;
+	}
+
+	return result;
+}
+
+static vk::DescriptorSetLayout getDescriptorSetLayout(	const Graphics::Vulkan& vulkan,
+														const TwoInputLayer::Layout& layout )
+{
+	static std::mutex mutex;
+	static std::map<const TwoInputLayer::Layout*, const Utils::StaticId> ids;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	const auto& id = ids[&layout];
+	lock.unlock();
+
+	auto result = vulkan.createDescriptorSetLayout(id);
+	if(!result) {
+		//Create the bindings. The model matrix is always present
+		std::vector<vk::DescriptorSetLayoutBinding> bindings = {
+			vk::DescriptorSetLayoutBinding(	//UBO binding
+				TwoInputLayer::DESCRIPTOR_BINDING_MODEL_MATRIX,	//Binding
+				vk::DescriptorType::eUniformBuffer,				//Type
+				1,												//Count
+				vk::ShaderStageFlagBits::eVertex,				//Shader stage
+				nullptr											//Immutable samplers
+			)
+		};
+
+		for(const auto& binding : layout.bindings) {
+			bindings.emplace_back(
+				binding.binding,								//Binding
+				binding.type,									//Type
+				1,												//Count
+				binding.stages,									//Shader stage
+				nullptr											//Immutable samplers
+			);
+		}
+
+		const vk::DescriptorSetLayoutCreateInfo createInfo(
+			{},
+			bindings.size(), bindings.data()
+		);
+
+		result = vulkan.createDescriptorSetLayout(id, createInfo);
+	}
+
+	return result;
+}
+
+static vk::UniqueDescriptorPool createDescriptorPool(	const Graphics::Vulkan& vulkan,
+														const TwoInputLayer::Layout& layout )
+{
+	uint32_t uniformBufferCount = 1; //Model matrix
+	uint32_t storageBufferCount = 0;
+	for(const auto& binding : layout.bindings) {
+		if(binding.type == vk::DescriptorType::eStorageBuffer) {
+			++storageBufferCount;
+		} else {
+			assert(binding.type == vk::DescriptorType::eUniformBuffer);
+			++uniformBufferCount;
+		}
+	}
+
+	std::vector<vk::DescriptorPoolSize> poolSizes = {
+		vk::DescriptorPoolSize(
+			vk::DescriptorType::eUniformBuffer,					//Descriptor type
+			uniformBufferCount									//Descriptor count
+		)
+	};
+
+	if(storageBufferCount) {
+		poolSizes.emplace_back(
+			vk::DescriptorType::eStorageBuffer,					//Descriptor type
+			storageBufferCount									//Descriptor count
+		);
+	}
+
+	const vk::DescriptorPoolCreateInfo createInfo(
+		{},														//Flags
+		1,														//Descriptor set count
+		poolSizes.size(), poolSizes.data()						//Pool sizes
+	);
+
+	return vulkan.createDescriptorPool(createInfo);
+}
+
+static vk::DescriptorSet createDescriptorSet(	const Graphics::Vulkan& vulkan,
+												const TwoInputLayer::Layout& layout,
+												vk::DescriptorPool pool )
+{
+	const auto descriptorSetLayout = getDescriptorSetLayout(vulkan, layout);
+	return vulkan.allocateDescriptorSet(pool, descriptorSetLayout).release();
+}
+
+static vk::PipelineLayout createPipelineLayout(	const Graphics::Vulkan& vulkan,
+												vk::DescriptorSetLayout transitionDescriptorSetLayout,
+												vk::DescriptorSetLayout prevFrameDescriptorSetLayout,
+												vk::DescriptorSetLayout postFrameDescriptorSetLayout )
+{
+	using Index = std::tuple<vk::DescriptorSetLayout, vk::DescriptorSetLayout, vk::DescriptorSetLayout>;
+	static std::mutex mutex;
+	static std::map<Index, const Utils::StaticId> ids;
+
+	const Index index(transitionDescriptorSetLayout, prevFrameDescriptorSetLayout, postFrameDescriptorSetLayout);
+	std::unique_lock<std::mutex> lock(mutex);
+	const auto& id = ids[index];
+	lock.unlock();
+
+	auto result = vulkan.createPipelineLayout(id);
+	if(!result) {
+		const std::array layouts = {
+			RendererBase::getDescriptorSetLayout(vulkan), 			//DESCRIPTOR_SET_RENDERER
+			transitionDescriptorSetLayout, 							//DESCRIPTOR_SET_TRANSITION
+			prevFrameDescriptorSetLayout, 							//DESCRIPTOR_SET_PREVFRAME
+			postFrameDescriptorSetLayout 							//DESCRIPTOR_SET_POSTFRAME
+		};
+
+		const vk::PipelineLayoutCreateInfo createInfo(
+			{},													//Flags
+			layouts.size(), layouts.data(),						//Descriptor set layouts
+			0, nullptr											//Push constants
+		);
+
+		result = vulkan.createPipelineLayout(id, createInfo);
+	}
+
+	return result;
+}
+
+static std::vector<vk::SpecializationMapEntry> getSpecializationLayout(size_t count) {
+	std::vector<vk::SpecializationMapEntry> result;
+	result.reserve(count);
+
+	for(uint32_t i = 0; i < count; ++i) {
+		result.emplace_back(
+			i,													//Constant id
+			i*sizeof(uint32_t),									//Offset
+			sizeof(uint32_t)									//Size
+		);
+	}
+
+	return result;
+}
+
+static vk::ShaderModule getShaderModule(const Graphics::Vulkan& vulkan,
+										Utils::BufferView<const uint32_t> code )
+{
+	//The code's address is used as an identifier, as it is static
+	const size_t id = reinterpret_cast<uintptr_t>(code.data());
+
+	//Try to retrive the module from cache
+	auto result = vulkan.createShaderModule(id);
+	if(!result) {
+		//Module isn't in cache. Create it
+		result = vulkan.createShaderModule(id, code);
+	}
+
+	assert(result);
+	return result;
+}
+
+static vk::Pipeline createPipeline(	const Graphics::Vulkan& vulkan,
+									const TwoInputLayer::Layout& transitionLayout,
+									vk::PipelineLayout layout,
+									vk::RenderPass renderPass,
+									BlendingMode blendingMode,
+									RenderingLayer renderingLayer,
+									const std::vector<uint32_t>& vertexConstants,
+									const std::vector<uint32_t>& fragmentConstants )
+{
+	using Index = std::tuple<	const TwoInputLayer::Layout*,
+								vk::PipelineLayout,
+								vk::RenderPass,
+								BlendingMode,
+								RenderingLayer,
+								std::vector<uint32_t>,
+								std::vector<uint32_t> >;
+	static std::mutex mutex;
+	static std::map<Index, const Utils::StaticId> ids;
+
+	//Create a index for gathering the id
+	const Index index(
+		&transitionLayout,
+		layout,
+		renderPass,
+		blendingMode,
+		renderingLayer,
+		vertexConstants,
+		fragmentConstants
+	);
+
+	//Try to retrieve the result from cache
+	std::unique_lock<std::mutex> lock(mutex);
+	const auto& id = ids[index];
+	lock.unlock();
+
+	auto result = vulkan.createGraphicsPipeline(id);
+	if(!result) {
+		//No luck, create it
+		const auto vertexShader = getShaderModule(vulkan, transitionLayout.vertexShader);
+		const auto fragmentShader = getShaderModule(vulkan, transitionLayout.fragmentShader);
+
+		//Set the specialization constants
+		const auto vertexSpecializationLayout = getSpecializationLayout(vertexConstants.size());
+		const vk::SpecializationInfo vertexSpecializationInfo(
+			vertexSpecializationLayout.size(), vertexSpecializationLayout.data(),
+			vertexConstants.size()*sizeof(uint32_t), vertexConstants.data()
+		);
+
+		const auto fragmentSpecializationLayout = getSpecializationLayout(fragmentConstants.size());
+		const vk::SpecializationInfo fragmentSpecializationInfo(
+			fragmentSpecializationLayout.size(), fragmentSpecializationLayout.data(),
+			fragmentConstants.size()*sizeof(uint32_t), fragmentConstants.data()
+		);
+
+		//Define the shader modules
+		constexpr auto SHADER_ENTRY_POINT = "main";
+		const std::array shaderStages = {
+			vk::PipelineShaderStageCreateInfo(
+				{},												//Flags
+				vk::ShaderStageFlagBits::eVertex,				//Shader type
+				vertexShader,									//Shader handle
+				SHADER_ENTRY_POINT,								//Shader entry point
+				vertexConstants.empty() ? nullptr : &vertexSpecializationInfo //Specialization constants
+			),
+			vk::PipelineShaderStageCreateInfo(
+				{},												//Flags
+				vk::ShaderStageFlagBits::eFragment,				//Shader type
+				fragmentShader,									//Shader handle
+				SHADER_ENTRY_POINT, 							//Shader entry point
+				&fragmentSpecializationInfo						//Specialization constants
+			),
+		};
+
+		constexpr std::array vertexBindings = {
+			vk::VertexInputBindingDescription(
+				VERTEX_BUFFER_BINDING,
+				sizeof(Vertex),
+				vk::VertexInputRate::eVertex
+			)
+		};
+
+		constexpr std::array vertexAttributes = {
+			vk::VertexInputAttributeDescription(
+				VERTEX_LOCATION_POSITION,
+				VERTEX_BUFFER_BINDING,
+				vk::Format::eR32G32Sfloat,
+				offsetof(Vertex, position)
+			),
+			vk::VertexInputAttributeDescription(
+				VERTEX_LOCATION_TEXCOORD,
+				VERTEX_BUFFER_BINDING,
+				vk::Format::eR32G32Sfloat,
+				offsetof(Vertex, texCoord)
+			)
+		};
+
+		const vk::PipelineVertexInputStateCreateInfo vertexInput(
+			{},
+			vertexBindings.size(), vertexBindings.data(),		//Vertex bindings
+			vertexAttributes.size(), vertexAttributes.data()	//Vertex attributes
+		);
+
+		constexpr vk::PipelineInputAssemblyStateCreateInfo inputAssembly(
+			{},													//Flags
+			vk::PrimitiveTopology::eTriangleStrip,				//Topology
+			false												//Restart enable
+		);
+
+		constexpr vk::PipelineViewportStateCreateInfo viewport(
+			{},													//Flags
+			1, nullptr,											//Viewports (dynamic)
+			1, nullptr											//Scissors (dynamic)
+		);
+
+		constexpr vk::PipelineRasterizationStateCreateInfo rasterizer(
+			{},													//Flags
+			false, 												//Depth clamp enabled
+			false,												//Rasterizer discard enable
+			vk::PolygonMode::eFill,								//Polygon mode
+			vk::CullModeFlagBits::eNone, 						//Cull faces
+			vk::FrontFace::eClockwise,							//Front face direction
+			false, 0.0f, 0.0f, 0.0f,							//Depth bias
+			1.0f												//Line width
+		);
+
+		constexpr vk::PipelineMultisampleStateCreateInfo multisample(
+			{},													//Flags
+			vk::SampleCountFlagBits::e1,						//Sample count
+			false, 1.0f,										//Sample shading enable, min sample shading
+			nullptr,											//Sample mask
+			false, false										//Alpha to coverage, alpha to 1 enable
+		);
+
+		const auto depthStencil = Graphics::getDepthStencilConfiguration(renderingLayer);
+
+		const std::array colorBlendAttachments = {
+			Graphics::getBlendingConfiguration(blendingMode)
+		};
+
+		const vk::PipelineColorBlendStateCreateInfo colorBlend(
+			{},													//Flags
+			false,												//Enable logic operation
+			vk::LogicOp::eCopy,									//Logic operation
+			colorBlendAttachments.size(), colorBlendAttachments.data() //Blend attachments
+		);
+
+		constexpr std::array dynamicStates = {
+			vk::DynamicState::eViewport,
+			vk::DynamicState::eScissor
+		};
+
+		const vk::PipelineDynamicStateCreateInfo dynamicState(
+			{},													//Flags
+			dynamicStates.size(), dynamicStates.data()			//Dynamic states
+		);
+
+		const vk::GraphicsPipelineCreateInfo createInfo(
+			{},													//Flags
+			shaderStages.size(), shaderStages.data(),			//Shader stages
+			&vertexInput,										//Vertex input
+			&inputAssembly,										//Vertex assembly
+			nullptr,											//Tesselation
+			&viewport,											//Viewports
+			&rasterizer,										//Rasterizer
+			&multisample,										//Multisampling
+			&depthStencil,										//Depth / Stencil tests
+			&colorBlend,										//Color blending
+			&dynamicState,										//Dynamic states
+			layout,												//Pipeline layout
+			renderPass, 0,										//Renderpasses
+			nullptr, 0											//Inherit
+		);
+
+		result = vulkan.createGraphicsPipeline(id, createInfo);
+	}
+
+	assert(result);
+	return result;
+}
+
+
+
+TwoInputLayer::TwoInputLayer(	const Graphics::Vulkan& vulkan,
+								const Layout& layout,
+								Math::Vec2f size )
+	: m_vulkan(vulkan)
+	, m_layout(layout)
+	, m_resources(Utils::makeShared<Resources>(	createVertexBuffer(vulkan),
+												getUniformBufferSizes(layout),
+												vulkan,
+												createDescriptorPool(vulkan, layout) ))
+	, m_descriptorSet(createDescriptorSet(vulkan, layout, *m_resources->descriptorPool))
+	, m_size(size)
+	, m_flushVertexBuffer(true)
+	, m_flushStorageBuffers()
+	, m_vertexConstants(layout.vertexConstantCount)
+	, m_fragmentConstants(layout.fragmentConstantCount)
+	, m_prevFrameDescriptorSetLayout()
+	, m_postFrameDescriptorSetLayout()
+	, m_pipelineLayout()
+	, m_pipeline()
+{
+	assert(layout.fragmentConstantCount >= FRAGMENT_CONSTANT_ID_COUNT);
+	m_resources->uniformBuffer.writeDescirptorSet(vulkan, m_descriptorSet);
+
+	//Create the storage buffers and write them into the descriptor set
+	for(const auto& binding : layout.bindings) {
+		if(binding.type == vk::DescriptorType::eStorageBuffer) {
+			const auto& buffer = m_resources->storageBuffers.emplace_back(
+				vulkan,
+				vk::BufferUsageFlagBits::eStorageBuffer,
+				binding.size
+			);
+
+			const vk::DescriptorBufferInfo bufferInfo(
+				buffer.getBuffer(),										//Buffer
+				0,														//Offset
+				buffer.size()											//Size
+			);
+
+			const vk::WriteDescriptorSet write(
+				m_descriptorSet,										//Descriptor set
+				binding.binding,										//Binding
+				0, 														//Index
+				1,														//Descriptor count
+				vk::DescriptorType::eStorageBuffer,						//Descriptor type
+				nullptr,												//Images
+				&bufferInfo,											//Buffers
+				nullptr													//Texel buffers
+			);
+
+			vulkan.getDevice().updateDescriptorSets(write, {}, vulkan.getDispatcher());
+		}
+	}
+
+	m_flushStorageBuffers.resize(m_resources->storageBuffers.size(), false);
+}
+
+TwoInputLayer::~TwoInputLayer() {
+	m_resources->vertexBuffer.waitCompletion(m_vulkan);
+	m_resources->uniformBuffer.waitCompletion(m_vulkan);
+	for(auto& buffer : m_resources->storageBuffers) {
+		buffer.waitCompletion(m_vulkan);
+	}
+}
+
+
+
+void TwoInputLayer::recreate() {
+	//Force pipeline creation
+	m_prevFrameDescriptorSetLayout = nullptr;
+}
+
+void TwoInputLayer::draw(	Graphics::CommandBuffer& cmd,
+							const Video& prevFrame,
+							const Video& postFrame,
+							ScalingFilter filter,
+							vk::RenderPass renderPass,
+							BlendingMode blendingMode,
+							RenderingLayer renderingLayer,
+							Utils::BufferView<const uint32_t> instances )
+{
+	assert(m_resources);
+	assert(prevFrame);
+	assert(postFrame);
+
+	//Upload vertex and storage data if necessary
+	fillVertexBuffer();
+	fillStorageBuffers();
+
+	//Flush the unform buffer
+	m_resources->uniformBuffer.flush(m_vulkan);
+
+	//Configure the samplers for propper operation
+	configureSamplers(*prevFrame, *postFrame, filter, renderPass, blendingMode, renderingLayer);
+	assert(m_prevFrameDescriptorSetLayout);
+	assert(m_postFrameDescriptorSetLayout);
+	assert(m_pipelineLayout);
+	assert(m_pipeline);
+
+	//Bind the pipeline and its descriptor sets
+	cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, m_pipeline);
+
+	cmd.bindVertexBuffers(
+		VERTEX_BUFFER_BINDING,											//Binding
+		m_resources->vertexBuffer.getBuffer(),							//Vertex buffers
+		0UL																//Offsets
+	);
+
+	cmd.bindDescriptorSets(
+		vk::PipelineBindPoint::eGraphics,								//Pipeline bind point
+		m_pipelineLayout,												//Pipeline layout
+		DESCRIPTOR_SET_TRANSITION,										//First index
+		m_descriptorSet,												//Descriptor sets
+		{}																//Dynamic offsets
+	);
+
+	prevFrame->bind(
+		cmd.get(), 														//Commandbuffer
+		m_pipelineLayout, 												//Pipeline layout
+		DESCRIPTOR_SET_PREVFRAME, 										//Descriptor set index
+		filter															//Filter
+	);
+	postFrame->bind(
+		cmd.get(), 														//Commandbuffer
+		m_pipelineLayout, 												//Pipeline layout
+		DESCRIPTOR_SET_POSTFRAME, 										//Descriptor set index
+		filter															//Filter
+	);
+
+	//Draw a full-screen quad for each instance. The shaders
+	//may use the instance index to tell them apart
+	for(const auto instance : instances) {
+		cmd.draw(
+			VERTEX_COUNT, 												//Vertex count
+			1, 															//Instance count
+			0, 															//First vertex
+			instance													//First instance
+		);
+	}
+
+	//Add the dependencies to the command buffer
+	cmd.addDependencies({ m_resources, prevFrame, postFrame });
+}
+
+void TwoInputLayer::setSize(Math::Vec2f size) {
+	m_size = size;
+	m_flushVertexBuffer = true;
+}
+
+void TwoInputLayer::updateModelMatrixUniform(const Math::Transformf& transform) {
+	const auto mtx = transform.calculateMatrix();
+	writeUniform(DESCRIPTOR_BINDING_MODEL_MATRIX, &mtx, sizeof(mtx));
+}
+
+
+
+void TwoInputLayer::writeUniform(	uint32_t binding,
+									const void* data,
+									size_t size,
+									size_t offset )
+{
+	assert(m_resources);
+	m_resources->uniformBuffer.waitCompletion(m_vulkan);
+
+	m_resources->uniformBuffer.write(
+		m_vulkan,
+		binding,
+		data,
+		size,
+		offset
+	);
+}
+
+Utils::BufferView<std::byte> TwoInputLayer::writeStorage(uint32_t binding) {
+	assert(m_resources);
+	const auto index = findStorageBuffer(binding);
+	auto& buffer = m_resources->storageBuffers[index];
+
+	//Wait for any previous transfers
+	buffer.waitCompletion(m_vulkan);
+	m_flushStorageBuffers[index] = true;
+
+	return Utils::BufferView<std::byte>(buffer.data(), buffer.size());
+}
+
+
+
+void TwoInputLayer::configureSamplers(	const Graphics::Frame& prevFrame,
+										const Graphics::Frame& postFrame,
+										ScalingFilter filter,
+										vk::RenderPass renderPass,
+										BlendingMode blendingMode,
+										RenderingLayer renderingLayer )
+{
+	const auto newPrevDescriptorSetLayout = prevFrame.getDescriptorSetLayout(filter);
+	const auto newPostDescriptorSetLayout = postFrame.getDescriptorSetLayout(filter);
+	const auto newPrevSampleMode = prevFrame.getSamplingMode(filter);
+	const auto newPostSampleMode = postFrame.getSamplingMode(filter);
+
+	if(	m_prevFrameDescriptorSetLayout != newPrevDescriptorSetLayout ||
+		m_postFrameDescriptorSetLayout != newPostDescriptorSetLayout ||
+		m_fragmentConstants[FRAGMENT_CONSTANT_ID_PREV_SAMPLE_MODE] != newPrevSampleMode ||
+		m_fragmentConstants[FRAGMENT_CONSTANT_ID_POST_SAMPLE_MODE] != newPostSampleMode )
+	{
+		m_prevFrameDescriptorSetLayout = newPrevDescriptorSetLayout;
+		m_postFrameDescriptorSetLayout = newPostDescriptorSetLayout;
+		m_fragmentConstants[FRAGMENT_CONSTANT_ID_PREV_SAMPLE_MODE] = newPrevSampleMode;
+		m_fragmentConstants[FRAGMENT_CONSTANT_ID_POST_SAMPLE_MODE] = newPostSampleMode;
+
+		//Recreate stuff
+		m_pipelineLayout = createPipelineLayout(
+			m_vulkan,
+			getDescriptorSetLayout(m_vulkan, m_layout),
+			m_prevFrameDescriptorSetLayout,
+			m_postFrameDescriptorSetLayout
+		);
+		m_pipeline = createPipeline(
+			m_vulkan,
+			m_layout,
+			m_pipelineLayout,
+			renderPass,
+			blendingMode,
+			renderingLayer,
+			m_vertexConstants,
+			m_fragmentConstants
+		);
+	}
+}
+
+void TwoInputLayer::fillVertexBuffer() {
+	assert(m_resources);
+
+	if(m_flushVertexBuffer) {
+		//Wait for any previous transfers
+		m_resources->vertexBuffer.waitCompletion(m_vulkan);
+
+		//Obtain the buffer data
+		Utils::BufferView<Vertex> vertexBufferData(
+			reinterpret_cast<Vertex*>(m_resources->vertexBuffer.data()),
+			m_resources->vertexBuffer.size() / sizeof(Vertex)
+		);
+		assert(vertexBufferData.size() == VERTEX_COUNT);
+
+		//Cover all the viewport with a triangle strip
+		const auto halfSize = m_size / 2.0f;
+		vertexBufferData[0] = Vertex(Math::Vec2f(-halfSize.x, -halfSize.y), Math::Vec2f(0.0f, 0.0f));
+		vertexBufferData[1] = Vertex(Math::Vec2f(-halfSize.x, +halfSize.y), Math::Vec2f(0.0f, 1.0f));
+		vertexBufferData[2] = Vertex(Math::Vec2f(+halfSize.x, -halfSize.y), Math::Vec2f(1.0f, 0.0f));
+		vertexBufferData[3] = Vertex(Math::Vec2f(+halfSize.x, +halfSize.y), Math::Vec2f(1.0f, 1.0f));
+
+		//Flush the buffer
+		m_resources->vertexBuffer.flushData(
+			m_vulkan,
+			m_vulkan.getTransferQueueIndex(),
+			vk::AccessFlagBits::eVertexAttributeRead,
+			vk::PipelineStageFlagBits::eVertexInput
+		);
+
+		m_flushVertexBuffer = false;
+	}
+
+	assert(!m_flushVertexBuffer);
+}
+
+void TwoInputLayer::fillStorageBuffers() {
+	assert(m_resources);
+
+	size_t index = 0;
+	for(const auto& binding : m_layout.bindings) {
+		if(binding.type == vk::DescriptorType::eStorageBuffer) {
+			if(m_flushStorageBuffers[index]) {
+				//Data has been written through writeStorage()
+				m_resources->storageBuffers[index].flushData(
+					m_vulkan,
+					m_vulkan.getTransferQueueIndex(),
+					vk::AccessFlagBits::eShaderRead,
+					getPipelineStages(binding.stages)
+				);
+
+				m_flushStorageBuffers[index] = false;
+			}
+
+			++index;
+		}
+	}
+}
+
+size_t TwoInputLayer::findStorageBuffer(uint32_t binding) const noexcept {
+	size_t result = 0;
+	for(const auto& b : m_layout.bindings) {
+		if(b.binding == binding) {
+			assert(b.type == vk::DescriptorType::eStorageBuffer);
+			break;
+		} else if(b.type == vk::DescriptorType::eStorageBuffer) {
+			++result;
+		}
+	}
+
+	assert(result < m_flushStorageBuffers.size());
+	return result;
+}
+
+}
\ No newline at end of file
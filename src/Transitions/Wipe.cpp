@@ -0,0 +1,717 @@
+#include <Transitions/Wipe.h>
+
+#include <Transitions/TwoInputLayer.h>
+
+#include <zuazo/Signal/Input.h>
+#include <zuazo/Signal/DummyPad.h>
+#include <zuazo/Math/Trigonometry.h>
+#include <zuazo/Math/Absolute.h>
+
+#include <utility>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+namespace Cenital::Transitions {
+
+using namespace Zuazo;
+
+struct WipeImpl {
+	struct Open : TwoInputLayer {
+		static constexpr size_t MAX_SHAPE_VERTICES = 128;
+
+		enum DescriptorBindings {
+			DESCRIPTOR_BINDING_WIPEDATA = TwoInputLayer::DESCRIPTOR_BINDING_COUNT,
+			DESCRIPTOR_BINDING_SHAPEDATA,
+
+			DESCRIPTOR_BINDING_COUNT
+		};
+
+		enum FragmentConstantId {
+			FRAGMENT_CONSTANT_ID_PATTERN = TwoInputLayer::FRAGMENT_CONSTANT_ID_COUNT,
+
+			FRAGMENT_CONSTANT_ID_COUNT
+		};
+
+		enum WipeDataUniforms {
+			WIPEDATA_UNIFORM_ASPECT,
+			WIPEDATA_UNIFORM_DIRECTION,
+			WIPEDATA_UNIFORM_PROGRESS,
+			WIPEDATA_UNIFORM_BORDER,
+			WIPEDATA_UNIFORM_BAR_COUNT,
+			WIPEDATA_UNIFORM_SHAPE_SCALE,
+			WIPEDATA_UNIFORM_SHAPE_VERTEX_COUNT,
+			WIPEDATA_UNIFORM_OPACITY,
+
+			WIPEDATA_UNIFORM_COUNT
+		};
+
+		static constexpr std::array<Utils::Area, WIPEDATA_UNIFORM_COUNT> WIPEDATA_UNIFORM_LAYOUT = {
+			Utils::Area(0*sizeof(float),	sizeof(Math::Vec2f)),	//WIPEDATA_UNIFORM_ASPECT
+			Utils::Area(2*sizeof(float),	sizeof(Math::Vec2f)),	//WIPEDATA_UNIFORM_DIRECTION
+			Utils::Area(4*sizeof(float),	sizeof(float)),			//WIPEDATA_UNIFORM_PROGRESS
+			Utils::Area(5*sizeof(float),	sizeof(float)),			//WIPEDATA_UNIFORM_BORDER
+			Utils::Area(6*sizeof(float),	sizeof(float)),			//WIPEDATA_UNIFORM_BAR_COUNT
+			Utils::Area(7*sizeof(float),	sizeof(float)),			//WIPEDATA_UNIFORM_SHAPE_SCALE
+			Utils::Area(8*sizeof(float),	sizeof(int32_t)),		//WIPEDATA_UNIFORM_SHAPE_VERTEX_COUNT
+			Utils::Area(9*sizeof(float),	sizeof(float)),			//WIPEDATA_UNIFORM_OPACITY
+		};
+
+		Open(	const Graphics::Vulkan& vulkan,
+				Math::Vec2f size )
+			: TwoInputLayer(vulkan, getLayout(), size)
+		{
+		}
+
+		void updatePatternConstant(Wipe::Pattern pattern) {
+			setFragmentConstant(FRAGMENT_CONSTANT_ID_PATTERN, static_cast<int32_t>(pattern));
+		}
+
+		void updateAspectUniform(Math::Vec2f size) {
+			//Normalize it so that the longest side is 1
+			const auto maxSide = Math::max(size.x, size.y);
+			const auto aspect = maxSide > 0 ? size / maxSide : Math::Vec2f(1.0f);
+			updateFragmentUniform(WIPEDATA_UNIFORM_ASPECT, aspect);
+		}
+
+		void updateDirectionUniform(float angle) {
+			//As vulkan's Y axis is inverted, use a "-" in the sin
+			const auto theta = Math::deg2rad(angle);
+			const auto direction = Math::Vec2f(Math::cos(theta), -Math::sin(theta));
+			updateFragmentUniform(WIPEDATA_UNIFORM_DIRECTION, direction);
+		}
+
+		void updateProgressUniform(float progress) {
+			updateFragmentUniform(WIPEDATA_UNIFORM_PROGRESS, progress);
+		}
+
+		void updateBorderUniform(float border) {
+			updateFragmentUniform(WIPEDATA_UNIFORM_BORDER, Math::max(border, 0.0f));
+		}
+
+		void updateBarCountUniform(uint32_t count) {
+			updateFragmentUniform(WIPEDATA_UNIFORM_BAR_COUNT, static_cast<float>(Math::max(count, 1U)));
+		}
+
+		void updateShapeUniform(Utils::BufferView<const Math::Vec2f> vertices, float scale) {
+			assert(vertices.size() <= MAX_SHAPE_VERTICES);
+
+			//Vertices are stored as vec4-s due to std140 array stride
+			std::array<Math::Vec4f, MAX_SHAPE_VERTICES> data;
+			for(size_t i = 0; i < vertices.size(); ++i) {
+				data[i] = Math::Vec4f(vertices[i], 0.0f, 0.0f);
+			}
+
+			writeUniform(
+				DESCRIPTOR_BINDING_SHAPEDATA,
+				data.data(),
+				vertices.size()*sizeof(Math::Vec4f)
+			);
+
+			updateFragmentUniform(WIPEDATA_UNIFORM_SHAPE_VERTEX_COUNT, static_cast<int32_t>(vertices.size()));
+			updateFragmentUniform(WIPEDATA_UNIFORM_SHAPE_SCALE, scale);
+		}
+
+		void updateOpacityUniform(float opa) {
+			updateFragmentUniform(WIPEDATA_UNIFORM_OPACITY, opa);
+		}
+
+	private:
+		template<typename T>
+		void updateFragmentUniform(WipeDataUniforms binding, const T& value) {
+			writeUniform(DESCRIPTOR_BINDING_WIPEDATA, WIPEDATA_UNIFORM_LAYOUT[binding], value);
+		}
+
+		static const Layout& getLayout() {
+			static
+			#include <wipe_vert.h>
+			static
+			#include <wipe_frag.h>
+
+			static const std::array bindings = {
+				Binding{
+					DESCRIPTOR_BINDING_WIPEDATA,					//Binding
+					vk::DescriptorType::eUniformBuffer,				//Type
+					vk::ShaderStageFlagBits::eFragment,				//Shader stage
+					WIPEDATA_UNIFORM_LAYOUT.back().end()			//Size
+				},
+				Binding{
+					DESCRIPTOR_BINDING_SHAPEDATA,					//Binding
+					vk::DescriptorType::eUniformBuffer,				//Type
+					vk::ShaderStageFlagBits::eFragment,				//Shader stage
+					MAX_SHAPE_VERTICES*sizeof(Math::Vec4f)			//Size
+				}
+			};
+
+			static const Layout layout = {
+				wipe_vert,											//Vertex shader
+				wipe_frag,											//Fragment shader
+				bindings,											//Bindings
+				0,													//Vertex constant count
+				FRAGMENT_CONSTANT_ID_COUNT							//Fragment constant count
+			};
+
+			return layout;
+		}
+
+	};
+
+	using Input = Signal::DummyPad<Zuazo::Video>;
+	using FrameInput = Signal::Input<Video>;
+	using LastFrames = std::unordered_map<const RendererBase*, std::pair<Video, Video>>;
+
+	static constexpr size_t SHAPE_SUBDIVISIONS = 8;
+	static constexpr size_t SHAPE_BOUNDARY_SAMPLES = 64;
+
+	std::reference_wrapper<Wipe>			owner;
+
+	Input									prevIn;
+	Input									postIn;
+	FrameInput								prevFrameIn;
+	FrameInput								postFrameIn;
+
+	std::vector<RendererBase::LayerRef>		layerReferences;
+
+	ScalingFilter							scalingFilter;
+	Wipe::Pattern							pattern;
+	float									angle;
+	uint32_t								barCount;
+	float									border;
+	Shape									shape;
+	std::vector<Math::Vec2f>				shapeVertices;
+	float									shapeScale;
+
+	std::unique_ptr<Open>					opened;
+	LastFrames								lastFrames;
+
+
+	WipeImpl(Wipe& owner, Instance&)
+		: owner(owner)
+		, prevIn(owner, "prevIn")
+		, postIn(owner, "postIn")
+		, prevFrameIn(owner, "prevFrameIn")
+		, postFrameIn(owner, "postFrameIn")
+		, layerReferences()
+		, scalingFilter(ScalingFilter::linear)
+		, pattern(Wipe::Pattern::bars)
+		, angle(0.0f)
+		, barCount(1)
+		, border(0.05f)
+		, shape()
+		, shapeVertices()
+		, shapeScale(1.0f)
+	{
+		//Route the signals permanently
+		prevFrameIn << prevIn;
+		postFrameIn << postIn;
+
+		//Use a star as the default shape
+		generateStar(shape, 5, 1.0f, 0.5f, -M_PI/2);
+	}
+
+	~WipeImpl() = default;
+
+	void moved(ZuazoBase& base) {
+		owner = static_cast<Wipe&>(base);
+		prevIn.setLayout(base);
+		postIn.setLayout(base);
+		prevFrameIn.setLayout(base);
+		postFrameIn.setLayout(base);
+
+		//The layer is ourselves, so the reference needs to be updated
+		layerReferences = { static_cast<LayerBase&>(owner.get()) };
+	}
+
+	void open(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& wipe = static_cast<Wipe&>(base);
+		assert(&owner.get() == &wipe);
+		assert(!opened);
+
+		if(wipe.getRenderPass()) {
+			//Create in a unlocked environment
+			if(lock) lock->unlock();
+			auto newOpened = Utils::makeUnique<Open>(
+					wipe.getInstance().getVulkan(),
+					wipe.getSize()
+			);
+
+			//Set all the parameters
+			newOpened->updateModelMatrixUniform(wipe.getTransform());
+			newOpened->updateOpacityUniform(wipe.getOpacity());
+			newOpened->updateAspectUniform(wipe.getSize());
+			newOpened->updateProgressUniform(static_cast<float>(wipe.getEasedProgress()));
+
+			newOpened->updatePatternConstant(getPattern());
+			newOpened->updateDirectionUniform(getAngle());
+			newOpened->updateBarCountUniform(getBarCount());
+			newOpened->updateBorderUniform(getBorder());
+			newOpened->updateShapeUniform(shapeVertices, shapeScale);
+
+			if(lock) lock->lock();
+
+			//Write changes after locking back
+			opened = std::move(newOpened);
+		}
+
+		assert(lastFrames.empty()); //Any hasChanged() should return true
+	}
+
+	void asyncOpen(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		open(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+
+	void close(ZuazoBase& base, std::unique_lock<Instance>* lock = nullptr) {
+		auto& wipe = static_cast<Wipe&>(base);
+		assert(&owner.get() == &wipe); (void)(wipe);
+
+		//Write changes
+		prevFrameIn.reset();
+		postFrameIn.reset();
+		lastFrames.clear();
+		auto oldOpened = std::move(opened);
+
+		//Destroy the object in a unlocked environment
+		if(oldOpened) {
+			if(lock) lock->unlock();
+			oldOpened.reset();
+			if(lock) lock->lock();
+		}
+
+		assert(!opened);
+	}
+
+	void asyncClose(ZuazoBase& base, std::unique_lock<Instance>& lock) {
+		assert(lock.owns_lock());
+		close(base, &lock);
+		assert(lock.owns_lock());
+	}
+
+
+
+	void updateCallback() {
+		const auto& wipe = owner.get();
+
+		//Only a uniform needs to be written, so that the
+		//pipeline and the geometry remain untouched
+		if(opened) {
+			opened->updateProgressUniform(static_cast<float>(wipe.getEasedProgress()));
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	void sizeCallback(Base&, Math::Vec2f size) {
+		if(opened) {
+			opened->setSize(size);
+			opened->updateAspectUniform(size);
+		}
+
+		//Shape's scale depends on the aspect ratio
+		updateShape();
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	bool hasChangedCallback(const LayerBase& base, const RendererBase& renderer) const {
+		const auto& wipe = static_cast<const Wipe&>(base);
+		assert(&owner.get() == &wipe); (void)(wipe);
+
+		const auto ite = lastFrames.find(&renderer);
+		if(ite == lastFrames.cend()) {
+			//There is no frame previously rendered for this renderer
+			return true;
+		}
+
+		if(	ite->second.first != prevFrameIn.getLastElement() ||
+			ite->second.second != postFrameIn.getLastElement() )
+		{
+			//A new frame has arrived since the last rendered one at this renderer
+			return true;
+		}
+
+		if(prevFrameIn.hasChanged() || postFrameIn.hasChanged()) {
+			//A new frame is available
+			return true;
+		}
+
+		//Nothing has changed :-)
+		return false;
+	}
+
+	bool hasAlphaCallback(const LayerBase& base) const noexcept {
+		const auto& wipe = static_cast<const Wipe&>(base);
+		assert(&owner.get() == &wipe); Utils::ignore(wipe);
+
+		//Both frames are rendered as a background
+		return false;
+	}
+
+	void drawCallback(const LayerBase& base, const RendererBase& renderer, Graphics::CommandBuffer& cmd) {
+		const auto& wipe = static_cast<const Wipe&>(base);
+		assert(&owner.get() == &wipe); (void)(wipe);
+
+		if(opened) {
+			const auto& prevFrame = prevFrameIn.pull();
+			const auto& postFrame = postFrameIn.pull();
+
+			//Draw
+			if(prevFrame && postFrame) {
+				opened->draw(
+					cmd,
+					prevFrame,
+					postFrame,
+					scalingFilter,
+					wipe.getRenderPass(),
+					wipe.getBlendingMode(),
+					wipe.getRenderingLayer()
+				);
+			}
+
+			//Update the state for next hasChanged()
+			lastFrames[&renderer] = std::make_pair(prevFrame, postFrame);
+		}
+	}
+
+	void transformCallback(LayerBase& base, const Math::Transformf& transform) {
+		auto& wipe = static_cast<Wipe&>(base);
+		assert(&owner.get() == &wipe); (void)(wipe);
+
+		if(opened) {
+			opened->updateModelMatrixUniform(transform);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	void opacityCallback(LayerBase& base, float opa) {
+		auto& wipe = static_cast<Wipe&>(base);
+		assert(&owner.get() == &wipe); (void)(wipe);
+
+		if(opened) {
+			opened->updateOpacityUniform(opa);
+		}
+
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	void blendingModeCallback(LayerBase& base, BlendingMode mode) {
+		auto& wipe = static_cast<Wipe&>(base);
+		recreateCallback(wipe, wipe.getRenderPass(), mode);
+	}
+
+	void renderingLayerCallback(LayerBase& base, RenderingLayer) {
+		auto& wipe = static_cast<Wipe&>(base);
+		recreateCallback(wipe, wipe.getRenderPass(), wipe.getBlendingMode());
+	}
+
+	void renderPassCallback(LayerBase& base, vk::RenderPass renderPass) {
+		auto& wipe = static_cast<Wipe&>(base);
+		recreateCallback(wipe, renderPass, wipe.getBlendingMode());
+	}
+
+
+
+	void setScalingFilter(ScalingFilter filter) {
+		if(scalingFilter != filter) {
+			scalingFilter = filter;
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	ScalingFilter getScalingFilter() const noexcept {
+		return scalingFilter;
+	}
+
+
+	void setPattern(Wipe::Pattern pattern) {
+		if(this->pattern != pattern) {
+			this->pattern = pattern;
+
+			if(opened) {
+				opened->updatePatternConstant(this->pattern);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	Wipe::Pattern getPattern() const noexcept {
+		return pattern;
+	}
+
+
+	void setAngle(float angle) {
+		if(this->angle != angle) {
+			this->angle = angle;
+
+			if(opened) {
+				opened->updateDirectionUniform(this->angle);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	float getAngle() const noexcept {
+		return angle;
+	}
+
+
+	void setBarCount(uint32_t count) {
+		if(barCount != count) {
+			barCount = count;
+
+			if(opened) {
+				opened->updateBarCountUniform(barCount);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	uint32_t getBarCount() const noexcept {
+		return barCount;
+	}
+
+
+	void setBorder(float border) {
+		if(this->border != border) {
+			this->border = border;
+
+			if(opened) {
+				opened->updateBorderUniform(this->border);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	float getBorder() const noexcept {
+		return border;
+	}
+
+
+	void setShape(const Shape& shape) {
+		this->shape = shape;
+		updateShape();
+		lastFrames.clear(); //Will force hasChanged() to true
+	}
+
+	const Shape& getShape() const noexcept {
+		return shape;
+	}
+
+	void updateShape() {
+		//Flatten the contour into a polygon, as this is what the shader evaluates.
+		//This is only done when the shape changes, never on a per-frame basis
+		const std::vector<Math::Vec2f> points(shape.cbegin(), shape.cend());
+		const size_t segmentCount = points.size() / Shape::degree();
+		const size_t segmentStep = Math::max((segmentCount + Open::MAX_SHAPE_VERTICES - 1) / Open::MAX_SHAPE_VERTICES, size_t(1));
+		const size_t subdivisions = Math::min(
+			Math::max(Open::MAX_SHAPE_VERTICES / Math::max(segmentCount, size_t(1)), size_t(1)),
+			SHAPE_SUBDIVISIONS
+		);
+
+		shapeVertices.clear();
+		for(size_t i = 0; i < segmentCount; i += segmentStep) {
+			const auto& p0 = points[Shape::degree()*i + 0];
+			const auto& p1 = points[Shape::degree()*i + 1];
+			const auto& p2 = points[Shape::degree()*i + 2];
+			const auto& p3 = points[(Shape::degree()*(i + 1)) % points.size()];
+
+			//Evaluate the cubic Bézier segment. The end point is added by the next segment
+			for(size_t j = 0; j < subdivisions && shapeVertices.size() < Open::MAX_SHAPE_VERTICES; ++j) {
+				const auto t = static_cast<float>(j) / subdivisions;
+				const auto s = 1.0f - t;
+				shapeVertices.emplace_back(
+					s*s*s*p0 + 3.0f*s*s*t*p1 + 3.0f*s*t*t*p2 + t*t*t*p3
+				);
+			}
+		}
+
+		//Scale it so that the last revealed point of the viewport is reached at the end
+		const auto viewportSize = owner.get().getSize();
+		const auto maxSide = Math::max(viewportSize.x, viewportSize.y);
+		const auto aspect = maxSide > 0 ? viewportSize / maxSide : Math::Vec2f(1.0f);
+		float maxField = 0.0f;
+		for(size_t i = 0; i < SHAPE_BOUNDARY_SAMPLES; ++i) {
+			const auto t = static_cast<float>(i) / SHAPE_BOUNDARY_SAMPLES - 0.5f;
+			const std::array boundary = {
+				Math::Vec2f(t, -0.5f) * aspect,
+				Math::Vec2f(t, +0.5f) * aspect,
+				Math::Vec2f(-0.5f, t) * aspect,
+				Math::Vec2f(+0.5f, t) * aspect
+			};
+
+			for(const auto& pos : boundary) {
+				maxField = Math::max(maxField, calculateShapeField(shapeVertices, pos));
+			}
+		}
+		shapeScale = maxField > 0.0f ? 1.0f / maxField : 1.0f;
+
+		if(opened) {
+			opened->updateShapeUniform(shapeVertices, shapeScale);
+		}
+	}
+
+private:
+	void recreateCallback(	Wipe& wipe,
+							vk::RenderPass renderPass,
+							BlendingMode blendingMode )
+	{
+		assert(&owner.get() == &wipe);
+
+		if(wipe.isOpen()) {
+			const bool isValid = 	renderPass &&
+									blendingMode > BlendingMode::none ;
+
+			if(opened && isValid) {
+				//It remains valid
+				opened->recreate();
+			} else if(opened && !isValid) {
+				//It has become invalid
+				prevFrameIn.reset();
+				postFrameIn.reset();
+				opened.reset();
+			} else if(!opened && isValid) {
+				//It has become valid
+				open(wipe, nullptr);
+			}
+
+			lastFrames.clear(); //Will force hasChanged() to true
+		}
+	}
+
+	static float calculateShapeField(Utils::BufferView<const Math::Vec2f> vertices, Math::Vec2f pos) {
+		//Same as in the fragment shader, without the scaling
+		const auto dist = Math::length(pos);
+		if(dist <= 0.0f) {
+			return 0.0f;
+		}
+
+		const auto dir = pos / dist;
+		float radius = 0.0f;
+		for(size_t i = 0; i < vertices.size(); ++i) {
+			const auto& a = vertices[i];
+			const auto& b = vertices[(i + 1) % vertices.size()];
+			const auto edge = b - a;
+
+			const auto den = dir.x*edge.y - dir.y*edge.x;
+			if(den != 0.0f) {
+				const auto t = (a.x*edge.y - a.y*edge.x) / den; //Along the ray
+				const auto s = (a.x*dir.y - a.y*dir.x) / den; //Along the edge
+				if(t > 0.0f && s >= 0.0f && s <= 1.0f) {
+					radius = Math::max(radius, t);
+				}
+			}
+		}
+
+		return (radius > 0.0f) ? (dist / radius) : 0.0f;
+	}
+
+};
+
+
+
+Wipe::Wipe(	Instance& instance,
+			std::string name )
+	: Utils::Pimpl<WipeImpl>({}, *this, instance)
+	, Base(
+		instance,
+		std::move(name),
+		(*this)->prevIn.getInput(),
+		(*this)->postIn.getInput(),
+		{},
+		std::bind(&WipeImpl::moved, std::ref(**this), std::placeholders::_1),
+		std::bind(&WipeImpl::open, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&WipeImpl::asyncOpen, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&WipeImpl::close, std::ref(**this), std::placeholders::_1, nullptr),
+		std::bind(&WipeImpl::asyncClose, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&WipeImpl::updateCallback, std::ref(**this)),
+		std::bind(&WipeImpl::sizeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
+	, LayerBase(
+		std::bind(&WipeImpl::transformCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&WipeImpl::opacityCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&WipeImpl::blendingModeCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&WipeImpl::renderingLayerCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&WipeImpl::hasChangedCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2),
+		std::bind(&WipeImpl::hasAlphaCallback, std::ref(**this), std::placeholders::_1),
+		std::bind(&WipeImpl::drawCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
+		std::bind(&WipeImpl::renderPassCallback, std::ref(**this), std::placeholders::_1, std::placeholders::_2) )
+{
+	//This transition is drawn by itself as a single layer.
+	//It can only be referenced once fully constructed
+	(*this)->layerReferences = { static_cast<LayerBase&>(*this) };
+	setLayers((*this)->layerReferences);
+
+	//Configure the permanent parameters of the layer
+	setBlendingMode(BlendingMode::write); //Not the default value
+	setRenderingLayer(RenderingLayer::background); //Not the default value
+
+	//Leave it in a known state
+	(*this)->updateShape();
+}
+
+Wipe::Wipe(Wipe&& other) = default;
+Wipe::~Wipe() = default;
+
+Wipe& Wipe::operator=(Wipe&& other) = default;
+
+
+
+void Wipe::setScalingFilter(Zuazo::ScalingFilter filter) {
+	(*this)->setScalingFilter(filter);
+}
+
+Zuazo::ScalingFilter Wipe::getScalingFilter() const noexcept {
+	return (*this)->getScalingFilter();
+}
+
+
+void Wipe::setPattern(Pattern pattern) {
+	(*this)->setPattern(pattern);
+}
+
+Wipe::Pattern Wipe::getPattern() const noexcept {
+	return (*this)->getPattern();
+}
+
+
+void Wipe::setAngle(float angle) {
+	(*this)->setAngle(angle);
+}
+
+float Wipe::getAngle() const noexcept {
+	return (*this)->getAngle();
+}
+
+
+void Wipe::setBarCount(uint32_t count) {
+	(*this)->setBarCount(count);
+}
+
+uint32_t Wipe::getBarCount() const noexcept {
+	return (*this)->getBarCount();
+}
+
+
+void Wipe::setBorder(float border) {
+	(*this)->setBorder(border);
+}
+
+float Wipe::getBorder() const noexcept {
+	return (*this)->getBorder();
+}
+
+
+void Wipe::setShape(const Shape& shape) {
+	(*this)->setShape(shape);
+}
+
+const Shape& Wipe::getShape() const noexcept {
+	return (*this)->getShape();
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include <Transitions/Wipe.h>
+
+#include <Control/Generic.h>
+#include <Control/VideoScalingCommands.h>
+#include <Control/TransitionCommands.h>
+
+#include <sstream>
+
+namespace Cenital::Transitions {
+
+using namespace Zuazo;
+using namespace Control;
+
+static void setPattern(	Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter(
+		&Wipe::setPattern,
+		controller, base, request, level, response
+	);
+}
+
+static void getPattern(	Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter(
+		&Wipe::getPattern,
+		controller, base, request, level, response
+	);
+}
+
+static void enumPattern(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	enumerate<Wipe::Pattern>(controller, base, request, level, response);
+}
+
+
+
+static void setAngle(	Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter( 
+		&Wipe::setAngle,
+		controller, base, request, level, response
+	);
+}
+
+static void getAngle(	Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter(
+		&Wipe::getAngle,
+		controller, base, request, level, response
+	);
+}
+
+
+
+static void setBarCount(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter( 
+		&Wipe::setBarCount,
+		controller, base, request, level, response
+	);
+}
+
+static void getBarCount(Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter(
+		&Wipe::getBarCount,
+		controller, base, request, level, response
+	);
+}
+
+
+
+static void setBorder(	Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeSetter( 
+		&Wipe::setBorder,
+		controller, base, request, level, response
+	);
+}
+
+static void getBorder(	Controller& controller,
+						ZuazoBase& base, 
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	invokeGetter(
+		&Wipe::getBorder,
+		controller, base, request, level, response
+	);
+}
+
+
+
+static void setShape(	Controller&,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level + 1) {
+		std::string_view token = tokens[level];
+
+		//Read all the available points
+		std::vector<Shape::value_type> contourPoints;
+		bool success = true;
+		size_t read;
+		while(!token.empty() && success) {
+			contourPoints.emplace_back();
+			read = fromString(token, contourPoints.back());
+
+			//Determine if it was successful. If so, pop out the parsed
+			//characters
+			if(read) {
+				token.remove_prefix(read);
+
+				//If not empty, try to obtain the separator:
+				if(!token.empty()) {
+					char separator;
+					read = fromString(token, separator);
+					if(read && separator == ';') {
+						token.remove_prefix(read);
+					} else {
+						success = false;
+					}
+				}
+
+			} else {
+				success = false;
+			}
+		}
+
+		//Check if the point count is correct, it must be divisible by 3
+		success = success && !contourPoints.empty();
+		success = success && (contourPoints.size() % Shape::degree()) == 0;
+
+		if(success) {
+			//As the multiple of degree constrain is satisfied at this point,
+			//It is safe to cast the data to a packed array of arrays
+			const Shape shape(
+				Utils::BufferView<const Shape::segment_data>(
+					reinterpret_cast<const Shape::segment_data*>(contourPoints.data()),
+					contourPoints.size() / Shape::degree()
+				)
+			);
+
+			//Perform mutations
+			assert(typeid(base) == typeid(Wipe));
+			Wipe& wipe = static_cast<Wipe&>(base);
+			wipe.setShape(shape);
+
+			//Elaborate the response
+			response.setType(Message::Type::broadcast);
+			response.getPayload() = tokens;
+		}
+	}
+}
+
+static void getShape(	Controller&,
+						ZuazoBase& base,
+						const Message& request,
+						size_t level,
+						Message& response ) 
+{
+	const auto& tokens = request.getPayload();
+
+	if(tokens.size() == level) {
+		assert(typeid(base) == typeid(Wipe));
+		const Wipe& wipe = static_cast<const Wipe&>(base);
+		const auto& shape = wipe.getShape();
+
+		std::stringstream ss;
+		for(auto ite = shape.cbegin(); ite != shape.cend(); ++ite) {
+			//Add the separator to all elements except the first one
+			if(ite != shape.cbegin()) {
+				ss << ';';
+			}
+
+			//Append this point
+			ss << *ite;
+		}
+
+		//Elaborate the response
+		response.setType(Message::Type::response);
+		response.getPayload() = { ss.str() };
+	}
+}
+
+
+
+
+
+void Wipe::registerCommands(Controller& controller) {
+	Node configNode;
+
+	configNode.addPath("pattern",		makeAttributeNode(	Transitions::setPattern,
+															Transitions::getPattern,
+															Transitions::enumPattern ));
+	configNode.addPath("angle",		 	makeAttributeNode( 	Transitions::setAngle,
+															Transitions::getAngle ));
+	configNode.addPath("bars",		 	makeAttributeNode( 	Transitions::setBarCount,
+															Transitions::getBarCount ));
+	configNode.addPath("border",	 	makeAttributeNode( 	Transitions::setBorder,
+															Transitions::getBorder ));
+	configNode.addPath("shape",		 	makeAttributeNode( 	Transitions::setShape,
+															Transitions::getShape ));
+
+	registerVideoScalingFilterAttribute<Wipe>(configNode, true, true);
+	registerTransitionEasingCommands<Wipe>(configNode);
+
+	auto& classIndex = controller.getClassIndex();
+	classIndex.registerClass(
+		typeid(Wipe),
+		ClassIndex::Entry(
+			"wipe",
+			std::move(configNode),
+			invokeBaseConstructor<Wipe>,
+			typeid(Base)
+		)	
+	);
+
+}
+
+}
\ No newline at end of file
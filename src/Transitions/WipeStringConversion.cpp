@@ -0,0 +1,35 @@
+#include <Transitions/Wipe.h>
+
+#include <zuazo/StringConversions.h>
+
+namespace Zuazo {
+
+std::string_view toString(Cenital::Transitions::Wipe::Pattern pattern) noexcept {
+	switch(pattern){
+
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Wipe::Pattern, bars )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Wipe::Pattern, box )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Wipe::Pattern, circle )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Wipe::Pattern, diamond )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Wipe::Pattern, clock )
+	ZUAZO_ENUM2STR_CASE( Cenital::Transitions::Wipe::Pattern, shape )
+
+	default: return "";
+	}
+}
+
+size_t fromString(std::string_view str, Cenital::Transitions::Wipe::Pattern& pattern) {
+	//HACK. Using a lambda to call toString as otherwise it fails due to include ordering
+	return enumFromString(
+		str, pattern, 
+		[] (const Cenital::Transitions::Wipe::Pattern& pattern) -> std::string_view { 
+			return toString(pattern);
+		}
+	);
+}
+
+std::ostream& operator<<(std::ostream& os, Cenital::Transitions::Wipe::Pattern pattern) {
+	return os << toString(pattern);
+}
+
+}
\ No newline at end of file
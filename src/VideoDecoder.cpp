@@ -0,0 +1,144 @@
+#include <VideoDecoder.h>
+
+#include <array>
+#include <new>
+#include <stdexcept>
+
+namespace Cenital {
+
+void VideoDecoder::FormatContextDeleter::operator()(AVFormatContext* ctx) const noexcept {
+	avformat_close_input(&ctx);
+}
+
+void VideoDecoder::CodecContextDeleter::operator()(AVCodecContext* ctx) const noexcept {
+	avcodec_free_context(&ctx);
+}
+
+void VideoDecoder::PacketDeleter::operator()(AVPacket* packet) const noexcept {
+	av_packet_free(&packet);
+}
+
+void VideoDecoder::FrameDeleter::operator()(AVFrame* frame) const noexcept {
+	av_frame_free(&frame);
+}
+
+void VideoDecoder::SwsContextDeleter::operator()(SwsContext* ctx) const noexcept {
+	sws_freeContext(ctx);
+}
+
+
+
+VideoDecoder::VideoDecoder(std::string filename)
+	: m_filename(std::move(filename))
+	, m_formatContext()
+	, m_codecContext()
+	, m_packet(av_packet_alloc())
+	, m_frame(av_frame_alloc())
+	, m_swsContext()
+	, m_streamIndex(-1)
+{
+	if(!m_packet || !m_frame) {
+		throw std::bad_alloc();
+	}
+
+	//Open the file and find the video on it
+	AVFormatContext* formatContextPtr = nullptr;
+	if(avformat_open_input(&formatContextPtr, m_filename.c_str(), nullptr, nullptr) < 0) {
+		throw std::runtime_error("Could not open " + m_filename);
+	}
+	m_formatContext.reset(formatContextPtr);
+
+	if(avformat_find_stream_info(m_formatContext.get(), nullptr) < 0) {
+		throw std::runtime_error("Could not read " + m_filename);
+	}
+
+	m_streamIndex = av_find_best_stream(m_formatContext.get(), AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+	if(m_streamIndex < 0) {
+		throw std::runtime_error("No video in " + m_filename);
+	}
+	const auto* codecParameters = m_formatContext->streams[m_streamIndex]->codecpar;
+
+	//Create a decoder for it
+	const AVCodec* codec = avcodec_find_decoder(codecParameters->codec_id);
+	if(!codec) {
+		throw std::runtime_error("Unsupported format in " + m_filename);
+	}
+
+	m_codecContext.reset(avcodec_alloc_context3(codec));
+	if(	!m_codecContext ||
+		avcodec_parameters_to_context(m_codecContext.get(), codecParameters) < 0 ||
+		avcodec_open2(m_codecContext.get(), codec, nullptr) < 0 )
+	{
+		throw std::runtime_error("Could not create a decoder for " + m_filename);
+	}
+}
+
+
+
+const std::string& VideoDecoder::getFilename() const noexcept {
+	return m_filename;
+}
+
+
+
+const AVFrame* VideoDecoder::decode() {
+	for(;;) {
+		//Try to obtain a frame from the data sent so far
+		const auto result = avcodec_receive_frame(m_codecContext.get(), m_frame.get());
+		if(result >= 0) {
+			return m_frame.get();
+		} else if(result == AVERROR_EOF) {
+			return nullptr;
+		} else if(result != AVERROR(EAGAIN)) {
+			throw std::runtime_error("Could not decode " + m_filename);
+		}
+
+		//Feed the decoder. At the end of the file, make it
+		//output the frames it may be holding
+		if(av_read_frame(m_formatContext.get(), m_packet.get()) >= 0) {
+			const auto sent = (m_packet->stream_index == m_streamIndex) ?
+				avcodec_send_packet(m_codecContext.get(), m_packet.get()) :
+				0 ;
+			av_packet_unref(m_packet.get());
+
+			if(sent < 0) {
+				throw std::runtime_error("Could not decode " + m_filename);
+			}
+		} else {
+			avcodec_send_packet(m_codecContext.get(), nullptr);
+		}
+	}
+}
+
+void VideoDecoder::convert(	const AVFrame& frame,
+							AVPixelFormat format,
+							int width,
+							int height,
+							uint8_t* data,
+							int lineSize )
+{
+	//The context is reused as long as the parameters do not change.
+	//Area averaging is used, as frames are not upscaled
+	m_swsContext.reset(
+		sws_getCachedContext(
+			m_swsContext.release(),
+			frame.width, frame.height, static_cast<AVPixelFormat>(frame.format),
+			width, height, format,
+			SWS_AREA, nullptr, nullptr, nullptr
+		)
+	);
+	if(!m_swsContext) {
+		throw std::runtime_error("Unsupported pixel format in " + m_filename);
+	}
+
+	const std::array<uint8_t*, 4> destinationData = { data, nullptr, nullptr, nullptr };
+	const std::array<int, 4> destinationLineSize = { lineSize, 0, 0, 0 };
+	sws_scale(
+		m_swsContext.get(),
+		reinterpret_cast<const uint8_t* const*>(frame.data), frame.linesize,
+		0, frame.height,
+		destinationData.data(), destinationLineSize.data()
+	);
+}
+
+}
\ No newline at end of file
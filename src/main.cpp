@@ -1,14 +1,22 @@
 #include "Mixer.h"
 
 #include "MixEffect.h"
+#include "Tally.h"
+#include "AnimationNotifier.h"
+#include "Profiling.h"
+#include "Metrics.h"
+#include "DumpDirectory.h"
 
 #include "Sources/MediaPlayer.h"
 #include "Sources/NDI.h"
 
 #include "Consumers/Window.h"
+#include "Consumers/Offscreen.h"
 
 #include "Transitions/Mix.h"
 #include "Transitions/DVE.h"
+#include "Transitions/Wipe.h"
+#include "Transitions/Stinger.h"
 
 #include "Overlays/Keyer.h"
 
@@ -16,6 +24,7 @@
 #include "Control/CLIView.h"
 #include "Control/WebSocketServer.h"
 #include "Control/TCPServer.h"
+#include "Control/PrometheusServer.h"
 
 #include <zuazo/Instance.h>
 #include <zuazo/Modules/Window.h>
@@ -25,16 +34,18 @@
 #include <zuazo/Modules/Compositor.h>
 
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include <cstdint>
 
 #include <tclap/CmdLine.h>
 
 using namespace Cenital;
 
-static void registerCommands(Control::Controller& controller) {
+static void registerCommands(Control::Controller& controller, bool headless) {
 	//Register the commands we know ahead of time.
 	//Although the ordering is not important, calls
 	//are ordered by type for convenience.
@@ -48,14 +59,23 @@ static void registerCommands(Control::Controller& controller) {
 	Sources::NDI::registerCommands(controller);
 
 	//Register consumers
-	Consumers::Window::registerCommands(controller);
+	if(!headless) {
+		Consumers::Window::registerCommands(controller);
+	}
+	Consumers::Offscreen::registerCommands(controller);
 
 	//Register transitions
 	Transitions::Mix::registerCommands(controller);
 	Transitions::DVE::registerCommands(controller);
+	Transitions::Wipe::registerCommands(controller);
+	Transitions::Stinger::registerCommands(controller);
 
 	//Register overlays
 	Overlays::Keyer::registerCommands(controller);
+
+	//Register diagnostics
+	Tracing::registerCommands(controller);
+	Metrics::registerCommands(controller);
 }
 
 
@@ -128,6 +148,32 @@ static std::unique_ptr<Control::TCPServer> createTCPServer(	boost::asio::io_serv
 
 
 
+static std::unique_ptr<Control::PrometheusServer> createPrometheusServer(	boost::asio::io_service& ios,
+																			uint16_t port,
+																			Zuazo::Instance& instance )
+{
+	std::unique_ptr<Control::PrometheusServer> result;
+
+	if(port > 0) { //0 port is used to disable the service
+		result = Zuazo::Utils::makeUnique<Control::PrometheusServer>(ios, port);
+
+		result->setBodyCallback(
+			[&instance] () -> std::string {
+				std::lock_guard<Zuazo::Instance> lock(instance);
+				std::ostringstream oss;
+				Metrics::writePrometheus(oss);
+				return oss.str();
+			}
+		);
+
+		result->startAccept();
+	}
+
+	return result;
+}
+
+
+
 static void wait(std::unique_lock<Zuazo::Instance>& lock, std::string_view keyword) {
 	//Show running message
 	std::cerr << "Running... Type \"" << keyword << "\" and press ENTER to terminate" << std::endl;
@@ -184,12 +230,34 @@ int main(int argc, const char* const* argv) {
 		"port", 							//Type description
 		cmd									//Command parser
 	);
+	TCLAP::ValueArg<uint16_t> metricsPortArg(
+		"", "metrics-port", 				//Arguments
+		"Port used by the Prometheus metrics endpoint. 0 disables it. Default: 0",//Description
+		false, 								//Required
+		0, 									//Default value
+		"port", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::ValueArg<std::string> dumpDirectoryArg(
+		"", "dump-directory", 				//Arguments
+		"Directory where the files requested through the CLI (traces and offscreen dumps) are written. Empty disables them. Default: empty",//Description
+		false, 								//Required
+		"", 								//Default value
+		"path", 							//Type description
+		cmd									//Command parser
+	);
+	TCLAP::SwitchArg headlessArg(
+		"", "headless", 					//Arguments
+		"Run without a display. Only offscreen outputs are available", //Description
+		cmd 								//Command parser
+	);
 	
 
 	//Create XORs between arguments
 
 	//Parse the arguments
 	cmd.parse(argc, argv);
+	DumpDirectory::setPath(dumpDirectoryArg.getValue());
 
 
 
@@ -203,13 +271,18 @@ int main(int argc, const char* const* argv) {
 							Zuazo::Verbosity::geqError ;
 
 	Zuazo::Instance::ApplicationInfo::Modules modules {
-		Zuazo::Modules::Window::get(),
 		Zuazo::Modules::FFmpeg::get(),
 		//Zuazo::Modules::Magick::get(),
 		Zuazo::Modules::NDI::get(),
 		Zuazo::Modules::Compositor::get(),
 	};
 
+	//The window module requires a display. Without it, no presentation
+	//support is required, so that software Vulkan implementations can be used
+	if(!headlessArg.getValue()) {
+		modules.emplace_back(Zuazo::Modules::Window::get());
+	}
+
 	Zuazo::Instance::ApplicationInfo appInfo(
 		appName,					//Application name
 		version,					//Application version
@@ -238,11 +311,18 @@ int main(int argc, const char* const* argv) {
 	 *****************************/
 
 	Control::Controller controller(mixer);
-	registerCommands(controller);
+	registerCommands(controller, headlessArg.getValue());
 
 	Control::CLIView cliView(controller);
 	controller.addView(cliView);
 
+	Tally tally(controller, mixer);
+	controller.addView(tally);
+	tally.registerCommands(controller);
+
+	AnimationNotifier animationNotifier(controller, mixer);
+	controller.addView(animationNotifier);
+
 
 
 	/*****************************
@@ -264,6 +344,50 @@ int main(int argc, const char* const* argv) {
 		cliView
 	);
 
+	const auto prometheusServer = createPrometheusServer(
+		ios,
+		metricsPortArg.getValue(),
+		instance
+	);
+
+	//Collect the metrics of the control services
+	std::vector<Metrics::CollectorId> metricsCollectors;
+	if(webSocketServer) {
+		metricsCollectors.push_back(Metrics::addCollector(
+			std::bind(&Control::WebSocketServer::collectMetrics, std::cref(*webSocketServer), std::placeholders::_1)
+		));
+	}
+	if(tcpServer) {
+		metricsCollectors.push_back(Metrics::addCollector(
+			std::bind(&Control::TCPServer::collectMetrics, std::cref(*tcpServer), std::placeholders::_1)
+		));
+	}
+
+	//Tally changes which happen on their own (i.e. the end of an
+	//auto transition) are published from the service thread
+	tally.setInvalidateCallback(
+		[&ios, &instance] (Tally& tally) -> void {
+			ios.post(
+				[&instance, &tally] () -> void {
+					std::lock_guard<Zuazo::Instance> lock(instance);
+					tally.refresh();
+				}
+			);
+		}
+	);
+
+	//Same for the end of the keyer animations
+	animationNotifier.setInvalidateCallback(
+		[&ios, &instance] (AnimationNotifier& notifier) -> void {
+			ios.post(
+				[&instance, &notifier] () -> void {
+					std::lock_guard<Zuazo::Instance> lock(instance);
+					notifier.refresh();
+				}
+			);
+		}
+	);
+
 	//Create a thread for running the services
 	std::thread serviceThread(
 		[&ios] () {
@@ -284,5 +408,9 @@ int main(int argc, const char* const* argv) {
 	ios.stop();
 	serviceThread.join();
 
+	for(const auto collector : metricsCollectors) {
+		Metrics::removeCollector(collector);
+	}
+
 	return 0;
 }
\ No newline at end of file
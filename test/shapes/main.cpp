@@ -0,0 +1,69 @@
+#include <Shapes.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace Cenital;
+
+using ShapesPtr = std::shared_ptr<const std::vector<Shape>>;
+
+static bool report(const std::string& name, bool result) {
+	std::cout << (result ? "PASS " : "FAIL ") << name << std::endl;
+	return result;
+}
+
+static std::string makeSquarePath(size_t size) {
+	const auto s = std::to_string(size);
+	return "M0 0 L" + s + " 0 L" + s + " " + s + " L0 " + s + " Z";
+}
+
+
+
+static bool testCacheHit() {
+	//The first result is dropped before the second call, as the
+	//shape command does after copying the contours
+	const auto path = makeSquarePath(1);
+	std::weak_ptr<const std::vector<Shape>> first = loadSVGPath(path);
+	const auto second = loadSVGPath(path);
+
+	return report(
+		"A repeated path is not parsed again",
+		second && !first.expired() && first.lock() == second
+	);
+}
+
+static bool testInvalidPath() {
+	return report(
+		"An invalid path is rejected",
+		loadSVGPath("M0 0 X1 1") == nullptr
+	);
+}
+
+static bool testEviction() {
+	//Fill the cache with other paths, so that the first one is evicted
+	const auto path = makeSquarePath(2);
+	std::weak_ptr<const std::vector<Shape>> first = loadSVGPath(path);
+
+	bool result = !first.expired();
+	for(size_t i = 0; i < 1024 && !first.expired(); ++i) {
+		result = result && loadSVGPath(makeSquarePath(i + 3));
+	}
+
+	return report(
+		"The least recently used paths are released",
+		result && first.expired()
+	);
+}
+
+
+
+int main() {
+	size_t failures = 0;
+	failures += testCacheHit() ? 0 : 1;
+	failures += testInvalidPath() ? 0 : 1;
+	failures += testEviction() ? 0 : 1;
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <FrameClock.h>
+
+#include <zuazo/Chrono.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Cenital;
+
+struct Case {
+	std::string						name;
+	Zuazo::Rate						frameRate;
+	Zuazo::Duration					duration;
+	FrameClock::FrameCount			expectedFrames;
+	double							jitter; //Relative to the period
+};
+
+
+
+static bool run(const Case& test) {
+	//Same as MixEffectImpl::update(), with a simulated render loop. Its
+	//ticks are displaced from the ideal timestamps by a random jitter
+	const auto period = Zuazo::getPeriod(test.frameRate);
+	const auto frameCount = FrameClock::getFrameCount(test.duration, period);
+	const auto duration = frameCount * period;
+
+	std::mt19937 generator(frameCount); //Deterministic
+	std::uniform_real_distribution<double> distribution(-test.jitter / 2, +test.jitter / 2);
+	const auto displacement = [&] () -> Zuazo::Duration {
+		return std::chrono::duration_cast<Zuazo::Duration>(distribution(generator) * period);
+	};
+
+	FrameClock clock;
+	Zuazo::TimePoint time;
+	std::vector<Zuazo::TimePoint> frames;
+	auto lastTick = displacement();
+	for(size_t tick = 1; time.time_since_epoch() < duration && tick <= 2*static_cast<size_t>(frameCount); ++tick) {
+		const auto now = static_cast<Zuazo::Duration::rep>(tick) * period + displacement();
+		const auto elapsedFrames = clock.advance(now - lastTick, period);
+		lastTick = now;
+
+		time = std::min(time + elapsedFrames * period, Zuazo::TimePoint(duration));
+		frames.push_back(time);
+	}
+
+	//Each tick should have advanced exactly one frame
+	bool result = frameCount == test.expectedFrames && frames.size() == static_cast<size_t>(frameCount);
+	for(size_t i = 0; i < frames.size() && result; ++i) {
+		result = frames[i].time_since_epoch() == static_cast<Zuazo::Duration::rep>(i + 1) * period;
+	}
+
+	std::cout 	<< (result ? "PASS " : "FAIL ") << test.name << ": "
+				<< frames.size() << " frames rendered, "
+				<< test.expectedFrames << " expected" << std::endl;
+
+	return result;
+}
+
+int main() {
+	using namespace std::chrono_literals;
+
+	const Zuazo::Rate FPS_25(25, 1);
+	const Zuazo::Rate FPS_50(50, 1);
+	const Zuazo::Rate FPS_59_94(60000, 1001);
+
+	const std::vector<Case> cases = {
+		{ "25fps, 25 frames, no jitter",		FPS_25,		Zuazo::getPeriod(FPS_25) * 25,		25,		0.0 },
+		{ "25fps, 25 frames, jitter",			FPS_25,		Zuazo::getPeriod(FPS_25) * 25,		25,		0.45 },
+		{ "25fps, 1s",							FPS_25,		1s,									25,		0.45 },
+		{ "50fps, 50 frames, no jitter",		FPS_50,		Zuazo::getPeriod(FPS_50) * 50,		50,		0.0 },
+		{ "50fps, 50 frames, jitter",			FPS_50,		Zuazo::getPeriod(FPS_50) * 50,		50,		0.45 },
+		{ "50fps, 1s",							FPS_50,		1s,									50,		0.45 },
+		{ "59.94fps, 60 frames, no jitter",		FPS_59_94,	Zuazo::getPeriod(FPS_59_94) * 60,	60,		0.0 },
+		{ "59.94fps, 60 frames, jitter",		FPS_59_94,	Zuazo::getPeriod(FPS_59_94) * 60,	60,		0.45 },
+		{ "59.94fps, 1s",						FPS_59_94,	1s,									60,		0.45 },
+		{ "59.94fps, 10s",						FPS_59_94,	10s,								599,	0.45 },
+	};
+
+	size_t failures = 0;
+	for(const auto& test : cases) {
+		if(!run(test)) {
+			++failures;
+		}
+	}
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
\ No newline at end of file